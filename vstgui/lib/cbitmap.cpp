@@ -160,6 +160,8 @@ auto CBitmap::getBestPlatformBitmapForScaleFactor (double scaleFactor) const ->
 {
 	if (bitmaps.empty ())
 		return nullptr;
+	if (bitmaps.size () == 1)
+		return bitmaps[0];
 	auto bestBitmap = bitmaps[0];
 	double bestDiff = std::abs (scaleFactor - bestBitmap->getScaleFactor ());
 	for (const auto& bitmap : bitmaps)
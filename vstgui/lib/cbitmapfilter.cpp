@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "cbitmapfilter.h"
+#include "cbitmapfilterkernels.h"
 #include "cbitmap.h"
 #include "platform/iplatformbitmap.h"
 #include "ccolor.h"
@@ -282,6 +283,7 @@ bool Factory::unregisterFilter (IdStringPtr name, IFilter::CreateFunction create
 FilterBase::FilterBase (UTF8StringPtr description)
 : description (description ? description : "")
 {
+	registerProperty (Standard::Property::kMaxThreads, Property ((int32_t)1));
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -383,9 +385,63 @@ CBitmap* FilterBase::getInputBitmap () const
 	return nullptr;
 }
 
+//----------------------------------------------------------------------------------------------------
+void FilterBase::forEachTile (int32_t count, int32_t minTileSize, const TileFunction& proc) const
+{
+	uint32_t maxThreads = 1;
+	const auto& maxThreadsProp = getProperty (Standard::Property::kMaxThreads);
+	if (maxThreadsProp.getType () == Property::kInteger && maxThreadsProp.getInteger () >= 0)
+		maxThreads = static_cast<uint32_t> (maxThreadsProp.getInteger ());
+	Kernels::runTiled (count, minTileSize, maxThreads, proc);
+}
+
+//----------------------------------------------------------------------------------------------------
+constexpr int32_t FilterBase::kMinTilePixels;
+
 ///@cond ignore
 namespace Standard {
 
+//----------------------------------------------------------------------------------------------------
+static Kernels::ChannelLayout getChannelLayout (IPlatformBitmapPixelAccess::PixelFormat format)
+{
+	switch (format)
+	{
+		case IPlatformBitmapPixelAccess::kARGB: return {1, 2, 3, 0};
+		case IPlatformBitmapPixelAccess::kRGBA: return {0, 1, 2, 3};
+		case IPlatformBitmapPixelAccess::kABGR: return {3, 2, 1, 0};
+		case IPlatformBitmapPixelAccess::kBGRA: return {2, 1, 0, 3};
+	}
+	return {0, 1, 2, 3};
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint32_t packColor (const CColor& color, Kernels::ChannelLayout layout)
+{
+	uint8_t bytes[4];
+	bytes[layout.red] = color.red;
+	bytes[layout.green] = color.green;
+	bytes[layout.blue] = color.blue;
+	bytes[layout.alpha] = color.alpha;
+	uint32_t result;
+	memcpy (&result, bytes, sizeof (result));
+	return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+static void convertRow (const uint8_t* src, Kernels::ChannelLayout srcLayout, uint8_t* dst,
+						Kernels::ChannelLayout dstLayout, uint32_t count)
+{
+	for (auto i = 0u; i < count; ++i, src += 4, dst += 4)
+	{
+		uint8_t pixel[4];
+		pixel[dstLayout.red] = src[srcLayout.red];
+		pixel[dstLayout.green] = src[srcLayout.green];
+		pixel[dstLayout.blue] = src[srcLayout.blue];
+		pixel[dstLayout.alpha] = src[srcLayout.alpha];
+		memcpy (dst, pixel, sizeof (pixel));
+	}
+}
+
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
@@ -459,6 +515,7 @@ private:
 		auto outputAddressPtr = outputPbpa->getAddress ();
 		auto width = inputPbpa->getBytesPerRow () / 4;
 		auto height = inputAccessor.getBitmapHeight ();
+		bool usePlane[4] = {true, true, true, true};
 		if (alphaChannelOnly)
 		{
 			switch (inputPbpa->getPixelFormat ())
@@ -466,207 +523,59 @@ private:
 				case IPlatformBitmapPixelAccess::kARGB:
 				case IPlatformBitmapPixelAccess::kABGR:
 				{
-					algo<true, false, false, false> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
+					usePlane[1] = usePlane[2] = usePlane[3] = false;
 					break;
 				}
 				case IPlatformBitmapPixelAccess::kRGBA:
 				case IPlatformBitmapPixelAccess::kBGRA:
 				{
-					algo<false, false, false, true> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
+					usePlane[0] = usePlane[1] = usePlane[2] = false;
 					break;
 				}
 			}
-		
-		}
-		else
-		{
-			algo<true, true, true, true> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
 		}
+		algo (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2), usePlane);
 	}
 
-	Buffer<uint8_t> pc0;
-	Buffer<uint8_t> pc1;
-	Buffer<uint8_t> pc2;
-	Buffer<uint8_t> pc3;
-	Buffer<int32_t> vMin;
-	Buffer<int32_t> vMax;
+	Buffer<uint8_t> pc[4];
 	Buffer<uint8_t> dv;
 
-	template<bool plane0, bool plane1, bool plane2, bool plane3>
-	void algo (uint8_t* inPixel, uint8_t* outPixel, int32_t width, int32_t height, int32_t radius)
+	void algo (const uint8_t* inPixel, uint8_t* outPixel, int32_t width, int32_t height, int32_t radius, const bool (&usePlane)[4])
 	{
 		vstgui_assert (radius > 0);
 
-		constexpr int32_t pos0 = 0;
-		constexpr int32_t pos1 = 1;
-		constexpr int32_t pos2 = 2;
-		constexpr int32_t pos3 = 3;
-		constexpr int32_t numComponents = 4;
-
-		int32_t wm = width - 1;
-		int32_t hm = height - 1;
 		int32_t areaSize = width * height;
 		int32_t div = radius + radius + 1;
-		
-		if (plane0)
-			pc0.allocate (areaSize);
-		if (plane1)
-			pc1.allocate (areaSize);
-		if (plane2)
-			pc2.allocate (areaSize);
-		if (plane3)
-			pc3.allocate (areaSize);
-		vMin.allocate (std::max (width, height));
-		vMax.allocate (std::max (width, height));
-		dv.allocate (256 * div);
-
-		for (auto i = 0u; i < dv.size (); ++i)
-			dv[i] = (i / div);
 
-		int32_t sum0, sum1, sum2, sum3;
-		for (auto y = 0, yw = 0, yi = 0; y < height; ++y, yw += width)
+		Kernels::BoxBlurPlanes planes;
+		for (auto i = 0; i < 4; ++i)
 		{
-			sum0 = sum1 = sum2 = sum3 = 0;
-			for (auto i = -radius; i <= radius; i++)
-			{
-				auto p = (yi + std::min (wm, std::max (i, 0))) * numComponents;
-				if (plane0)
-					sum0 += inPixel[p + pos0];
-				if (plane1)
-					sum1 += inPixel[p + pos1];
-				if (plane2)
-					sum2 += inPixel[p + pos2];
-				if (plane3)
-					sum3 += inPixel[p + pos3];
-			}
-			if (y == 0)
-			{
-				for (auto x = 0; x < width; ++x, ++yi)
-				{
-					if (plane0)
-						pc0[yi] = dv[sum0];
-					if (plane1)
-						pc1[yi] = dv[sum1];
-					if (plane2)
-						pc2[yi] = dv[sum2];
-					if (plane3)
-						pc3[yi] = dv[sum3];
-					vMin[x] = std::min (x + radius + 1, wm);
-					vMax[x] = std::max (x - radius, 0);
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
-					if (plane0)
-						sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
-					if (plane1)
-						sum1 += inPixel[p1 + pos1] - inPixel[p2 + pos1];
-					if (plane2)
-						sum2 += inPixel[p1 + pos2] - inPixel[p2 + pos2];
-					if (plane3)
-						sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
-				}
-			}
-			else
+			planes.plane[i] = nullptr;
+			if (usePlane[i])
 			{
-				for (auto x = 0; x < width; ++x, ++yi)
-				{
-					if (plane0)
-						pc0[yi] = dv[sum0];
-					if (plane1)
-						pc1[yi] = dv[sum1];
-					if (plane2)
-						pc2[yi] = dv[sum2];
-					if (plane3)
-						pc3[yi] = dv[sum3];
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
-					if (plane0)
-						sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
-					if (plane1)
-						sum1 += inPixel[p1 + pos1] - inPixel[p2 + pos1];
-					if (plane2)
-						sum2 += inPixel[p1 + pos2] - inPixel[p2 + pos2];
-					if (plane3)
-						sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
-				}
+				pc[i].allocate (areaSize);
+				planes.plane[i] = pc[i].data ();
 			}
 		}
+		dv.allocate (256 * div);
 
-		sum0 = sum1 = sum2 = sum3 = 0;
-		for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
-		{
-			auto yi = std::max (0, yp);
-			if (plane0)
-				sum0 += pc0[yi];
-			if (plane1)
-				sum1 += pc1[yi];
-			if (plane2)
-				sum2 += pc2[yi];
-			if (plane3)
-				sum3 += pc3[yi];
-		}
-		for (auto y = 0, yi = 0; y < height; ++y, yi += width)
-		{
-			auto pos = yi * numComponents;
-			if (plane0)
-				outPixel[pos + pos0] = dv[sum0];
-			if (plane1)
-				outPixel[pos + pos1] = dv[sum1];
-			if (plane2)
-				outPixel[pos + pos2] = dv[sum2];
-			if (plane3)
-				outPixel[pos + pos3] = dv[sum3];
-			vMin[y] = std::min (y + radius + 1, hm) * width;
-			vMax[y] = std::max (y - radius, 0) * width;
-			auto p1 = vMin[y];
-			auto p2 = vMax[y];
-			if (plane0)
-				sum0 += pc0[p1] - pc0[p2];
-			if (plane1)
-				sum1 += pc1[p1] - pc1[p2];
-			if (plane2)
-				sum2 += pc2[p1] - pc2[p2];
-			if (plane3)
-				sum3 += pc3[p1] - pc3[p2];
-		}
+		for (auto i = 0u; i < dv.size (); ++i)
+			dv[i] = (i / div);
 
-		for (auto x = 1; x < width; ++x)
-		{
-			sum0 = sum1 = sum2 = sum3 = 0;
-			for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
-			{
-				auto yi = std::max (0, yp) + x;
-				if (plane0)
-					sum0 += pc0[yi];
-				if (plane1)
-					sum1 += pc1[yi];
-				if (plane2)
-					sum2 += pc2[yi];
-				if (plane3)
-					sum3 += pc3[yi];
-			}
-			for (auto y = 0, yi = x; y < height; ++y, yi += width)
-			{
-				auto pos = yi * numComponents;
-				if (plane0)
-					outPixel[pos + pos0] = dv[sum0];
-				if (plane1)
-					outPixel[pos + pos1] = dv[sum1];
-				if (plane2)
-					outPixel[pos + pos2] = dv[sum2];
-				if (plane3)
-					outPixel[pos + pos3] = dv[sum3];
-				auto p1 = x + vMin[y];
-				auto p2 = x + vMax[y];
-				if (plane0)
-					sum0 += pc0[p1] - pc0[p2];
-				if (plane1)
-					sum1 += pc1[p1] - pc1[p2];
-				if (plane2)
-					sum2 += pc2[p1] - pc2[p2];
-				if (plane3)
-					sum3 += pc3[p1] - pc3[p2];
-			}
-		}
+		planes.width = width;
+		planes.height = height;
+		planes.radius = radius;
+		planes.divTable = dv.data ();
+
+		const auto& kernels = Kernels::getRowKernels ();
+		auto minTileRows = std::max (1, kMinTilePixels / width);
+		forEachTile (height, minTileRows, [&] (int32_t begin, int32_t end) {
+			kernels.boxBlurRows (inPixel, planes, begin, end);
+		});
+		// the vertical pass of a tile reads radius rows of the planes above and below the tile
+		forEachTile (height, minTileRows, [&] (int32_t begin, int32_t end) {
+			kernels.boxBlurColumns (planes, outPixel, begin, end);
+		});
 	}
 };
 
@@ -680,7 +589,7 @@ protected:
 		registerProperty (Property::kInputBitmap, BitmapFilter::Property (BitmapFilter::Property::kObject));
 		registerProperty (Property::kOutputRect, CRect (0, 0, 10, 10));
 	}
-	
+
 	bool run (bool replace) override
 	{
 		if (replace)
@@ -698,7 +607,7 @@ protected:
 		SharedPointer<CBitmap> outputBitmap = owned (new CBitmap (outSize.getWidth (), outSize.getHeight ()));
 		if (outputBitmap == nullptr)
 			return false;
-		
+
 		SharedPointer<CBitmapPixelAccess> inputAccessor = owned (CBitmapPixelAccess::create (inputBitmap));
 		SharedPointer<CBitmapPixelAccess> outputAccessor = owned (CBitmapPixelAccess::create (outputBitmap));
 		if (inputAccessor == nullptr || outputAccessor == nullptr)
@@ -706,9 +615,9 @@ protected:
 		process (*inputAccessor, *outputAccessor);
 		return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (outputBitmap));
 	}
-	
+
 	virtual void process (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap) = 0;
-	
+
 };
 
 //----------------------------------------------------------------------------------------------------
@@ -723,16 +632,19 @@ public:
 private:
 	ScaleLinear () : ScaleBase ("A Linear Scale Filter") {}
 
+	Buffer<int32_t> xIndex;
+	Buffer<int32_t> yIndex;
+
 	void process (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap) override
 	{
 		originalBitmap.setPosition (0, 0);
 		copyBitmap.setPosition (0, 0);
-		
+
 		uint32_t origWidth = (uint32_t)originalBitmap.getBitmapWidth ();
 		uint32_t origHeight = (uint32_t)originalBitmap.getBitmapHeight ();
 		uint32_t newWidth = (uint32_t)copyBitmap.getBitmapWidth ();
 		uint32_t newHeight = (uint32_t)copyBitmap.getBitmapHeight ();
-		
+
 		float xRatio = (float)origWidth / (float)newWidth;
 		float yRatio = (float)origHeight / (float)newHeight;
 
@@ -741,29 +653,35 @@ private:
 		uint32_t origBytesPerRow = originalBitmap.getPlatformBitmapPixelAccess ()->getBytesPerRow ();
 		uint32_t copyBytesPerRow = copyBitmap.getPlatformBitmapPixelAccess ()->getBytesPerRow ();
 
-		int32_t ix;
-		int32_t iy = -1;
-		int32_t* origPixel = nullptr;
-		float origY = 0;
+		// the source columns are the same for every row. The positions are accumulated, so they
+		// are computed up front to get the same rows no matter how the rows are tiled.
+		xIndex.allocate (newWidth);
 		float origX = 0;
+		for (uint32_t x = 0; x < newWidth; x++, origX += xRatio)
+			xIndex[x] = std::min ((int32_t)origX, (int32_t)origWidth - 1);
+		yIndex.allocate (newHeight);
+		float origY = 0;
 		for (uint32_t y = 0; y < newHeight; y++, origY += yRatio)
-		{
-			int32_t* copyPixel = (int32_t*)(copyAddress + y * copyBytesPerRow);
-			if (iy != (int32_t)origY)
-				iy = (int32_t)origY;
-			ix = -1;
-			origX = 0;
-			for (uint32_t x = 0; x < newWidth; x++, origX += xRatio, copyPixel++)
+			yIndex[y] = std::min ((int32_t)origY, (int32_t)origHeight - 1);
+
+		const auto& kernels = Kernels::getRowKernels ();
+		auto minTileRows = std::max (1, kMinTilePixels / static_cast<int32_t> (newWidth));
+		forEachTile (static_cast<int32_t> (newHeight), minTileRows, [&] (int32_t begin, int32_t end) {
+			for (auto y = begin; y < end; y++)
 			{
-				if (ix != (int32_t)origX || origPixel == nullptr)
+				auto copyRow = reinterpret_cast<uint32_t*> (copyAddress + y * copyBytesPerRow);
+				if (y > begin && yIndex[y] == yIndex[y - 1])
 				{
-					ix = (int32_t)origX;
-					vstgui_assert (iy >= 0);
-					origPixel = (int32_t*)(origAddress + static_cast<uint32_t> (iy) * origBytesPerRow + ix * 4);
+					memcpy (copyRow, copyAddress + (y - 1) * copyBytesPerRow, newWidth * 4);
+				}
+				else
+				{
+					auto origRow = reinterpret_cast<const uint32_t*> (
+						origAddress + static_cast<uint32_t> (yIndex[y]) * origBytesPerRow);
+					kernels.gather (origRow, xIndex.data (), copyRow, newWidth);
 				}
-				*copyPixel = *origPixel;
 			}
-		}
+		});
 	}
 };
 
@@ -779,7 +697,65 @@ public:
 private:
 	ScaleBiliniear () : ScaleBase ("A Biliniear Scale Filter") {}
 
+	Buffer<int32_t> xIndex;
+	Buffer<int32_t> xNextIndex;
+	Buffer<float> xDiffs;
+
 	void process (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap) override
+	{
+		auto origPbpa = originalBitmap.getPlatformBitmapPixelAccess ();
+		auto copyPbpa = copyBitmap.getPlatformBitmapPixelAccess ();
+		if (origPbpa->getPixelFormat () != copyPbpa->getPixelFormat ())
+		{
+			processPixels (originalBitmap, copyBitmap);
+			return;
+		}
+
+		uint32_t origWidth = (uint32_t)originalBitmap.getBitmapWidth ();
+		uint32_t origHeight = (uint32_t)originalBitmap.getBitmapHeight ();
+		uint32_t newWidth = (uint32_t)copyBitmap.getBitmapWidth ();
+		uint32_t newHeight = (uint32_t)copyBitmap.getBitmapHeight ();
+
+		float xRatio = ((float)(origWidth-1)) / (float)newWidth;
+		float yRatio = ((float)(origHeight-1)) / (float)newHeight;
+		float xDiff;
+		uint32_t x;
+
+		// the source columns and their weights are the same for every row
+		xIndex.allocate (newWidth);
+		xNextIndex.allocate (newWidth);
+		xDiffs.allocate (newWidth);
+		for (uint32_t j = 0; j < newWidth; j++)
+		{
+			x = static_cast<uint32_t> (xRatio * j);
+			xDiff = (xRatio * j) - x;
+			xIndex[j] = static_cast<int32_t> (x);
+			xNextIndex[j] = static_cast<int32_t> (std::min (x + 1, origWidth - 1));
+			xDiffs[j] = xDiff;
+		}
+
+		const auto& kernels = Kernels::getRowKernels ();
+		auto origAddress = origPbpa->getAddress ();
+		auto origBytesPerRow = origPbpa->getBytesPerRow ();
+		auto minTileRows = std::max (1, kMinTilePixels / static_cast<int32_t> (newWidth));
+		forEachTile (static_cast<int32_t> (newHeight), minTileRows, [&] (int32_t begin, int32_t end) {
+			for (auto i = static_cast<uint32_t> (begin); i < static_cast<uint32_t> (end); i++)
+			{
+				auto y = static_cast<uint32_t> (yRatio * i);
+				auto yDiff = (yRatio * i) - y;
+
+				auto row0 = reinterpret_cast<const uint32_t*> (origAddress + y * origBytesPerRow);
+				auto row1 = reinterpret_cast<const uint32_t*> (
+					origAddress + std::min (y + 1, origHeight - 1) * origBytesPerRow);
+				auto copyRow = reinterpret_cast<uint32_t*> (copyPbpa->getAddress () +
+															i * copyPbpa->getBytesPerRow ());
+				kernels.bilinear (row0, row1, xIndex.data (), xNextIndex.data (), xDiffs.data (),
+								  yDiff, copyRow, newWidth);
+			}
+		});
+	}
+
+	void processPixels (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap)
 	{
 		originalBitmap.setPosition (0, 0);
 		copyBitmap.setPosition (0, 0);
@@ -831,15 +807,11 @@ private:
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-using SimpleFilterProcessFunction = void (*) (CColor& color, FilterBase* self);
-
-template<typename SimpleFilterProcessFunction>
 class SimpleFilter : public FilterBase
 {
 protected:
-	SimpleFilter (UTF8StringPtr description, SimpleFilterProcessFunction function)
+	SimpleFilter (UTF8StringPtr description)
 	: FilterBase (description)
-	, processFunction (function)
 	{
 		registerProperty (Property::kInputBitmap, BitmapFilter::Property (BitmapFilter::Property::kObject));
 	}
@@ -874,39 +846,41 @@ protected:
 
 	void run (CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor)
 	{
-		inputAccessor.setPosition (0, 0);
-		outputAccessor.setPosition (0, 0);
-		CColor color;
-		if (&inputAccessor == &outputAccessor)
-		{
-			do
-			{
-				inputAccessor.getColor (color);
-				processFunction (color, this);
-				outputAccessor.setColor (color);
-			}
-			while (++inputAccessor);
-		}
-		else
-		{
-			do
+		auto inputPbpa = inputAccessor.getPlatformBitmapPixelAccess ();
+		auto outputPbpa = outputAccessor.getPlatformBitmapPixelAccess ();
+		auto inputLayout = getChannelLayout (inputPbpa->getPixelFormat ());
+		auto outputLayout = getChannelLayout (outputPbpa->getPixelFormat ());
+		bool convert = inputPbpa->getPixelFormat () != outputPbpa->getPixelFormat ();
+		auto width = std::min (inputAccessor.getBitmapWidth (), outputAccessor.getBitmapWidth ());
+		auto height = std::min (inputAccessor.getBitmapHeight (), outputAccessor.getBitmapHeight ());
+		const auto& kernels = Kernels::getRowKernels ();
+		auto minTileRows = std::max (1, kMinTilePixels / static_cast<int32_t> (width));
+		forEachTile (static_cast<int32_t> (height), minTileRows, [&] (int32_t begin, int32_t end) {
+			for (auto y = static_cast<uint32_t> (begin); y < static_cast<uint32_t> (end); ++y)
 			{
-				inputAccessor.getColor (color);
-				processFunction (color, this);
-				outputAccessor.setColor (color);
-				++outputAccessor;
+				const uint8_t* src = inputPbpa->getAddress () + y * inputPbpa->getBytesPerRow ();
+				uint8_t* dst = outputPbpa->getAddress () + y * outputPbpa->getBytesPerRow ();
+				if (convert)
+				{
+					convertRow (src, inputLayout, dst, outputLayout, width);
+					src = dst;
+				}
+				processRow (kernels, reinterpret_cast<const uint32_t*> (src),
+							reinterpret_cast<uint32_t*> (dst), width, outputLayout);
 			}
-			while (++inputAccessor);
-		}
+		});
 	}
 
-	SimpleFilterProcessFunction processFunction;
+	/** process count pixels of a row, src and dst may be the same. Called concurrently for
+	 *	different rows. */
+	virtual void processRow (const Kernels::RowKernels& kernels, const uint32_t* src, uint32_t* dst,
+							 uint32_t count, Kernels::ChannelLayout layout) = 0;
 };
 
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-class SetColor : public SimpleFilter<SimpleFilterProcessFunction>
+class SetColor : public SimpleFilter
 {
 public:
 	static IFilter* CreateFunction (IdStringPtr _name)
@@ -916,18 +890,24 @@ public:
 
 private:
 	SetColor ()
-	: SimpleFilter<SimpleFilterProcessFunction> ("A Set Color Filter", processSetColor)
+	: SimpleFilter ("A Set Color Filter")
 	{
 		registerProperty (Property::kIgnoreAlphaColorValue, BitmapFilter::Property ((int32_t)1));
 		registerProperty (Property::kInputColor, BitmapFilter::Property (kWhiteCColor));
 	}
 
-	static void processSetColor (CColor& color, FilterBase* obj)
+	void processRow (const Kernels::RowKernels& kernels, const uint32_t* src, uint32_t* dst,
+					 uint32_t count, Kernels::ChannelLayout layout) override
 	{
-		SetColor* filter = static_cast<SetColor*> (obj);
-		if (filter->ignoreAlpha)
-			filter->inputColor.alpha = color.alpha;
-		color = filter->inputColor;
+		auto color = packColor (inputColor, layout);
+		uint32_t keepMask = 0;
+		if (ignoreAlpha)
+		{
+			CColor alphaMask (0, 0, 0, 255);
+			keepMask = packColor (alphaMask, layout);
+			color &= ~keepMask;
+		}
+		kernels.setColor (src, dst, count, color, keepMask);
 	}
 
 	bool ignoreAlpha;
@@ -942,14 +922,14 @@ private:
 			return false;
 		inputColor = inputColorProp.getColor ();
 		ignoreAlpha = ignoreAlphaProp.getInteger () > 0;
-		return SimpleFilter<SimpleFilterProcessFunction>::run (replace);
+		return SimpleFilter::run (replace);
 	}
 };
 
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-class Grayscale : public SimpleFilter<SimpleFilterProcessFunction>
+class Grayscale : public SimpleFilter
 {
 public:
 	static IFilter* CreateFunction (IdStringPtr name)
@@ -959,13 +939,14 @@ public:
 
 private:
 	Grayscale ()
-	: SimpleFilter<SimpleFilterProcessFunction> ("A Grayscale Filter", processGrayscale)
+	: SimpleFilter ("A Grayscale Filter")
 	{
 	}
 
-	static void processGrayscale (CColor& color, FilterBase* obj)
+	void processRow (const Kernels::RowKernels& kernels, const uint32_t* src, uint32_t* dst,
+					 uint32_t count, Kernels::ChannelLayout layout) override
 	{
-		color.red = color.green = color.blue = color.getLuma ();
+		kernels.grayscale (src, dst, count, layout);
 	}
 
 };
@@ -973,7 +954,7 @@ private:
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-class ReplaceColor : public SimpleFilter<SimpleFilterProcessFunction>
+class ReplaceColor : public SimpleFilter
 {
 public:
 	static IFilter* CreateFunction (IdStringPtr name)
@@ -983,17 +964,17 @@ public:
 
 private:
 	ReplaceColor ()
-	: SimpleFilter<SimpleFilterProcessFunction> ("A Replace Color Filter", processReplace)
+	: SimpleFilter ("A Replace Color Filter")
 	{
 		registerProperty (Property::kInputColor, BitmapFilter::Property (kWhiteCColor));
 		registerProperty (Property::kOutputColor, BitmapFilter::Property (kTransparentCColor));
 	}
 
-	static void processReplace (CColor& color, FilterBase* obj)
+	void processRow (const Kernels::RowKernels& kernels, const uint32_t* src, uint32_t* dst,
+					 uint32_t count, Kernels::ChannelLayout layout) override
 	{
-		ReplaceColor* filter = static_cast<ReplaceColor*> (obj);
-		if (color == filter->inputColor)
-			color = filter->outputColor;
+		kernels.replaceColor (src, dst, count, packColor (inputColor, layout),
+							  packColor (outputColor, layout));
 	}
 
 	CColor inputColor;
@@ -1008,7 +989,7 @@ private:
 			return false;
 		inputColor = inputColorProp.getColor ();
 		outputColor = outputColorProp.getColor ();
-		return SimpleFilter<SimpleFilterProcessFunction>::run (replace);
+		return SimpleFilter::run (replace);
 	}
 };
 
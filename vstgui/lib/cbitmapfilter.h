@@ -8,6 +8,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <functional>
 
 namespace VSTGUI {
 
@@ -200,6 +201,11 @@ namespace Standard {
 		static const IdStringPtr kIgnoreAlphaColorValue = "IgnoreAlphaColorValue";
 		/** [Property::kInteger] */
 		static const IdStringPtr kAlphaChannelOnly = "AlphaChannelOnly";
+		/** [Property::kInteger] maximum number of threads a filter uses, 0 uses all CPU cores.
+		 *	Defaults to 1, which processes the bitmap on the calling thread. Filters running on a
+		 *	worker thread always use one thread. Every filter derived from FilterBase supports
+		 *	this property. */
+		static const IdStringPtr kMaxThreads = "MaxThreads";
 	} // Property
 
 } // Standard
@@ -216,6 +222,13 @@ protected:
 	bool registerProperty (IdStringPtr name, const Property& defaultProperty);
 	CBitmap* getInputBitmap () const;
 
+	using TileFunction = std::function<void (int32_t begin, int32_t end)>;
+	/** splits [0, count) into tiles of at least minTileSize items and processes them on up to
+	 *	Standard::Property::kMaxThreads threads. Returns after all tiles are processed. */
+	void forEachTile (int32_t count, int32_t minTileSize, const TileFunction& proc) const;
+	/** the minimum number of pixels per tile */
+	static constexpr int32_t kMinTilePixels = 16384;
+
 	UTF8StringPtr getDescription () const override;
 	bool setProperty (IdStringPtr name, const Property& property) override;
 	bool setProperty (IdStringPtr name, Property&& property) override;
@@ -0,0 +1,789 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cbitmapfilterkernels.h"
+#include "cpufeatures.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if VSTGUI_CPU_X86
+#define VSTGUI_BITMAPFILTER_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#else
+#define VSTGUI_BITMAPFILTER_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VSTGUI_TARGET_SSE2 __attribute__ ((target ("sse2")))
+#define VSTGUI_TARGET_AVX2 __attribute__ ((target ("avx2")))
+#else
+#define VSTGUI_TARGET_SSE2
+#define VSTGUI_TARGET_AVX2
+#endif
+
+// the scalar and the vector kernels must round the same way, so multiplications and additions
+// must not be fused
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
+/// @cond ignore
+namespace VSTGUI {
+namespace BitmapFilter {
+namespace Kernels {
+namespace {
+
+//----------------------------------------------------------------------------------------------------
+inline uint32_t loadPixel (const uint8_t* ptr)
+{
+	uint32_t value;
+	std::memcpy (&value, ptr, sizeof (value));
+	return value;
+}
+
+//----------------------------------------------------------------------------------------------------
+inline int32_t clampIndex (int32_t index, int32_t maxIndex)
+{
+	return std::min (maxIndex, std::max (index, 0));
+}
+
+//----------------------------------------------------------------------------------------------------
+// scalar kernels, written so that compilers can auto vectorize them on other architectures
+//----------------------------------------------------------------------------------------------------
+void setColorScalar (const uint32_t* src, uint32_t* dst, uint32_t count, uint32_t color,
+					 uint32_t keepMask)
+{
+	for (auto i = 0u; i < count; ++i)
+		dst[i] = (src[i] & keepMask) | color;
+}
+
+//----------------------------------------------------------------------------------------------------
+void replaceColorScalar (const uint32_t* src, uint32_t* dst, uint32_t count, uint32_t from,
+						 uint32_t to)
+{
+	for (auto i = 0u; i < count; ++i)
+		dst[i] = src[i] == from ? to : src[i];
+}
+
+//----------------------------------------------------------------------------------------------------
+inline uint8_t luma (uint8_t red, uint8_t green, uint8_t blue)
+{
+	// same as CColor::getLuma
+	float r = static_cast<float> (red) * 0.3f;
+	float g = static_cast<float> (green) * 0.59f;
+	float b = static_cast<float> (blue) * 0.11f;
+	float sum = r + g;
+	sum = sum + b;
+	return static_cast<uint8_t> (sum);
+}
+
+//----------------------------------------------------------------------------------------------------
+void grayscaleScalar (const uint32_t* src, uint32_t* dst, uint32_t count, ChannelLayout layout)
+{
+	for (auto i = 0u; i < count; ++i)
+	{
+		uint8_t pixel[4];
+		std::memcpy (pixel, &src[i], sizeof (pixel));
+		auto value = luma (pixel[layout.red], pixel[layout.green], pixel[layout.blue]);
+		pixel[layout.red] = pixel[layout.green] = pixel[layout.blue] = value;
+		std::memcpy (&dst[i], pixel, sizeof (pixel));
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+void gatherScalar (const uint32_t* row, const int32_t* index, uint32_t* dst, uint32_t count)
+{
+	for (auto i = 0u; i < count; ++i)
+		dst[i] = row[index[i]];
+}
+
+//----------------------------------------------------------------------------------------------------
+void bilinearScalar (const uint32_t* row0, const uint32_t* row1, const int32_t* index,
+					 const int32_t* nextIndex, const float* xDiff, float yDiff, uint32_t* dst,
+					 uint32_t count)
+{
+	float yInv = 1.f - yDiff;
+	for (auto i = 0u; i < count; ++i)
+	{
+		uint8_t c0[4], c1[4], c2[4], c3[4], result[4];
+		std::memcpy (c0, &row0[index[i]], 4);
+		std::memcpy (c1, &row0[nextIndex[i]], 4);
+		std::memcpy (c2, &row1[index[i]], 4);
+		std::memcpy (c3, &row1[nextIndex[i]], 4);
+		float xd = xDiff[i];
+		float xInv = 1.f - xd;
+		for (auto k = 0; k < 4; ++k)
+		{
+			float t0 = static_cast<float> (c0[k]) * xInv;
+			t0 = t0 * yInv;
+			float t1 = static_cast<float> (c1[k]) * xd;
+			t1 = t1 * yInv;
+			float t2 = static_cast<float> (c2[k]) * yDiff;
+			t2 = t2 * xInv;
+			float t3 = static_cast<float> (c3[k]) * xd;
+			t3 = t3 * yDiff;
+			float sum = t0 + t1;
+			sum = sum + t2;
+			sum = sum + t3;
+			result[k] = static_cast<uint8_t> (sum);
+		}
+		std::memcpy (&dst[i], result, 4);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+void boxBlurRowsScalar (const uint8_t* src, const BoxBlurPlanes& p, int32_t begin, int32_t end)
+{
+	auto wm = p.width - 1;
+	auto radius = p.radius;
+	for (auto y = begin; y < end; ++y)
+	{
+		auto row = src + y * p.width * 4;
+		for (auto k = 0; k < 4; ++k)
+		{
+			if (!p.plane[k])
+				continue;
+			auto plane = p.plane[k] + y * p.width;
+			int32_t sum = 0;
+			for (auto i = -radius; i <= radius; ++i)
+				sum += row[clampIndex (i, wm) * 4 + k];
+			for (auto x = 0; x < p.width; ++x)
+			{
+				plane[x] = p.divTable[sum];
+				sum += row[std::min (x + radius + 1, wm) * 4 + k] -
+					   row[std::max (x - radius, 0) * 4 + k];
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+void boxBlurColumnRangeScalar (const BoxBlurPlanes& p, uint8_t* dst, int32_t rowBegin,
+							   int32_t rowEnd, int32_t columnBegin, int32_t columnEnd)
+{
+	auto hm = p.height - 1;
+	auto radius = p.radius;
+	std::vector<int32_t> sums (static_cast<size_t> (columnEnd - columnBegin));
+	for (auto k = 0; k < 4; ++k)
+	{
+		if (!p.plane[k])
+			continue;
+		auto plane = p.plane[k];
+		std::fill (sums.begin (), sums.end (), 0);
+		for (auto i = rowBegin - radius; i <= rowBegin + radius; ++i)
+		{
+			auto row = plane + clampIndex (i, hm) * p.width;
+			for (auto x = columnBegin; x < columnEnd; ++x)
+				sums[x - columnBegin] += row[x];
+		}
+		for (auto y = rowBegin; y < rowEnd; ++y)
+		{
+			auto out = dst + y * p.width * 4;
+			auto addRow = plane + std::min (y + radius + 1, hm) * p.width;
+			auto subRow = plane + std::max (y - radius, 0) * p.width;
+			for (auto x = columnBegin; x < columnEnd; ++x)
+			{
+				auto& sum = sums[x - columnBegin];
+				out[x * 4 + k] = p.divTable[sum];
+				sum += addRow[x] - subRow[x];
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+void boxBlurColumnsScalar (const BoxBlurPlanes& p, uint8_t* dst, int32_t begin, int32_t end)
+{
+	boxBlurColumnRangeScalar (p, dst, begin, end, 0, p.width);
+}
+
+//----------------------------------------------------------------------------------------------------
+const RowKernels scalarKernels = {
+	InstructionSet::Scalar, setColorScalar,		 replaceColorScalar,  grayscaleScalar,
+	gatherScalar,			bilinearScalar,		 boxBlurRowsScalar,	  boxBlurColumnsScalar,
+};
+
+#if VSTGUI_BITMAPFILTER_X86
+//----------------------------------------------------------------------------------------------------
+// SSE2 kernels
+//----------------------------------------------------------------------------------------------------
+/** the float math of the box blur division is exact as long as all values stay below 2^24 */
+constexpr int32_t kMaxVectorBoxBlurDivisor = (1 << 24) / 257;
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_SSE2 inline __m128i loadBytesSSE2 (const uint8_t* ptr)
+{
+	auto zero = _mm_setzero_si128 ();
+	auto value = _mm_cvtsi32_si128 (static_cast<int> (loadPixel (ptr)));
+	return _mm_unpacklo_epi16 (_mm_unpacklo_epi8 (value, zero), zero);
+}
+
+//----------------------------------------------------------------------------------------------------
+/** sum / divisor for sums in the range 0 to 255 * divisor */
+VSTGUI_TARGET_SSE2 inline __m128i divideSSE2 (__m128i sum, __m128 divisor, __m128 reciprocal)
+{
+	auto s = _mm_cvtepi32_ps (sum);
+	auto q = _mm_cvttps_epi32 (_mm_mul_ps (s, reciprocal));
+	auto t = _mm_mul_ps (_mm_cvtepi32_ps (q), divisor);
+	// the estimate is off by one at most
+	q = _mm_add_epi32 (q, _mm_castps_si128 (_mm_cmpgt_ps (t, s)));
+	q = _mm_sub_epi32 (q, _mm_castps_si128 (_mm_cmple_ps (_mm_add_ps (t, divisor), s)));
+	return q;
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_SSE2 void setColorSSE2 (const uint32_t* src, uint32_t* dst, uint32_t count,
+									  uint32_t color, uint32_t keepMask)
+{
+	auto colorV = _mm_set1_epi32 (static_cast<int> (color));
+	auto maskV = _mm_set1_epi32 (static_cast<int> (keepMask));
+	auto i = 0u;
+	for (; i + 4 <= count; i += 4)
+	{
+		auto value = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i));
+		value = _mm_or_si128 (_mm_and_si128 (value, maskV), colorV);
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst + i), value);
+	}
+	setColorScalar (src + i, dst + i, count - i, color, keepMask);
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_SSE2 void replaceColorSSE2 (const uint32_t* src, uint32_t* dst, uint32_t count,
+										  uint32_t from, uint32_t to)
+{
+	auto fromV = _mm_set1_epi32 (static_cast<int> (from));
+	auto toV = _mm_set1_epi32 (static_cast<int> (to));
+	auto i = 0u;
+	for (; i + 4 <= count; i += 4)
+	{
+		auto value = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i));
+		auto equal = _mm_cmpeq_epi32 (value, fromV);
+		value = _mm_or_si128 (_mm_and_si128 (equal, toV), _mm_andnot_si128 (equal, value));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst + i), value);
+	}
+	replaceColorScalar (src + i, dst + i, count - i, from, to);
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_SSE2 void grayscaleSSE2 (const uint32_t* src, uint32_t* dst, uint32_t count,
+									   ChannelLayout layout)
+{
+	auto byteMask = _mm_set1_epi32 (0xFF);
+	auto redShift = _mm_cvtsi32_si128 (static_cast<int> (layout.red * 8));
+	auto greenShift = _mm_cvtsi32_si128 (static_cast<int> (layout.green * 8));
+	auto blueShift = _mm_cvtsi32_si128 (static_cast<int> (layout.blue * 8));
+	auto keepMask = _mm_set1_epi32 (static_cast<int> (0xFFu << (layout.alpha * 8)));
+	auto redFactor = _mm_set1_ps (0.3f);
+	auto greenFactor = _mm_set1_ps (0.59f);
+	auto blueFactor = _mm_set1_ps (0.11f);
+	auto i = 0u;
+	for (; i + 4 <= count; i += 4)
+	{
+		auto value = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i));
+		auto r = _mm_cvtepi32_ps (_mm_and_si128 (_mm_srl_epi32 (value, redShift), byteMask));
+		auto g = _mm_cvtepi32_ps (_mm_and_si128 (_mm_srl_epi32 (value, greenShift), byteMask));
+		auto b = _mm_cvtepi32_ps (_mm_and_si128 (_mm_srl_epi32 (value, blueShift), byteMask));
+		auto sum = _mm_add_ps (_mm_mul_ps (r, redFactor), _mm_mul_ps (g, greenFactor));
+		sum = _mm_add_ps (sum, _mm_mul_ps (b, blueFactor));
+		auto l = _mm_cvttps_epi32 (sum);
+		auto result = _mm_and_si128 (value, keepMask);
+		result = _mm_or_si128 (result, _mm_sll_epi32 (l, redShift));
+		result = _mm_or_si128 (result, _mm_sll_epi32 (l, greenShift));
+		result = _mm_or_si128 (result, _mm_sll_epi32 (l, blueShift));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst + i), result);
+	}
+	grayscaleScalar (src + i, dst + i, count - i, layout);
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_SSE2 void bilinearSSE2 (const uint32_t* row0, const uint32_t* row1,
+									  const int32_t* index, const int32_t* nextIndex,
+									  const float* xDiff, float yDiff, uint32_t* dst,
+									  uint32_t count)
+{
+	auto yd = _mm_set1_ps (yDiff);
+	auto yInv = _mm_set1_ps (1.f - yDiff);
+	for (auto i = 0u; i < count; ++i)
+	{
+		auto c0 = _mm_cvtepi32_ps (
+			loadBytesSSE2 (reinterpret_cast<const uint8_t*> (row0 + index[i])));
+		auto c1 = _mm_cvtepi32_ps (
+			loadBytesSSE2 (reinterpret_cast<const uint8_t*> (row0 + nextIndex[i])));
+		auto c2 = _mm_cvtepi32_ps (
+			loadBytesSSE2 (reinterpret_cast<const uint8_t*> (row1 + index[i])));
+		auto c3 = _mm_cvtepi32_ps (
+			loadBytesSSE2 (reinterpret_cast<const uint8_t*> (row1 + nextIndex[i])));
+		auto xd = _mm_set1_ps (xDiff[i]);
+		auto xInv = _mm_set1_ps (1.f - xDiff[i]);
+		auto t0 = _mm_mul_ps (_mm_mul_ps (c0, xInv), yInv);
+		auto t1 = _mm_mul_ps (_mm_mul_ps (c1, xd), yInv);
+		auto t2 = _mm_mul_ps (_mm_mul_ps (c2, yd), xInv);
+		auto t3 = _mm_mul_ps (_mm_mul_ps (c3, xd), yd);
+		auto sum = _mm_add_ps (_mm_add_ps (_mm_add_ps (t0, t1), t2), t3);
+		auto result = _mm_cvttps_epi32 (sum);
+		result = _mm_packs_epi32 (result, result);
+		result = _mm_packus_epi16 (result, result);
+		dst[i] = static_cast<uint32_t> (_mm_cvtsi128_si32 (result));
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_SSE2 inline __m128i boxBlurWindowSSE2 (const int32_t* prefix, int32_t divisor,
+													 __m128 divisorV, __m128 reciprocal)
+{
+	auto high = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (prefix + divisor * 4));
+	auto low = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (prefix));
+	return divideSSE2 (_mm_sub_epi32 (high, low), divisorV, reciprocal);
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_SSE2 void boxBlurRowsSSE2 (const uint8_t* src, const BoxBlurPlanes& p,
+										 int32_t begin, int32_t end)
+{
+	auto divisor = p.radius * 2 + 1;
+	// the vector pass always blurs all channels, for single channels the scalar pass is faster
+	if (divisor > kMaxVectorBoxBlurDivisor || !p.plane[0] || !p.plane[1] || !p.plane[2] ||
+		!p.plane[3])
+	{
+		boxBlurRowsScalar (src, p, begin, end);
+		return;
+	}
+	auto divisorV = _mm_set1_ps (static_cast<float> (divisor));
+	auto reciprocal = _mm_set1_ps (1.f / static_cast<float> (divisor));
+	auto width = p.width;
+	auto radius = p.radius;
+	// prefix[e] is the sum of the first e pixels of the row extended by radius pixels on each
+	// side, so the sum of the window around x is prefix[x + divisor] - prefix[x]
+	std::vector<int32_t> prefixData (static_cast<size_t> (width + divisor + 1) * 4);
+	auto prefix = prefixData.data ();
+	for (auto y = begin; y < end; ++y)
+	{
+		auto row = src + y * width * 4;
+		auto acc = _mm_setzero_si128 ();
+		auto out = prefix;
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (out), acc);
+		auto first = loadBytesSSE2 (row);
+		for (auto e = 0; e < radius; ++e)
+		{
+			acc = _mm_add_epi32 (acc, first);
+			_mm_storeu_si128 (reinterpret_cast<__m128i*> (out += 4), acc);
+		}
+		for (auto x = 0; x < width; ++x)
+		{
+			acc = _mm_add_epi32 (acc, loadBytesSSE2 (row + x * 4));
+			_mm_storeu_si128 (reinterpret_cast<__m128i*> (out += 4), acc);
+		}
+		auto last = loadBytesSSE2 (row + (width - 1) * 4);
+		for (auto e = 0; e < radius; ++e)
+		{
+			acc = _mm_add_epi32 (acc, last);
+			_mm_storeu_si128 (reinterpret_cast<__m128i*> (out += 4), acc);
+		}
+
+		auto offset = y * width;
+		auto x = 0;
+		for (; x + 4 <= width; x += 4)
+		{
+			auto window = prefix + x * 4;
+			auto q0 = boxBlurWindowSSE2 (window, divisor, divisorV, reciprocal);
+			auto q1 = boxBlurWindowSSE2 (window + 4, divisor, divisorV, reciprocal);
+			auto q2 = boxBlurWindowSSE2 (window + 8, divisor, divisorV, reciprocal);
+			auto q3 = boxBlurWindowSSE2 (window + 12, divisor, divisorV, reciprocal);
+			auto q01 = _mm_packs_epi32 (q0, q1);
+			auto q23 = _mm_packs_epi32 (q2, q3);
+			// 4 interleaved pixels to 4 bytes per channel
+			auto v = _mm_packus_epi16 (q01, q23);
+			v = _mm_unpacklo_epi8 (v, _mm_srli_si128 (v, 8));
+			v = _mm_unpacklo_epi8 (v, _mm_srli_si128 (v, 8));
+			for (auto k = 0; k < 4; ++k)
+			{
+				auto value = _mm_cvtsi128_si32 (v);
+				std::memcpy (p.plane[k] + offset + x, &value, 4);
+				v = _mm_srli_si128 (v, 4);
+			}
+		}
+		for (; x < width; ++x)
+		{
+			auto q = boxBlurWindowSSE2 (prefix + x * 4, divisor, divisorV, reciprocal);
+			q = _mm_packus_epi16 (_mm_packs_epi32 (q, q), q);
+			auto value = static_cast<uint32_t> (_mm_cvtsi128_si32 (q));
+			for (auto k = 0; k < 4; ++k)
+				p.plane[k][offset + x] = static_cast<uint8_t> (value >> (k * 8));
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_SSE2 void boxBlurColumnsSSE2 (const BoxBlurPlanes& p, uint8_t* dst, int32_t begin,
+											int32_t end)
+{
+	auto divisor = p.radius * 2 + 1;
+	auto vectorEnd = (p.width / 4) * 4;
+	if (divisor > kMaxVectorBoxBlurDivisor || vectorEnd == 0)
+	{
+		boxBlurColumnsScalar (p, dst, begin, end);
+		return;
+	}
+	auto divisorV = _mm_set1_ps (static_cast<float> (divisor));
+	auto reciprocal = _mm_set1_ps (1.f / static_cast<float> (divisor));
+	auto hm = p.height - 1;
+	auto radius = p.radius;
+	auto numColumns = static_cast<size_t> (vectorEnd);
+	uint32_t keepMask = 0;
+	std::vector<int32_t> sums[4];
+	for (auto k = 0; k < 4; ++k)
+	{
+		if (!p.plane[k])
+		{
+			keepMask |= 0xFFu << (k * 8);
+			continue;
+		}
+		sums[k].assign (numColumns, 0);
+		for (auto i = begin - radius; i <= begin + radius; ++i)
+		{
+			auto row = p.plane[k] + clampIndex (i, hm) * p.width;
+			for (auto x = 0; x < vectorEnd; ++x)
+				sums[k][x] += row[x];
+		}
+	}
+	auto keepMaskV = _mm_set1_epi32 (static_cast<int> (keepMask));
+	for (auto y = begin; y < end; ++y)
+	{
+		auto out = dst + y * p.width * 4;
+		auto addOffset = std::min (y + radius + 1, hm) * p.width;
+		auto subOffset = std::max (y - radius, 0) * p.width;
+		for (auto x = 0; x < vectorEnd; x += 4)
+		{
+			auto result = _mm_setzero_si128 ();
+			for (auto k = 0; k < 4; ++k)
+			{
+				if (!p.plane[k])
+					continue;
+				auto sumPtr = reinterpret_cast<__m128i*> (sums[k].data () + x);
+				auto sum = _mm_loadu_si128 (sumPtr);
+				auto q = divideSSE2 (sum, divisorV, reciprocal);
+				result = _mm_or_si128 (result, _mm_sll_epi32 (q, _mm_cvtsi32_si128 (k * 8)));
+				sum = _mm_add_epi32 (sum, loadBytesSSE2 (p.plane[k] + addOffset + x));
+				sum = _mm_sub_epi32 (sum, loadBytesSSE2 (p.plane[k] + subOffset + x));
+				_mm_storeu_si128 (sumPtr, sum);
+			}
+			auto outPtr = reinterpret_cast<__m128i*> (out + x * 4);
+			if (keepMask)
+				result = _mm_or_si128 (result, _mm_and_si128 (_mm_loadu_si128 (outPtr), keepMaskV));
+			_mm_storeu_si128 (outPtr, result);
+		}
+	}
+	if (vectorEnd != p.width)
+		boxBlurColumnRangeScalar (p, dst, begin, end, vectorEnd, p.width);
+}
+
+//----------------------------------------------------------------------------------------------------
+const RowKernels sse2Kernels = {
+	InstructionSet::SSE2, setColorSSE2,	  replaceColorSSE2,	 grayscaleSSE2,
+	gatherScalar,		  bilinearSSE2,	  boxBlurRowsSSE2,	 boxBlurColumnsSSE2,
+};
+
+//----------------------------------------------------------------------------------------------------
+// AVX2 kernels
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_AVX2 void setColorAVX2 (const uint32_t* src, uint32_t* dst, uint32_t count,
+									  uint32_t color, uint32_t keepMask)
+{
+	auto colorV = _mm256_set1_epi32 (static_cast<int> (color));
+	auto maskV = _mm256_set1_epi32 (static_cast<int> (keepMask));
+	auto i = 0u;
+	for (; i + 8 <= count; i += 8)
+	{
+		auto value = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (src + i));
+		value = _mm256_or_si256 (_mm256_and_si256 (value, maskV), colorV);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (dst + i), value);
+	}
+	setColorScalar (src + i, dst + i, count - i, color, keepMask);
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_AVX2 void replaceColorAVX2 (const uint32_t* src, uint32_t* dst, uint32_t count,
+										  uint32_t from, uint32_t to)
+{
+	auto fromV = _mm256_set1_epi32 (static_cast<int> (from));
+	auto toV = _mm256_set1_epi32 (static_cast<int> (to));
+	auto i = 0u;
+	for (; i + 8 <= count; i += 8)
+	{
+		auto value = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (src + i));
+		auto equal = _mm256_cmpeq_epi32 (value, fromV);
+		value = _mm256_blendv_epi8 (value, toV, equal);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (dst + i), value);
+	}
+	replaceColorScalar (src + i, dst + i, count - i, from, to);
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_AVX2 void grayscaleAVX2 (const uint32_t* src, uint32_t* dst, uint32_t count,
+									   ChannelLayout layout)
+{
+	auto byteMask = _mm256_set1_epi32 (0xFF);
+	auto redShift = _mm_cvtsi32_si128 (static_cast<int> (layout.red * 8));
+	auto greenShift = _mm_cvtsi32_si128 (static_cast<int> (layout.green * 8));
+	auto blueShift = _mm_cvtsi32_si128 (static_cast<int> (layout.blue * 8));
+	auto keepMask = _mm256_set1_epi32 (static_cast<int> (0xFFu << (layout.alpha * 8)));
+	auto redFactor = _mm256_set1_ps (0.3f);
+	auto greenFactor = _mm256_set1_ps (0.59f);
+	auto blueFactor = _mm256_set1_ps (0.11f);
+	auto i = 0u;
+	for (; i + 8 <= count; i += 8)
+	{
+		auto value = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (src + i));
+		auto r =
+			_mm256_cvtepi32_ps (_mm256_and_si256 (_mm256_srl_epi32 (value, redShift), byteMask));
+		auto g =
+			_mm256_cvtepi32_ps (_mm256_and_si256 (_mm256_srl_epi32 (value, greenShift), byteMask));
+		auto b =
+			_mm256_cvtepi32_ps (_mm256_and_si256 (_mm256_srl_epi32 (value, blueShift), byteMask));
+		auto sum = _mm256_add_ps (_mm256_mul_ps (r, redFactor), _mm256_mul_ps (g, greenFactor));
+		sum = _mm256_add_ps (sum, _mm256_mul_ps (b, blueFactor));
+		auto l = _mm256_cvttps_epi32 (sum);
+		auto result = _mm256_and_si256 (value, keepMask);
+		result = _mm256_or_si256 (result, _mm256_sll_epi32 (l, redShift));
+		result = _mm256_or_si256 (result, _mm256_sll_epi32 (l, greenShift));
+		result = _mm256_or_si256 (result, _mm256_sll_epi32 (l, blueShift));
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (dst + i), result);
+	}
+	grayscaleSSE2 (src + i, dst + i, count - i, layout);
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_AVX2 void gatherAVX2 (const uint32_t* row, const int32_t* index, uint32_t* dst,
+									uint32_t count)
+{
+	auto base = reinterpret_cast<const int*> (row);
+	auto i = 0u;
+	for (; i + 8 <= count; i += 8)
+	{
+		auto indexV = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (index + i));
+		auto value = _mm256_i32gather_epi32 (base, indexV, 4);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (dst + i), value);
+	}
+	gatherScalar (row, index + i, dst + i, count - i);
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_AVX2 inline __m256i loadBytesAVX2 (const uint8_t* ptr)
+{
+	return _mm256_cvtepu8_epi32 (_mm_loadl_epi64 (reinterpret_cast<const __m128i*> (ptr)));
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_AVX2 inline __m256i divideAVX2 (__m256i sum, __m256 divisor, __m256 reciprocal)
+{
+	auto s = _mm256_cvtepi32_ps (sum);
+	auto q = _mm256_cvttps_epi32 (_mm256_mul_ps (s, reciprocal));
+	auto t = _mm256_mul_ps (_mm256_cvtepi32_ps (q), divisor);
+	// the estimate is off by one at most
+	q = _mm256_add_epi32 (q, _mm256_castps_si256 (_mm256_cmp_ps (t, s, _CMP_GT_OQ)));
+	q = _mm256_sub_epi32 (
+		q, _mm256_castps_si256 (_mm256_cmp_ps (_mm256_add_ps (t, divisor), s, _CMP_LE_OQ)));
+	return q;
+}
+
+//----------------------------------------------------------------------------------------------------
+VSTGUI_TARGET_AVX2 void boxBlurColumnsAVX2 (const BoxBlurPlanes& p, uint8_t* dst, int32_t begin,
+											int32_t end)
+{
+	auto divisor = p.radius * 2 + 1;
+	auto vectorEnd = (p.width / 8) * 8;
+	if (divisor > kMaxVectorBoxBlurDivisor || vectorEnd == 0)
+	{
+		boxBlurColumnsSSE2 (p, dst, begin, end);
+		return;
+	}
+	auto divisorV = _mm256_set1_ps (static_cast<float> (divisor));
+	auto reciprocal = _mm256_set1_ps (1.f / static_cast<float> (divisor));
+	auto hm = p.height - 1;
+	auto radius = p.radius;
+	auto numColumns = static_cast<size_t> (vectorEnd);
+	uint32_t keepMask = 0;
+	std::vector<int32_t> sums[4];
+	for (auto k = 0; k < 4; ++k)
+	{
+		if (!p.plane[k])
+		{
+			keepMask |= 0xFFu << (k * 8);
+			continue;
+		}
+		sums[k].assign (numColumns, 0);
+		for (auto i = begin - radius; i <= begin + radius; ++i)
+		{
+			auto row = p.plane[k] + clampIndex (i, hm) * p.width;
+			for (auto x = 0; x < vectorEnd; ++x)
+				sums[k][x] += row[x];
+		}
+	}
+	auto keepMaskV = _mm256_set1_epi32 (static_cast<int> (keepMask));
+	for (auto y = begin; y < end; ++y)
+	{
+		auto out = dst + y * p.width * 4;
+		auto addOffset = std::min (y + radius + 1, hm) * p.width;
+		auto subOffset = std::max (y - radius, 0) * p.width;
+		for (auto x = 0; x < vectorEnd; x += 8)
+		{
+			auto result = _mm256_setzero_si256 ();
+			for (auto k = 0; k < 4; ++k)
+			{
+				if (!p.plane[k])
+					continue;
+				auto sumPtr = reinterpret_cast<__m256i*> (sums[k].data () + x);
+				auto sum = _mm256_loadu_si256 (sumPtr);
+				auto q = divideAVX2 (sum, divisorV, reciprocal);
+				result =
+					_mm256_or_si256 (result, _mm256_sll_epi32 (q, _mm_cvtsi32_si128 (k * 8)));
+				sum = _mm256_add_epi32 (sum, loadBytesAVX2 (p.plane[k] + addOffset + x));
+				sum = _mm256_sub_epi32 (sum, loadBytesAVX2 (p.plane[k] + subOffset + x));
+				_mm256_storeu_si256 (sumPtr, sum);
+			}
+			auto outPtr = reinterpret_cast<__m256i*> (out + x * 4);
+			if (keepMask)
+				result = _mm256_or_si256 (
+					result, _mm256_and_si256 (_mm256_loadu_si256 (outPtr), keepMaskV));
+			_mm256_storeu_si256 (outPtr, result);
+		}
+	}
+	if (vectorEnd != p.width)
+		boxBlurColumnRangeScalar (p, dst, begin, end, vectorEnd, p.width);
+}
+
+//----------------------------------------------------------------------------------------------------
+const RowKernels avx2Kernels = {
+	InstructionSet::AVX2, setColorAVX2,	  replaceColorAVX2,	 grayscaleAVX2,
+	gatherAVX2,			  bilinearSSE2,	  boxBlurRowsSSE2,	 boxBlurColumnsAVX2,
+};
+
+#endif // VSTGUI_BITMAPFILTER_X86
+
+//----------------------------------------------------------------------------------------------------
+} // anonymous
+
+//----------------------------------------------------------------------------------------------------
+const RowKernels* getRowKernels (InstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+		case InstructionSet::Scalar:
+			return &scalarKernels;
+#if VSTGUI_BITMAPFILTER_X86
+		case InstructionSet::SSE2:
+			return CPUFeatures::isSupported (CPUFeatures::Feature::SSE2) ? &sse2Kernels : nullptr;
+		case InstructionSet::AVX2:
+			return CPUFeatures::isSupported (CPUFeatures::Feature::AVX2) ? &avx2Kernels : nullptr;
+#else
+		case InstructionSet::SSE2:
+		case InstructionSet::AVX2:
+			break;
+#endif
+	}
+	return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+const RowKernels& getRowKernels ()
+{
+	static const RowKernels& kernels = [] () -> const RowKernels& {
+		for (auto instructionSet : {InstructionSet::AVX2, InstructionSet::SSE2})
+		{
+			if (auto result = getRowKernels (instructionSet))
+				return *result;
+		}
+		return scalarKernels;
+	}();
+	return kernels;
+}
+
+//----------------------------------------------------------------------------------------------------
+static thread_local bool gIsWorkerThread = false;
+
+//----------------------------------------------------------------------------------------------------
+WorkerThreadScope::WorkerThreadScope ()
+: wasWorkerThread (gIsWorkerThread)
+{
+	gIsWorkerThread = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+WorkerThreadScope::~WorkerThreadScope () noexcept
+{
+	gIsWorkerThread = wasWorkerThread;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool WorkerThreadScope::isWorkerThread ()
+{
+	return gIsWorkerThread;
+}
+
+//----------------------------------------------------------------------------------------------------
+void runTiled (int32_t count, int32_t minTileSize, uint32_t maxThreads, const TileFunction& proc)
+{
+	if (count <= 0)
+		return;
+	if (WorkerThreadScope::isWorkerThread ())
+		maxThreads = 1;
+	else if (maxThreads == 0)
+		maxThreads = std::max (1u, std::thread::hardware_concurrency ());
+	auto maxTiles = std::max (1, count / std::max (1, minTileSize));
+	auto numThreads = std::min (maxThreads, static_cast<uint32_t> (maxTiles));
+	if (numThreads <= 1)
+	{
+		proc (0, count);
+		return;
+	}
+	// more tiles than threads, so that a thread which is descheduled does not delay the others
+	auto numTiles = std::min (maxTiles, static_cast<int32_t> (numThreads * 4));
+	std::atomic<int32_t> nextTile {0};
+	auto work = [&] () {
+		WorkerThreadScope workerThreadScope;
+		int32_t tile;
+		while ((tile = nextTile++) < numTiles)
+		{
+			auto begin = static_cast<int32_t> (static_cast<int64_t> (count) * tile / numTiles);
+			auto end = static_cast<int32_t> (static_cast<int64_t> (count) * (tile + 1) / numTiles);
+			proc (begin, end);
+		}
+	};
+	std::vector<std::thread> workers;
+	workers.reserve (numThreads - 1);
+	for (auto i = 1u; i < numThreads; ++i)
+	{
+		try
+		{
+			workers.emplace_back (work);
+		}
+		catch (const std::system_error&)
+		{
+			// the remaining tiles are processed by the threads already running
+			break;
+		}
+	}
+	work ();
+	for (auto& worker : workers)
+		worker.join ();
+}
+
+} // Kernels
+} // BitmapFilter
+} // VSTGUI
+/// @endcond
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#endif
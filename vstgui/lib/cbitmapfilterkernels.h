@@ -0,0 +1,119 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstguifwd.h"
+#include <functional>
+
+/// @cond ignore
+namespace VSTGUI {
+namespace BitmapFilter {
+namespace Kernels {
+
+//----------------------------------------------------------------------------------------------------
+enum class InstructionSet
+{
+	Scalar,
+	SSE2,
+	AVX2
+};
+
+//----------------------------------------------------------------------------------------------------
+/** byte positions of the color channels inside a 32 bit pixel */
+struct ChannelLayout
+{
+	uint32_t red;
+	uint32_t green;
+	uint32_t blue;
+	uint32_t alpha;
+};
+
+//----------------------------------------------------------------------------------------------------
+/** the intermediate planes of the separable box blur */
+struct BoxBlurPlanes
+{
+	/** one plane per byte position of the pixel, nullptr for channels which are not blurred */
+	uint8_t* plane[4];
+	/** pixels per row of the interleaved bitmap and of the planes */
+	int32_t width;
+	int32_t height;
+	int32_t radius;
+	/** i / (radius * 2 + 1) for i < 256 * (radius * 2 + 1) */
+	const uint8_t* divTable;
+};
+
+//----------------------------------------------------------------------------------------------------
+/** The row kernels of the standard filters
+ *
+ *	All kernels of one instruction set produce byte identical results to the scalar kernels.
+ *	Source and destination may be the same memory.
+ */
+struct RowKernels
+{
+	InstructionSet instructionSet;
+
+	/** dst = (src & keepMask) | color */
+	void (*setColor) (const uint32_t* src, uint32_t* dst, uint32_t count, uint32_t color,
+					  uint32_t keepMask);
+	/** dst = src == from ? to : src */
+	void (*replaceColor) (const uint32_t* src, uint32_t* dst, uint32_t count, uint32_t from,
+						  uint32_t to);
+	/** sets red, green and blue to the luma of the pixel (see CColor::getLuma) */
+	void (*grayscale) (const uint32_t* src, uint32_t* dst, uint32_t count, ChannelLayout layout);
+	/** dst[i] = row[index[i]] */
+	void (*gather) (const uint32_t* row, const int32_t* index, uint32_t* dst, uint32_t count);
+	/** bilinear interpolation of the pixels index[i] and nextIndex[i] of row0 and row1 */
+	void (*bilinear) (const uint32_t* row0, const uint32_t* row1, const int32_t* index,
+					  const int32_t* nextIndex, const float* xDiff, float yDiff, uint32_t* dst,
+					  uint32_t count);
+	/** horizontal box blur pass of the rows [begin, end) from the pixels into the planes */
+	void (*boxBlurRows) (const uint8_t* src, const BoxBlurPlanes& planes, int32_t begin,
+						 int32_t end);
+	/** vertical box blur pass of the rows [begin, end) from the planes into the pixels, the
+	 *	planes must be complete up to radius rows above and below the range */
+	void (*boxBlurColumns) (const BoxBlurPlanes& planes, uint8_t* dst, int32_t begin,
+							int32_t end);
+};
+
+//----------------------------------------------------------------------------------------------------
+/** the kernels of the best instruction set the CPU supports */
+const RowKernels& getRowKernels ();
+/** the kernels of an instruction set or nullptr if the CPU or the compiler does not support it */
+const RowKernels* getRowKernels (InstructionSet instructionSet);
+
+//----------------------------------------------------------------------------------------------------
+using TileFunction = std::function<void (int32_t begin, int32_t end)>;
+
+/** Splits [0, count) into tiles of at least minTileSize items and calls proc for each tile
+ *
+ *	The tiles are processed by the calling thread and up to maxThreads - 1 worker threads which
+ *	are joined before the function returns. A maxThreads of zero uses one thread per CPU core.
+ *	If the calling thread is a worker thread (see WorkerThreadScope) all tiles are processed by
+ *	the calling thread. proc must only write to data owned by its tile.
+ */
+void runTiled (int32_t count, int32_t minTileSize, uint32_t maxThreads, const TileFunction& proc);
+
+//----------------------------------------------------------------------------------------------------
+/** marks the calling thread as a worker thread while the object exists, so that filters running
+ *	on threads which already share the CPU cores do not start threads of their own */
+class WorkerThreadScope
+{
+public:
+	WorkerThreadScope ();
+	~WorkerThreadScope () noexcept;
+
+	WorkerThreadScope (const WorkerThreadScope&) = delete;
+	WorkerThreadScope& operator= (const WorkerThreadScope&) = delete;
+
+	static bool isWorkerThread ();
+
+private:
+	bool wasWorkerThread;
+};
+
+} // Kernels
+} // BitmapFilter
+} // VSTGUI
+/// @endcond
@@ -43,12 +43,21 @@ public:
 
 	bool getCell (const CPoint& where, CDataBrowser::Cell& cell);
 
+	void updateRowOffsets ();
+	CCoord getAllRowsHeight () const;
+
 	bool drawFocusOnTop () override;
 	bool getFocusPath (CGraphicsPath& outPath) override;
 protected:
+	CCoord getRowLineWidth () const;
+	void getRowPosition (int32_t row, CCoord& top, CCoord& height) const;
+	int32_t getRowAt (CCoord y) const;
 
 	IDataBrowserDelegate* db;
 	CDataBrowser* browser;
+	// the top of every row relative to the view followed by the height of all rows, only used if
+	// the delegate has variable row heights
+	std::vector<CCoord> rowOffsets;
 };
 
 //-----------------------------------------------------------------------------------------------
@@ -236,11 +245,9 @@ void CDataBrowser::recalculateLayout (bool rememberSelection)
 	db->dbGetLineWidthAndColor (lineWidth, lineColor, this);
 	CCoord rowHeight = db->dbGetRowHeight (this);
 	CCoord headerHeight = db->dbGetHeaderHeight (this);
-	int32_t numRows = db->dbGetNumRows (this);
 	int32_t numColumns = db->dbGetNumColumns (this);
-	CCoord allRowsHeight = rowHeight * numRows;
-	if (style & kDrawRowLines)
-		allRowsHeight += numRows * lineWidth;
+	dbView->updateRowOffsets ();
+	CCoord allRowsHeight = dbView->getAllRowsHeight ();
 	CCoord allColumnsWidth = 0;
 	for (int32_t i = 0; i < numColumns; i++)
 		allColumnsWidth += db->dbGetCurrentColumnWidth (i, this);
@@ -378,10 +385,9 @@ void CDataBrowser::setSelectedRow (int32_t index, bool makeVisible)
 		index = numRows-1;
 
 	bool hasChanged = true;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), index);
-	if (alreadySelected != selection.end ())
+	if (isRowSelected (index))
 	{
-		selection.erase (alreadySelected);
+		selection.erase (std::find (selection.begin (), selection.end (), index));
 		hasChanged = !selection.empty ();
 	}
 	else
@@ -392,10 +398,12 @@ void CDataBrowser::setSelectedRow (int32_t index, bool makeVisible)
 	for (auto row : selection)
 	{
 		dbView->invalidateRow (row);
+		setRowSelected (row, false);
 	}
 	selection.clear ();
 	
 	selection.emplace_back (index);
+	setRowSelected (index, true);
 	if (hasChanged)
 		db->dbSelectionChanged (this);
 	
@@ -411,17 +419,40 @@ int32_t CDataBrowser::getSelectedRow () const
 	return kNoSelection;
 }
 
+//-----------------------------------------------------------------------------------------------
+bool CDataBrowser::isRowSelected (int32_t row) const
+{
+	if (row < 0 || static_cast<size_t> (row) >= selectedRows.size ())
+		return false;
+	return selectedRows[static_cast<size_t> (row)];
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::setRowSelected (int32_t row, bool state)
+{
+	if (row < 0)
+		return;
+	auto index = static_cast<size_t> (row);
+	if (index >= selectedRows.size ())
+	{
+		if (!state)
+			return;
+		selectedRows.resize (index + 1, false);
+	}
+	selectedRows[index] = state;
+}
+
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::selectRow (int32_t row)
 {
 	if (row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected == selection.end ())
+	if (!isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
 			selection.emplace_back (row);
+			setRowSelected (row, true);
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -437,12 +468,12 @@ void CDataBrowser::unselectRow (int32_t row)
 {
 	if (row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected != selection.end ())
+	if (isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
-			selection.erase (alreadySelected);
+			selection.erase (std::find (selection.begin (), selection.end (), row));
+			setRowSelected (row, false);
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -461,12 +492,21 @@ void CDataBrowser::unselectAll ()
 		for (auto row : selection)
 		{
 			dbView->invalidateRow (row);
+			setRowSelected (row, false);
 		}
 		selection.clear ();
 		db->dbSelectionChanged (this);
 	}
 }
 
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::selectionModified ()
+{
+	selectedRows.clear ();
+	for (auto row : selection)
+		setRowSelected (row, true);
+}
+
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::validateSelection ()
 {
@@ -476,6 +516,7 @@ void CDataBrowser::validateSelection ()
 	{
 		if (*it >= numRows)
 		{
+			setRowSelected (*it, false);
 			it = selection.erase (it);
 			selectionChanged = true;
 		}
@@ -501,10 +542,8 @@ CRect CDataBrowser::getCellBounds (const Cell& cell)
 		CColor lineColor;
 		db->dbGetLineWidthAndColor (lineWidth, lineColor, this);
 	}
-	CCoord rowHeight = db->dbGetRowHeight (this);
-	if (style & kDrawRowLines)
-		rowHeight += lineWidth;
-	CRect result (0, rowHeight * cell.row, 0, rowHeight * (cell.row+1));
+	CRect rowBounds = dbView->getRowBounds (cell.row);
+	CRect result (0, rowBounds.top, 0, rowBounds.bottom);
 	for (int32_t i = 0; i <= cell.column; i++)
 	{
 		CCoord colWidth = db->dbGetCurrentColumnWidth (i, this);
@@ -516,8 +555,7 @@ CRect CDataBrowser::getCellBounds (const Cell& cell)
 		}
 		result.setWidth (colWidth);
 	}
-	CRect viewSize = dbView->getViewSize ();
-	result.offset (viewSize.left, viewSize.top);
+	result.offset (dbView->getViewSize ().left, 0);
 	return result;
 }
 
@@ -741,22 +779,93 @@ CDataBrowserView::CDataBrowserView (const CRect& size, IDataBrowserDelegate* db,
 }
 
 //-----------------------------------------------------------------------------------------------
-CRect CDataBrowserView::getRowBounds (int32_t row)
+CCoord CDataBrowserView::getRowLineWidth () const
 {
 	CCoord lineWidth = 0;
-	if (browser->getStyle () & CDataBrowser::kDrawRowLines || browser->getStyle () & CDataBrowser::kDrawColumnLines)
+	if (browser->getStyle () & CDataBrowser::kDrawRowLines)
 	{
 		CColor lineColor;
 		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
 	}
-	CCoord rowHeight = db->dbGetRowHeight (browser);
+	return lineWidth;
+}
 
-	CRect where (getViewSize ());
-	where.originize ();
-	if (browser->getStyle () & CDataBrowser::kDrawRowLines)
-		rowHeight+=lineWidth;
+//-----------------------------------------------------------------------------------------------
+void CDataBrowserView::updateRowOffsets ()
+{
+	rowOffsets.clear ();
+	if (!db->dbHasVariableRowHeight (browser))
+		return;
+	int32_t numRows = db->dbGetNumRows (browser);
+	CCoord lineWidth = getRowLineWidth ();
+	rowOffsets.reserve (static_cast<size_t> (std::max (numRows, 0)) + 1);
+	CCoord top = 0;
+	for (int32_t row = 0; row < numRows; row++)
+	{
+		rowOffsets.emplace_back (top);
+		top += db->dbGetVariableRowHeight (row, browser) + lineWidth;
+	}
+	rowOffsets.emplace_back (top);
+}
+
+//-----------------------------------------------------------------------------------------------
+CCoord CDataBrowserView::getAllRowsHeight () const
+{
+	if (!rowOffsets.empty ())
+		return rowOffsets.back ();
+	return (db->dbGetRowHeight (browser) + getRowLineWidth ()) * db->dbGetNumRows (browser);
+}
+
+//-----------------------------------------------------------------------------------------------
+/**
+ * @param row row
+ * @param top top of row relative to the view
+ * @param height height of row including the row line
+ */
+void CDataBrowserView::getRowPosition (int32_t row, CCoord& top, CCoord& height) const
+{
+	if (rowOffsets.empty ())
+	{
+		height = db->dbGetRowHeight (browser) + getRowLineWidth ();
+		top = height * row;
+	}
+	else if (row >= 0 && static_cast<size_t> (row) + 1 < rowOffsets.size ())
+	{
+		top = rowOffsets[static_cast<size_t> (row)];
+		height = rowOffsets[static_cast<size_t> (row) + 1] - top;
+	}
+	else
+	{
+		top = row < 0 ? 0. : rowOffsets.back ();
+		height = 0.;
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+/**
+ * @param y vertical position relative to the view
+ * @return row at y, may be out of the range of rows
+ */
+int32_t CDataBrowserView::getRowAt (CCoord y) const
+{
+	if (rowOffsets.empty ())
+	{
+		CCoord rowHeight = db->dbGetRowHeight (browser) + getRowLineWidth ();
+		if (rowHeight <= 0.)
+			return 0;
+		return static_cast<int32_t> (y / rowHeight);
+	}
+	auto it = std::upper_bound (rowOffsets.begin (), rowOffsets.end (), y);
+	return static_cast<int32_t> (it - rowOffsets.begin ()) - 1;
+}
 
-	CRect r (getViewSize ().left, getViewSize ().top + rowHeight * row, getViewSize ().right, getViewSize ().top + rowHeight * (row+1));
+//-----------------------------------------------------------------------------------------------
+CRect CDataBrowserView::getRowBounds (int32_t row)
+{
+	CCoord top;
+	CCoord height;
+	getRowPosition (row, top, height);
+	CRect r (getViewSize ().left, getViewSize ().top + top, getViewSize ().right, getViewSize ().top + top + height);
 	return r;
 }
 
@@ -787,25 +896,27 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
 	}
 
-	CCoord rowHeight = db->dbGetRowHeight (browser);
-	if (drawRowLines)
-		rowHeight += lineWidth;
 	int32_t numRows = db->dbGetNumRows (browser);
 	int32_t numColumns = db->dbGetNumColumns (browser);
 
-	const CDataBrowser::Selection& selection = browser->getSelection ();
-
 	CDrawContext::LineList lines;
 
-	CRect r (getViewSize ());
-	r.setHeight (rowHeight - lineWidth);
-	for (int32_t row = 0; row < numRows; row++)
+	// only the rows intersecting the update rect are visited
+	int32_t firstRow = std::max<int32_t> (getRowAt (updateRect.top - getViewSize ().top), 0);
+	int32_t lastRow = std::min<int32_t> (getRowAt (updateRect.bottom - getViewSize ().top), numRows - 1);
+	for (int32_t row = firstRow; row <= lastRow; row++)
 	{
+		CCoord rowTop;
+		CCoord rowHeight;
+		getRowPosition (row, rowTop, rowHeight);
+		CRect r (getViewSize ());
+		r.top += rowTop;
+		r.setHeight (rowHeight - lineWidth);
 		CRect testRect (r);
 		testRect.bound (updateRect);
 		if (testRect.isEmpty () == false)
 		{
-			bool isSelected = std::find (selection.begin (), selection.end (), row) != selection.end ();
+			bool isSelected = browser->isRowSelected (row);
 			for (int32_t col = 0; col < numColumns; col++)
 			{
 				CCoord columnWidth = db->dbGetCurrentColumnWidth (col, browser);
@@ -829,7 +940,6 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 		r.setWidth (getWidth ());
 		if (drawRowLines)
 			lines.emplace_back (r.getBottomLeft (), r.getBottomRight ());
-		r.offset (0, rowHeight);
 	}
 	if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
 	{
@@ -873,12 +983,9 @@ bool CDataBrowserView::getCell (const CPoint& where, CDataBrowser::Cell& cell)
 		CColor lineColor;
 		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
 	}
-	CCoord rowHeight = db->dbGetRowHeight (browser);
 	int32_t numColumns = db->dbGetNumColumns (browser);
 
-	if (browser->getStyle () & CDataBrowser::kDrawRowLines)
-		rowHeight += lineWidth;
-	int32_t rowNum = (int32_t)(_where.y / rowHeight);
+	int32_t rowNum = getRowAt (_where.y);
 	int32_t colNum = 0;
 	CCoord cw = 0;
 	for (int32_t i = 0; i < numColumns; i++)
@@ -886,7 +993,7 @@ bool CDataBrowserView::getCell (const CPoint& where, CDataBrowser::Cell& cell)
 		cw += db->dbGetCurrentColumnWidth (i, browser);
 		if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
 			cw += lineWidth;
-		if (_where.x < cw && rowNum < db->dbGetNumRows (browser) && colNum < db->dbGetNumColumns (browser))
+		if (_where.x < cw && rowNum >= 0 && rowNum < db->dbGetNumRows (browser) && colNum < db->dbGetNumColumns (browser))
 		{
 			colNum = i;
 			cell.row = rowNum;
@@ -905,7 +1012,7 @@ CMouseEventResult CDataBrowserView::onMouseDown (CPoint &where, const CButtonSta
 	if (getCell (where, cell))
 	{
 		const CDataBrowser::Selection& selection = browser->getSelection ();
-		bool alreadySelected = std::find (selection.begin (), selection.end (), cell.row) != selection.end ();
+		bool alreadySelected = browser->isRowSelected (cell.row);
 		if (browser->getStyle () & CDataBrowser::kMultiSelectionStyle)
 		{
 			if (buttons.getModifierState () == kControl)
@@ -87,6 +87,8 @@ public:
 
 	/** get all selected rows */
 	const Selection& getSelection () const { return selection; }
+	/** returns true if row is selected */
+	bool isRowSelected (int32_t row) const;
 	/** add row to selection */
 	virtual void selectRow (int32_t row);
 	/** remove row from selection */
@@ -117,12 +119,21 @@ protected:
 
 	void recalculateSubViews () override;
 	void validateSelection ();
+	/** rebuild the per row selection state, subclasses which change selection directly instead
+	 *	of via selectRow (), unselectRow (), unselectAll () or setSelectedRow () must call it */
+	void selectionModified ();
 
 	IDataBrowserDelegate* db;
 	CDataBrowserView* dbView;
 	CDataBrowserHeader* dbHeader;
 	CViewContainer* dbHeaderContainer;
 	Selection selection;
+
+private:
+	void setRowSelected (int32_t row, bool state);
+
+	/** selection state per row for constant time lookups, rows past the end are not selected */
+	std::vector<bool> selectedRows;
 };
 
 //-----------------------------------------------------------------------------
@@ -7,10 +7,73 @@
 #include "cstring.h"
 #include "cdrawcontext.h"
 #include "platform/iplatformfont.h"
+#include <array>
+#include <iterator>
+#include <vector>
 
 namespace VSTGUI {
 
 namespace CDrawMethods {
+namespace {
+
+//------------------------------------------------------------------------
+bool createTruncatedTextFromCharAdvances (UTF8String& result, TextTruncateMode mode,
+                                          const UTF8String& text, const IFontPainter* painter,
+                                          CCoord width, CCoord maxWidth, uint32_t flags)
+{
+	auto extension = dynamic_cast<const IFontPainterCharAdvancesExtension*> (painter);
+	if (!extension)
+		return false;
+	auto left = text.begin ();
+	auto right = text.end ();
+	auto numChars = static_cast<size_t> (std::distance (left, right));
+	// the advances of label sized strings are kept on the stack
+	std::array<CCoord, 256> stackAdvances;
+	std::vector<CCoord> heapAdvances;
+	auto advances = stackAdvances.data ();
+	if (numChars > stackAdvances.size ())
+	{
+		heapAdvances.resize (numChars);
+		advances = heapAdvances.data ();
+	}
+	if (!extension->getCharAdvances (text.getPlatformString (), advances, numChars))
+		return false;
+
+	UTF8String placeholder ("..");
+	auto placeholderWidth =
+	    painter->getStringWidth (nullptr, placeholder.getPlatformString (), true);
+	size_t leftIndex = 0;
+	size_t rightIndex = numChars;
+	bool first = true;
+	while (width > maxWidth && left != right)
+	{
+		if (first)
+		{
+			width += placeholderWidth;
+			first = false;
+		}
+		if (mode == kTextTruncateHead)
+		{
+			++left;
+			width -= advances[leftIndex++];
+		}
+		else if (mode == kTextTruncateTail)
+		{
+			--right;
+			width -= advances[--rightIndex];
+		}
+	}
+	if (left == right && flags & kReturnEmptyIfTruncationIsPlaceholderOnly)
+		result = "";
+	else if (mode == kTextTruncateHead)
+		result = placeholder.getString () + std::string (left.base (), right.base ());
+	else
+		result = std::string (left.base (), right.base ()) + placeholder.getString ();
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
 
 //------------------------------------------------------------------------
 UTF8String createTruncatedText (TextTruncateMode mode, const UTF8String& text, CFontRef font,
@@ -25,6 +88,11 @@ UTF8String createTruncatedText (TextTruncateMode mode, const UTF8String& text, C
 	width += textInset.x * 2;
 	if (width > maxWidth)
 	{
+		UTF8String fastResult;
+		if (createTruncatedTextFromCharAdvances (fastResult, mode, text, painter, width, maxWidth,
+		                                         flags))
+			return fastResult;
+
 		std::string truncatedText;
 		UTF8String result;
 		auto left = text.begin ();
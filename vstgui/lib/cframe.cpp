@@ -3,14 +3,18 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "cframe.h"
+#include "cinvalidrectlist.h"
 #include "coffscreencontext.h"
+#include "crowcolumnview.h"
 #include "ctooltipsupport.h"
+#include "cvstguitimer.h"
 #include "itouchevent.h"
 #include "iscalefactorchangedlistener.h"
 #include "idatapackage.h"
 #include "animation/animator.h"
 #include "controls/ctextedit.h"
 #include "platform/iplatformframe.h"
+#include <algorithm>
 #include <cassert>
 #include <vector>
 #include <queue>
@@ -33,10 +37,8 @@ struct CFrame::CollectInvalidRects
 	void flush ();
 
 private:
-	using InvalidRects = std::vector<CRect>;
-
 	SharedPointer<CFrame> frame;
-	InvalidRects invalidRects;
+	CInvalidRectList invalidRects;
 	uint32_t lastTicks;
 #if VSTGUI_LOG_COLLECT_INVALID_RECTS
 	uint32_t numAddedRects;
@@ -77,6 +79,9 @@ struct CFrame::Impl
 	DispatchList<IFocusViewObserver*> focusViewObservers;
 	DispatchList<IKeyboardHook*> keyboardHooks;
 	FunctionQueue postEventFunctionQueue;
+	std::vector<CAutoLayoutContainerView*> pendingLayouts;
+	std::vector<std::pair<uint32_t, CAutoLayoutContainerView*>> flushingLayouts;
+	SharedPointer<CVSTGUITimer> layoutTimer;
 
 	ModalViewSessionID modalViewSessionIDCounter {0};
 	double userScaleFactor {1.};
@@ -84,6 +89,7 @@ struct CFrame::Impl
 	bool active {false};
 	bool windowActive {false};
 	bool inEventHandling {false};
+	bool inFlushLayout {false};
 	BitmapInterpolationQuality bitmapQuality {BitmapInterpolationQuality::kDefault};
 
 	struct PostEventHandler
@@ -104,14 +110,75 @@ struct CFrame::Impl
 				fl.front () ();
 				fl.pop ();
 			}
+			if (!wasInEventHandling)
+				impl.flushLayout ();
 		}
 
 	private:
 		Impl& impl;
 		bool wasInEventHandling;
 	};
+
+	void flushLayout ();
+	void scheduleFlushLayout ();
 };
 
+//-----------------------------------------------------------------------------
+static uint32_t getViewDepth (const CView* view)
+{
+	uint32_t depth = 0;
+	while ((view = view->getParentView ()))
+		++depth;
+	return depth;
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::Impl::flushLayout ()
+{
+	if (inFlushLayout)
+		return;
+	if (layoutTimer)
+		layoutTimer->stop ();
+	inFlushLayout = true;
+	// a layout changes the size of the child containers which schedules them again, so the
+	// parents are laid out before their children and containers scheduled while flushing are laid
+	// out in the next round. The rounds are limited in case views keep on scheduling each other.
+	static constexpr auto kMaxLayoutRounds = 32;
+	for (auto round = 0; round < kMaxLayoutRounds && !pendingLayouts.empty (); ++round)
+	{
+		for (auto& container : pendingLayouts)
+			flushingLayouts.emplace_back (getViewDepth (container), container);
+		pendingLayouts.clear ();
+		std::stable_sort (flushingLayouts.begin (), flushingLayouts.end (),
+		                  [] (const std::pair<uint32_t, CAutoLayoutContainerView*>& lhs,
+		                      const std::pair<uint32_t, CAutoLayoutContainerView*>& rhs) {
+			                  return lhs.first < rhs.first;
+		                  });
+		for (auto& entry : flushingLayouts)
+		{
+			// the container is reset when it was removed by the layout of another container
+			if (entry.second)
+				entry.second->layoutIfNeeded ();
+		}
+		flushingLayouts.clear ();
+	}
+	inFlushLayout = false;
+	if (!pendingLayouts.empty () && platformFrame)
+		scheduleFlushLayout ();
+}
+
+//-----------------------------------------------------------------------------
+/** the containers left after the last layout round are laid out when the run loop is idle again */
+void CFrame::Impl::scheduleFlushLayout ()
+{
+	if (!layoutTimer)
+	{
+		layoutTimer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { flushLayout (); }, 0,
+		                                       false);
+	}
+	layoutTimer->start ();
+}
+
 //-----------------------------------------------------------------------------
 // CFrame Implementation
 //-----------------------------------------------------------------------------
@@ -145,6 +212,8 @@ void CFrame::beforeDelete ()
 
 	pImpl->tooltips = nullptr;
 	pImpl->animator = nullptr;
+	pImpl->pendingLayouts.clear ();
+	pImpl->layoutTimer = nullptr;
 
 #if DEBUG
 	if (!pImpl->scaleFactorChangedListenerList.empty ())
@@ -747,6 +816,36 @@ Animation::Animator* CFrame::getAnimator ()
 	return pImpl->animator;
 }
 
+//-----------------------------------------------------------------------------
+void CFrame::scheduleLayout (CAutoLayoutContainerView* container)
+{
+	vstgui_assert (container && container->getFrame () == this);
+	pImpl->pendingLayouts.emplace_back (container);
+	// layouts scheduled outside of the event handling, e.g. by a timer or the host, are done
+	// before the platform draws the frame the next time, so it never draws the old geometry
+	if (!pImpl->inEventHandling && !pImpl->inFlushLayout && pImpl->platformFrame)
+		container->invalid ();
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::cancelLayout (CAutoLayoutContainerView* container)
+{
+	auto& pendingLayouts = pImpl->pendingLayouts;
+	pendingLayouts.erase (std::remove (pendingLayouts.begin (), pendingLayouts.end (), container),
+	                      pendingLayouts.end ());
+	for (auto& entry : pImpl->flushingLayouts)
+	{
+		if (entry.second == container)
+			entry.second = nullptr;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::flushLayout ()
+{
+	pImpl->flushLayout ();
+}
+
 //-----------------------------------------------------------------------------
 /**
  * @return tick count in milliseconds
@@ -1425,15 +1524,31 @@ void CFrame::setFocusWidth (CCoord width)
  */
 void CFrame::scrollRect (const CRect& src, const CPoint& distance)
 {
-	CRect rect (src);
-	rect.offset (getViewSize ().left, getViewSize ().top);
+	if (!isVisible () || !pImpl->platformFrame)
+		return;
 
-	if (pImpl->platformFrame)
+	const auto& transform = getTransform ();
+	if (transform.m12 == 0. && transform.m21 == 0.)
 	{
-		if (pImpl->platformFrame->scrollRect (src, distance))
-			return;
+		CRect platformSrc (src);
+		transform.transform (platformSrc);
+		platformSrc.makeIntegral ();
+		CPoint platformDistance (distance.x * transform.m11, distance.y * transform.m22);
+		// only whole pixels can be moved without resampling
+		if (platformDistance.x == std::floor (platformDistance.x) &&
+			platformDistance.y == std::floor (platformDistance.y))
+		{
+			// invalid rects collected so far refer to the content before the scroll, so they must
+			// reach the platform frame first to be moved together with the content
+			if (pImpl->collectInvalidRects)
+				pImpl->collectInvalidRects->flush ();
+			if (pImpl->platformFrame->scrollRect (platformSrc, platformDistance))
+				return;
+		}
 	}
-	invalidRect (src);
+	CRect rect (src);
+	rect.unite (CRect (src).offset (distance.x, distance.y));
+	invalidRect (rect);
 }
 
 //-----------------------------------------------------------------------------
@@ -1643,10 +1758,18 @@ IPlatformFrame* CFrame::getPlatformFrame () const
 //-----------------------------------------------------------------------------
 bool CFrame::platformDrawRect (CDrawContext* context, const CRect& rect)
 {
+	// for platforms which do not call platformOnBeforeDraw
+	pImpl->flushLayout ();
 	drawRect (context, rect);
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+void CFrame::platformOnBeforeDraw ()
+{
+	pImpl->flushLayout ();
+}
+
 //-----------------------------------------------------------------------------
 CMouseEventResult CFrame::platformOnMouseDown (CPoint& where, const CButtonState& buttons)
 {
@@ -1969,30 +2092,7 @@ void CFrame::CollectInvalidRects::addRect (const CRect& rect)
 #if VSTGUI_LOG_COLLECT_INVALID_RECTS
 	numAddedRects++;
 #endif
-	bool add = true;
-	for (auto it = invalidRects.begin (), end = invalidRects.end (); it != end; ++it)
-	{
-		if (it->rectInside (rect))
-		{
-			add = false;
-			break;
-		}
-		
-		CRect r (rect);
-		if (r.bound (*it) == rect)
-		{
-			add = false;
-			break;
-		}
-		r = *it;
-		if (r.bound (rect) == *it)
-		{
-			invalidRects.erase (it);
-			break;
-		}
-	}
-	if (add)
-		invalidRects.emplace_back (rect);
+	invalidRects.add (rect);
 	uint32_t now = frame->getTicks ();
 	if (now - lastTicks > 16)
 	{
@@ -125,6 +125,15 @@ public:
 	/** get animator for this frame */
 	Animation::Animator* getAnimator ();
 
+	/** schedule the layout of an auto layout container, the pending layouts are done top-down
+	 *	when the event was handled or, outside of the event handling, when the run loop is idle
+	 *	again */
+	void scheduleLayout (CAutoLayoutContainerView* container);
+	/** remove the container from the pending layouts */
+	void cancelLayout (CAutoLayoutContainerView* container);
+	/** do all pending layouts now */
+	void flushLayout ();
+
 	/** get the clipboard data. data is owned by the caller */
 	SharedPointer<IDataPackage> getClipboard ();
 	/** set the clipboard data. */
@@ -254,6 +263,7 @@ protected:
 
 	// platform frame
 	bool platformDrawRect (CDrawContext* context, const CRect& rect) override;
+	void platformOnBeforeDraw () override;
 	CMouseEventResult platformOnMouseDown (CPoint& where, const CButtonState& buttons) override;
 	CMouseEventResult platformOnMouseMoved (CPoint& where, const CButtonState& buttons) override;
 	CMouseEventResult platformOnMouseUp (CPoint& where, const CButtonState& buttons) override;
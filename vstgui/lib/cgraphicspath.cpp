@@ -149,4 +149,11 @@ void CGraphicsPath::closeSubpath ()
 	dirty ();
 }
 
+//-----------------------------------------------------------------------------
+bool CCachedGraphicsPathBase::createPath (CDrawContext* context)
+{
+	path = owned (context->createGraphicsPath ());
+	return path != nullptr;
+}
+
 } // VSTGUI
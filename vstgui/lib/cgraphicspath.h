@@ -150,4 +150,47 @@ protected:
 	ElementList elements;
 };
 
+//-----------------------------------------------------------------------------
+///	@brief Graphics path which is only created again when its geometry changes
+///
+///	Views which draw the same path again and again keep an instance as member instead of creating
+///	a new path on every draw, so that the platform path and the device data cached in it survive
+///	between draws. The geometry is described by a key which must be equality comparable.
+//-----------------------------------------------------------------------------
+class CCachedGraphicsPathBase
+{
+public:
+	void reset () { path = nullptr; }
+
+protected:
+	/** replaces the path with a new empty path of context, returns false if it has none */
+	bool createPath (CDrawContext* context);
+
+	SharedPointer<CGraphicsPath> path;
+};
+
+//-----------------------------------------------------------------------------
+template <typename Key>
+class CCachedGraphicsPath : public CCachedGraphicsPathBase
+{
+public:
+	/** returns the path for key. If the path was not created for key before, a new path is created
+	 *	and proc (CGraphicsPath&) is called to add the geometry. */
+	template <typename Proc>
+	CGraphicsPath* get (CDrawContext* context, const Key& key, Proc proc)
+	{
+		if (path && key == pathKey)
+			return path;
+		if (createPath (context))
+		{
+			proc (*path);
+			pathKey = key;
+		}
+		return path;
+	}
+
+private:
+	Key pathKey {};
+};
+
 } // VSTGUI
@@ -0,0 +1,156 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cinvalidrectlist.h"
+#include <algorithm>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+constexpr CCoord CInvalidRectList::kDefaultPerRectCost;
+constexpr size_t CInvalidRectList::kDefaultMaxRects;
+
+//-----------------------------------------------------------------------------
+CInvalidRectList::CInvalidRectList (CCoord perRectCost, size_t maxRects)
+: perRectCost (perRectCost)
+, maxRects (maxRects)
+{
+}
+
+//-----------------------------------------------------------------------------
+bool CInvalidRectList::add (const CRect& r)
+{
+	if (r.isEmpty ())
+		return false;
+	for (const auto& rect : rects)
+	{
+		if (rect.rectInside (r))
+			return false;
+	}
+	if (rects.empty ())
+	{
+		rects.emplace_back (r);
+		return true;
+	}
+	rects.emplace_back (r);
+	rebuildBands ();
+	collapseIfCheaper ();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void CInvalidRectList::clear ()
+{
+	rects.clear ();
+}
+
+//-----------------------------------------------------------------------------
+void CInvalidRectList::swap (CInvalidRectList& other)
+{
+	rects.swap (other.rects);
+	std::swap (perRectCost, other.perRectCost);
+	std::swap (maxRects, other.maxRects);
+}
+
+//-----------------------------------------------------------------------------
+CRect CInvalidRectList::getBounds () const
+{
+	if (rects.empty ())
+		return {};
+	CRect bounds (rects.front ());
+	for (const auto& rect : rects)
+		bounds.unite (rect);
+	return bounds;
+}
+
+//-----------------------------------------------------------------------------
+CCoord CInvalidRectList::getArea () const
+{
+	CCoord area = 0.;
+	for (const auto& rect : rects)
+		area += rect.getWidth () * rect.getHeight ();
+	return area;
+}
+
+//-----------------------------------------------------------------------------
+void CInvalidRectList::rebuildBands ()
+{
+	using CoordList = std::vector<CCoord>;
+	using Span = std::pair<CCoord, CCoord>;
+	using SpanList = std::vector<Span>;
+
+	CoordList yEdges;
+	yEdges.reserve (rects.size () * 2);
+	for (const auto& rect : rects)
+	{
+		yEdges.emplace_back (rect.top);
+		yEdges.emplace_back (rect.bottom);
+	}
+	std::sort (yEdges.begin (), yEdges.end ());
+	yEdges.erase (std::unique (yEdges.begin (), yEdges.end ()), yEdges.end ());
+
+	scratch.clear ();
+	SpanList spans;
+	SpanList prevSpans;
+	size_t prevBandStart = 0;
+	CCoord prevBandBottom = 0.;
+	for (size_t i = 0; i + 1 < yEdges.size (); ++i)
+	{
+		auto top = yEdges[i];
+		auto bottom = yEdges[i + 1];
+
+		spans.clear ();
+		for (const auto& rect : rects)
+		{
+			if (rect.top <= top && rect.bottom >= bottom)
+				spans.emplace_back (rect.left, rect.right);
+		}
+		if (spans.empty ())
+			continue;
+		std::sort (spans.begin (), spans.end ());
+		auto last = spans.begin ();
+		for (auto it = spans.begin () + 1; it != spans.end (); ++it)
+		{
+			// merge overlapping and touching spans
+			if (it->first <= last->second)
+				last->second = std::max (last->second, it->second);
+			else
+				*(++last) = *it;
+		}
+		spans.erase (last + 1, spans.end ());
+
+		if (prevBandBottom == top && spans == prevSpans)
+		{
+			// coalesce with the band above
+			for (auto j = prevBandStart; j < scratch.size (); ++j)
+				scratch[j].bottom = bottom;
+		}
+		else
+		{
+			prevBandStart = scratch.size ();
+			for (const auto& span : spans)
+				scratch.emplace_back (span.first, top, span.second, bottom);
+			prevSpans.swap (spans);
+		}
+		prevBandBottom = bottom;
+	}
+	rects.swap (scratch);
+}
+
+//-----------------------------------------------------------------------------
+void CInvalidRectList::collapseIfCheaper ()
+{
+	if (rects.size () < 2)
+		return;
+	auto bounds = getBounds ();
+	auto boundsCost = bounds.getWidth () * bounds.getHeight () + perRectCost;
+	auto regionCost = getArea () + perRectCost * rects.size ();
+	if (boundsCost <= regionCost || rects.size () > maxRects)
+	{
+		rects.clear ();
+		rects.emplace_back (bounds);
+	}
+}
+
+} // VSTGUI
@@ -0,0 +1,70 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstguifwd.h"
+#include "crect.h"
+#include <vector>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+/** @brief Accumulates dirty rectangles into a region
+ *
+ *	The rectangles are kept as a y-x banded list (like pixman regions): the list never contains
+ *	overlapping rectangles, rectangles in the same band share the same top and bottom and
+ *	vertically adjacent bands with the same horizontal spans are coalesced.
+ *
+ *	Every rectangle in the list costs a redraw pass, so when the area of the region plus the per
+ *	rectangle cost exceeds the cost of redrawing the bounding box of the region, the region
+ *	collapses to its bounding box. The same happens when the number of rectangles exceeds the
+ *	maximum rectangle count.
+ */
+//-----------------------------------------------------------------------------
+class CInvalidRectList
+{
+public:
+	using RectList = std::vector<CRect>;
+	using const_iterator = RectList::const_iterator;
+
+	static constexpr CCoord kDefaultPerRectCost = 64. * 64.;
+	static constexpr size_t kDefaultMaxRects = 32;
+
+	explicit CInvalidRectList (CCoord perRectCost = kDefaultPerRectCost,
+							   size_t maxRects = kDefaultMaxRects);
+
+	/** add a rect to the region. returns false if the rect is empty or already covered */
+	bool add (const CRect& r);
+	void clear ();
+	void swap (CInvalidRectList& other);
+
+	bool empty () const { return rects.empty (); }
+	size_t size () const { return rects.size (); }
+	const RectList& data () const { return rects; }
+	const_iterator begin () const { return rects.begin (); }
+	const_iterator end () const { return rects.end (); }
+
+	/** bounding box of the region */
+	CRect getBounds () const;
+	/** covered area of the region */
+	CCoord getArea () const;
+
+	/** cost of one redraw pass, expressed in pixels */
+	void setPerRectCost (CCoord cost) { perRectCost = cost; }
+	CCoord getPerRectCost () const { return perRectCost; }
+	void setMaxRects (size_t count) { maxRects = count; }
+	size_t getMaxRects () const { return maxRects; }
+
+private:
+	void rebuildBands ();
+	void collapseIfCheaper ();
+
+	RectList rects;
+	RectList scratch;
+	CCoord perRectCost;
+	size_t maxRects;
+};
+
+} // VSTGUI
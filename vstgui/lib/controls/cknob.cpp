@@ -519,9 +519,6 @@ void CKnob::addArc (CGraphicsPath* path, const CRect& r, double startAngle, doub
 //------------------------------------------------------------------------
 void CKnob::drawCoronaOutline (CDrawContext* pContext) const
 {
-	auto path = owned (pContext->createGraphicsPath ());
-	if (path == nullptr)
-		return;
 	CRect corona (getViewSize ());
 	corona.inset (coronaInset, coronaInset);
 	auto start = startAngle;
@@ -532,7 +529,10 @@ void CKnob::drawCoronaOutline (CDrawContext* pContext) const
 		start -= a;
 		range += a * 2.f;
 	}
-	addArc (path, corona, start, range);
+	auto path = coronaOutlinePath.get (pContext, ArcKey (corona, start, range),
+									   [&] (CGraphicsPath& p) { addArc (&p, corona, start, range); });
+	if (path == nullptr)
+		return;
 	pContext->setFrameColor (colorShadowHandle);
 	CLineStyle lineStyle (kLineSolid);
 	if (!(drawStyle & kCoronaLineCapButt))
@@ -546,6 +546,7 @@ void CKnob::drawCoronaOutline (CDrawContext* pContext) const
 //------------------------------------------------------------------------
 void CKnob::drawCorona (CDrawContext* pContext) const
 {
+	// the arc changes with every value, so the path is not cached like the outline
 	auto path = owned (pContext->createGraphicsPath ());
 	if (path == nullptr)
 		return;
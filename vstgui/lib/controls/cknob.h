@@ -7,6 +7,8 @@
 #include "ccontrol.h"
 #include "../ccolor.h"
 #include "../clinestyle.h"
+#include "../cgraphicspath.h"
+#include <tuple>
 
 namespace VSTGUI {
 
@@ -146,6 +148,10 @@ protected:
 
 	CLineStyle coronaLineStyle;
 	CBitmap* pHandle;
+
+private:
+	using ArcKey = std::tuple<CRect, double, double>;
+	mutable CCachedGraphicsPath<ArcKey> coronaOutlinePath;
 };
 
 //-----------------------------------------------------------------------------
@@ -429,13 +429,38 @@ void CSegmentButton::drawRect (CDrawContext* pContext, const CRect& dirtyRect)
 	{
 		lineWidth = pContext->getHairlineSize ();
 	}
-	SharedPointer<CGraphicsPath> path;
-	if (gradient || gradientHighlighted || drawLines)
+	auto lineIndexStart = 1u;
+	auto lineIndexEnd = segments.size ();
+	if (isInverseStyle (style))
 	{
-		CRect r (getViewSize ());
-		r.inset (lineWidth / 2., lineWidth / 2.);
-		path = owned (pContext->createGraphicsPath ());
-		path->addRoundRect (r, getRoundRadius ());
+		--lineIndexStart;
+		--lineIndexEnd;
+	}
+	CRect frameRect (getViewSize ());
+	frameRect.inset (lineWidth / 2., lineWidth / 2.);
+	PathKey pathKey (getViewSize (), lineWidth, getRoundRadius (), segments.size (), style);
+	CGraphicsPath* path = nullptr;
+	if (gradient || gradientHighlighted)
+	{
+		path = fillPath.get (pContext, pathKey, [&] (CGraphicsPath& p) {
+			p.addRoundRect (frameRect, getRoundRadius ());
+		});
+	}
+	CGraphicsPath* linesPath = nullptr;
+	if (drawLines)
+	{
+		// the frame and all separator lines are stroked at once, the clip of the context limits the
+		// drawing to the dirty rect
+		linesPath = strokePath.get (pContext, pathKey, [&] (CGraphicsPath& p) {
+			p.addRoundRect (frameRect, getRoundRadius ());
+			for (auto index = lineIndexStart; index < lineIndexEnd && index < segments.size ();
+			     ++index)
+			{
+				const auto& rect = segments[index].rect;
+				p.beginSubpath (rect.getTopLeft ());
+				p.addLine (isHorizontal ? rect.getBottomLeft () : rect.getTopRight ());
+			}
+		});
 	}
 	pContext->setDrawMode (kAntiAliasing);
 	if (drawLines)
@@ -444,7 +469,7 @@ void CSegmentButton::drawRect (CDrawContext* pContext, const CRect& dirtyRect)
 		pContext->setLineWidth (lineWidth);
 		pContext->setFrameColor (getFrameColor ());
 	}
-	if (gradient)
+	if (gradient && path)
 	{
 		if (isHorizontal)
 		{
@@ -457,14 +482,6 @@ void CSegmentButton::drawRect (CDrawContext* pContext, const CRect& dirtyRect)
 			                              getViewSize ().getTopRight ());
 		}
 	}
-	auto lineIndexStart = 1u;
-	auto lineIndexEnd = segments.size ();
-	if (isInverseStyle (style))
-	{
-		--lineIndexStart;
-		--lineIndexEnd;
-	}
-
 	for (uint32_t index = 0u, end = static_cast<uint32_t> (segments.size ()); index < end; ++index)
 	{
 		const auto& segment = segments[index];
@@ -472,7 +489,7 @@ void CSegmentButton::drawRect (CDrawContext* pContext, const CRect& dirtyRect)
 			continue;
 
 		drawClipped (pContext, segment.rect, [&] () {
-			if (segment.selected && gradientHighlighted)
+			if (segment.selected && gradientHighlighted && path)
 			{
 				if (isHorizontal)
 				{
@@ -500,15 +517,9 @@ void CSegmentButton::drawRect (CDrawContext* pContext, const CRect& dirtyRect)
 			    segment.iconPosition, textAlignment, textMargin, segment.rect, segment.name, font,
 			    segment.selected ? textColorHighlighted : textColor, textTruncateMode);
 		});
-		if (drawLines && index >= lineIndexStart && index < lineIndexEnd)
-		{
-			path->beginSubpath (segment.rect.getTopLeft ());
-			path->addLine (isHorizontal ? segment.rect.getBottomLeft () :
-			                              segment.rect.getTopRight ());
-		}
 	}
-	if (drawLines)
-		pContext->drawGraphicsPath (path, CDrawContext::kPathStroked);
+	if (linesPath)
+		pContext->drawGraphicsPath (linesPath, CDrawContext::kPathStroked);
 	setDirty (false);
 }
 
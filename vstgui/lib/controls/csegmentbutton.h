@@ -10,8 +10,10 @@
 #include "../cgradient.h"
 #include "../cstring.h"
 #include "../ccolor.h"
+#include "../cgraphicspath.h"
 #include <vector>
 #include <limits>
+#include <tuple>
 
 namespace VSTGUI {
 
@@ -172,6 +174,11 @@ private:
 	Style style {Style::kHorizontal};
 	SelectionMode selectionMode {SelectionMode::kSingle};
 	CDrawMethods::TextTruncateMode textTruncateMode {CDrawMethods::kTextTruncateNone};
+
+	// view size, line width, round radius, number of segments and style
+	using PathKey = std::tuple<CRect, CCoord, CCoord, size_t, Style>;
+	CCachedGraphicsPath<PathKey> fillPath;
+	CCachedGraphicsPath<PathKey> strokePath;
 };
 
 } // VSTGUI
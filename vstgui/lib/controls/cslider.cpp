@@ -597,6 +597,8 @@ struct CSlider::Impl
 	CColor frameColor {kGreyCColor};
 	CColor backColor {kBlackCColor};
 	CColor valueColor {kWhiteCColor};
+
+	CCachedGraphicsPath<CRect> framePath;
 };
 
 //------------------------------------------------------------------------
@@ -762,11 +764,13 @@ void CSlider::draw (CDrawContext* pContext)
 		{
 			pContext->setFrameColor (impl->frameColor);
 			pContext->setFillColor (impl->backColor);
-			if (auto path = owned (pContext->createGraphicsPath ()))
+			CRect frameRect (r);
+			if (impl->drawStyle & kDrawFrame)
+				frameRect.inset (lineWidth / 2., lineWidth / 2.);
+			if (auto path = impl->framePath.get (
+					pContext, frameRect, [&] (CGraphicsPath& p) { p.addRect (frameRect); }))
 			{
-				if (impl->drawStyle & kDrawFrame)
-					r.inset (lineWidth / 2., lineWidth / 2.);
-				path->addRect (r);
+				r = frameRect;
 				if (impl->drawStyle & kDrawBack)
 					pContext->drawGraphicsPath (path, CDrawContext::kPathFilled);
 				if (impl->drawStyle & kDrawFrame)
@@ -0,0 +1,70 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cpufeatures.h"
+
+#if VSTGUI_CPU_X86 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace VSTGUI {
+namespace CPUFeatures {
+namespace {
+
+//-----------------------------------------------------------------------------
+struct Features
+{
+	bool sse2 {false};
+	bool ssse3 {false};
+	bool avx2 {false};
+
+	Features ()
+	{
+#if VSTGUI_CPU_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid (info, 0);
+		auto maxLeaf = info[0];
+		__cpuid (info, 1);
+		sse2 = (info[3] & (1 << 26)) != 0;
+		ssse3 = (info[2] & (1 << 9)) != 0;
+		// the AVX registers are only usable if the operating system saves them
+		bool osSavesAVX = (info[2] & (1 << 27)) && (_xgetbv (0) & 6) == 6;
+		if (osSavesAVX && maxLeaf >= 7)
+		{
+			__cpuidex (info, 7, 0);
+			avx2 = (info[1] & (1 << 5)) != 0;
+		}
+#else
+		__builtin_cpu_init ();
+		sse2 = __builtin_cpu_supports ("sse2");
+		ssse3 = __builtin_cpu_supports ("ssse3");
+		avx2 = __builtin_cpu_supports ("avx2");
+#endif
+#endif // VSTGUI_CPU_X86
+	}
+};
+
+//-----------------------------------------------------------------------------
+} // anonymous
+
+//-----------------------------------------------------------------------------
+bool isSupported (Feature feature)
+{
+	static const Features features;
+	switch (feature)
+	{
+		case Feature::SSE2:
+			return features.sse2;
+		case Feature::SSSE3:
+			return features.ssse3;
+		case Feature::AVX2:
+			return features.avx2;
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+} // CPUFeatures
+} // VSTGUI
@@ -0,0 +1,31 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define VSTGUI_CPU_X86 1
+#else
+#define VSTGUI_CPU_X86 0
+#endif
+
+namespace VSTGUI {
+namespace CPUFeatures {
+
+//-----------------------------------------------------------------------------
+enum class Feature
+{
+	SSE2,
+	SSSE3,
+	AVX2,
+};
+
+/** returns if the processor has the instructions of feature and the operating system saves their
+ *	registers. The processor is only queried once, on other processors than x86 it is always
+ *	false. */
+bool isSupported (Feature feature);
+
+//-----------------------------------------------------------------------------
+} // CPUFeatures
+} // VSTGUI
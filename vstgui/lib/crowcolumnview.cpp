@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "crowcolumnview.h"
+#include "cframe.h"
 #include "animation/animations.h"
 #include "animation/timingfunctions.h"
 
@@ -27,8 +28,7 @@ void CRowColumnView::setStyle (Style newStyle)
 	if (newStyle != style)
 	{
 		style = newStyle;
-		if (isAttached ())
-			layoutViews ();
+		invalidLayout ();
 	}
 }
 
@@ -38,8 +38,7 @@ void CRowColumnView::setSpacing (CCoord newSpacing)
 	if (newSpacing != spacing)
 	{
 		spacing = newSpacing;
-		if (isAttached ())
-			layoutViews ();
+		invalidLayout ();
 	}
 }
 
@@ -49,8 +48,7 @@ void CRowColumnView::setMargin (const CRect& newMargin)
 	if (newMargin != margin)
 	{
 		margin = newMargin;
-		if (isAttached ())
-			layoutViews ();
+		invalidLayout ();
 	}
 }
 
@@ -60,8 +58,7 @@ void CRowColumnView::setLayoutStyle (LayoutStyle inLayoutStyle)
 	if (inLayoutStyle != layoutStyle)
 	{
 		layoutStyle = inLayoutStyle;
-		if (isAttached ())
-			layoutViews ();
+		invalidLayout ();
 	}
 }
 
@@ -235,8 +232,9 @@ CMessageResult CRowColumnView::notify (CBaseObject* sender, IdStringPtr message)
 {
 	if (message == kMsgViewSizeChanged)
 	{
-		if (isAttached ())
-			layoutViews ();
+		// the size changes of the child views in our own layout don't need another layout
+		if (!layoutGuard)
+			invalidLayout ();
 	}
 	return CViewContainer::notify (sender, message);
 }
@@ -249,6 +247,33 @@ CAutoLayoutContainerView::CAutoLayoutContainerView (const CRect& size)
 {
 }
 
+//--------------------------------------------------------------------------------
+void CAutoLayoutContainerView::invalidLayout ()
+{
+	if (!isAttached () || layoutPending)
+		return;
+	auto frame = getFrame ();
+	if (!frame)
+	{
+		layoutViews ();
+		return;
+	}
+	layoutPending = true;
+	frame->scheduleLayout (this);
+}
+
+//--------------------------------------------------------------------------------
+void CAutoLayoutContainerView::layoutIfNeeded ()
+{
+	if (!layoutPending)
+		return;
+	layoutPending = false;
+	layoutViews ();
+	// the platform is asked to draw the container after the layout, so it never draws the old
+	// geometry of the child views
+	invalid ();
+}
+
 //--------------------------------------------------------------------------------
 bool CAutoLayoutContainerView::attached (CView* parent)
 {
@@ -260,12 +285,23 @@ bool CAutoLayoutContainerView::attached (CView* parent)
 	return false;
 }
 
+//--------------------------------------------------------------------------------
+bool CAutoLayoutContainerView::removed (CView* parent)
+{
+	if (layoutPending)
+	{
+		if (auto frame = getFrame ())
+			frame->cancelLayout (this);
+		layoutPending = false;
+	}
+	return CViewContainer::removed (parent);
+}
+
 //--------------------------------------------------------------------------------
 void CAutoLayoutContainerView::setViewSize (const CRect& rect, bool invalid)
 {
 	CViewContainer::setViewSize (rect, invalid);
-	if (isAttached ())
-		layoutViews ();
+	invalidLayout ();
 }
 
 //--------------------------------------------------------------------------------
@@ -273,8 +309,7 @@ bool CAutoLayoutContainerView::addView (CView* pView, CView* pBefore)
 {
 	if (CViewContainer::addView (pView, pBefore))
 	{
-		if (isAttached ())
-			layoutViews ();
+		invalidLayout ();
 		return true;
 	}
 	return false;
@@ -285,8 +320,7 @@ bool CAutoLayoutContainerView::removeView (CView* pView, bool withForget)
 {
 	if (CViewContainer::removeView (pView, withForget))
 	{
-		if (isAttached ())
-			layoutViews ();
+		invalidLayout ();
 		return true;
 	}
 	return false;
@@ -297,8 +331,7 @@ bool CAutoLayoutContainerView::changeViewZOrder (CView* view, uint32_t newIndex)
 {
 	if (CViewContainer::changeViewZOrder (view, newIndex))
 	{
-		if (isAttached ())
-			layoutViews ();
+		invalidLayout ();
 		return true;
 	}
 	return false;
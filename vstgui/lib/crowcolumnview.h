@@ -9,8 +9,12 @@
 namespace VSTGUI {
 
 // a container view which automatically layout its child views
-/** TODO: Doc 
-*/
+/** Changes to the size or the child views of the container don't layout the child views
+ *	immediately, the container is scheduled at its frame and all pending layouts are done once,
+ *	top-down, when an event was handled or, outside of the event handling, when the run loop is
+ *	idle again.
+ *	Use CFrame::flushLayout if the geometry of the child views is needed immediately.
+ */
 class CAutoLayoutContainerView : public CViewContainer
 {
 public:
@@ -18,13 +22,22 @@ public:
 
 	virtual void layoutViews () = 0;
 
+	/** schedule a layout of the child views */
+	void invalidLayout ();
+	/** layout the child views now if a layout is scheduled */
+	void layoutIfNeeded ();
+	bool isLayoutPending () const { return layoutPending; }
+
 	bool attached (CView* parent) override;
+	bool removed (CView* parent) override;
 	void setViewSize (const CRect& rect, bool invalid = true) override;
 	bool addView (CView* pView, CView* pBefore = nullptr) override;
 	bool removeView (CView* pView, bool withForget = true) override;
 	bool changeViewZOrder (CView* view, uint32_t newIndex) override;
 
 	CLASS_METHODS_VIRTUAL(CAutoLayoutContainerView, CViewContainer)
+private:
+	bool layoutPending {false};
 };
 
 
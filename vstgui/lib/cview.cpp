@@ -160,6 +160,7 @@ UTF8StringPtr kPerthousandSymbol= "\xE2\x80\xB0";
 
 //-----------------------------------------------------------------------------
 IdStringPtr kMsgViewSizeChanged = "kMsgViewSizeChanged";
+IdStringPtr kMsgViewMouseableAreaChanged = "kMsgViewMouseableAreaChanged";
 
 bool CView::kDirtyCallAlwaysOnMainThread = false;
 
@@ -270,6 +271,7 @@ void CView::beforeDelete ()
 //-----------------------------------------------------------------------------
 void CView::setMouseableArea (const CRect& rect)
 {
+	bool changed = getParentView () && getMouseableArea () != rect;
 	if (pImpl->size == rect)
 	{
 		setViewFlag (kHasMouseableArea, false);
@@ -280,6 +282,8 @@ void CView::setMouseableArea (const CRect& rect)
 		setViewFlag (kHasMouseableArea, true);
 		setAttribute (kCViewMouseableAreaAttrID, rect);
 	}
+	if (changed)
+		getParentView ()->notify (this, kMsgViewMouseableAreaChanged);
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
@@ -34,6 +34,8 @@ extern UTF8StringPtr kPerthousandSymbol;
 //-----------------------------------------------------------------------------
 /** Message send to parent that the size of the view has changed */
 extern IdStringPtr kMsgViewSizeChanged;
+/** Message send to parent that the mouseable area of the view has changed */
+extern IdStringPtr kMsgViewMouseableAreaChanged;
 
 //-----------------------------------------------------------------------------
 // Attributes
@@ -13,9 +13,13 @@
 #include "cgraphicspath.h"
 #include "controls/ccontrol.h"
 #include "dragging.h"
+#include "algorithm.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -26,6 +30,197 @@ const CViewAttributeID kCViewContainerMouseDownViewAttribute = 'vcmd';
 const CViewAttributeID kCViewContainerLastDrawnFocusAttribute = 'vclf';
 const CViewAttributeID kCViewContainerBackgroundOffsetAttribute = 'vcbo';
 
+//-----------------------------------------------------------------------------
+// uniform grid over the child views of a container keyed on the union of the view size and the
+// mouseable area. Each cell holds the views overlapping it sorted by z-order. Positions outside
+// of the grid are clamped to the border cells, so views moved outside are still found.
+//-----------------------------------------------------------------------------
+class ChildViewGrid
+{
+public:
+	using ViewList = CViewContainer::ViewList;
+	using Views = std::vector<CView*>;
+
+	bool needsRebuild () const { return dirty; }
+	void invalidate () { dirty = true; }
+
+	//-----------------------------------------------------------------------------
+	void rebuild (const ViewList& children)
+	{
+		entries.clear ();
+		cells.clear ();
+		bounds = {};
+		for (auto it = children.begin (); it != children.end (); ++it)
+		{
+			if (it == children.begin ())
+				bounds = keyOf (*it);
+			else
+				bounds.unite (keyOf (*it));
+		}
+		auto numCells = std::max<size_t> (1, children.size () / kViewsPerCell);
+		auto width = std::max<CCoord> (bounds.getWidth (), 1.);
+		auto height = std::max<CCoord> (bounds.getHeight (), 1.);
+		columns = clamp (static_cast<int32_t> (std::round (std::sqrt (numCells * width / height))),
+		                 1, kMaxCellsPerAxis);
+		rows = clamp (static_cast<int32_t> ((numCells + columns - 1) / columns), 1,
+		              kMaxCellsPerAxis);
+		cellWidth = width / columns;
+		cellHeight = height / rows;
+		cells.resize (static_cast<size_t> (columns * rows));
+		nextZ = 0;
+		for (auto& child : children)
+			add (child);
+		rebuildSize = children.size ();
+		dirty = false;
+	}
+
+	//-----------------------------------------------------------------------------
+	void add (CView* view)
+	{
+		Entry entry {nextZ++, keyOf (view)};
+		forEachCell (entry.key, [&] (Cell& cell) { cell.emplace_back (Item {entry.z, view}); });
+		entries.emplace (view, entry);
+		// too many views outside of the grid bounds or too many views per cell
+		if (entries.size () > rebuildSize * 2 + kViewsPerCell)
+			dirty = true;
+	}
+
+	//-----------------------------------------------------------------------------
+	void remove (CView* view)
+	{
+		auto it = entries.find (view);
+		if (it == entries.end ())
+			return;
+		erase (view, it->second.key);
+		entries.erase (it);
+	}
+
+	//-----------------------------------------------------------------------------
+	void update (CView* view)
+	{
+		auto it = entries.find (view);
+		if (it == entries.end ())
+			return;
+		auto key = keyOf (view);
+		if (key == it->second.key)
+			return;
+		erase (view, it->second.key);
+		it->second.key = key;
+		Item item {it->second.z, view};
+		forEachCell (key, [&] (Cell& cell) {
+			cell.insert (std::upper_bound (cell.begin (), cell.end (), item, isBelow), item);
+		});
+	}
+
+	//-----------------------------------------------------------------------------
+	/** views whose key contains where, top-most first */
+	void getViewsAt (const CPoint& where, Views& result) const
+	{
+		const auto& cell = cells[static_cast<size_t> (row (where.y) * columns + column (where.x))];
+		for (auto it = cell.rbegin (); it != cell.rend (); ++it)
+			result.emplace_back (it->view);
+	}
+
+	//-----------------------------------------------------------------------------
+	/** views whose key overlaps rect and the view include, bottom-most first */
+	void getViewsInRect (const CRect& rect, CView* include, Views& result) const
+	{
+		std::vector<Item> items;
+		forEachCell (rect, [&] (const Cell& cell) {
+			for (auto& item : cell)
+			{
+				if (entries.at (item.view).key.rectOverlap (rect))
+					items.emplace_back (item);
+			}
+		});
+		auto it = include ? entries.find (include) : entries.end ();
+		if (it != entries.end ())
+			items.emplace_back (Item {it->second.z, include});
+		std::sort (items.begin (), items.end (), isBelow);
+		items.erase (std::unique (items.begin (), items.end (),
+		                          [] (const Item& a, const Item& b) { return a.view == b.view; }),
+		             items.end ());
+		result.reserve (items.size ());
+		for (auto& item : items)
+			result.emplace_back (item.view);
+	}
+
+private:
+	static constexpr size_t kViewsPerCell = 4;
+	static constexpr int32_t kMaxCellsPerAxis = 128;
+
+	struct Item
+	{
+		uint32_t z;
+		CView* view;
+	};
+	struct Entry
+	{
+		uint32_t z;
+		CRect key;
+	};
+	using Cell = std::vector<Item>;
+
+	static bool isBelow (const Item& a, const Item& b) { return a.z < b.z; }
+
+	static CRect keyOf (CView* view)
+	{
+		CRect key (view->getViewSize ());
+		key.normalize ();
+		CRect mouseableArea (view->getMouseableArea ());
+		mouseableArea.normalize ();
+		return key.unite (mouseableArea);
+	}
+
+	int32_t column (CCoord x) const
+	{
+		return clamp (static_cast<int32_t> (std::floor ((x - bounds.left) / cellWidth)), 0,
+		              columns - 1);
+	}
+
+	int32_t row (CCoord y) const
+	{
+		return clamp (static_cast<int32_t> (std::floor ((y - bounds.top) / cellHeight)), 0,
+		              rows - 1);
+	}
+
+	template <typename Proc>
+	void forEachCell (const CRect& rect, Proc proc)
+	{
+		for (auto y = row (rect.top), bottom = row (rect.bottom); y <= bottom; ++y)
+		{
+			for (auto x = column (rect.left), right = column (rect.right); x <= right; ++x)
+				proc (cells[static_cast<size_t> (y * columns + x)]);
+		}
+	}
+
+	template <typename Proc>
+	void forEachCell (const CRect& rect, Proc proc) const
+	{
+		const_cast<ChildViewGrid*> (this)->forEachCell (rect, [&] (const Cell& cell) { proc (cell); });
+	}
+
+	void erase (CView* view, const CRect& key)
+	{
+		forEachCell (key, [&] (Cell& cell) {
+			cell.erase (std::remove_if (cell.begin (), cell.end (),
+			                            [&] (const Item& item) { return item.view == view; }),
+			            cell.end ());
+		});
+	}
+
+	std::vector<Cell> cells;
+	std::unordered_map<const CView*, Entry> entries;
+	CRect bounds;
+	CCoord cellWidth {1.};
+	CCoord cellHeight {1.};
+	int32_t columns {1};
+	int32_t rows {1};
+	uint32_t nextZ {0};
+	size_t rebuildSize {0};
+	bool dirty {true};
+};
+
 //-----------------------------------------------------------------------------
 // CViewContainer Implementation
 //-----------------------------------------------------------------------------
@@ -37,9 +232,42 @@ struct CViewContainer::Impl
 	CGraphicsTransform transform;
 	
 	ViewList children;
+	std::unique_ptr<ChildViewGrid> grid;
 	
 	CDrawStyle backgroundColorDrawStyle {kDrawFilledAndStroked};
 	CColor backgroundColor {kBlackCColor};
+
+	ChildViewGrid* getGrid (const CViewContainer* container)
+	{
+		if (!grid || !container->isAttached ())
+			return nullptr;
+		if (grid->needsRebuild ())
+			grid->rebuild (children);
+		return grid.get ();
+	}
+
+	/** calls proc with the child views which may contain where, top-most first, until proc
+	 *  returns false */
+	template <typename Proc>
+	void forEachChildAt (const CViewContainer* container, const CPoint& where, Proc proc)
+	{
+		if (auto g = getGrid (container))
+		{
+			ChildViewGrid::Views views;
+			g->getViewsAt (where, views);
+			for (auto& view : views)
+			{
+				if (!proc (view))
+					return;
+			}
+			return;
+		}
+		for (auto it = children.rbegin (), end = children.rend (); it != end; ++it)
+		{
+			if (!proc (*it))
+				return;
+		}
+	}
 };
 
 //------------------------------------------------------------------------
@@ -147,6 +375,7 @@ CViewContainer::CViewContainer (const CViewContainer& v)
 	pImpl->backgroundColorDrawStyle = v.pImpl->backgroundColorDrawStyle;
 	pImpl->backgroundColor = v.pImpl->backgroundColor;
 	setBackgroundOffset (v.getBackgroundOffset ());
+	setSpatialIndexEnabled (v.getSpatialIndexEnabled ());
 	for (auto& view : v.pImpl->children)
 		addView (static_cast<CView*> (view->newCopy ()));
 }
@@ -272,6 +501,23 @@ void CViewContainer::setAutosizingEnabled (bool state)
 	setViewFlag (kAutosizeSubviews, state);
 }
 
+//-----------------------------------------------------------------------------
+void CViewContainer::setSpatialIndexEnabled (bool state)
+{
+	if (state == getSpatialIndexEnabled ())
+		return;
+	if (state)
+		pImpl->grid = std::unique_ptr<ChildViewGrid> (new ChildViewGrid ());
+	else
+		pImpl->grid = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool CViewContainer::getSpatialIndexEnabled () const
+{
+	return pImpl->grid != nullptr;
+}
+
 //-----------------------------------------------------------------------------
 /**
  * @param rect the new size of the container
@@ -490,6 +736,11 @@ CMessageResult CViewContainer::notify (CBaseObject* sender, IdStringPtr message)
 			setLastDrawnFocus (CRect (0, 0, 0, 0));
 		}
 	}
+	else if (message == kMsgViewSizeChanged || message == kMsgViewMouseableAreaChanged)
+	{
+		if (pImpl->grid)
+			pImpl->grid->update (static_cast<CView*> (sender));
+	}
 	return kMessageUnknown;
 }
 
@@ -511,10 +762,14 @@ bool CViewContainer::addView (CView *pView, CView* pBefore)
 		auto it = std::find (pImpl->children.begin (), pImpl->children.end (), pBefore);
 		vstgui_assert (it != pImpl->children.end ());
 		pImpl->children.insert (it, pView);
+		if (pImpl->grid)
+			pImpl->grid->invalidate ();
 	}
 	else
 	{
 		pImpl->children.emplace_back (pView);
+		if (pImpl->grid && !pImpl->grid->needsRebuild ())
+			pImpl->grid->add (pView);
 	}
 
 	pView->setSubviewState (true);
@@ -557,6 +812,8 @@ bool CViewContainer::addView (CView* pView, const CRect &mouseableArea, bool mou
 bool CViewContainer::removeAll (bool withForget)
 {
 	clearMouseDownView ();
+	if (pImpl->grid)
+		pImpl->grid->invalidate ();
 	
 	auto it = pImpl->children.begin ();
 	while (it != pImpl->children.end ())
@@ -596,6 +853,8 @@ bool CViewContainer::removeView (CView *pView, bool withForget)
 		pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 			listener->viewContainerViewRemoved (this, pView);
 		});
+		if (pImpl->grid)
+			pImpl->grid->remove (pView);
 		if (withForget)
 			pView->forget ();
 		pImpl->children.erase (it);
@@ -696,6 +955,8 @@ bool CViewContainer::changeViewZOrder (CView* view, uint32_t newIndex)
 
 			pImpl->children.insert (dest, view);
 			pImpl->children.erase (src);
+			if (pImpl->grid)
+				pImpl->grid->invalidate ();
 
 			pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 				listener->viewContainerViewZOrderChanged (this, view);
@@ -843,8 +1104,7 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 		getTransform ().transform (oldClip2);
 		
 		// draw each view
-		for (const auto& pV : pImpl->children)
-		{
+		auto drawChild = [&] (CView* pV) {
 			if (pV->isVisible ())
 			{
 				if (frame && _focusDrawing && _focusView == pV && !_focusDrawing->drawFocusOnTop ())
@@ -875,7 +1135,7 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 					CRect viewSize = pV->getViewSize ();
 					viewSize.bound (newClip);
 					if (viewSize.getWidth () == 0 || viewSize.getHeight () == 0)
-						continue;
+						return;
 					pContext->setClipRect (viewSize);
 					float globalContextAlpha = pContext->getGlobalAlpha ();
 					pContext->setGlobalAlpha (globalContextAlpha * pV->getAlphaValue ());
@@ -883,6 +1143,18 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 					pContext->setGlobalAlpha (globalContextAlpha);
 				}
 			}
+		};
+		if (auto grid = pImpl->getGrid (this))
+		{
+			ChildViewGrid::Views views;
+			grid->getViewsInRect (clientRect, _focusDrawing ? _focusView : nullptr, views);
+			for (auto& pV : views)
+				drawChild (pV);
+		}
+		else
+		{
+			for (const auto& pV : pImpl->children)
+				drawChild (pV);
 		}
 	}
 	
@@ -945,21 +1217,21 @@ bool CViewContainer::hitTestSubViews (const CPoint& where, const CButtonState& b
 	where2.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where2);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	bool result = false;
+	pImpl->forEachChildAt (this, where2, [&] (CView* pV) {
 		if (pV && pV->isVisible () && pV->getMouseEnabled () && pV->hitTest (where2, buttons))
 		{
 			if (auto container = pV->asViewContainer ())
 			{
 				if (container->hitTestSubViews (where2, buttons))
-					return true;
+					result = true;
 			}
 			else
-				return true;
+				result = true;
 		}
-	}
-	return false;
+		return !result;
+	});
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -983,9 +1255,9 @@ CMouseEventResult CViewContainer::onMouseDown (CPoint &where, const CButtonState
 	where2.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where2);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		auto pV = *it;
+	auto mouseResult = kMouseEventNotHandled;
+	pImpl->forEachChildAt (this, where2, [&] (CView* view) {
+		SharedPointer<CView> pV (view);
 		if (pV && pV->isVisible () && pV->getMouseEnabled () && pV->hitTest (where2, buttons))
 		{
 			if (buttons & (kAlt | kShift | kControl | kApple | kRButton))
@@ -994,7 +1266,10 @@ CMouseEventResult CViewContainer::onMouseDown (CPoint &where, const CButtonState
 				if (control && control->getListener ())
 				{
 					if (control->getListener ()->controlModifierClicked (control, buttons) != 0)
-						return kMouseEventHandled;
+					{
+						mouseResult = kMouseEventHandled;
+						return false;
+					}
 				}
 			}
 			auto frame = getFrame ();
@@ -1015,13 +1290,18 @@ CMouseEventResult CViewContainer::onMouseDown (CPoint &where, const CButtonState
 					if (result == kMouseEventHandled)
 						setMouseDownView (pV);
 				}
-				return result;
+				mouseResult = result;
+				return false;
 			}
 			if (!pV->getTransparency ())
-				return result;
+			{
+				mouseResult = result;
+				return false;
+			}
 		}
-	}
-	return kMouseEventNotHandled;
+		return true;
+	});
+	return mouseResult;
 }
 
 //-----------------------------------------------------------------------------
@@ -1083,21 +1363,25 @@ CMouseEventResult CViewContainer::onMouseCancel ()
 //-----------------------------------------------------------------------------
 bool CViewContainer::onWheel (const CPoint &where, const CMouseWheelAxis &axis, const float &distance, const CButtonState &buttons)
 {
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
-		CPoint where2 (where);
-		where2.offset (-getViewSize ().left, -getViewSize ().top);
-		getTransform ().inverse ().transform (where2);
+	CPoint where2 (where);
+	where2.offset (-getViewSize ().left, -getViewSize ().top);
+	getTransform ().inverse ().transform (where2);
+
+	bool result = false;
+	pImpl->forEachChildAt (this, where2, [&] (CView* pV) {
 		if (pV && pV->isVisible () && pV->getMouseEnabled () && pV->getMouseableArea ().pointInside (where2))
 		{
 			if (pV->onWheel (where2, axis, distance, buttons))
-				return true;
+			{
+				result = true;
+				return false;
+			}
 			if (!pV->getTransparency ())
 				return false;
 		}
-	}
-	return false;
+		return true;
+	});
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1294,33 +1578,35 @@ CView* CViewContainer::getViewAt (const CPoint& p, const GetViewOptions& options
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	CView* result = nullptr;
+	pImpl->forEachChildAt (this, where, [&] (CView* pV) {
 		if (pV && pV->getMouseableArea ().pointInside (where))
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
+				return true;
 			if (options.getMouseEnabled ())
 			{
 				if (pV->getMouseEnabled () == false)
-					continue;
+					return true;
 			}
 			if (options.getDeep ())
 			{
 				if (auto container = pV->asViewContainer ())
 				{
 					CView* view = container->getViewAt (where, options);
-					return options.getIncludeViewContainer () ? (view ? view : container) : view;
+					result = options.getIncludeViewContainer () ? (view ? view : container) : view;
+					return false;
 				}
 			}
 			if (!options.getIncludeViewContainer () && pV->asViewContainer ())
-				continue;
-			return pV;
+				return true;
+			result = pV;
+			return false;
 		}
-	}
+		return true;
+	});
 
-	return nullptr;
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1338,17 +1624,15 @@ bool CViewContainer::getViewsAt (const CPoint& p, ViewList& views, const GetView
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	pImpl->forEachChildAt (this, where, [&] (CView* pV) {
 		if (pV && pV->getMouseableArea ().pointInside (where))
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
+				return true;
 			if (options.getMouseEnabled ())
 			{
 				if (pV->getMouseEnabled () == false)
-					continue;
+					return true;
 			}
 			if (options.getDeep ())
 			{
@@ -1358,12 +1642,13 @@ bool CViewContainer::getViewsAt (const CPoint& p, ViewList& views, const GetView
 			if (options.getIncludeViewContainer () == false)
 			{
 				if (pV->asViewContainer ())
-					continue;
+					return true;
 			}
 			views.emplace_back (pV);
 			result = true;
 		}
-	}
+		return true;
+	});
 
 	return result;
 }
@@ -1380,28 +1665,28 @@ CViewContainer* CViewContainer::getContainerAt (const CPoint& p, const GetViewOp
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	CViewContainer* result = const_cast<CViewContainer*>(this);
+	pImpl->forEachChildAt (this, where, [&] (CView* pV) {
 		if (pV && pV->getMouseableArea ().pointInside (where))
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
+				return true;
 			if (options.getMouseEnabled ())
 			{
 				if (pV->getMouseEnabled() == false)
-					continue;
+					return true;
 			}
 			if (options.getDeep ())
 			{
 				if (CViewContainer* container = pV->asViewContainer ())
-					return container->getContainerAt (where, options);
+					result = container->getContainerAt (where, options);
 			}
-			break;
+			return false;
 		}
-	}
+		return true;
+	});
 
-	return const_cast<CViewContainer*>(this);
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1430,6 +1715,8 @@ bool CViewContainer::removed (CView* parent)
 
 	for (const auto& pV : pImpl->children)
 		pV->removed (this);
+	if (pImpl->grid)
+		pImpl->grid->invalidate ();
 	
 	return CView::removed (parent);
 }
@@ -1441,6 +1728,8 @@ bool CViewContainer::attached (CView* parent)
 		return false;
 
 	setParentFrame (parent->getFrame ());
+	if (pImpl->grid)
+		pImpl->grid->invalidate ();
 
 	bool result = CView::attached (parent);
 	if (result)
@@ -94,6 +94,18 @@ public:
 	virtual void setAutosizingEnabled (bool state);
 	bool getAutosizingEnabled () const { return hasViewFlag (kAutosizeSubviews); }
 
+	/** enable or disable the spatial index of the child views. Per default this is disabled.
+	 *
+	 *	With the index, drawing and hit testing only visit the child views whose size or mouseable
+	 *	area overlaps the update rect or the mouse position instead of all child views, in the same
+	 *	z-order. Only enable it for containers with many child views which neither draw nor accept
+	 *	hits outside of their size and mouseable area. The index is only used while the container
+	 *	is attached and relies on kMsgViewSizeChanged and kMsgViewMouseableAreaChanged reaching
+	 *	CViewContainer::notify.
+	 */
+	void setSpatialIndexEnabled (bool state);
+	bool getSpatialIndexEnabled () const;
+
 	/** get child views of type ViewClass. ContainerClass must be a stdc++ container */
 	template<class ViewClass, class ContainerClass>
 	uint32_t getChildViewsOfType (ContainerClass& result, bool deep = false) const;
@@ -63,6 +63,7 @@ bool CVSTGUITimer::start ()
 		platformTimer = IPlatformTimer::create (this);
 		if (platformTimer)
 		{
+			platformTimer->setTolerance (tolerance);
 			platformTimer->start (fireTime);
 		#if DEBUGLOG
 			DebugPrint ("Timer started (0x%x)\n", timerObject);
@@ -102,6 +103,20 @@ bool CVSTGUITimer::setFireTime (uint32_t newFireTime)
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+bool CVSTGUITimer::setTolerance (uint32_t newTolerance)
+{
+	if (tolerance != newTolerance)
+	{
+		bool wasRunning = stop ();
+		tolerance = newTolerance;
+		if (wasRunning)
+			return start ();
+		return true;
+	}
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 void CVSTGUITimer::fire ()
 {
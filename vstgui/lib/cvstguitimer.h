@@ -33,6 +33,11 @@ public:
 	/** get fire time in milliseconds*/
 	uint32_t getFireTime () const { return fireTime; }
 
+	/** set how late the timer may fire in milliseconds, zero means one fire time */
+	bool setTolerance (uint32_t newTolerance);
+	/** get the tolerance in milliseconds */
+	uint32_t getTolerance () const { return tolerance; }
+
 //-----------------------------------------------------------------------------
 	/** message string posted to CBaseObject's notify method */
 	static IdStringPtr kMsgTimer;
@@ -45,6 +50,7 @@ protected:
 	void fire () override;
 	
 	uint32_t fireTime;
+	uint32_t tolerance {0};
 	CallbackFunc callbackFunc;
 
 	SharedPointer<IPlatformTimer> platformTimer;
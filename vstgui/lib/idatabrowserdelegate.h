@@ -38,6 +38,14 @@ public:
 	                                      CDataBrowser* browser) = 0;
 	/** return height of one row */
 	virtual CCoord dbGetRowHeight (CDataBrowser* browser) = 0;
+	/** return true if the rows have different heights, the height of every row is then queried
+	 *	with dbGetVariableRowHeight when the layout of the browser is recalculated */
+	virtual bool dbHasVariableRowHeight (CDataBrowser* browser) { return false; }
+	/** return height of row, only called if dbHasVariableRowHeight returns true */
+	virtual CCoord dbGetVariableRowHeight (int32_t row, CDataBrowser* browser)
+	{
+		return dbGetRowHeight (browser);
+	}
 	/** return height of header */
 	virtual CCoord dbGetHeaderHeight (CDataBrowser* browser) = 0;
 	/** return the line width and color */
@@ -22,6 +22,18 @@ public:
 	virtual CCoord getStringWidth (CDrawContext* context, IPlatformString* string, bool antialias = true) const = 0;
 };
 
+//-----------------------------------------------------------------------------
+class IFontPainterCharAdvancesExtension /* Extents IFontPainter */
+{
+public:
+	virtual ~IFontPainterCharAdvancesExtension () noexcept = default;
+
+	/** fill advances with the advance of each of the numChars UTF-8 characters of the string, so
+	 *	that the width of substrings can be calculated without measuring them again. Returns false
+	 *	if not supported or if the string does not have numChars characters. */
+	virtual bool getCharAdvances (IPlatformString* string, CCoord* advances, size_t numChars) const = 0;
+};
+
 //-----------------------------------------------------------------------------
 // IPlatformFont declaration
 //! @brief platform font class
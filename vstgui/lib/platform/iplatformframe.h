@@ -121,6 +121,44 @@ public:
 	virtual void recreateTouchBar () = 0;
 };
 
+//-----------------------------------------------------------------------------
+/* Extension to query redraw timing */
+//-----------------------------------------------------------------------------
+struct PlatformFrameTimingStats
+{
+	/** number of frames drawn */
+	uint64_t frameCount {0};
+	/** number of display refreshes skipped because a frame was late */
+	uint64_t droppedFrames {0};
+	/** duration of the display refresh interval in milliseconds */
+	double refreshInterval {0.};
+	/** time in milliseconds the last frame took to draw the views */
+	double lastDrawTime {0.};
+	/** time in milliseconds the last frame took to present the drawing to the screen */
+	double lastPresentTime {0.};
+	/** maximum draw time in milliseconds since the stats were reset */
+	double maxDrawTime {0.};
+	/** maximum present time in milliseconds since the stats were reset */
+	double maxPresentTime {0.};
+	/** time in milliseconds the last frame took from the start of the drawing until it was
+	 *	presented, frames without anything to draw are not counted */
+	double lastFrameTime {0.};
+	/** maximum frame time in milliseconds since the stats were reset */
+	double maxFrameTime {0.};
+};
+
+//-----------------------------------------------------------------------------
+class IPlatformFrameTimingStatsExtension /* Extents IPlatformFrame */
+{
+public:
+	virtual ~IPlatformFrameTimingStatsExtension () noexcept = default;
+
+	/** get the redraw timing stats of the frame */
+	virtual PlatformFrameTimingStats getTimingStats () const = 0;
+	/** reset the frame, dropped frame and maximum time counters */
+	virtual void resetTimingStats () = 0;
+};
+
 } // VSTGUI
 
 /// @endcond
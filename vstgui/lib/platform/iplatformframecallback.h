@@ -32,6 +32,9 @@ class IPlatformFrameCallback
 {
 public:
 	virtual bool platformDrawRect (CDrawContext* context, const CRect& rect) = 0;
+	/** called before the platform collects the rects to draw, views may change their geometry
+	 *	and invalidate rects here */
+	virtual void platformOnBeforeDraw () = 0;
 	
 	virtual CMouseEventResult platformOnMouseDown (CPoint& where, const CButtonState& buttons) = 0;
 	virtual CMouseEventResult platformOnMouseMoved (CPoint& where, const CButtonState& buttons) = 0;
@@ -23,6 +23,10 @@ public:
 
 	virtual bool start (uint32_t fireTime) = 0;
 	virtual bool stop () = 0;
+
+	/** how late the timer may fire in milliseconds, zero means one fire time. Used by the next
+	 *	start on platforms which coalesce timers, ignored on the others */
+	virtual void setTolerance (uint32_t toleranceMs) {}
 };
 
 } // VSTGUI
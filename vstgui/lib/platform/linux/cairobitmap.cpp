@@ -182,6 +182,7 @@ bool Bitmap::load (const CResourceDescription& desc)
 				return false;
 			}
 			surface = s;
+			patterns.clear ();
 			size.x = cairo_image_surface_get_width (surface);
 			size.y = cairo_image_surface_get_height (surface);
 			return true;
@@ -195,6 +196,27 @@ const CPoint& Bitmap::getSize () const
 {
 	return size;
 }
+//-----------------------------------------------------------------------------
+const PatternHandle& Bitmap::getPattern (cairo_filter_t filter, cairo_extend_t extend)
+{
+	for (const auto& entry : patterns)
+	{
+		if (entry.filter == filter && entry.extend == extend)
+			return entry.pattern;
+	}
+	auto& s = getSurface ();
+	if (!s)
+	{
+		static PatternHandle empty;
+		return empty;
+	}
+	PatternHandle pattern (cairo_pattern_create_for_surface (s));
+	cairo_pattern_set_filter (pattern, filter);
+	cairo_pattern_set_extend (pattern, extend);
+	patterns.push_back ({filter, extend, std::move (pattern)});
+	return patterns.back ().pattern;
+}
+
 //-----------------------------------------------------------------------------
 SharedPointer<IPlatformBitmapPixelAccess> Bitmap::lockPixels (bool alphaPremultiplied)
 {
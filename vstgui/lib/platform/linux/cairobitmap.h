@@ -11,6 +11,7 @@
 #include "../iplatformbitmap.h"
 #include "cairoutils.h"
 #include <functional>
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -41,14 +42,29 @@ public:
 		return surface;
 	}
 
+	/** surface pattern of the bitmap, cached per filter and extend mode
+	 *
+	 *	The pattern is shared by all users, so its matrix must be set before every use.
+	 */
+	const PatternHandle& getPattern (cairo_filter_t filter = CAIRO_FILTER_GOOD,
+									 cairo_extend_t extend = CAIRO_EXTEND_NONE);
+
 	void unlock () { locked = false; }
 
 	using GetResourcePathFunc = std::function<std::string ()>;
 	static void setGetResourcePathFunc (GetResourcePathFunc&& func);
 
 private:
+	struct CachedPattern
+	{
+		cairo_filter_t filter;
+		cairo_extend_t extend;
+		PatternHandle pattern;
+	};
+
 	double scaleFactor {1.0};
 	SurfaceHandle surface;
+	std::vector<CachedPattern> patterns;
 	CPoint size;
 	bool locked {false};
 
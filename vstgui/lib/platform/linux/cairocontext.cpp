@@ -7,6 +7,7 @@
 #include "cairobitmap.h"
 #include "cairogradient.h"
 #include "cairopath.h"
+#include <cmath>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -384,30 +385,37 @@ void Context::drawPoint (const CPoint& point, const CColor& color)
 //-----------------------------------------------------------------------------
 void Context::drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset, float alpha)
 {
+	double transformedScaleFactor = getScaleFactor ();
+	CGraphicsTransform t = getCurrentTransform ();
+	if (t.m11 == t.m22 && t.m12 == 0 && t.m21 == 0)
+		transformedScaleFactor *= t.m11;
+	auto cairoBitmap =
+		bitmap->getBestPlatformBitmapForScaleFactor (transformedScaleFactor).cast<Bitmap> ();
+	if (!cairoBitmap)
+		return;
+	alpha *= getGlobalAlpha ();
+	if (alpha == 1.f && drawBitmapPixelAligned (*cairoBitmap, dest, offset))
+		return;
+
 	if (auto cd = DrawBlock::begin (*this))
 	{
-		double transformedScaleFactor = getScaleFactor();
-		CGraphicsTransform t = getCurrentTransform ();
-		if (t.m11 == t.m22 && t.m12 == 0 && t.m21 == 0)
-			transformedScaleFactor *= t.m11;
-                auto cairoBitmap = bitmap->getBestPlatformBitmapForScaleFactor (transformedScaleFactor).cast<Bitmap> ();
-		if (cairoBitmap)
+		const auto& pattern = cairoBitmap->getPattern ();
+		if (pattern)
 		{
 			cairo_translate (cr, dest.left, dest.top);
 			cairo_rectangle (cr, 0, 0, dest.getWidth (), dest.getHeight ());
 			cairo_clip (cr);
 
-			// Setup a pattern for scaling bitmaps and take it as source afterwards.
-			auto pattern = cairo_pattern_create_for_surface (cairoBitmap->getSurface());
+			// Setup the pattern for scaling bitmaps and take it as source afterwards.
 			cairo_matrix_t matrix;
-			cairo_pattern_get_matrix (pattern, &matrix);
-			cairo_matrix_init_scale (&matrix, cairoBitmap->getScaleFactor (), cairoBitmap->getScaleFactor ());
+			cairo_matrix_init_scale (&matrix, cairoBitmap->getScaleFactor (),
+			                         cairoBitmap->getScaleFactor ());
 			cairo_matrix_translate (&matrix, offset.x, offset.y);
 			cairo_pattern_set_matrix (pattern, &matrix);
 			cairo_set_source (cr, pattern);
 
-			cairo_rectangle (cr, -offset.x, -offset.y, dest.getWidth () + offset.x, dest.getHeight () + offset.y);
-			alpha *= getGlobalAlpha ();
+			cairo_rectangle (cr, -offset.x, -offset.y, dest.getWidth () + offset.x,
+			                 dest.getHeight () + offset.y);
 			if (alpha != 1.f)
 			{
 				cairo_paint_with_alpha (cr, alpha);
@@ -416,8 +424,118 @@ void Context::drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offs
 			{
 				cairo_fill (cr);
 			}
+		}
+	}
+	checkCairoStatus (cr);
+}
+
+//-----------------------------------------------------------------------------
+bool Context::drawBitmapPixelAligned (Bitmap& bitmap, const CRect& dest, const CPoint& offset)
+{
+	// an unscaled bitmap which is drawn on whole pixels is copied without a clip and without
+	// changing the state of the cairo context
+	const auto& t = getCurrentTransform ();
+	if (bitmap.getScaleFactor () != 1. || t.m11 != 1. || t.m22 != 1. || t.m12 != 0. ||
+	    t.m21 != 0.)
+		return false;
+	auto isIntegral = [] (const CRect& r) {
+		return r.left == std::floor (r.left) && r.top == std::floor (r.top) &&
+		       r.right == std::floor (r.right) && r.bottom == std::floor (r.bottom);
+	};
+	CRect r (dest);
+	t.transform (r);
+	CRect clip;
+	getClipRect (clip);
+	t.transform (clip);
+	clip.bound (getSurfaceRect ());
+	if (!isIntegral (r) || !isIntegral (clip) || offset.x != std::floor (offset.x) ||
+	    offset.y != std::floor (offset.y))
+		return false;
+
+	CPoint origin (r.left - offset.x, r.top - offset.y);
+	r.bound (clip);
+	r.bound (CRect (origin, bitmap.getSize ()));
+	if (r.isEmpty ())
+		return true;
+	const auto& pattern = bitmap.getPattern ();
+	if (!pattern)
+		return true;
+	cairo_matrix_t matrix;
+	cairo_matrix_init_translate (&matrix, -origin.x, -origin.y);
+	cairo_pattern_set_matrix (pattern, &matrix);
+	cairo_set_source (cr, pattern);
+	cairo_rectangle (cr, r.left, r.top, r.getWidth (), r.getHeight ());
+	cairo_fill (cr);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void Context::fillRectWithBitmap (CBitmap* bitmap, const CRect& srcRect, const CRect& dstRect,
+                                  float alpha)
+{
+	if (bitmap == nullptr || alpha == 0.f || srcRect.isEmpty () || dstRect.isEmpty ())
+		return;
+
+	double transformedScaleFactor = getScaleFactor ();
+	CGraphicsTransform t = getCurrentTransform ();
+	if (t.m11 == t.m22 && t.m12 == 0 && t.m21 == 0)
+		transformedScaleFactor *= t.m11;
+	auto cairoBitmap =
+		bitmap->getBestPlatformBitmapForScaleFactor (transformedScaleFactor).cast<Bitmap> ();
+	if (!cairoBitmap)
+		return;
 
-			cairo_pattern_destroy (pattern);
+	// the tile is a sub surface of the bitmap, which needs to be on whole pixels
+	auto bitmapScaleFactor = cairoBitmap->getScaleFactor ();
+	CRect tileRect (srcRect.left * bitmapScaleFactor, srcRect.top * bitmapScaleFactor,
+	                srcRect.right * bitmapScaleFactor, srcRect.bottom * bitmapScaleFactor);
+	const auto& bitmapSize = cairoBitmap->getSize ();
+	if (tileRect.left != std::floor (tileRect.left) || tileRect.top != std::floor (tileRect.top) ||
+	    tileRect.right != std::floor (tileRect.right) ||
+	    tileRect.bottom != std::floor (tileRect.bottom) || tileRect.left < 0. ||
+	    tileRect.top < 0. || tileRect.right > bitmapSize.x || tileRect.bottom > bitmapSize.y)
+	{
+		CDrawContext::fillRectWithBitmap (bitmap, srcRect, dstRect, alpha);
+		return;
+	}
+
+	if (auto cd = DrawBlock::begin (*this))
+	{
+		PatternHandle tilePattern;
+		cairo_pattern_t* pattern = nullptr;
+		if (tileRect == CRect (0., 0., bitmapSize.x, bitmapSize.y))
+		{
+			pattern = cairoBitmap->getPattern (CAIRO_FILTER_GOOD, CAIRO_EXTEND_REPEAT);
+		}
+		else
+		{
+			SurfaceHandle tile (cairo_surface_create_for_rectangle (
+				cairoBitmap->getSurface (), tileRect.left, tileRect.top, tileRect.getWidth (),
+				tileRect.getHeight ()));
+			tilePattern.assign (cairo_pattern_create_for_surface (tile));
+			cairo_pattern_set_extend (tilePattern, CAIRO_EXTEND_REPEAT);
+			pattern = tilePattern;
+		}
+		if (!pattern)
+			return;
+		// the tiles start at the top left of the destination, like the tiles drawn one by one in
+		// CDrawContext::fillRectWithBitmap
+		cairo_matrix_t matrix;
+		cairo_matrix_init_scale (&matrix, bitmapScaleFactor, bitmapScaleFactor);
+		cairo_matrix_translate (&matrix, -dstRect.left, -dstRect.top);
+		cairo_pattern_set_matrix (pattern, &matrix);
+		cairo_set_source (cr, pattern);
+
+		cairo_rectangle (cr, dstRect.left, dstRect.top, dstRect.getWidth (), dstRect.getHeight ());
+		alpha *= getGlobalAlpha ();
+		if (alpha != 1.f)
+		{
+			cairo_clip (cr);
+			cairo_paint_with_alpha (cr, alpha);
+		}
+		else
+		{
+			cairo_fill (cr);
 		}
 	}
 	checkCairoStatus (cr);
@@ -438,7 +556,7 @@ void Context::clearRect (const CRect& rect)
 //-----------------------------------------------------------------------------
 CGraphicsPath* Context::createGraphicsPath ()
 {
-	return new Path (cr);
+	return new Path ();
 }
 
 //-----------------------------------------------------------------------------
@@ -40,6 +40,8 @@ public:
 	void drawPoint (const CPoint& point, const CColor& color) override;
 	void drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset,
 	                 float alpha) override;
+	void fillRectWithBitmap (CBitmap* bitmap, const CRect& srcRect, const CRect& dstRect,
+	                         float alpha) override;
 	void clearRect (const CRect& rect) override;
 	CGraphicsPath* createGraphicsPath () override;
 	CGraphicsPath* createTextPath (const CFontRef font, UTF8StringPtr text) override;
@@ -60,6 +62,7 @@ public:
 
 private:
 	void init () override;
+	bool drawBitmapPixelAligned (Bitmap& bitmap, const CRect& dest, const CPoint& offset);
 	void setSourceColor (CColor color);
 	void setupCurrentStroke ();
 	void draw (CDrawStyle drawstyle);
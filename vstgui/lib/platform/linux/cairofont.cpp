@@ -5,13 +5,19 @@
 #include "cairofont.h"
 #include "../../../lib/cstring.h"
 #include "cairocontext.h"
+#include "cairotextlayout.h"
 #include "linuxstring.h"
 #include "x11frame.h"
 #include <cairo/cairo-ft.h>
 #include <fontconfig/fontconfig.h>
 #include <freetype2/ft2build.h>
-#include <unordered_map>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <unordered_map>
 
 #include FT_FREETYPE_H
 
@@ -89,6 +95,8 @@ struct CairoFontFace
 		return *this;
 	}
 
+	const std::string& getPath () const { return path; }
+
 	operator cairo_font_face_t* () const
 	{
 		if (!face && !path.empty ())
@@ -109,6 +117,13 @@ private:
 };
 
 //------------------------------------------------------------------------
+/** The family to style to file map of all fonts known to fontconfig
+ *
+ *	The map is built on first use and is written to a cache file in the user cache directory.
+ *	Later processes read the cache file as long as no fontconfig configuration file and no font
+ *	directory was modified after the cache was written, which skips loading the fontconfig font
+ *	caches and enumerating all fonts.
+ */
 class FontList
 {
 public:
@@ -128,26 +143,72 @@ public:
 	std::vector<std::string> fontFamilyNames ()
 	{
 		std::vector<std::string> result;
-		for (auto e : fonts)
+		for (auto& e : getFonts ())
 			result.push_back (e.first);
 		return result;
 	}
 
-	const Fonts& getFonts () const { return fonts; }
+	const Fonts& getFonts ()
+	{
+		if (!loaded)
+			load ();
+		return fonts;
+	}
 
-	void clear () { fonts.clear (); }
+	void clear ()
+	{
+		fonts.clear ();
+		loaded = false;
+	}
 
 private:
-	FontList ()
+	using StringList = std::vector<std::string>;
+
+	FontList () = default;
+	~FontList () {}
+
+	void load ()
 	{
+		loaded = true;
+		std::string appFontDir;
+		if (!X11::Frame::resourcePath.empty ())
+			appFontDir = X11::Frame::resourcePath + "Fonts/";
+		auto cachePath = getCachePath ();
+		if (!cachePath.empty () && readCache (cachePath, appFontDir))
+			return;
+
 		FcInit ();
 		auto config = FcInitLoadConfigAndFonts ();
-		if (!X11::Frame::resourcePath.empty ())
+		if (!appFontDir.empty ())
+			FcConfigAppFontAddDir (config, reinterpret_cast<const FcChar8*> (appFontDir.data ()));
+		StringList fontDirs;
+		enumerate (config, fontDirs);
+		if (!cachePath.empty ())
+		{
+			addFontDirs (FcConfigGetFontDirs (config), fontDirs);
+			if (!appFontDir.empty ())
+				fontDirs.emplace_back (appFontDir);
+			auto timestamp = getConfigTimestamp (config, fontDirs);
+			writeCache (cachePath, appFontDir, timestamp, fontDirs);
+		}
+		FcConfigDestroy (config);
+	}
+
+	void addFont (const std::string& family, const std::string& style, const std::string& file)
+	{
+		auto it = fonts.find (family);
+		if (it == fonts.end ())
 		{
-			auto fontDir = X11::Frame::resourcePath + "Fonts/";
-			FcConfigAppFontAddDir (config, reinterpret_cast<const FcChar8*> (fontDir.data ()));
+			FontFamily fam;
+			fam.styles.emplace (style, CairoFontFace {file});
+			fonts.emplace (family, std::move (fam));
 		}
+		else
+			it->second.styles.emplace (style, CairoFontFace {file});
+	}
 
+	void enumerate (FcConfig* config, StringList& fontDirs)
+	{
 		auto pattern = FcPatternCreate ();
 		auto objectSet = FcObjectSetBuild (FC_FAMILY, FC_FILE, FC_STYLE, nullptr);
 		auto fontList = FcFontList (config, pattern, objectSet);
@@ -161,29 +222,181 @@ private:
 				FcPatternGetString (font, FC_FILE, 0, &file) == FcResultMatch &&
 				FcPatternGetString (font, FC_STYLE, 0, &style) == FcResultMatch)
 			{
-				std::string familyStr (reinterpret_cast<const char*> (family));
 				std::string fileStr (reinterpret_cast<const char*> (file));
-				std::string styleStr (reinterpret_cast<const char*> (style));
-				auto it = fonts.find (familyStr);
-				if (it == fonts.end ())
-				{
-					FontFamily fam;
-					fam.styles.emplace (styleStr, CairoFontFace {fileStr});
-					fonts.emplace (familyStr, std::move (fam));
-				}
-				else
-					it->second.styles.emplace (styleStr, CairoFontFace {fileStr});
+				addFont (reinterpret_cast<const char*> (family),
+						 reinterpret_cast<const char*> (style), fileStr);
+				addFontDir (fileStr.substr (0, fileStr.find_last_of ('/')), fontDirs);
 			}
 		}
 		FcFontSetDestroy (fontList);
 		FcObjectSetDestroy (objectSet);
 		FcPatternDestroy (pattern);
+	}
+
+	static std::string getCachePath ()
+	{
+		std::string cacheDir;
+		if (auto xdgCacheHome = getenv ("XDG_CACHE_HOME"))
+			cacheDir = xdgCacheHome;
+		else if (auto home = getenv ("HOME"))
+			cacheDir = std::string (home) + "/.cache";
+		if (cacheDir.empty ())
+			return {};
+		mkdir (cacheDir.data (), 0755);
+		cacheDir += "/vstgui";
+		mkdir (cacheDir.data (), 0755);
+		return cacheDir + "/fontlist-" + std::to_string (kCacheVersion) + ".cache";
+	}
+
+	static time_t getModificationTime (const char* path)
+	{
+		struct stat info;
+		if (stat (path, &info) == 0)
+			return info.st_mtime;
+		return 0;
+	}
+
+	static void addFontDir (std::string&& dir, StringList& fontDirs)
+	{
+		if (std::find (fontDirs.begin (), fontDirs.end (), dir) == fontDirs.end ())
+			fontDirs.emplace_back (std::move (dir));
+	}
+
+	static void addFontDirs (FcStrList* list, StringList& fontDirs)
+	{
+		while (auto path = FcStrListNext (list))
+			addFontDir (reinterpret_cast<const char*> (path), fontDirs);
+		FcStrListDone (list);
+	}
+
+	/** the newest modification time of the fontconfig configuration files and the font
+	 *	directories */
+	static time_t getConfigTimestamp (FcConfig* config, const StringList& fontDirs)
+	{
+		time_t result = 0;
+		auto configFiles = FcConfigGetConfigFiles (config);
+		while (auto path = FcStrListNext (configFiles))
+			result = std::max (result, getModificationTime (reinterpret_cast<const char*> (path)));
+		FcStrListDone (configFiles);
+		for (const auto& dir : fontDirs)
+			result = std::max (result, getModificationTime (dir.data ()));
+		return result;
+	}
+
+	// file format: a header line with the version, the timestamp and the app font dir, a line
+	// with the number of font directories followed by the directories and then one line per font
+	// with family, style and file separated by tabs
+	bool readCache (const std::string& path, const std::string& appFontDir)
+	{
+		std::ifstream stream (path);
+		if (!stream)
+			return false;
+		std::string line;
+		if (!std::getline (stream, line))
+			return false;
+		auto header = split (line);
+		if (header.size () != 3 || header[0] != std::to_string (kCacheVersion) ||
+			header[2] != appFontDir)
+			return false;
+		auto timestamp = static_cast<time_t> (std::strtoll (header[1].data (), nullptr, 10));
+		if (!std::getline (stream, line))
+			return false;
+		// the count is not trusted, the list only grows with the directories which are read and a
+		// count which is not a number or exceeds the limit makes the cache invalid
+		char* countEnd = nullptr;
+		auto numFontDirs = std::strtoul (line.data (), &countEnd, 10);
+		if (countEnd == line.data () || *countEnd != 0 || numFontDirs > kMaxCachedFontDirs)
+			return false;
+		StringList fontDirs;
+		for (auto i = 0ul; i < numFontDirs; ++i)
+		{
+			if (!std::getline (stream, line))
+				return false;
+			fontDirs.emplace_back (std::move (line));
+		}
+
+		// only the configuration is loaded, the font caches of fontconfig are not needed
+		auto config = FcInitLoadConfig ();
+		auto upToDate = getConfigTimestamp (config, fontDirs) == timestamp;
 		FcConfigDestroy (config);
+		if (!upToDate)
+			return false;
+
+		while (std::getline (stream, line))
+		{
+			auto entry = split (line);
+			if (entry.size () != 3)
+			{
+				fonts.clear ();
+				return false;
+			}
+			addFont (entry[0], entry[1], entry[2]);
+		}
+		return !fonts.empty ();
 	}
 
-	~FontList () {}
+	void writeCache (const std::string& path, const std::string& appFontDir, time_t timestamp,
+					 const StringList& fontDirs) const
+	{
+		if (fontDirs.size () > kMaxCachedFontDirs)
+			return;
+		// write to a temporary file first, so that other processes never read a partial file
+		auto tmpPath = path + "." + std::to_string (getpid ());
+		{
+			std::ofstream stream (tmpPath, std::ios::trunc);
+			if (!stream)
+				return;
+			stream << kCacheVersion << '\t' << timestamp << '\t' << appFontDir << '\n';
+			stream << fontDirs.size () << '\n';
+			for (const auto& dir : fontDirs)
+				stream << dir << '\n';
+			for (const auto& family : fonts)
+			{
+				for (const auto& style : family.second.styles)
+				{
+					const auto& file = style.second.getPath ();
+					if (!isValidCacheField (family.first) || !isValidCacheField (style.first) ||
+						!isValidCacheField (file))
+						continue;
+					stream << family.first << '\t' << style.first << '\t' << file << '\n';
+				}
+			}
+			if (!stream)
+			{
+				stream.close ();
+				unlink (tmpPath.data ());
+				return;
+			}
+		}
+		if (rename (tmpPath.data (), path.data ()) != 0)
+			unlink (tmpPath.data ());
+	}
+
+	static bool isValidCacheField (const std::string& str)
+	{
+		return str.find_first_of ("\t\n") == std::string::npos;
+	}
+
+	static StringList split (const std::string& line)
+	{
+		StringList result;
+		std::string::size_type start = 0;
+		while (true)
+		{
+			auto pos = line.find ('\t', start);
+			result.emplace_back (line.substr (start, pos - start));
+			if (pos == std::string::npos)
+				break;
+			start = pos + 1;
+		}
+		return result;
+	}
+
+	static constexpr uint32_t kCacheVersion = 1;
+	static constexpr size_t kMaxCachedFontDirs = 4096;
 
 	Fonts fonts;
+	bool loaded {false};
 };
 
 //------------------------------------------------------------------------
@@ -345,9 +558,14 @@ void Font::drawString (CDrawContext* context, IPlatformString* string, const CPo
 				auto alpha = color.normAlpha<double> () * cairoContext->getGlobalAlpha ();
 				cairo_set_source_rgba (cr, color.normRed<double> (), color.normGreen<double> (),
 				                       color.normBlue<double> (), alpha);
-				cairo_move_to (cr, p.x, p.y);
+				const auto& layout =
+					TextLayoutCache::instance ().get (impl->font, linuxString->get ());
+				if (layout.glyphs.empty ())
+					return;
 				cairo_set_scaled_font (cr, impl->font);
-				cairo_show_text (cr, linuxString->get ().data ());
+				cairo_translate (cr, p.x, p.y);
+				cairo_show_glyphs (cr, layout.glyphs.data (),
+								   static_cast<int> (layout.glyphs.size ()));
 			}
 		}
 	}
@@ -355,14 +573,25 @@ void Font::drawString (CDrawContext* context, IPlatformString* string, const CPo
 
 //------------------------------------------------------------------------
 CCoord Font::getStringWidth (CDrawContext* context, IPlatformString* string, bool antialias) const
+{
+	if (auto linuxString = dynamic_cast<LinuxString*> (string))
+		return TextLayoutCache::instance ().get (impl->font, linuxString->get ()).width;
+	return 0;
+}
+
+//------------------------------------------------------------------------
+bool Font::getCharAdvances (IPlatformString* string, CCoord* advances, size_t numChars) const
 {
 	if (auto linuxString = dynamic_cast<LinuxString*> (string))
 	{
-		cairo_text_extents_t e;
-		cairo_scaled_font_text_extents (impl->font, linuxString->get ().data (), &e);
-		return e.x_advance;
+		const auto& charAdvances =
+			TextLayoutCache::instance ().get (impl->font, linuxString->get ()).charAdvances;
+		if (charAdvances.size () != numChars)
+			return false;
+		std::copy (charAdvances.begin (), charAdvances.end (), advances);
+		return true;
 	}
-	return 0;
+	return false;
 }
 
 //------------------------------------------------------------------------
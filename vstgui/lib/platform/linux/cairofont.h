@@ -12,7 +12,7 @@ namespace VSTGUI {
 namespace Cairo {
 
 //------------------------------------------------------------------------
-class Font : public IPlatformFont, public IFontPainter
+class Font : public IPlatformFont, public IFontPainter, public IFontPainterCharAdvancesExtension
 {
 public:
 	Font (UTF8StringPtr name, const CCoord& size, const int32_t& style);
@@ -30,6 +30,7 @@ public:
 					 bool antialias = true) const override;
 	CCoord getStringWidth (CDrawContext* context, IPlatformString* string,
 						   bool antialias = true) const override;
+	bool getCharAdvances (IPlatformString* string, CCoord* advances, size_t numChars) const override;
 
 private:
 	struct Impl;
@@ -12,10 +12,20 @@ namespace VSTGUI {
 namespace Cairo {
 
 //------------------------------------------------------------------------
-Path::Path (const ContextHandle& cr) noexcept : cr (cr)
+namespace {
+
+//------------------------------------------------------------------------
+/** a context to query the path outside of drawing, the path does not hold on to the context it
+ *	was created from, as that would keep the surface of the context alive as long as the path */
+ContextHandle createQueryContext ()
 {
+	SurfaceHandle surface (cairo_image_surface_create (CAIRO_FORMAT_A8, 1, 1));
+	return ContextHandle (cairo_create (surface));
 }
 
+//------------------------------------------------------------------------
+} // anonymous
+
 //------------------------------------------------------------------------
 Path::~Path () noexcept
 {
@@ -43,6 +53,7 @@ bool Path::hitTest (const CPoint& p, bool evenOddFilled, CGraphicsTransform* tra
 CPoint Path::getCurrentPosition ()
 {
 	CPoint p;
+	auto cr = createQueryContext ();
 	if (auto cPath = getPath (cr))
 	{
 		cairo_save (cr);
@@ -58,6 +69,7 @@ CPoint Path::getCurrentPosition ()
 CRect Path::getBoundingBox ()
 {
 	CRect r;
+	auto cr = createQueryContext ();
 	if (auto cPath = getPath (cr))
 	{
 		cairo_save (cr);
@@ -80,118 +92,137 @@ void Path::dirty ()
 		cairo_path_destroy (path);
 		path = nullptr;
 	}
+	if (alignedPath)
+	{
+		cairo_path_destroy (alignedPath);
+		alignedPath = nullptr;
+	}
 }
 
 //------------------------------------------------------------------------
 cairo_path_t* Path::getPath (const ContextHandle& handle, const CGraphicsTransform* alignTm)
 {
 	if (alignTm)
-		dirty ();
+	{
+		if (!alignedPath || !(*alignTm == alignTransform))
+		{
+			if (alignedPath)
+				cairo_path_destroy (alignedPath);
+			alignedPath = buildPath (handle, alignTm);
+			alignTransform = *alignTm;
+		}
+		return alignedPath;
+	}
 	if (!path)
+		path = buildPath (handle, nullptr);
+	return path;
+}
+
+//------------------------------------------------------------------------
+cairo_path_t* Path::buildPath (const ContextHandle& handle, const CGraphicsTransform* alignTm)
+{
+	cairo_new_path (handle);
+	for (auto& e : elements)
 	{
-		cairo_new_path (handle);
-		for (auto& e : elements)
+		switch (e.type)
 		{
-			switch (e.type)
+			case Element::Type::kBeginSubpath:
 			{
-				case Element::Type::kBeginSubpath:
+				cairo_new_sub_path (handle);
+				if (alignTm)
 				{
-					cairo_new_sub_path (handle);
-					if (alignTm)
-					{
-						auto p = pixelAlign (*alignTm,
-											 CPoint {e.instruction.point.x, e.instruction.point.y});
-						cairo_move_to (handle, p.x - 0.5, p.y - 0.5);
-					}
-					else
-						cairo_move_to (handle, e.instruction.point.x, e.instruction.point.y);
-					break;
+					auto p = pixelAlign (*alignTm,
+										 CPoint {e.instruction.point.x, e.instruction.point.y});
+					cairo_move_to (handle, p.x - 0.5, p.y - 0.5);
 				}
-				case Element::Type::kCloseSubpath:
+				else
+					cairo_move_to (handle, e.instruction.point.x, e.instruction.point.y);
+				break;
+			}
+			case Element::Type::kCloseSubpath:
+			{
+				cairo_close_path (handle);
+				break;
+			}
+			case Element::Type::kLine:
+			{
+				if (alignTm)
 				{
-					cairo_close_path (handle);
-					break;
+					auto p = pixelAlign (*alignTm,
+										 CPoint {e.instruction.point.x, e.instruction.point.y});
+					cairo_line_to (handle, p.x - 0.5, p.y - 0.5);
 				}
-				case Element::Type::kLine:
+				else
+					cairo_line_to (handle, e.instruction.point.x, e.instruction.point.y);
+				break;
+			}
+			case Element::Type::kBezierCurve:
+			{
+				cairo_curve_to (handle, e.instruction.curve.control1.x,
+								e.instruction.curve.control1.y, e.instruction.curve.control2.x,
+								e.instruction.curve.control2.y, e.instruction.curve.end.x,
+								e.instruction.curve.end.y);
+				break;
+			}
+			case Element::Type::kRect:
+			{
+				if (alignTm)
 				{
-					if (alignTm)
-					{
-						auto p = pixelAlign (*alignTm,
-											 CPoint {e.instruction.point.x, e.instruction.point.y});
-						cairo_line_to (handle, p.x - 0.5, p.y - 0.5);
-					}
-					else
-						cairo_line_to (handle, e.instruction.point.x, e.instruction.point.y);
-					break;
+					auto r = pixelAlign (
+						*alignTm, CRect {e.instruction.rect.left, e.instruction.rect.top,
+										 e.instruction.rect.right, e.instruction.rect.bottom});
+					cairo_rectangle (handle, r.left - 0.5, r.top - 0.5, r.getWidth (),
+									 r.getHeight ());
 				}
-				case Element::Type::kBezierCurve:
+				else
 				{
-					cairo_curve_to (handle, e.instruction.curve.control1.x,
-									e.instruction.curve.control1.y, e.instruction.curve.control2.x,
-									e.instruction.curve.control2.y, e.instruction.curve.end.x,
-									e.instruction.curve.end.y);
-					break;
+					cairo_rectangle (handle, e.instruction.rect.left, e.instruction.rect.top,
+									 e.instruction.rect.right - e.instruction.rect.left,
+									 e.instruction.rect.bottom - e.instruction.rect.top);
 				}
-				case Element::Type::kRect:
+				break;
+			}
+			case Element::Type::kEllipse: {
+#warning TODO: Implementation Element::Type::kEllipse
+				break;
+			}
+			case Element::Type::kArc:
+			{
+				auto radiusX =
+					(e.instruction.arc.rect.right - e.instruction.arc.rect.left) / 2.;
+				auto radiusY =
+					(e.instruction.arc.rect.bottom - e.instruction.arc.rect.top) / 2.;
+
+				auto centerX = static_cast<double> (e.instruction.arc.rect.left + radiusX);
+				auto centerY = static_cast<double> (e.instruction.arc.rect.top + radiusY);
+
+				double startAngle = radians (e.instruction.arc.startAngle);
+				double endAngle = radians (e.instruction.arc.endAngle);
+				if (radiusX != radiusY)
 				{
-					if (alignTm)
-					{
-						auto r = pixelAlign (
-							*alignTm, CRect {e.instruction.rect.left, e.instruction.rect.top,
-											 e.instruction.rect.right, e.instruction.rect.bottom});
-						cairo_rectangle (handle, r.left - 0.5, r.top - 0.5, r.getWidth (),
-										 r.getHeight ());
-					}
-					else
-					{
-						cairo_rectangle (handle, e.instruction.rect.left, e.instruction.rect.top,
-										 e.instruction.rect.right - e.instruction.rect.left,
-										 e.instruction.rect.bottom - e.instruction.rect.top);
-					}
-					break;
+					startAngle = atan2 (sin (startAngle) * radiusX, cos (startAngle) * radiusY);
+					endAngle = atan2 (sin (endAngle) * radiusX, cos (endAngle) * radiusY);
 				}
-				case Element::Type::kEllipse: {
-#warning TODO: Implementation Element::Type::kEllipse
-					break;
+				cairo_matrix_t matrix;
+				cairo_get_matrix (handle, &matrix);
+				cairo_translate (handle, centerX, centerY);
+				cairo_scale (handle, radiusX, radiusY);
+				if (e.instruction.arc.clockwise)
+				{
+					cairo_arc (handle, 0, 0, 1, startAngle, endAngle);
 				}
-				case Element::Type::kArc:
+				else
 				{
-					auto radiusX =
-						(e.instruction.arc.rect.right - e.instruction.arc.rect.left) / 2.;
-					auto radiusY =
-						(e.instruction.arc.rect.bottom - e.instruction.arc.rect.top) / 2.;
-
-					auto centerX = static_cast<double> (e.instruction.arc.rect.left + radiusX);
-					auto centerY = static_cast<double> (e.instruction.arc.rect.top + radiusY);
-
-					double startAngle = radians (e.instruction.arc.startAngle);
-					double endAngle = radians (e.instruction.arc.endAngle);
-					if (radiusX != radiusY)
-					{
-						startAngle = atan2 (sin (startAngle) * radiusX, cos (startAngle) * radiusY);
-						endAngle = atan2 (sin (endAngle) * radiusX, cos (endAngle) * radiusY);
-					}
-					cairo_matrix_t matrix;
-					cairo_get_matrix (handle, &matrix);
-					cairo_translate (handle, centerX, centerY);
-					cairo_scale (handle, radiusX, radiusY);
-					if (e.instruction.arc.clockwise)
-					{
-						cairo_arc (handle, 0, 0, 1, startAngle, endAngle);
-					}
-					else
-					{
-						cairo_arc_negative (handle, 0, 0, 1, startAngle, endAngle);
-					}
-					cairo_set_matrix (handle, &matrix);
-					break;
+					cairo_arc_negative (handle, 0, 0, 1, startAngle, endAngle);
 				}
+				cairo_set_matrix (handle, &matrix);
+				break;
 			}
 		}
-		path = cairo_copy_path (handle);
-		cairo_new_path (handle); // clear path
 	}
-	return path;
+	auto result = cairo_copy_path (handle);
+	cairo_new_path (handle); // clear path
+	return result;
 }
 
 //------------------------------------------------------------------------
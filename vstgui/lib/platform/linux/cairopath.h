@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../../cgraphicspath.h"
+#include "../../cgraphicstransform.h"
 #include "cairoutils.h"
 
 //------------------------------------------------------------------------
@@ -15,7 +16,6 @@ namespace Cairo {
 class Path : public CGraphicsPath
 {
 public:
-	Path (const ContextHandle& cr) noexcept;
 	~Path () noexcept;
 
 	cairo_path_t* getPath (const ContextHandle& handle,
@@ -33,8 +33,12 @@ public:
 
 //------------------------------------------------------------------------
 private:
-	ContextHandle cr;
+	cairo_path_t* buildPath (const ContextHandle& handle, const CGraphicsTransform* alignTm);
+
 	cairo_path_t* path {nullptr};
+	/** pixel aligned path, kept as long as the path is drawn with the same transform */
+	cairo_path_t* alignedPath {nullptr};
+	CGraphicsTransform alignTransform;
 };
 
 //------------------------------------------------------------------------
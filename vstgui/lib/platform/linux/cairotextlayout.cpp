@@ -0,0 +1,231 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cairotextlayout.h"
+#include <cstring>
+
+#if VSTGUI_HARFBUZZ_SUPPORT
+#include <cairo/cairo-ft.h>
+#include <hb-ft.h>
+#include <hb.h>
+#endif
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+namespace {
+
+//------------------------------------------------------------------------
+inline bool isUTF8LeadByte (char c)
+{
+	return (static_cast<uint8_t> (c) & 0xC0) != 0x80;
+}
+
+//------------------------------------------------------------------------
+/** adds the advance of each glyph to the character its cluster starts with */
+struct CharAdvanceBuilder
+{
+	CharAdvanceBuilder (TextLayout& layout, const std::string& text) : layout (layout)
+	{
+		charIndex.resize (text.size ());
+		size_t index = 0;
+		for (size_t i = 0; i < text.size (); ++i)
+		{
+			if (i > 0 && isUTF8LeadByte (text[i]))
+				++index;
+			charIndex[i] = index;
+		}
+		layout.charAdvances.assign (text.empty () ? 0 : index + 1, 0.);
+	}
+
+	void add (size_t byteOffset, CCoord advance)
+	{
+		if (byteOffset < charIndex.size ())
+			layout.charAdvances[charIndex[byteOffset]] += advance;
+	}
+
+private:
+	TextLayout& layout;
+	std::vector<size_t> charIndex;
+};
+
+#if VSTGUI_HARFBUZZ_SUPPORT
+//------------------------------------------------------------------------
+bool shape (TextLayout& layout, cairo_scaled_font_t* font, const std::string& text)
+{
+	auto face = cairo_ft_scaled_font_lock_face (font);
+	if (!face)
+		return false;
+	// the face is locked with the size of the scaled font, so the positions are in pixels * 64
+	auto hbFont = hb_ft_font_create_referenced (face);
+	auto buffer = hb_buffer_create ();
+	hb_buffer_add_utf8 (buffer, text.data (), static_cast<int> (text.size ()), 0,
+						static_cast<int> (text.size ()));
+	hb_buffer_guess_segment_properties (buffer);
+	hb_shape (hbFont, buffer, nullptr, 0);
+
+	unsigned int numGlyphs = 0;
+	auto infos = hb_buffer_get_glyph_infos (buffer, &numGlyphs);
+	auto positions = hb_buffer_get_glyph_positions (buffer, &numGlyphs);
+	CharAdvanceBuilder advances (layout, text);
+	layout.glyphs.resize (numGlyphs);
+	CCoord x = 0.;
+	CCoord y = 0.;
+	for (auto i = 0u; i < numGlyphs; ++i)
+	{
+		auto& glyph = layout.glyphs[i];
+		glyph.index = infos[i].codepoint;
+		glyph.x = x + positions[i].x_offset / 64.;
+		glyph.y = y - positions[i].y_offset / 64.;
+		auto advance = positions[i].x_advance / 64.;
+		advances.add (infos[i].cluster, advance);
+		x += advance;
+		y -= positions[i].y_advance / 64.;
+	}
+	layout.width = x;
+
+	hb_buffer_destroy (buffer);
+	hb_font_destroy (hbFont);
+	cairo_ft_scaled_font_unlock_face (font);
+	return true;
+}
+#endif
+
+//------------------------------------------------------------------------
+void convert (TextLayout& layout, cairo_scaled_font_t* font, const std::string& text)
+{
+	cairo_glyph_t* glyphs = nullptr;
+	int numGlyphs = 0;
+	cairo_text_cluster_t* clusters = nullptr;
+	int numClusters = 0;
+	cairo_text_cluster_flags_t clusterFlags;
+	if (cairo_scaled_font_text_to_glyphs (font, 0., 0., text.data (),
+										  static_cast<int> (text.size ()), &glyphs, &numGlyphs,
+										  &clusters, &numClusters,
+										  &clusterFlags) != CAIRO_STATUS_SUCCESS)
+		return;
+
+	layout.glyphs.assign (glyphs, glyphs + numGlyphs);
+	if (numGlyphs > 0)
+	{
+		cairo_text_extents_t extents;
+		cairo_scaled_font_glyph_extents (font, glyphs, numGlyphs, &extents);
+		layout.width = extents.x_advance;
+	}
+
+	CharAdvanceBuilder advances (layout, text);
+	size_t byteOffset = 0;
+	int glyphIndex = 0;
+	for (auto i = 0; i < numClusters; ++i)
+	{
+		for (auto j = 0; j < clusters[i].num_glyphs; ++j, ++glyphIndex)
+		{
+			auto nextX = glyphIndex + 1 < numGlyphs ? glyphs[glyphIndex + 1].x : layout.width;
+			advances.add (byteOffset, nextX - glyphs[glyphIndex].x);
+		}
+		byteOffset += clusters[i].num_bytes;
+	}
+
+	cairo_glyph_free (glyphs);
+	cairo_text_cluster_free (clusters);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+void TextLayout::create (TextLayout& layout, cairo_scaled_font_t* font, const std::string& text)
+{
+	layout.glyphs.clear ();
+	layout.charAdvances.clear ();
+	layout.width = 0.;
+	if (!font || text.empty ())
+		return;
+#if VSTGUI_HARFBUZZ_SUPPORT
+	if (shape (layout, font, text))
+		return;
+#endif
+	convert (layout, font, text);
+}
+
+//------------------------------------------------------------------------
+constexpr size_t TextLayoutCache::kDefaultCapacity;
+
+//------------------------------------------------------------------------
+bool TextLayoutCache::Key::operator== (const Key& other) const
+{
+	return font == other.font && length == other.length &&
+		   std::memcmp (text, other.text, length) == 0;
+}
+
+//------------------------------------------------------------------------
+size_t TextLayoutCache::KeyHash::operator() (const Key& key) const
+{
+	// FNV-1a
+	size_t hash = 2166136261u;
+	for (size_t i = 0; i < key.length; ++i)
+		hash = (hash ^ static_cast<uint8_t> (key.text[i])) * 16777619u;
+	return hash ^ std::hash<cairo_scaled_font_t*> () (key.font);
+}
+
+//------------------------------------------------------------------------
+TextLayoutCache& TextLayoutCache::instance ()
+{
+	static TextLayoutCache gInstance;
+	return gInstance;
+}
+
+//------------------------------------------------------------------------
+const TextLayout& TextLayoutCache::get (const ScaledFontHandle& font, const std::string& text)
+{
+	Key key {font, text.data (), text.size ()};
+	auto it = map.find (key);
+	if (it != map.end ())
+	{
+		entries.splice (entries.begin (), entries, it->second);
+		return it->second->layout;
+	}
+	if (capacity == 0)
+	{
+		TextLayout::create (uncachedLayout, font, text);
+		return uncachedLayout;
+	}
+	evict (capacity - 1);
+	entries.emplace_front ();
+	auto& entry = entries.front ();
+	entry.font = font;
+	entry.text = text;
+	TextLayout::create (entry.layout, font, text);
+	map.emplace (Key {entry.font, entry.text.data (), entry.text.size ()}, entries.begin ());
+	return entry.layout;
+}
+
+//------------------------------------------------------------------------
+void TextLayoutCache::setCapacity (size_t numLayouts)
+{
+	capacity = numLayouts;
+	evict (capacity);
+}
+
+//------------------------------------------------------------------------
+void TextLayoutCache::clear ()
+{
+	map.clear ();
+	entries.clear ();
+}
+
+//------------------------------------------------------------------------
+void TextLayoutCache::evict (size_t maxEntries)
+{
+	while (entries.size () > maxEntries)
+	{
+		const auto& entry = entries.back ();
+		map.erase (Key {entry.font, entry.text.data (), entry.text.size ()});
+		entries.pop_back ();
+	}
+}
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
@@ -0,0 +1,98 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../vstguifwd.h"
+#include "cairoutils.h"
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef VSTGUI_HARFBUZZ_SUPPORT
+#define VSTGUI_HARFBUZZ_SUPPORT 0
+#endif
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+
+//------------------------------------------------------------------------
+/** A string converted to glyphs of a scaled font
+ *
+ *	The glyphs are positioned relative to the origin of the text run. When HarfBuzz is available
+ *	the string is shaped, otherwise the glyphs are mapped one by one like cairo_show_text does.
+ */
+struct TextLayout
+{
+	using GlyphList = std::vector<cairo_glyph_t>;
+	using AdvanceList = std::vector<CCoord>;
+
+	GlyphList glyphs;
+	/** advance of each UTF-8 character, characters which share a glyph cluster with the previous
+	 *	character have an advance of zero */
+	AdvanceList charAdvances;
+	CCoord width {0.};
+
+	static void create (TextLayout& layout, cairo_scaled_font_t* font, const std::string& text);
+};
+
+//------------------------------------------------------------------------
+/** LRU cache of text layouts keyed by scaled font and string
+ *
+ *	cairo hands out the same scaled font for the same font face, size and options, so labels
+ *	sharing a font description share the cache entries. Lookups of cached strings do not allocate.
+ */
+class TextLayoutCache
+{
+public:
+	static constexpr size_t kDefaultCapacity = 2048;
+
+	static TextLayoutCache& instance ();
+
+	/** returns the layout of the string. The reference is valid until the next call to get. */
+	const TextLayout& get (const ScaledFontHandle& font, const std::string& text);
+
+	void setCapacity (size_t numLayouts);
+	size_t getCapacity () const { return capacity; }
+	size_t size () const { return entries.size (); }
+	void clear ();
+
+private:
+	struct Entry
+	{
+		ScaledFontHandle font;
+		std::string text;
+		TextLayout layout;
+	};
+	using EntryList = std::list<Entry>;
+
+	struct Key
+	{
+		cairo_scaled_font_t* font;
+		const char* text;
+		size_t length;
+
+		bool operator== (const Key& other) const;
+	};
+	struct KeyHash
+	{
+		size_t operator() (const Key& key) const;
+	};
+	using EntryMap = std::unordered_map<Key, EntryList::iterator, KeyHash>;
+
+	TextLayoutCache () = default;
+
+	void evict (size_t maxEntries);
+
+	EntryList entries;
+	EntryMap map;
+	TextLayout uncachedLayout;
+	size_t capacity {kDefaultCapacity};
+};
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
@@ -0,0 +1,159 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cairoviewlayer.h"
+#include "../../cbitmap.h"
+#include "cairobitmap.h"
+#include <cmath>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+
+//------------------------------------------------------------------------
+ViewLayer::ViewLayer (IPlatformViewLayerDelegate* drawDelegate, ViewLayer* parent,
+					  double scaleFactor, InvalidFunc&& invalidFunc)
+: drawDelegate (drawDelegate)
+, parent (parent)
+, invalidFunc (std::move (invalidFunc))
+, scaleFactor (scaleFactor)
+{
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::invalidRect (const CRect& rect)
+{
+	CRect r (rect);
+	r.bound (CRect (0., 0., size.getWidth (), size.getHeight ()));
+	if (r.isEmpty ())
+		return;
+	// without a cache everything is drawn when it is created
+	if (context)
+		dirtyRects.add (r);
+	invalidParent (r.offset (size.left, size.top));
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::invalidParent (const CRect& rect)
+{
+	if (parent)
+		parent->invalidRect (rect);
+	else if (invalidFunc)
+		invalidFunc (rect);
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::setSize (const CRect& newSize)
+{
+	if (newSize == size)
+		return;
+	invalidParent (size);
+	if (newSize.getWidth () != size.getWidth () || newSize.getHeight () != size.getHeight ())
+		releaseCache ();
+	size = newSize;
+	invalidParent (size);
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::setZIndex (uint32_t newZIndex)
+{
+	zIndex = newZIndex;
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::setAlpha (float newAlpha)
+{
+	if (newAlpha == alpha)
+		return;
+	// the alpha value is applied by the global alpha of the context the layer is composited into,
+	// so only the composition needs to be updated
+	alpha = newAlpha;
+	invalidParent (size);
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::onScaleFactorChanged (double newScaleFactor)
+{
+	if (newScaleFactor == scaleFactor)
+		return;
+	scaleFactor = newScaleFactor;
+	releaseCache ();
+	invalidParent (size);
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::releaseCache ()
+{
+	context = nullptr;
+	bitmap = nullptr;
+	dirtyRects.clear ();
+}
+
+//------------------------------------------------------------------------
+bool ViewLayer::updateCache ()
+{
+	if (!context)
+	{
+		CPoint pixelSize (std::ceil (size.getWidth () * scaleFactor),
+						  std::ceil (size.getHeight () * scaleFactor));
+		if (pixelSize.x < 1. || pixelSize.y < 1.)
+			return false;
+		auto platformBitmap = makeOwned<Bitmap> (&pixelSize);
+		platformBitmap->setScaleFactor (scaleFactor);
+		auto cacheContext = makeOwned<Context> (CRect (0., 0., pixelSize.x, pixelSize.y),
+												platformBitmap->getSurface ());
+		if (!cacheContext->valid ())
+			return false;
+		context = cacheContext;
+		bitmap = makeOwned<CBitmap> (platformBitmap);
+		dirtyRects.clear ();
+		dirtyRects.add (CRect (0., 0., size.getWidth (), size.getHeight ()));
+	}
+	if (dirtyRects.empty ())
+		return true;
+
+	context->beginDraw ();
+	{
+		CDrawContext::Transform transform (
+			*context, CGraphicsTransform ().scale (scaleFactor, scaleFactor));
+		for (auto rect : dirtyRects)
+		{
+			// extend the rect to whole pixels of the cache, otherwise the cleared edges are not
+			// completely drawn again
+			rect.left = std::floor (rect.left * scaleFactor) / scaleFactor;
+			rect.top = std::floor (rect.top * scaleFactor) / scaleFactor;
+			rect.right = std::ceil (rect.right * scaleFactor) / scaleFactor;
+			rect.bottom = std::ceil (rect.bottom * scaleFactor) / scaleFactor;
+			context->setClipRect (rect);
+			context->saveGlobalState ();
+			context->clearRect (rect);
+			drawDelegate->drawViewLayer (context, rect);
+			context->restoreGlobalState ();
+		}
+	}
+	context->endDraw ();
+	dirtyRects.clear ();
+	return true;
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::draw (CDrawContext* drawContext, const CRect& updateRect)
+{
+	if (!updateCache ())
+		return;
+
+	// draw in the coordinates of the platform parent. The parent layer draws into its cache with a
+	// scale transform for its scale factor, the frame without any transform. The update rect is
+	// already part of the clip of the context.
+	auto transform = drawContext->getCurrentTransform ().inverse ();
+	if (parent)
+		transform = transform * CGraphicsTransform ().scale (parent->getScaleFactor (),
+															 parent->getScaleFactor ());
+	CDrawContext::Transform parentTransform (*drawContext, transform);
+	drawContext->drawBitmap (bitmap, size, CPoint (0., 0.), 1.f);
+}
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
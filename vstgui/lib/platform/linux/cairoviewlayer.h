@@ -0,0 +1,71 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../cinvalidrectlist.h"
+#include "../iplatformviewlayer.h"
+#include "cairocontext.h"
+#include <functional>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+
+//------------------------------------------------------------------------
+/** View layer which caches the drawing of its delegate in an image surface
+ *
+ *	The delegate is only asked to draw the parts of the layer which were invalidated via
+ *	invalidRect (or all of it after a size or scale factor change). When the frame or the parent
+ *	layer draws over the layer, the cache is composited with the current transform and global
+ *	alpha of the draw context, so the content of the layer is not rasterized again.
+ *
+ *	The size of the layer and all invalidations it forwards are in the coordinates of the platform
+ *	parent: the cache of the parent layer or, for top level layers, the frame, which is notified
+ *	via the invalid function. As the layers are composited while the view hierarchy is drawn, they
+ *	are stacked in view order and the z index has no effect.
+ */
+class ViewLayer : public IPlatformViewLayer
+{
+public:
+	using InvalidFunc = std::function<void (const CRect& rect)>;
+
+	/** scaleFactor is the current scale factor of the frame, later changes are passed via
+	 *	onScaleFactorChanged */
+	ViewLayer (IPlatformViewLayerDelegate* drawDelegate, ViewLayer* parent, double scaleFactor,
+			   InvalidFunc&& invalidFunc);
+	~ViewLayer () noexcept override = default;
+
+	void invalidRect (const CRect& size) override;
+	void setSize (const CRect& size) override;
+	void setZIndex (uint32_t zIndex) override;
+	void setAlpha (float alpha) override;
+	void draw (CDrawContext* context, const CRect& updateRect) override;
+	void onScaleFactorChanged (double newScaleFactor) override;
+
+	const CRect& getSize () const { return size; }
+	double getScaleFactor () const { return scaleFactor; }
+
+	/** let the delegate draw the invalid parts of the cache. returns false if the layer is empty */
+	bool updateCache ();
+
+private:
+	void invalidParent (const CRect& rect);
+	void releaseCache ();
+
+	IPlatformViewLayerDelegate* drawDelegate;
+	SharedPointer<ViewLayer> parent;
+	InvalidFunc invalidFunc;
+	SharedPointer<CBitmap> bitmap;
+	SharedPointer<Context> context;
+	CInvalidRectList dirtyRects;
+	CRect size;
+	double scaleFactor {1.};
+	float alpha {1.f};
+	uint32_t zIndex {0};
+};
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
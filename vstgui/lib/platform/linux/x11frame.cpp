@@ -5,6 +5,7 @@
 #include "x11frame.h"
 #include "../../cbuttonstate.h"
 #include "../../cframe.h"
+#include "../../cinvalidrectlist.h"
 #include "../../crect.h"
 #include "../../dragging.h"
 #include "../../vstkeycode.h"
@@ -17,15 +18,20 @@
 #include "../common/genericoptionmenu.h"
 #include "cairobitmap.h"
 #include "cairocontext.h"
+#include "cairoviewlayer.h"
 #include "x11platform.h"
 #include "x11utils.h"
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <unordered_map>
 #include <X11/Xlib.h>
 #include <xcb/xcb.h>
 #include <xcb/xcb_util.h>
 #include <cairo/cairo-xcb.h>
+#if VSTGUI_X11_PRESENT_SUPPORT
+#include <xcb/present.h>
+#endif
 
 #ifdef None
 #	undef None
@@ -96,26 +102,187 @@ inline uint32_t translateModifiers (int state)
 } // anonymous
 
 //------------------------------------------------------------------------
-struct RedrawTimerHandler
-	: ITimerHandler
-	, NonAtomicReferenceCounted
+using Clock = std::chrono::steady_clock;
+
+//------------------------------------------------------------------------
+inline double toMilliseconds (Clock::duration d)
+{
+	return std::chrono::duration<double, std::milli> (d).count ();
+}
+
+//------------------------------------------------------------------------
+struct FrameTiming
+{
+	bool drawn {false};
+	double drawTime {0.};
+	double presentTime {0.};
+};
+
+//------------------------------------------------------------------------
+/** Paces redraws to the display refresh
+ *
+ *	When the X server supports the Present extension a complete notify event is requested for the
+ *	next display refresh and the frame is drawn when it arrives. Otherwise a one shot timer is
+ *	scheduled for the next point on a fixed frame grid, so that timer inaccuracy does not add up
+ *	over time. Frames which are late skip to the next point on the grid instead of being drawn
+ *	back to back.
+ */
+struct FrameScheduler : ITimerHandler
 {
-	using RedrawCallback = std::function<void()>;
+	using DrawCallback = std::function<FrameTiming ()>;
+
+	static constexpr double kDefaultRefreshInterval = 1000. / 60.;
 
-	RedrawTimerHandler (uint64_t delay, RedrawCallback&& redrawCallback)
-		: redrawCallback (std::move (redrawCallback))
+	FrameScheduler (xcb_window_t window, DrawCallback&& drawCallback)
+	: window (window), drawCallback (std::move (drawCallback))
 	{
-		RunLoop::instance ().get ()->registerTimer (delay, this);
+		stats.refreshInterval = kDefaultRefreshInterval;
+#if VSTGUI_X11_PRESENT_SUPPORT
+		presentEventId = RunLoop::instance ().selectPresentCompleteNotify (window);
+		usePresent = presentEventId != 0;
+#endif
+	}
+
+	~FrameScheduler () noexcept
+	{
+		stopTimer ();
+#if VSTGUI_X11_PRESENT_SUPPORT
+		if (usePresent)
+			RunLoop::instance ().deselectPresentCompleteNotify (window, presentEventId);
+#endif
+	}
+
+	void scheduleFrame ()
+	{
+		if (frameRequested)
+			return;
+		frameRequested = true;
+		auto now = Clock::now ();
+#if VSTGUI_X11_PRESENT_SUPPORT
+		if (usePresent)
+		{
+			continuous = toMilliseconds (now - lastFrameTime) < stats.refreshInterval;
+			RunLoop::instance ().requestPresentNotify (window, ++serial, lastMsc);
+			return;
+		}
+#endif
+		auto interval = getRefreshInterval ();
+		if (nextFrameTime <= now)
+			nextFrameTime += interval * ((now - nextFrameTime) / interval + 1);
+		startTimer (nextFrameTime - now);
 	}
-	~RedrawTimerHandler () noexcept { RunLoop::instance ().get ()->unregisterTimer (this); }
 
 	void onTimer () override
 	{
-		SharedPointer<RedrawTimerHandler> Self (this);
-		Self->redrawCallback ();
+		stopTimer ();
+		if (!frameRequested)
+			return;
+		auto now = Clock::now ();
+		auto interval = getRefreshInterval ();
+		if (now - nextFrameTime >= interval)
+		{
+			// the timer fired more than a frame too late
+			auto missed = (now - nextFrameTime) / interval;
+			stats.droppedFrames += static_cast<uint64_t> (missed);
+			nextFrameTime += interval * missed;
+		}
+		drawFrame ();
+		now = Clock::now ();
+		if (now > nextFrameTime)
+		{
+			// the draw overran the frame, skip to the next point on the frame grid
+			auto skipped = (now - nextFrameTime) / interval + 1;
+			stats.droppedFrames += static_cast<uint64_t> (skipped);
+			nextFrameTime += interval * skipped;
+		}
+	}
+
+#if VSTGUI_X11_PRESENT_SUPPORT
+	void onPresentCompleteNotify (uint32_t eventSerial, uint64_t ust, uint64_t msc)
+	{
+		if (eventSerial != serial || !frameRequested)
+			return;
+		if (lastMsc && msc > lastMsc && ust > lastUst)
+		{
+			auto refreshCount = msc - lastMsc;
+			if (refreshCount < 8)
+				stats.refreshInterval = (ust - lastUst) / 1000. / refreshCount;
+			if (continuous && refreshCount > 1)
+				stats.droppedFrames += refreshCount - 1;
+		}
+		lastUst = ust;
+		lastMsc = msc;
+		drawFrame ();
+	}
+#endif
+
+	const PlatformFrameTimingStats& getStats () const { return stats; }
+
+	void resetStats ()
+	{
+		stats.frameCount = 0;
+		stats.droppedFrames = 0;
+		stats.maxDrawTime = 0.;
+		stats.maxPresentTime = 0.;
+		stats.maxFrameTime = 0.;
+	}
+
+private:
+	Clock::duration getRefreshInterval () const
+	{
+		return std::chrono::duration_cast<Clock::duration> (
+			std::chrono::duration<double, std::milli> (stats.refreshInterval));
 	}
 
-	RedrawCallback redrawCallback;
+	void drawFrame ()
+	{
+		frameRequested = false;
+		auto start = Clock::now ();
+		auto timing = drawCallback ();
+		// nothing was invalid anymore, this is not a frame
+		if (!timing.drawn)
+			return;
+		lastFrameTime = start;
+		auto frameTime = toMilliseconds (Clock::now () - start);
+		++stats.frameCount;
+		stats.lastDrawTime = timing.drawTime;
+		stats.lastPresentTime = timing.presentTime;
+		stats.lastFrameTime = frameTime;
+		stats.maxDrawTime = std::max (stats.maxDrawTime, timing.drawTime);
+		stats.maxPresentTime = std::max (stats.maxPresentTime, timing.presentTime);
+		stats.maxFrameTime = std::max (stats.maxFrameTime, frameTime);
+	}
+
+	void startTimer (Clock::duration delay)
+	{
+		auto delayMs = std::chrono::duration_cast<std::chrono::milliseconds> (delay).count ();
+		timerRunning = RunLoop::get ()->registerTimer (std::max<uint64_t> (delayMs, 1), this);
+	}
+
+	void stopTimer ()
+	{
+		if (!timerRunning)
+			return;
+		if (auto runLoop = RunLoop::get ())
+			runLoop->unregisterTimer (this);
+		timerRunning = false;
+	}
+
+	xcb_window_t window;
+	DrawCallback drawCallback;
+	PlatformFrameTimingStats stats;
+	Clock::time_point nextFrameTime {};
+	Clock::time_point lastFrameTime {};
+	bool frameRequested {false};
+	bool timerRunning {false};
+#if VSTGUI_X11_PRESENT_SUPPORT
+	bool usePresent {false};
+	bool continuous {false};
+	uint32_t presentEventId {0};
+	uint32_t serial {0};
+	uint64_t lastUst {0};
+	uint64_t lastMsc {0};
+#endif
 };
 
 //------------------------------------------------------------------------
@@ -147,25 +314,55 @@ struct DrawHandler
 		drawContext = makeOwned<Cairo::Context> (r, backBuffer);
 	}
 
-	template<typename RectList, typename Proc>
-	void draw (const RectList& dirtyRects, Proc proc)
+	template<typename Proc>
+	FrameTiming draw (const CInvalidRectList& dirtyRects, Proc proc)
 	{
-		CRect copyRect;
+		FrameTiming timing;
+		timing.drawn = true;
+		auto start = Clock::now ();
 		drawContext->beginDraw ();
-		for (auto rect : dirtyRects)
+		for (const auto& rect : dirtyRects)
 		{
 			drawContext->setClipRect (rect);
 			drawContext->saveGlobalState ();
 			proc (drawContext, rect);
 			drawContext->restoreGlobalState ();
-			if (copyRect.isEmpty ())
-				copyRect = rect;
-			else
-				copyRect.unite (rect);
 		}
 		drawContext->endDraw ();
-		blitBackbufferToWindow (copyRect);
+		auto drawEnd = Clock::now ();
+		auto blitRect = dirtyRects.getBounds ();
+		if (!scrolledRect.isEmpty ())
+		{
+			blitRect = blitRect.isEmpty () ? scrolledRect : blitRect.unite (scrolledRect);
+			scrolledRect = {};
+		}
+		blitBackbufferToWindow (blitRect);
 		xcb_flush (RunLoop::instance ().getXcbConnection ());
+		timing.drawTime = toMilliseconds (drawEnd - start);
+		timing.presentTime = toMilliseconds (Clock::now () - drawEnd);
+		return timing;
+	}
+
+	/** moves the content of src by distance inside the back buffer. The moved content reaches the
+	 *	window with the next draw call.
+	 */
+	void scroll (const CRect& src, const CPoint& distance)
+	{
+		CRect dst (src);
+		dst.offset (distance.x, distance.y);
+		// cairo does not support overlapping copies inside one surface, so the copy goes through
+		// an intermediate group
+		Cairo::ContextHandle context (cairo_create (backBuffer));
+		cairo_rectangle (context, dst.left, dst.top, dst.getWidth (), dst.getHeight ());
+		cairo_clip (context);
+		cairo_push_group (context);
+		cairo_set_source_surface (context, backBuffer, distance.x, distance.y);
+		cairo_set_operator (context, CAIRO_OPERATOR_SOURCE);
+		cairo_paint (context);
+		cairo_pop_group_to_source (context);
+		cairo_set_operator (context, CAIRO_OPERATOR_SOURCE);
+		cairo_paint (context);
+		scrolledRect = scrolledRect.isEmpty () ? dst : scrolledRect.unite (dst);
 	}
 
 private:
@@ -173,6 +370,7 @@ private:
 	Cairo::SurfaceHandle windowSurface;
 	Cairo::SurfaceHandle backBuffer;
 	SharedPointer<Cairo::Context> drawContext;
+	CRect scrolledRect;
 
 	void blitBackbufferToWindow (const CRect& rect)
 	{
@@ -260,21 +458,22 @@ private:
 //------------------------------------------------------------------------
 struct Frame::Impl : IFrameEventHandler
 {
-	using RectList = std::vector<CRect>;
-
 	ChildWindow window;
 	DrawHandler drawHandler;
 	DoubleClickDetector doubleClickDetector;
 	IPlatformFrameCallback* frame;
 	std::unique_ptr<GenericOptionMenuTheme> genericOptionMenuTheme;
-	SharedPointer<RedrawTimerHandler> redrawTimer;
-	RectList dirtyRects;
+	CInvalidRectList dirtyRects;
+	FrameScheduler frameScheduler;
 	CCursorType currentCursor{kCursorDefault};
 	uint32_t pointerGrabed{0};
 
 	//------------------------------------------------------------------------
 	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame)
-		: window (parent, size), drawHandler (window), frame (frame)
+	: window (parent, size)
+	, drawHandler (window)
+	, frame (frame)
+	, frameScheduler (window.getID (), [this] () { return redraw (); })
 	{
 		RunLoop::instance ().registerWindowEventHandler (window.getID (), this);
 	}
@@ -288,7 +487,8 @@ struct Frame::Impl : IFrameEventHandler
 		window.setSize (size);
 		drawHandler.onSizeChanged (size.getSize ());
 		dirtyRects.clear ();
-		dirtyRects.push_back (size);
+		dirtyRects.add (size);
+		frameScheduler.scheduleFrame ();
 	}
 
 	//------------------------------------------------------------------------
@@ -312,25 +512,69 @@ struct Frame::Impl : IFrameEventHandler
 	}
 
 	//------------------------------------------------------------------------
-	void redraw ()
+	FrameTiming redraw ()
 	{
-		drawHandler.draw (dirtyRects, [&](CDrawContext* context, const CRect& rect) {
+		// pending layouts invalidate the new geometry, which is drawn with this frame
+		frame->platformOnBeforeDraw ();
+		if (dirtyRects.empty ())
+			return {};
+		// views may invalidate while they are drawn, which changes dirtyRects. So the rects are
+		// drawn from a local list and rects invalidated while drawing are drawn with the next frame
+		CInvalidRectList drawRects (dirtyRects.getPerRectCost (), dirtyRects.getMaxRects ());
+		drawRects.swap (dirtyRects);
+		return drawHandler.draw (drawRects, [&] (CDrawContext* context, const CRect& rect) {
 			frame->platformDrawRect (context, rect);
 		});
-		dirtyRects.clear ();
 	}
 
 	//------------------------------------------------------------------------
 	void invalidRect (CRect r)
 	{
-		dirtyRects.emplace_back (r);
-		if (redrawTimer)
-			return;
-		redrawTimer = makeOwned<RedrawTimerHandler> (16, [this]() {
-			if (dirtyRects.empty ())
-				return;
-			redraw ();
-		});
+		if (dirtyRects.add (r))
+			frameScheduler.scheduleFrame ();
+	}
+
+	//------------------------------------------------------------------------
+	bool scrollRect (CRect src, CPoint distance)
+	{
+		CRect bounds;
+		bounds.setSize (window.getSize ());
+		CRect area (src);
+		area.unite (CRect (src).offset (distance.x, distance.y));
+		area.bound (bounds);
+		// only content which is inside the window before and after the scroll can be moved
+		CRect dst (src);
+		dst.bound (bounds);
+		dst.offset (distance.x, distance.y);
+		dst.bound (bounds);
+		if (dst.isEmpty ())
+			return false;
+		src = dst;
+		src.offset (-distance.x, -distance.y);
+
+		drawHandler.scroll (src, distance);
+
+		// pending dirty rects inside the source were not drawn yet, so the content moved from
+		// there is outdated as well
+		CInvalidRectList movedRects (dirtyRects.getPerRectCost (), dirtyRects.getMaxRects ());
+		for (const auto& rect : dirtyRects)
+		{
+			CRect r (rect);
+			r.bound (src);
+			if (!r.isEmpty ())
+				movedRects.add (r.offset (distance.x, distance.y));
+		}
+		for (const auto& rect : movedRects)
+			dirtyRects.add (rect);
+
+		// everything in the scrolled area which is not covered by the moved content
+		dirtyRects.add (CRect (area.left, area.top, dst.left, area.bottom));
+		dirtyRects.add (CRect (dst.right, area.top, area.right, area.bottom));
+		dirtyRects.add (CRect (dst.left, area.top, dst.right, dst.top));
+		dirtyRects.add (CRect (dst.left, dst.bottom, dst.right, area.bottom));
+
+		frameScheduler.scheduleFrame ();
+		return true;
 	}
 
 	//------------------------------------------------------------------------
@@ -502,6 +746,14 @@ struct Frame::Impl : IFrameEventHandler
 #endif
 	}
 
+#if VSTGUI_X11_PRESENT_SUPPORT
+	//------------------------------------------------------------------------
+	void onEvent (xcb_present_complete_notify_event_t& event) override
+	{
+		frameScheduler.onPresentCompleteNotify (event.serial, event.ust, event.msc);
+	}
+#endif
+
 	//------------------------------------------------------------------------
 	void onEvent (xcb_client_message_event_t& event) override
 	{
@@ -648,12 +900,22 @@ bool Frame::invalidRect (const CRect& rect)
 	return true;
 }
 
+//------------------------------------------------------------------------
+PlatformFrameTimingStats Frame::getTimingStats () const
+{
+	return impl->frameScheduler.getStats ();
+}
+
+//------------------------------------------------------------------------
+void Frame::resetTimingStats ()
+{
+	impl->frameScheduler.resetStats ();
+}
+
 //------------------------------------------------------------------------
 bool Frame::scrollRect (const CRect& src, const CPoint& distance)
 {
-	(void)src;
-	(void)distance;
-	return false;
+	return impl->scrollRect (src, distance);
 }
 
 //------------------------------------------------------------------------
@@ -713,8 +975,14 @@ SharedPointer<IPlatformOpenGLView> Frame::createPlatformOpenGLView ()
 SharedPointer<IPlatformViewLayer> Frame::createPlatformViewLayer (
 	IPlatformViewLayerDelegate* drawDelegate, IPlatformViewLayer* parentLayer)
 {
-	// optional
-	return nullptr;
+	auto parent = static_cast<Cairo::ViewLayer*> (parentLayer);
+	// the layer is only notified about later scale factor changes, so it has to start with the
+	// current one of the frame, including its zoom
+	auto scaleFactor = 1.;
+	if (auto cFrame = dynamic_cast<CFrame*> (frame))
+		scaleFactor = cFrame->getScaleFactor ();
+	return makeOwned<Cairo::ViewLayer> (drawDelegate, parent, scaleFactor,
+										[this] (const CRect& rect) { impl->invalidRect (rect); });
 }
 
 //------------------------------------------------------------------------
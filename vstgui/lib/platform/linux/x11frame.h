@@ -21,6 +21,7 @@ class Frame
 	: public IPlatformFrame
 	, public IX11Frame
 	, public IGenericOptionMenuListener
+	, public IPlatformFrameTimingStatsExtension
 {
 public:
 	Frame (IPlatformFrameCallback* frame,
@@ -77,6 +78,9 @@ private:
 	void optionMenuPopupStarted () override;
 	void optionMenuPopupStopped () override;
 
+	PlatformFrameTimingStats getTimingStats () const override;
+	void resetTimingStats () override;
+
 private:
 	struct Impl;
 	std::unique_ptr<Impl> impl;
@@ -25,6 +25,9 @@
 #include <xkbcommon/xkbcommon.h>
 #include <xkbcommon/xkbcommon-x11.h>
 #include <X11/Xlib.h>
+#if VSTGUI_X11_PRESENT_SUPPORT
+#include <xcb/present.h>
+#endif
 
 // c++11 compile error workaround
 #define explicit _explicit
@@ -184,6 +187,7 @@ struct RunLoop::Impl : IEventHandler
 	std::array<xcb_cursor_t, CCursorType::kCursorIBeam + 1> cursors{{XCB_CURSOR_NONE}};
 	VstKeyCode lastUnprocessedKeyEvent;
 	uint32_t lastUtf32KeyEventChar{0};
+	uint8_t presentOpcode{0};
 
 	void init (const SharedPointer<IRunLoop>& inRunLoop)
 	{
@@ -208,6 +212,20 @@ struct RunLoop::Impl : IEventHandler
 			xkbState = xkb_state_new (xkbKeymap);
 			xkbUnprocessedState = xkb_state_new (xkbKeymap);
 		}
+
+#if VSTGUI_X11_PRESENT_SUPPORT
+		auto presentExtension = xcb_get_extension_data (xcbConnection, &xcb_present_id);
+		if (presentExtension && presentExtension->present)
+		{
+			auto cookie = xcb_present_query_version (xcbConnection, XCB_PRESENT_MAJOR_VERSION,
+													 XCB_PRESENT_MINOR_VERSION);
+			if (auto reply = xcb_present_query_version_reply (xcbConnection, cookie, nullptr))
+			{
+				presentOpcode = presentExtension->major_opcode;
+				free (reply);
+			}
+		}
+#endif
 	}
 
 	void exit ()
@@ -235,6 +253,7 @@ struct RunLoop::Impl : IEventHandler
 			}
 
 			xcb_disconnect (xcbConnection);
+			presentOpcode = 0;
 		}
 		runLoop->unregisterEventHandler (this);
 		runLoop = nullptr;
@@ -369,6 +388,19 @@ struct RunLoop::Impl : IEventHandler
 					dispatchEvent (*ev, ev->event);
 					break;
 				}
+#if VSTGUI_X11_PRESENT_SUPPORT
+				case XCB_GE_GENERIC:
+				{
+					auto ev = reinterpret_cast<xcb_ge_generic_event_t*> (event);
+					if (presentOpcode && ev->extension == presentOpcode &&
+						ev->event_type == XCB_PRESENT_COMPLETE_NOTIFY)
+					{
+						auto cn = reinterpret_cast<xcb_present_complete_notify_event_t*> (event);
+						dispatchEvent (*cn, cn->window);
+					}
+					break;
+				}
+#endif
 			}
 			std::free (event);
 		}
@@ -432,6 +464,39 @@ xcb_connection_t* RunLoop::getXcbConnection () const
 	return impl->xcbConnection;
 }
 
+#if VSTGUI_X11_PRESENT_SUPPORT
+//------------------------------------------------------------------------
+uint32_t RunLoop::selectPresentCompleteNotify (uint32_t windowId)
+{
+	if (impl->presentOpcode == 0)
+		return 0;
+	auto eventId = xcb_generate_id (impl->xcbConnection);
+	xcb_present_select_input (impl->xcbConnection, eventId, windowId,
+							  XCB_PRESENT_EVENT_MASK_COMPLETE_NOTIFY);
+	return eventId;
+}
+
+//------------------------------------------------------------------------
+void RunLoop::deselectPresentCompleteNotify (uint32_t windowId, uint32_t eventId)
+{
+	if (impl->presentOpcode == 0 || eventId == 0)
+		return;
+	xcb_present_select_input (impl->xcbConnection, eventId, windowId,
+							  XCB_PRESENT_EVENT_MASK_NO_EVENT);
+	xcb_flush (impl->xcbConnection);
+}
+
+//------------------------------------------------------------------------
+void RunLoop::requestPresentNotify (uint32_t windowId, uint32_t serial, uint64_t lastMsc)
+{
+	// without a known msc let the server pick the next refresh
+	auto targetMsc = lastMsc ? lastMsc + 1 : 0;
+	auto divisor = lastMsc ? 0 : 1;
+	xcb_present_notify_msc (impl->xcbConnection, windowId, serial, targetMsc, divisor, 0);
+	xcb_flush (impl->xcbConnection);
+}
+#endif
+
 //------------------------------------------------------------------------
 namespace {
 
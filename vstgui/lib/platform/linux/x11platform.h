@@ -9,6 +9,10 @@
 #include <atomic>
 #include <memory>
 
+#ifndef VSTGUI_X11_PRESENT_SUPPORT
+#define VSTGUI_X11_PRESENT_SUPPORT 0
+#endif
+
 struct xcb_connection_t;	  // forward declaration
 struct xcb_key_press_event_t; // forward declaration
 struct xcb_button_press_event_t;
@@ -19,6 +23,9 @@ struct xcb_expose_event_t;
 struct xcb_map_notify_event_t;
 struct xcb_property_notify_event_t;
 struct xcb_client_message_event_t;
+#if VSTGUI_X11_PRESENT_SUPPORT
+struct xcb_present_complete_notify_event_t;
+#endif
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -42,6 +49,9 @@ struct IFrameEventHandler
 	virtual void onEvent (xcb_expose_event_t& event) = 0;
 	virtual void onEvent (xcb_property_notify_event_t& event) = 0;
 	virtual void onEvent (xcb_client_message_event_t& event) = 0;
+#if VSTGUI_X11_PRESENT_SUPPORT
+	virtual void onEvent (xcb_present_complete_notify_event_t& event) = 0;
+#endif
 };
 
 //------------------------------------------------------------------------
@@ -78,6 +88,15 @@ struct RunLoop
 	VstKeyCode getCurrentKeyEvent () const;
 	Optional<UTF8String> convertCurrentKeyEventToText () const;
 
+#if VSTGUI_X11_PRESENT_SUPPORT
+	/** returns the id of the event selection or 0 if the server does not support the Present
+	 *	extension */
+	uint32_t selectPresentCompleteNotify (uint32_t windowId);
+	void deselectPresentCompleteNotify (uint32_t windowId, uint32_t eventId);
+	/** request a complete notify event for the window at the display refresh after lastMsc */
+	void requestPresentNotify (uint32_t windowId, uint32_t serial, uint64_t lastMsc);
+#endif
+
 	static RunLoop& instance ();
 
 private:
@@ -4,6 +4,7 @@
 
 #include "x11timer.h"
 #include "x11platform.h"
+#include <algorithm>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -32,21 +33,28 @@ Timer::~Timer () noexcept
 //------------------------------------------------------------------------
 bool Timer::start (uint32_t periodMs)
 {
-	auto runLoop = RunLoop::get ();
-	vstgui_assert (runLoop, "Timer only works of run loop was set");
-	if (!runLoop)
+	if (!scheduler)
+		scheduler = TimerScheduler::get ();
+	vstgui_assert (scheduler, "Timer only works of run loop was set");
+	if (!scheduler)
 		return false;
-	return runLoop->registerTimer (periodMs, this);
+	return scheduler->add (this, periodMs, tolerance ? tolerance : periodMs);
 }
 
 //------------------------------------------------------------------------
 bool Timer::stop ()
 {
-	auto runLoop = RunLoop::get ();
-	vstgui_assert (runLoop, "Timer only works of run loop was set");
-	if (!runLoop)
+	if (!scheduler)
 		return false;
-	return runLoop->unregisterTimer (this);
+	auto result = scheduler->remove (this);
+	scheduler = nullptr;
+	return result;
+}
+
+//------------------------------------------------------------------------
+void Timer::setTolerance (uint32_t toleranceMs)
+{
+	tolerance = toleranceMs;
 }
 
 //------------------------------------------------------------------------
@@ -56,6 +64,262 @@ void Timer::onTimer ()
 		callback->fire ();
 }
 
+//------------------------------------------------------------------------
+static uint64_t tickIntervalForTimer (uint64_t period, uint64_t tolerance)
+{
+	return std::max<uint64_t> (1, std::min (period, tolerance));
+}
+
+//------------------------------------------------------------------------
+// the scheduler the running timers share, it is not owned here
+static TimerScheduler* gScheduler = nullptr;
+
+//------------------------------------------------------------------------
+TimerScheduler::TimerScheduler (const SharedPointer<IRunLoop>& runLoop, Clock clock)
+: runLoop (runLoop), clock (clock ? clock : &Platform::getCurrentTimeMs)
+{
+}
+
+//------------------------------------------------------------------------
+TimerScheduler::~TimerScheduler () noexcept
+{
+	if (gScheduler == this)
+		gScheduler = nullptr;
+	if (tickInterval)
+		runLoop->unregisterTimer (this);
+}
+
+//------------------------------------------------------------------------
+SharedPointer<TimerScheduler> TimerScheduler::get ()
+{
+	auto runLoop = RunLoop::get ();
+	if (!runLoop)
+		return nullptr;
+	if (gScheduler && gScheduler->runLoop == runLoop)
+		return gScheduler;
+	auto scheduler = makeOwned<TimerScheduler> (runLoop);
+	gScheduler = scheduler;
+	return scheduler;
+}
+
+//------------------------------------------------------------------------
+uint64_t TimerScheduler::now () const
+{
+	return clock ();
+}
+
+//------------------------------------------------------------------------
+uint64_t TimerScheduler::tickForTime (uint64_t time) const
+{
+	if (time <= epoch)
+		return 0;
+	return (time - epoch + tickInterval - 1) / tickInterval;
+}
+
+//------------------------------------------------------------------------
+uint64_t TimerScheduler::calcTickInterval () const
+{
+	uint64_t interval = 0;
+	for (auto& it : entries)
+	{
+		auto entryInterval = tickIntervalForTimer (it.second->period, it.second->tolerance);
+		if (interval == 0 || entryInterval < interval)
+			interval = entryInterval;
+	}
+	return interval;
+}
+
+//------------------------------------------------------------------------
+bool TimerScheduler::add (ITimerHandler* handler, uint32_t periodMs, uint32_t toleranceMs)
+{
+	remove (handler);
+	auto time = now ();
+	auto period = std::max<uint64_t> (1, periodMs);
+	auto entry = new Entry {handler, period, toleranceMs, time + period, 0, nullptr, 0};
+	entries.emplace (handler, std::unique_ptr<Entry> (entry));
+	if (tickInterval)
+	{
+		entry->fireTick = std::max (currentTick + 1, tickForTime (entry->due));
+		insert (entry);
+	}
+	if (tickInterval == 0 || tickIntervalForTimer (period, toleranceMs) < tickInterval)
+	{
+		tickIntervalDirty = true;
+		if (!inOnTimer)
+			updateTickInterval (time);
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool TimerScheduler::remove (ITimerHandler* handler)
+{
+	auto it = entries.find (handler);
+	if (it == entries.end ())
+		return false;
+	auto entry = std::move (it->second);
+	entries.erase (it);
+	unlink (entry.get ());
+	// an entry may still be in the list of entries firing in this tick
+	entry->handler = nullptr;
+	if (entries.empty () ||
+	    tickIntervalForTimer (entry->period, entry->tolerance) == tickInterval)
+	{
+		tickIntervalDirty = true;
+		if (!inOnTimer)
+			updateTickInterval (now ());
+	}
+	if (inOnTimer)
+		removedEntries.emplace_back (std::move (entry));
+	return true;
+}
+
+//------------------------------------------------------------------------
+void TimerScheduler::insert (Entry* entry)
+{
+	auto fireTick = std::max (entry->fireTick, currentTick);
+	auto delta = fireTick - currentTick;
+	if (delta >= kWheelRange)
+	{
+		// the entry is moved down again when its slot is cascaded
+		fireTick = currentTick + kWheelRange - 1;
+		delta = kWheelRange - 1;
+	}
+	uint32_t level = 0;
+	while (level < kNumLevels - 1 && delta >= (1ull << (kSlotBits * (level + 1))))
+		++level;
+	auto& slot = wheel[level][(fireTick >> (kSlotBits * level)) & (kNumSlots - 1)];
+	entry->slot = &slot;
+	entry->slotIndex = slot.size ();
+	slot.emplace_back (entry);
+}
+
+//------------------------------------------------------------------------
+void TimerScheduler::unlink (Entry* entry)
+{
+	if (!entry->slot)
+		return;
+	auto& slot = *entry->slot;
+	auto last = slot.back ();
+	slot[entry->slotIndex] = last;
+	last->slotIndex = entry->slotIndex;
+	slot.pop_back ();
+	entry->slot = nullptr;
+}
+
+//------------------------------------------------------------------------
+void TimerScheduler::cascade (uint32_t level, uint64_t tick)
+{
+	Slot entriesToMove;
+	entriesToMove.swap (wheel[level][(tick >> (kSlotBits * level)) & (kNumSlots - 1)]);
+	for (auto entry : entriesToMove)
+	{
+		entry->slot = nullptr;
+		insert (entry);
+	}
+}
+
+//------------------------------------------------------------------------
+void TimerScheduler::processTick (uint64_t tick, uint64_t time)
+{
+	if ((tick & (kNumSlots - 1)) == 0)
+	{
+		if (((tick >> kSlotBits) & (kNumSlots - 1)) == 0)
+			cascade (2, tick);
+		cascade (1, tick);
+	}
+	firing.swap (wheel[0][tick & (kNumSlots - 1)]);
+	for (auto entry : firing)
+		entry->slot = nullptr;
+	for (auto entry : firing)
+	{
+		if (!entry->handler)
+			continue;
+		if (entry->fireTick > tick)
+			insert (entry);
+		else
+			fire (entry, time);
+	}
+	firing.clear ();
+}
+
+//------------------------------------------------------------------------
+void TimerScheduler::fire (Entry* entry, uint64_t time)
+{
+	++statistics.fires;
+	if (time > entry->due + entry->tolerance)
+		++statistics.lateFires;
+	entry->due += entry->period;
+	// skip the periods which were missed completely
+	if (entry->due <= time)
+		entry->due = time + entry->period;
+	entry->fireTick = std::max (currentTick + 1, tickForTime (entry->due));
+	insert (entry);
+	entry->handler->onTimer ();
+}
+
+//------------------------------------------------------------------------
+void TimerScheduler::rebuild (uint64_t time)
+{
+	for (auto& level : wheel)
+	{
+		for (auto& slot : level)
+			slot.clear ();
+	}
+	epoch = time;
+	currentTick = 0;
+	for (auto& it : entries)
+	{
+		auto entry = it.second.get ();
+		entry->slot = nullptr;
+		entry->fireTick = std::max<uint64_t> (1, tickForTime (entry->due));
+		insert (entry);
+	}
+}
+
+//------------------------------------------------------------------------
+void TimerScheduler::updateTickInterval (uint64_t time)
+{
+	tickIntervalDirty = false;
+	auto interval = calcTickInterval ();
+	if (interval == tickInterval)
+		return;
+	if (tickInterval)
+		runLoop->unregisterTimer (this);
+	tickInterval = interval;
+	if (tickInterval == 0)
+		return;
+	rebuild (time);
+	runLoop->registerTimer (tickInterval, this);
+}
+
+//------------------------------------------------------------------------
+void TimerScheduler::onTimer ()
+{
+	if (inOnTimer || tickInterval == 0)
+		return;
+	// the timers may release the scheduler when they stop in their callbacks
+	SharedPointer<TimerScheduler> self (this);
+	auto time = now ();
+	++statistics.wakeups;
+	if (time < epoch)
+		return;
+	auto targetTick = (time - epoch) / tickInterval;
+	if (targetTick > currentTick + kWheelRange)
+	{
+		// the run loop did not call us for a long time, all overdue timers fire now
+		rebuild (time - tickInterval);
+		targetTick = 1;
+	}
+	inOnTimer = true;
+	while (currentTick < targetTick)
+		processTick (++currentTick, time);
+	inOnTimer = false;
+	removedEntries.clear ();
+	if (tickIntervalDirty)
+		updateTickInterval (time);
+}
+
 //------------------------------------------------------------------------
 } // X11
 } // VSTGUI
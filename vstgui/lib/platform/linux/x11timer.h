@@ -6,11 +6,17 @@
 
 #include "../iplatformtimer.h"
 #include "x11frame.h"
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
 namespace X11 {
 
+class TimerScheduler;
+
 //------------------------------------------------------------------------
 class Timer : public IPlatformTimer, public ITimerHandler
 {
@@ -18,13 +24,108 @@ public:
 	Timer (IPlatformTimerCallback* callback);
 	~Timer () noexcept;
 
+	/** the timer may fire late by up to its tolerance, by default one period */
 	bool start (uint32_t periodMs) override;
 	bool stop () override;
+	void setTolerance (uint32_t toleranceMs) override;
 
 	void onTimer () override;
 
 private:
 	IPlatformTimerCallback* callback = nullptr;
+	uint32_t tolerance = 0;
+	SharedPointer<TimerScheduler> scheduler;
+};
+
+//------------------------------------------------------------------------
+/** Shared timer scheduler
+ *
+ *	All timers are scheduled in a hierarchical timer wheel which is driven by one timer of the run
+ *	loop, so timers with compatible periods fire in the same wakeup instead of waking up the run
+ *	loop each on its own.
+ *
+ *	The tick of the wheel is the smallest period or tolerance of all timers. A timer fires in the
+ *	first tick at or after its due time, so it may fire late by up to one tick but never early.
+ *	A timer which fires later than its tolerance is counted as a late fire.
+ *
+ *	The scheduler of the run loop is shared by the running timers, it is released with the last
+ *	timer which stops.
+ */
+class TimerScheduler : public ITimerHandler, public NonAtomicReferenceCounted
+{
+public:
+	using Clock = uint64_t (*) ();
+
+	struct Statistics
+	{
+		/** number of times the run loop woke up the scheduler */
+		uint64_t wakeups {0};
+		/** number of times a timer fired */
+		uint64_t fires {0};
+		/** number of times a timer fired later than its tolerance */
+		uint64_t lateFires {0};
+	};
+
+	explicit TimerScheduler (const SharedPointer<IRunLoop>& runLoop, Clock clock = nullptr);
+	~TimerScheduler () noexcept;
+
+	/** returns the scheduler of the current run loop, creates it if no timer is running */
+	static SharedPointer<TimerScheduler> get ();
+
+	/** add or restart a timer, its first fire is one period from now */
+	bool add (ITimerHandler* handler, uint32_t periodMs, uint32_t toleranceMs);
+	bool remove (ITimerHandler* handler);
+
+	size_t getNumTimers () const { return entries.size (); }
+	/** the interval of the run loop timer, zero if no timer is active */
+	uint64_t getTickInterval () const { return tickInterval; }
+	const Statistics& getStatistics () const { return statistics; }
+
+	void onTimer () override;
+
+private:
+	static constexpr uint32_t kSlotBits = 6;
+	static constexpr uint32_t kNumSlots = 1 << kSlotBits;
+	static constexpr uint32_t kNumLevels = 3;
+	static constexpr uint64_t kWheelRange = 1ull << (kSlotBits * kNumLevels);
+
+	struct Entry
+	{
+		ITimerHandler* handler;
+		uint64_t period;
+		uint64_t tolerance;
+		uint64_t due;
+		uint64_t fireTick;
+		std::vector<Entry*>* slot;
+		size_t slotIndex;
+	};
+
+	using Slot = std::vector<Entry*>;
+	using Level = std::array<Slot, kNumSlots>;
+
+	uint64_t now () const;
+	uint64_t tickForTime (uint64_t time) const;
+	uint64_t calcTickInterval () const;
+	void insert (Entry* entry);
+	void unlink (Entry* entry);
+	void cascade (uint32_t level, uint64_t tick);
+	void processTick (uint64_t tick, uint64_t time);
+	void fire (Entry* entry, uint64_t time);
+	void rebuild (uint64_t time);
+	void updateTickInterval (uint64_t time);
+
+	SharedPointer<IRunLoop> runLoop;
+	Clock clock;
+	std::array<Level, kNumLevels> wheel;
+	std::unordered_map<ITimerHandler*, std::unique_ptr<Entry>> entries;
+	std::vector<Entry*> firing;
+	std::vector<std::unique_ptr<Entry>> removedEntries;
+	uint64_t tickInterval {0};
+	uint64_t epoch {0};
+	uint64_t currentTick {0};
+	bool inOnTimer {false};
+	bool tickIntervalDirty {false};
+	Statistics statistics;
 };
 
 //------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #include "../../../../lib/vstkeycode.h"
 #include "../../../../lib/platform/linux/x11frame.h"
 #include "../../../../lib/platform/common/fileresourceinputstream.h"
+#include "gdkasync.h"
 #include "gdkcommondirectories.h"
 #include "gdkpreference.h"
 #include "gdkwindow.h"
@@ -130,7 +131,9 @@ bool Application::init (int argc, char* argv[])
 //------------------------------------------------------------------------
 int Application::run ()
 {
-	return app->run ();
+	auto result = app->run ();
+	Async::waitAllTasksDone ();
+	return result;
 }
 
 //------------------------------------------------------------------------
@@ -2,7 +2,18 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
-#include "../../../include/iasync.h"
+#include "gdkasync.h"
+#include <glib.h>
+#include <pthread.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -10,6 +21,246 @@ namespace Standalone {
 namespace Platform {
 namespace GDK {
 
+static std::atomic<uint32_t> gBackgroundTaskCount {};
+
+//------------------------------------------------------------------------
+static void backgroundTaskDone ()
+{
+	// wake up the main context in case waitAllTasksDone waits for the last task
+	if (--gBackgroundTaskCount == 0)
+		g_main_context_wakeup (nullptr);
+}
+
+//------------------------------------------------------------------------
+static void setThreadName (const std::string& name)
+{
+	// the name of a thread is limited to 15 characters
+	pthread_setname_np (pthread_self (), name.substr (0, 15).data ());
+}
+
+//------------------------------------------------------------------------
+/** Tasks posted to the main thread, performed by the default main context of GLib which the GTK
+ *	application runs. One idle source performs all tasks posted until it is dispatched, so the
+ *	order of the tasks is kept.
+ */
+class MainTasks
+{
+public:
+	static MainTasks& instance ()
+	{
+		static MainTasks mainTasks;
+		return mainTasks;
+	}
+
+	void post (Async::Task&& task)
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		tasks.emplace_back (std::move (task));
+		if (scheduled)
+			return;
+		scheduled = true;
+		g_idle_add_full (G_PRIORITY_DEFAULT, performTasks, this, nullptr);
+	}
+
+private:
+	static gboolean performTasks (gpointer userData)
+	{
+		auto self = static_cast<MainTasks*> (userData);
+		std::deque<Async::Task> performing;
+		{
+			std::lock_guard<std::mutex> guard (self->mutex);
+			performing.swap (self->tasks);
+			self->scheduled = false;
+		}
+		for (auto& task : performing)
+			task ();
+		return G_SOURCE_REMOVE;
+	}
+
+	std::mutex mutex;
+	std::deque<Async::Task> tasks;
+	bool scheduled {false};
+};
+
+//------------------------------------------------------------------------
+/** Work stealing thread pool for the concurrent background queue.
+ *
+ *	Every worker thread has its own task deque. Tasks scheduled from a worker thread are added to
+ *	the deque of this worker, other tasks are distributed round robin. A worker performs the tasks
+ *	of its own deque from the front and steals tasks from the back of the other deques when its
+ *	own deque is empty.
+ */
+class ThreadPool
+{
+public:
+	explicit ThreadPool (uint32_t numThreads)
+	{
+		for (auto index = 0u; index < numThreads; ++index)
+			workers.emplace_back (new Worker);
+		for (auto index = 0u; index < numThreads; ++index)
+			workers[index]->thread = std::thread ([this, index] () { run (index); });
+	}
+
+	~ThreadPool () noexcept
+	{
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			quit = true;
+		}
+		condition.notify_all ();
+		for (auto& worker : workers)
+			worker->thread.join ();
+	}
+
+	void schedule (Async::Task&& task)
+	{
+		auto index = currentWorker.pool == this ? currentWorker.index :
+		                                          nextWorker++ % workers.size ();
+		{
+			std::lock_guard<std::mutex> guard (workers[index]->mutex);
+			workers[index]->tasks.emplace_back (std::move (task));
+		}
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			++numTasks;
+		}
+		condition.notify_one ();
+	}
+
+private:
+	struct Worker
+	{
+		std::mutex mutex;
+		std::deque<Async::Task> tasks;
+		std::thread thread;
+	};
+
+	struct CurrentWorker
+	{
+		ThreadPool* pool;
+		size_t index;
+	};
+
+	bool popTask (size_t index, Async::Task& task)
+	{
+		for (auto i = 0u; i < workers.size (); ++i)
+		{
+			auto& worker = *workers[(index + i) % workers.size ()];
+			std::lock_guard<std::mutex> guard (worker.mutex);
+			if (worker.tasks.empty ())
+				continue;
+			if (i == 0)
+			{
+				task = std::move (worker.tasks.front ());
+				worker.tasks.pop_front ();
+			}
+			else
+			{
+				task = std::move (worker.tasks.back ());
+				worker.tasks.pop_back ();
+			}
+			--numTasks;
+			return true;
+		}
+		return false;
+	}
+
+	void run (size_t index)
+	{
+		currentWorker = {this, index};
+		setThreadName ("Async Worker " + std::to_string (index));
+		while (true)
+		{
+			Async::Task task;
+			if (popTask (index, task))
+			{
+				task ();
+				continue;
+			}
+			std::unique_lock<std::mutex> lock (mutex);
+			condition.wait (lock, [this] () { return quit || numTasks > 0; });
+			if (quit && numTasks <= 0)
+				return;
+		}
+	}
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::mutex mutex;
+	std::condition_variable condition;
+	// may be negative for a short time as a task is counted after it was added to a deque
+	std::atomic<int64_t> numTasks {0};
+	std::atomic<size_t> nextWorker {0};
+	bool quit {false};
+
+	static thread_local CurrentWorker currentWorker;
+};
+
+thread_local ThreadPool::CurrentWorker ThreadPool::currentWorker {nullptr, 0};
+
+//------------------------------------------------------------------------
+/** Dedicated worker thread of a serial queue.
+ *
+ *	The state is shared with the thread, so the thread can perform the remaining tasks after the
+ *	queue was released, even when it is released by one of its own tasks.
+ */
+class SerialWorker
+{
+public:
+	explicit SerialWorker (std::string name) : state (std::make_shared<State> ())
+	{
+		std::thread ([state = state, name = std::move (name)] () {
+			if (!name.empty ())
+				setThreadName (name);
+			run (*state);
+		}).detach ();
+	}
+
+	~SerialWorker () noexcept
+	{
+		{
+			std::lock_guard<std::mutex> guard (state->mutex);
+			state->quit = true;
+		}
+		state->condition.notify_one ();
+	}
+
+	void schedule (Async::Task&& task)
+	{
+		{
+			std::lock_guard<std::mutex> guard (state->mutex);
+			state->tasks.emplace_back (std::move (task));
+		}
+		state->condition.notify_one ();
+	}
+
+private:
+	struct State
+	{
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<Async::Task> tasks;
+		bool quit {false};
+	};
+
+	static void run (State& state)
+	{
+		std::unique_lock<std::mutex> lock (state.mutex);
+		while (true)
+		{
+			state.condition.wait (lock, [&] () { return state.quit || !state.tasks.empty (); });
+			if (state.tasks.empty ())
+				return;
+			auto task = std::move (state.tasks.front ());
+			state.tasks.pop_front ();
+			lock.unlock ();
+			task ();
+			lock.lock ();
+		}
+	}
+
+	std::shared_ptr<State> state;
+};
+
 //------------------------------------------------------------------------
 } // GDK
 } // Platform
@@ -20,31 +271,87 @@ namespace Async {
 //------------------------------------------------------------------------
 struct Queue
 {
-	void schedule (Task&& task)
+	virtual ~Queue () noexcept = default;
+	virtual void schedule (Task&& task) = 0;
+};
+
+//------------------------------------------------------------------------
+namespace {
+
+using namespace Platform::GDK;
+
+//------------------------------------------------------------------------
+struct MainQueue final : Queue
+{
+	void schedule (Task&& task) override { MainTasks::instance ().post (std::move (task)); }
+};
+
+//------------------------------------------------------------------------
+struct BackgroundQueue final : Queue
+{
+	BackgroundQueue () : pool (std::max (std::thread::hardware_concurrency (), 2u)) {}
+
+	void schedule (Task&& task) override
 	{
-		// TODO: scheduling not implemented yet
-		task ();
+		++gBackgroundTaskCount;
+		pool.schedule ([task = std::move (task)] () {
+			task ();
+			backgroundTaskDone ();
+		});
 	}
+
+private:
+	ThreadPool pool;
 };
 
+//------------------------------------------------------------------------
+struct SerialQueue final : Queue
+{
+	SerialQueue (const char* name) : worker (name ? name : "") {}
+
+	void schedule (Task&& task) override
+	{
+		++gBackgroundTaskCount;
+		worker.schedule ([task = std::move (task)] () {
+			task ();
+			backgroundTaskDone ();
+		});
+	}
+
+private:
+	SerialWorker worker;
+};
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+void waitAllTasksDone ()
+{
+	while (gBackgroundTaskCount != 0)
+		g_main_context_iteration (nullptr, TRUE);
+	while (g_main_context_iteration (nullptr, FALSE))
+		;
+}
+
 //------------------------------------------------------------------------
 const QueuePtr& mainQueue ()
 {
-	static QueuePtr q = std::make_shared<Queue> ();
+	static QueuePtr q = std::make_shared<MainQueue> ();
 	return q;
 }
 
 //------------------------------------------------------------------------
 const QueuePtr& backgroundQueue ()
 {
-	static QueuePtr q = std::make_shared<Queue> ();
+	static QueuePtr q = std::make_shared<BackgroundQueue> ();
 	return q;
 }
 
 //------------------------------------------------------------------------
 QueuePtr makeSerialQueue (const char* name)
 {
-	return std::make_shared<Queue> ();
+	return std::make_shared<SerialQueue> (name);
 }
 
 //------------------------------------------------------------------------
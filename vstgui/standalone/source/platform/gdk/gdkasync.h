@@ -0,0 +1,20 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../../include/iasync.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Standalone {
+namespace Async {
+
+/** runs the main context until all background and serial queue tasks are done */
+void waitAllTasksDone ();
+
+//------------------------------------------------------------------------
+} // Async
+} // Standalone
+} // VSTGUI
@@ -0,0 +1,94 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/standalone/source/platform/gdk/gdkasync.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+using namespace VSTGUI::Standalone;
+
+//------------------------------------------------------------------------
+// schedules many small tasks on the background queue, on a serial queue and on the main queue
+// and reports the number of tasks performed per second, then performs a compute bound workload
+// on the background queue and reports the speedup compared to performing it on the main thread
+namespace {
+
+constexpr auto kNumTasks = 1000000;
+constexpr auto kNumWorkTasks = 1024;
+constexpr auto kWorkIterations = 100000;
+
+std::atomic<uint64_t> gCounter {0};
+std::atomic<double> gWorkResult {0.};
+
+//------------------------------------------------------------------------
+void work (int index)
+{
+	double sum = 0.;
+	for (auto i = 0; i < kWorkIterations; ++i)
+		sum += std::sqrt (static_cast<double> (index + i));
+	auto expected = gWorkResult.load ();
+	while (!gWorkResult.compare_exchange_weak (expected, expected + sum))
+		;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (Proc proc)
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	proc ();
+	Async::waitAllTasksDone ();
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	return std::chrono::duration<double> (duration).count ();
+}
+
+//------------------------------------------------------------------------
+void printThroughput (const char* name, double seconds)
+{
+	printf ("  %-11s: %8.2f M tasks/s\n", name, kNumTasks / seconds / 1000000.);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	printf ("%d tasks, %u hardware threads\n", kNumTasks, std::thread::hardware_concurrency ());
+
+	printThroughput ("background", measure ([] () {
+		for (auto i = 0; i < kNumTasks; ++i)
+			Async::schedule (Async::backgroundQueue (), [] () { ++gCounter; });
+	}));
+
+	auto serialQueue = Async::makeSerialQueue ("serial");
+	printThroughput ("serial", measure ([&] () {
+		for (auto i = 0; i < kNumTasks; ++i)
+			Async::schedule (serialQueue, [] () { ++gCounter; });
+	}));
+
+	printThroughput ("main", measure ([] () {
+		Async::schedule (Async::backgroundQueue (), [] () {
+			for (auto i = 0; i < kNumTasks; ++i)
+				Async::schedule (Async::mainQueue (), [] () { ++gCounter; });
+		});
+	}));
+
+	auto inlineTime = measure ([] () {
+		for (auto i = 0; i < kNumWorkTasks; ++i)
+			work (i);
+	});
+	auto backgroundTime = measure ([] () {
+		for (auto i = 0; i < kNumWorkTasks; ++i)
+			Async::schedule (Async::backgroundQueue (), [i] () { work (i); });
+	});
+	printf ("%d compute tasks\n", kNumWorkTasks);
+	printf ("  main thread: %8.2f ms\n", inlineTime * 1000.);
+	printf ("  background : %8.2f ms (%.2fx)\n", backgroundTime * 1000., inlineTime / backgroundTime);
+	return 0;
+}
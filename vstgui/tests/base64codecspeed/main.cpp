@@ -5,25 +5,141 @@
 #include "vstgui/uidescription/base64codec.h"
 #include "vstgui/lib/malloc.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <random>
+#include <string>
+#include <vector>
 
 using namespace VSTGUI;
 
+//------------------------------------------------------------------------
+// encodes and decodes 64 MB of random data in blocks of 1 MB, the size of a large embedded bitmap,
+// with every instruction set the processor supports and reports the throughput in GB/s of binary
+// data, the streaming decode gets the base64 text in chunks of 4 KB with a line break every 76
+// characters like the character data of the XML parser
+namespace {
+
+constexpr size_t kBlockSize = 1024 * 1024;
+constexpr size_t kNumBlocks = 64;
+constexpr size_t kDataSize = kBlockSize * kNumBlocks;
+constexpr size_t kChunkSize = 4096;
+constexpr size_t kLineLength = 76;
+constexpr auto kNumRuns = 5;
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (Proc proc)
+{
+	auto best = 0.;
+	for (auto run = 0; run < kNumRuns; ++run)
+	{
+		auto start = std::chrono::high_resolution_clock::now ();
+		proc ();
+		auto duration = std::chrono::high_resolution_clock::now () - start;
+		auto seconds = std::chrono::duration<double> (duration).count ();
+		if (run == 0 || seconds < best)
+			best = seconds;
+	}
+	return kDataSize / best / 1e9;
+}
+
+//------------------------------------------------------------------------
+bool equals (const uint8_t* data, const Base64Codec::Result& result)
+{
+	return result.dataSize == kBlockSize && memcmp (data, result.data.get (), kBlockSize) == 0;
+}
+
+//------------------------------------------------------------------------
+void streamDecode (Base64Codec::Decoder& decoder, const std::string& text)
+{
+	decoder.reserve (text.size ());
+	for (size_t pos = 0; pos < text.size (); pos += kChunkSize)
+		decoder.write (text.data () + pos, std::min (kChunkSize, text.size () - pos));
+}
+
+//------------------------------------------------------------------------
+std::string insertLineBreaks (const Base64Codec::Result& encoded)
+{
+	std::string text;
+	text.reserve (encoded.dataSize + encoded.dataSize / kLineLength + 1);
+	for (size_t pos = 0; pos < encoded.dataSize; pos += kLineLength)
+	{
+		auto length = std::min<size_t> (kLineLength, encoded.dataSize - pos);
+		text.append (reinterpret_cast<const char*> (encoded.data.get () + pos), length);
+		text += '\n';
+	}
+	return text;
+}
+
+//------------------------------------------------------------------------
+const char* getName (Base64Codec::InstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+		case Base64Codec::InstructionSet::Scalar: return "scalar";
+		case Base64Codec::InstructionSet::SSSE3: return "SSSE3";
+		case Base64Codec::InstructionSet::AVX2: return "AVX2";
+	}
+	return "";
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
 int main ()
 {
 	Buffer<uint8_t> origData;
-	origData.allocate (1024*1024*500);
+	origData.allocate (kDataSize);
 
 	std::independent_bits_engine<std::default_random_engine, sizeof (uint16_t) * 8, uint16_t> rbe;
 	std::generate (origData.get (), origData.get () + origData.size (), std::ref (rbe));
 
-	auto encoderResult = Base64Codec::encode (origData.get (), origData.size ());
-	auto decoderResult = Base64Codec::decode (encoderResult.data.get (), encoderResult.dataSize);
+	printf ("%zu MB random data, GB/s of binary data\n", kDataSize / (1024 * 1024));
+	printf ("  %-8s %8s %8s %8s\n", "", "encode", "decode", "stream");
+	for (auto instructionSet : {Base64Codec::InstructionSet::Scalar,
+	                            Base64Codec::InstructionSet::SSSE3,
+	                            Base64Codec::InstructionSet::AVX2})
+	{
+		if (!Base64Codec::setInstructionSet (instructionSet))
+			continue;
 
-	if (origData.size () != decoderResult.dataSize)
-		return -1;
+		std::vector<Base64Codec::Result> encoded (kNumBlocks);
+		std::vector<std::string> texts (kNumBlocks);
+		for (size_t block = 0; block < kNumBlocks; ++block)
+		{
+			auto data = origData.get () + block * kBlockSize;
+			encoded[block] = Base64Codec::encode (data, kBlockSize);
+			if (!equals (data, Base64Codec::decode (encoded[block].data.get (),
+			                                        encoded[block].dataSize)))
+				return -1;
+			texts[block] = insertLineBreaks (encoded[block]);
+			Base64Codec::Decoder decoder;
+			streamDecode (decoder, texts[block]);
+			if (!equals (data, decoder.finish ()))
+				return -1;
+		}
 
-	if (memcmp (origData.get (), decoderResult.data.get (), origData.size ()) != 0)
-		return -1;
+		auto encodeSpeed = measure ([&] () {
+			for (size_t block = 0; block < kNumBlocks; ++block)
+				Base64Codec::encode (origData.get () + block * kBlockSize, kBlockSize);
+		});
+		auto decodeSpeed = measure ([&] () {
+			for (auto& block : encoded)
+				Base64Codec::decode (block.data.get (), block.dataSize);
+		});
+		auto streamSpeed = measure ([&] () {
+			Base64Codec::Decoder decoder;
+			for (auto& text : texts)
+			{
+				streamDecode (decoder, text);
+				decoder.finish ();
+			}
+		});
+		printf ("  %-8s %8.2f %8.2f %8.2f\n", getName (instructionSet), encodeSpeed, decodeSpeed,
+		        streamSpeed);
+	}
 	return 0;
 }
@@ -0,0 +1,220 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cbitmapfilterkernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace VSTGUI;
+using namespace VSTGUI::BitmapFilter::Kernels;
+
+//------------------------------------------------------------------------
+// runs the row kernels of the standard bitmap filters on a 1024x1024 bitmap and reports the
+// throughput of each instruction set the CPU supports and of 1 to N threads in megapixels per
+// second
+static constexpr int32_t kWidth = 1024;
+static constexpr int32_t kHeight = 1024;
+static constexpr int32_t kBlurRadius = 4;
+
+using Pixels = std::vector<uint32_t>;
+
+//------------------------------------------------------------------------
+static double measure (const std::function<void ()>& proc)
+{
+	constexpr auto numRuns = 20;
+	proc ();
+	auto start = std::chrono::high_resolution_clock::now ();
+	for (auto i = 0; i < numRuns; ++i)
+		proc ();
+	std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now () - start;
+	return (static_cast<double> (kWidth * kHeight) * numRuns) / duration.count () / 1000000.;
+}
+
+//------------------------------------------------------------------------
+static void run (const RowKernels& kernels, const Pixels& src)
+{
+	static const char* names[] = {"scalar", "sse2", "avx2"};
+	Pixels dst (src.size ());
+	ChannelLayout layout {1, 2, 3, 0};
+	auto rows = [&] (const std::function<void (const uint32_t*, uint32_t*)>& proc) {
+		return [&, proc] () {
+			for (auto y = 0; y < kHeight; ++y)
+				proc (src.data () + y * kWidth, dst.data () + y * kWidth);
+		};
+	};
+
+	printf ("%s\n", names[static_cast<int> (kernels.instructionSet)]);
+	printf ("  SetColor      : %8.1f MP/s\n", measure (rows ([&] (const uint32_t* s, uint32_t* d) {
+				kernels.setColor (s, d, kWidth, 0x00FF8040, 0xFF000000);
+			})));
+	printf ("  ReplaceColor  : %8.1f MP/s\n", measure (rows ([&] (const uint32_t* s, uint32_t* d) {
+				kernels.replaceColor (s, d, kWidth, s[0], 0);
+			})));
+	printf ("  Grayscale     : %8.1f MP/s\n", measure (rows ([&] (const uint32_t* s, uint32_t* d) {
+				kernels.grayscale (s, d, kWidth, layout);
+			})));
+
+	// scale the bitmap by 0.7, the output rows are kWidth wide
+	std::vector<int32_t> index (kWidth);
+	std::vector<int32_t> nextIndex (kWidth);
+	std::vector<float> xDiff (kWidth);
+	float ratio = 0.7f;
+	for (auto i = 0; i < kWidth; ++i)
+	{
+		auto x = static_cast<int32_t> (ratio * i);
+		index[i] = x;
+		nextIndex[i] = std::min (x + 1, kWidth - 1);
+		xDiff[i] = (ratio * i) - x;
+	}
+	printf ("  ScaleLinear   : %8.1f MP/s\n", measure ([&] () {
+				for (auto y = 0; y < kHeight; ++y)
+				{
+					auto row = src.data () + static_cast<int32_t> (ratio * y) * kWidth;
+					kernels.gather (row, index.data (), dst.data () + y * kWidth, kWidth);
+				}
+			}));
+	printf ("  ScaleBilinear : %8.1f MP/s\n", measure ([&] () {
+				for (auto y = 0; y < kHeight; ++y)
+				{
+					auto srcY = static_cast<int32_t> (ratio * y);
+					auto row0 = src.data () + srcY * kWidth;
+					auto row1 = src.data () + std::min (srcY + 1, kHeight - 1) * kWidth;
+					kernels.bilinear (row0, row1, index.data (), nextIndex.data (), xDiff.data (),
+									  (ratio * y) - srcY, dst.data () + y * kWidth, kWidth);
+				}
+			}));
+
+	std::vector<uint8_t> divTable (256 * (kBlurRadius * 2 + 1));
+	for (auto i = 0u; i < divTable.size (); ++i)
+		divTable[i] = static_cast<uint8_t> (i / (kBlurRadius * 2 + 1));
+	std::vector<uint8_t> planeData[4];
+	BoxBlurPlanes planes;
+	for (auto i = 0; i < 4; ++i)
+	{
+		planeData[i].resize (src.size ());
+		planes.plane[i] = planeData[i].data ();
+	}
+	planes.width = kWidth;
+	planes.height = kHeight;
+	planes.radius = kBlurRadius;
+	planes.divTable = divTable.data ();
+	auto blur = [&] () {
+		kernels.boxBlurRows (reinterpret_cast<const uint8_t*> (src.data ()), planes, 0, kHeight);
+		kernels.boxBlurColumns (planes, reinterpret_cast<uint8_t*> (dst.data ()), 0, kHeight);
+	};
+	printf ("  BoxBlur       : %8.1f MP/s\n", measure (blur));
+	planes.plane[1] = planes.plane[2] = planes.plane[3] = nullptr;
+	printf ("  BoxBlur alpha : %8.1f MP/s\n", measure (blur));
+}
+
+//------------------------------------------------------------------------
+// runs the box blur and the bilinear scale tiled on 1 to N threads like the filters do and
+// checks that the output does not depend on the number of threads
+static void runScaling (const Pixels& src)
+{
+	const auto& kernels = getRowKernels ();
+	constexpr int32_t minTileRows = 16;
+
+	std::vector<uint8_t> divTable (256 * (kBlurRadius * 2 + 1));
+	for (auto i = 0u; i < divTable.size (); ++i)
+		divTable[i] = static_cast<uint8_t> (i / (kBlurRadius * 2 + 1));
+	std::vector<uint8_t> planeData[4];
+	BoxBlurPlanes planes;
+	for (auto i = 0; i < 4; ++i)
+	{
+		planeData[i].resize (src.size ());
+		planes.plane[i] = planeData[i].data ();
+	}
+	planes.width = kWidth;
+	planes.height = kHeight;
+	planes.radius = kBlurRadius;
+	planes.divTable = divTable.data ();
+
+	std::vector<int32_t> index (kWidth);
+	std::vector<int32_t> nextIndex (kWidth);
+	std::vector<float> xDiff (kWidth);
+	float ratio = 0.7f;
+	for (auto i = 0; i < kWidth; ++i)
+	{
+		auto x = static_cast<int32_t> (ratio * i);
+		index[i] = x;
+		nextIndex[i] = std::min (x + 1, kWidth - 1);
+		xDiff[i] = (ratio * i) - x;
+	}
+
+	Pixels dst (src.size ());
+	Pixels blurReference;
+	Pixels scaleReference;
+	double blurBase = 0.;
+	double scaleBase = 0.;
+	auto maxThreads = std::max (1u, std::thread::hardware_concurrency ());
+	printf ("scaling (%s kernels)\n", kernels.instructionSet == InstructionSet::AVX2
+										   ? "avx2"
+										   : kernels.instructionSet == InstructionSet::SSE2
+												 ? "sse2"
+												 : "scalar");
+	for (auto numThreads = 1u; numThreads <= maxThreads; ++numThreads)
+	{
+		auto blur = measure ([&] () {
+			runTiled (kHeight, minTileRows, numThreads, [&] (int32_t begin, int32_t end) {
+				kernels.boxBlurRows (reinterpret_cast<const uint8_t*> (src.data ()), planes, begin,
+									 end);
+			});
+			runTiled (kHeight, minTileRows, numThreads, [&] (int32_t begin, int32_t end) {
+				kernels.boxBlurColumns (planes, reinterpret_cast<uint8_t*> (dst.data ()), begin,
+										end);
+			});
+		});
+		if (numThreads == 1)
+			blurReference = dst;
+		bool blurIdentical = dst == blurReference;
+
+		auto scale = measure ([&] () {
+			runTiled (kHeight, minTileRows, numThreads, [&] (int32_t begin, int32_t end) {
+				for (auto y = begin; y < end; ++y)
+				{
+					auto srcY = static_cast<int32_t> (ratio * y);
+					auto row0 = src.data () + srcY * kWidth;
+					auto row1 = src.data () + std::min (srcY + 1, kHeight - 1) * kWidth;
+					kernels.bilinear (row0, row1, index.data (), nextIndex.data (), xDiff.data (),
+									  (ratio * y) - srcY, dst.data () + y * kWidth, kWidth);
+				}
+			});
+		});
+		if (numThreads == 1)
+		{
+			scaleReference = dst;
+			blurBase = blur;
+			scaleBase = scale;
+		}
+		bool scaleIdentical = dst == scaleReference;
+
+		printf ("  %2u threads: BoxBlur %8.1f MP/s (%4.2fx)%s, ScaleBilinear %8.1f MP/s (%4.2fx)%s\n",
+				numThreads, blur, blur / blurBase, blurIdentical ? "" : " MISMATCH", scale,
+				scale / scaleBase, scaleIdentical ? "" : " MISMATCH");
+	}
+}
+
+//------------------------------------------------------------------------
+int main ()
+{
+	std::default_random_engine rnd;
+	Pixels src (kWidth * kHeight);
+	for (auto& p : src)
+		p = static_cast<uint32_t> (rnd ());
+
+	for (auto instructionSet : {InstructionSet::Scalar, InstructionSet::SSE2, InstructionSet::AVX2})
+	{
+		if (auto kernels = getRowKernels (instructionSet))
+			run (*kernels, src);
+	}
+	runScaling (src);
+	return 0;
+}
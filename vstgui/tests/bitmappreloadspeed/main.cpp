@@ -0,0 +1,143 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cview.h"
+#include "vstgui/uidescription/uidescription.h"
+
+#include <cairo/cairo.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// writes 300 noise PNG images and a description referencing them into a temporary directory and
+// measures the time to parse the description and create a template using all images, once
+// loading the bitmaps serially on first use and once preloading them on worker threads
+namespace {
+
+constexpr auto kNumBitmaps = 300;
+constexpr auto kBitmapSize = 256;
+constexpr auto kNumRuns = 5;
+
+//------------------------------------------------------------------------
+bool writeImages (const std::string& directory)
+{
+	std::default_random_engine rnd;
+	auto surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, kBitmapSize, kBitmapSize);
+	auto stride = cairo_image_surface_get_stride (surface);
+	for (auto i = 0; i < kNumBitmaps; ++i)
+	{
+		cairo_surface_flush (surface);
+		auto data = cairo_image_surface_get_data (surface);
+		for (auto y = 0; y < kBitmapSize; ++y)
+		{
+			auto row = reinterpret_cast<uint32_t*> (data + y * stride);
+			for (auto x = 0; x < kBitmapSize; ++x)
+				row[x] = static_cast<uint32_t> (rnd ()) | 0xFF000000;
+		}
+		cairo_surface_mark_dirty (surface);
+		auto path = directory + "/bitmap" + std::to_string (i) + ".png";
+		if (cairo_surface_write_to_png (surface, path.data ()) != CAIRO_STATUS_SUCCESS)
+		{
+			cairo_surface_destroy (surface);
+			return false;
+		}
+	}
+	cairo_surface_destroy (surface);
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool writeDescription (const std::string& path)
+{
+	std::string xml = "<vstgui-ui-description version=\"1\">\n\t<bitmaps>\n";
+	for (auto i = 0; i < kNumBitmaps; ++i)
+	{
+		auto name = "bitmap" + std::to_string (i);
+		xml += "\t\t<bitmap name=\"" + name + "\" path=\"" + name + ".png\"";
+		if (i % 4)
+			xml += "/>\n";
+		else
+		{
+			xml += ">\n\t\t\t<filter name=\"Box Blur\">\n";
+			xml += "\t\t\t\t<property name=\"Radius\" value=\"4\"/>\n";
+			xml += "\t\t\t</filter>\n\t\t</bitmap>\n";
+		}
+	}
+	xml += "\t</bitmaps>\n";
+	xml += "\t<template class=\"CViewContainer\" name=\"main\" origin=\"0, 0\" size=\"1000, 1000\">\n";
+	for (auto i = 0; i < kNumBitmaps; ++i)
+	{
+		xml += "\t\t<view class=\"CView\" bitmap=\"bitmap" + std::to_string (i) + "\" origin=\"" +
+		       std::to_string ((i % 20) * 50) + ", " + std::to_string ((i / 20) * 50) +
+		       "\" size=\"50, 50\"/>\n";
+	}
+	xml += "\t</template>\n</vstgui-ui-description>\n";
+	auto file = fopen (path.data (), "w");
+	if (file == nullptr)
+		return false;
+	auto written = fwrite (xml.data (), 1, xml.size (), file);
+	fclose (file);
+	return written == xml.size ();
+}
+
+//------------------------------------------------------------------------
+double measureOpen (const std::string& path, bool preload)
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	auto desc = makeOwned<UIDescription> (CResourceDescription (path.data ()));
+	desc->setPreloadBitmaps (preload);
+	desc->parse ();
+	if (auto view = desc->createView ("main", nullptr))
+		view->forget ();
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	if (desc->getBitmap ("bitmap0") == nullptr ||
+	    desc->getBitmap ("bitmap0")->getPlatformBitmap () == nullptr)
+		printf ("bitmap not loaded\n");
+	return std::chrono::duration<double, std::milli> (duration).count ();
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	char directory[] = "/tmp/bitmappreloadspeedXXXXXX";
+	if (mkdtemp (directory) == nullptr)
+		return -1;
+	std::string descPath = std::string (directory) + "/test.uidesc";
+	if (!writeImages (directory) || !writeDescription (descPath))
+	{
+		printf ("could not write the test files to %s\n", directory);
+		return -1;
+	}
+
+	double serial = 0.;
+	double parallel = 0.;
+	for (auto run = 0; run < kNumRuns; ++run)
+	{
+		serial += measureOpen (descPath, false);
+		parallel += measureOpen (descPath, true);
+	}
+
+	printf ("%d bitmaps (%dx%d), a quarter of them box blurred\n", kNumBitmaps, kBitmapSize,
+	        kBitmapSize);
+	printf ("  serial   : %8.2f ms\n", serial / kNumRuns);
+	printf ("  preload  : %8.2f ms\n", parallel / kNumRuns);
+
+	for (auto i = 0; i < kNumBitmaps; ++i)
+		unlink ((std::string (directory) + "/bitmap" + std::to_string (i) + ".png").data ());
+	unlink (descPath.data ());
+	rmdir (directory);
+	return 0;
+}
@@ -0,0 +1,111 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cdatabrowser.h"
+#include "vstgui/lib/cdrawcontext.h"
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/idatabrowserdelegate.h"
+#include "vstgui/lib/platform/linux/cairobitmap.h"
+#include "vstgui/lib/platform/linux/cairocontext.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// scrolls through a data browser with 10k, 100k and 1M rows where every fourth row is selected and
+// reports the time to redraw the browser after each scroll step, once with a fixed row height and
+// once with variable row heights
+namespace {
+
+constexpr CCoord kBrowserWidth = 400.;
+constexpr CCoord kBrowserHeight = 600.;
+constexpr auto kNumScrollSteps = 200;
+
+//------------------------------------------------------------------------
+class Delegate : public DataBrowserDelegateAdapter
+{
+public:
+	Delegate (int32_t numRows, bool variableRowHeight)
+	: numRows (numRows), variableRowHeight (variableRowHeight)
+	{
+	}
+
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return numRows; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return 3; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return 20.; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override
+	{
+		return (kBrowserWidth - 20.) / 3.;
+	}
+	bool dbHasVariableRowHeight (CDataBrowser* browser) override { return variableRowHeight; }
+	CCoord dbGetVariableRowHeight (int32_t row, CDataBrowser* browser) override
+	{
+		return 16. + (row % 3) * 4.;
+	}
+	void dbDrawCell (CDrawContext* context, const CRect& size, int32_t row, int32_t column,
+	                 int32_t flags, CDataBrowser* browser) override
+	{
+		context->setFillColor (flags & kRowSelected ? kBlueCColor : kGreyCColor);
+		context->drawRect (size, kDrawFilled);
+	}
+
+private:
+	int32_t numRows;
+	bool variableRowHeight;
+};
+
+//------------------------------------------------------------------------
+double run (int32_t numRows, bool variableRowHeight)
+{
+	CRect size (0., 0., kBrowserWidth, kBrowserHeight);
+	auto frame = new CFrame (size, nullptr);
+	Delegate delegate (numRows, variableRowHeight);
+	auto browser = new CDataBrowser (
+		size, &delegate,
+		CDataBrowser::kMultiSelectionStyle | CScrollView::kVerticalScrollbar | CScrollView::kDontDrawFrame,
+		20.);
+	frame->addView (browser);
+	frame->attached (frame);
+	for (auto row = 0; row < numRows; row += 4)
+		browser->selectRow (row);
+
+	auto surfaceSize = size.getSize ();
+	auto bitmap = owned (new Cairo::Bitmap (&surfaceSize));
+	auto context = owned (new Cairo::Context (size, bitmap->getSurface ()));
+	context->beginDraw ();
+	auto start = std::chrono::high_resolution_clock::now ();
+	for (auto step = 0; step < kNumScrollSteps; ++step)
+	{
+		browser->makeRowVisible (static_cast<int32_t> (
+			static_cast<int64_t> (numRows - 1) * step / (kNumScrollSteps - 1)));
+		context->setClipRect (size);
+		frame->drawRect (context, size);
+	}
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	context->endDraw ();
+	frame->close ();
+	return std::chrono::duration<double, std::milli> (duration).count () / kNumScrollSteps;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	printf ("%gx%g data browser, %d scroll steps\n", kBrowserWidth, kBrowserHeight,
+	        kNumScrollSteps);
+	for (auto numRows : {10000, 100000, 1000000})
+	{
+		auto fixedHeight = run (numRows, false);
+		auto variableHeight = run (numRows, true);
+		printf ("  %7d rows: fixed height %8.3f ms, variable height %8.3f ms per repaint\n",
+		        numRows, fixedHeight, variableHeight);
+	}
+	return 0;
+}
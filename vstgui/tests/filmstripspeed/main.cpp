@@ -0,0 +1,101 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/controls/cknob.h"
+#include "vstgui/lib/platform/linux/cairobitmap.h"
+#include "vstgui/lib/platform/linux/cairocontext.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// animates 500 filmstrip knobs at once and reports the time per frame to redraw the dirty rects
+// of all knobs, once with the knobs on whole pixels and once with the knobs on half pixels, which
+// need to be drawn with a clip and a filtered pattern
+namespace {
+
+constexpr CCoord kKnobSize = 48.;
+constexpr auto kNumFrames = 64;
+constexpr auto kNumKnobs = 500;
+constexpr auto kColumns = 25;
+constexpr auto kNumRuns = 50;
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> createFilmstrip ()
+{
+	CPoint size (kKnobSize, kKnobSize * kNumFrames);
+	auto bitmap = makeOwned<CBitmap> (makeOwned<Cairo::Bitmap> (&size));
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap, false)))
+	{
+		do
+		{
+			auto x = accessor->getX ();
+			auto y = accessor->getY ();
+			accessor->setColor (CColor (static_cast<uint8_t> (x * 5), static_cast<uint8_t> (y),
+			                            static_cast<uint8_t> ((y / kKnobSize) * 4),
+			                            static_cast<uint8_t> (128 + (x + y) % 128)));
+		} while (++(*accessor));
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+double run (CBitmap* filmstrip, CCoord knobOffset)
+{
+	auto rows = (kNumKnobs + kColumns - 1) / kColumns;
+	CRect size (0., 0., kColumns * kKnobSize + 1., rows * kKnobSize + 1.);
+	auto frame = new CFrame (size, nullptr);
+	std::vector<CAnimKnob*> knobs;
+	for (auto i = 0; i < kNumKnobs; ++i)
+	{
+		CRect r (0., 0., kKnobSize, kKnobSize);
+		r.offset ((i % kColumns) * kKnobSize + knobOffset, (i / kColumns) * kKnobSize + knobOffset);
+		auto knob = new CAnimKnob (r, nullptr, i, kNumFrames, kKnobSize, filmstrip);
+		frame->addView (knob);
+		knobs.push_back (knob);
+	}
+	frame->attached (frame);
+
+	auto surfaceSize = size.getSize ();
+	auto bitmap = owned (new Cairo::Bitmap (&surfaceSize));
+	auto context = owned (new Cairo::Context (size, bitmap->getSurface ()));
+	context->beginDraw ();
+	auto start = std::chrono::high_resolution_clock::now ();
+	for (auto run = 0; run < kNumRuns; ++run)
+	{
+		for (auto i = 0; i < kNumKnobs; ++i)
+		{
+			knobs[i]->setValueNormalized (static_cast<float> ((run + i) % kNumFrames) / kNumFrames);
+			auto r = knobs[i]->getViewSize ();
+			r.extend (1., 1.);
+			context->setClipRect (r);
+			frame->drawRect (context, r);
+		}
+	}
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	context->endDraw ();
+	frame->close ();
+	return std::chrono::duration<double, std::milli> (duration).count () / kNumRuns;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	auto filmstrip = createFilmstrip ();
+	printf ("%d filmstrip knobs (%gx%g, %d frames)\n", kNumKnobs, kKnobSize, kKnobSize,
+	        kNumFrames);
+	printf ("  whole pixels : %8.3f ms per frame\n", run (filmstrip, 0.));
+	printf ("  half pixels  : %8.3f ms per frame\n", run (filmstrip, 0.5));
+	return 0;
+}
@@ -0,0 +1,93 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cfont.h"
+#include "vstgui/lib/cstring.h"
+#include "vstgui/lib/platform/linux/cairobitmap.h"
+#include "vstgui/lib/platform/linux/cairocontext.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// measures the latency of the first font draw of a process, which includes the enumeration of
+// the system fonts. Every measurement runs in a new process, the cold runs start with an empty
+// font list cache, the warm runs reuse the cache written by the previous run.
+namespace {
+
+constexpr auto kNumRuns = 5;
+
+//------------------------------------------------------------------------
+int measureFirstDraw ()
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	CPoint size (200, 20);
+	auto bitmap = owned (new Cairo::Bitmap (&size));
+	auto context = owned (new Cairo::Context (bitmap));
+	auto font = makeOwned<CFontDesc> ("Liberation Sans", 12.);
+	context->beginDraw ();
+	context->setFont (font);
+	context->drawString ("Cutoff", CRect (0, 0, 200, 20));
+	context->endDraw ();
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	printf ("%f\n", std::chrono::duration<double, std::milli> (duration).count ());
+	return 0;
+}
+
+//------------------------------------------------------------------------
+double runChild (const std::string& executable, const std::string& cacheDir)
+{
+	setenv ("XDG_CACHE_HOME", cacheDir.data (), 1);
+	auto command = executable + " --child";
+	double result = -1.;
+	if (auto pipe = popen (command.data (), "r"))
+	{
+		if (fscanf (pipe, "%lf", &result) != 1)
+			result = -1.;
+		pclose (pipe);
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+std::string makeCacheDir ()
+{
+	char dir[] = "/tmp/fontstartupspeedXXXXXX";
+	if (!mkdtemp (dir))
+		return {};
+	return dir;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	if (argc > 1 && std::strcmp (argv[1], "--child") == 0)
+		return measureFirstDraw ();
+
+	double cold = 0.;
+	double warm = 0.;
+	for (auto i = 0; i < kNumRuns; ++i)
+	{
+		auto cacheDir = makeCacheDir ();
+		if (cacheDir.empty ())
+			return 1;
+		cold += runChild (argv[0], cacheDir);
+		warm += runChild (argv[0], cacheDir);
+		std::system (("rm -rf " + cacheDir).data ());
+	}
+	printf ("first font draw latency, %d runs\n", kNumRuns);
+	printf ("  cold font list cache: %8.2f ms\n", cold / kNumRuns);
+	printf ("  warm font list cache: %8.2f ms\n", warm / kNumRuns);
+	return 0;
+}
@@ -0,0 +1,87 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cinvalidrectlist.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// simulates a meter heavy editor: 64 meters in a 16x4 grid, each meter invalidates its value
+// area and its peak label every frame, some meters are covered by an overlay that invalidates as
+// well. Reports the pixels redrawn per frame with a plain rect list and with the region.
+static void run (CCoord perRectCost, size_t maxRects)
+{
+	constexpr auto numFrames = 1000;
+	constexpr auto metersPerRow = 16;
+	constexpr auto meterRows = 4;
+	constexpr CCoord meterWidth = 20.;
+	constexpr CCoord meterHeight = 150.;
+	constexpr CCoord meterSpacing = 4.;
+
+	std::default_random_engine rnd;
+	std::uniform_real_distribution<CCoord> level (0., meterHeight);
+
+	double plainPixels = 0.;
+	double regionPixels = 0.;
+	size_t plainRects = 0;
+	size_t regionRects = 0;
+	std::chrono::nanoseconds duration {0};
+
+	CInvalidRectList region (perRectCost, maxRects);
+	for (auto frame = 0; frame < numFrames; ++frame)
+	{
+		region.clear ();
+		auto start = std::chrono::high_resolution_clock::now ();
+		for (auto row = 0; row < meterRows; ++row)
+		{
+			for (auto col = 0; col < metersPerRow; ++col)
+			{
+				CRect meter (0., 0., meterWidth, meterHeight);
+				meter.offset (col * (meterWidth + meterSpacing),
+							  row * (meterHeight + meterSpacing));
+				CRect value (meter);
+				value.top = meter.bottom - level (rnd);
+				CRect label (meter.left, meter.top, meter.right, meter.top + 12.);
+				CRect overlay (meter);
+				overlay.extend (meterSpacing, meterSpacing);
+				if ((col % 4) != 0)
+					overlay = {};
+
+				for (const auto& r : {value, label, overlay})
+				{
+					if (r.isEmpty ())
+						continue;
+					plainPixels += r.getWidth () * r.getHeight ();
+					++plainRects;
+					region.add (r);
+				}
+			}
+		}
+		duration += std::chrono::high_resolution_clock::now () - start;
+		regionPixels += region.getArea ();
+		regionRects += region.size ();
+	}
+
+	printf ("per rect cost %.0f, max rects %zu\n", perRectCost, maxRects);
+	printf ("  plain list : %10.0f pixels/frame, %6.1f draw passes/frame\n",
+			plainPixels / numFrames, static_cast<double> (plainRects) / numFrames);
+	printf ("  region     : %10.0f pixels/frame, %6.1f draw passes/frame\n",
+			regionPixels / numFrames, static_cast<double> (regionRects) / numFrames);
+	printf ("  region time: %10.2f µs/frame\n",
+			std::chrono::duration<double, std::micro> (duration).count () / numFrames);
+}
+
+//------------------------------------------------------------------------
+int main ()
+{
+	run (0., 1000);
+	run (256., 1000);
+	run (1024., 1000);
+	run (CInvalidRectList::kDefaultPerRectCost, CInvalidRectList::kDefaultMaxRects);
+	return 0;
+}
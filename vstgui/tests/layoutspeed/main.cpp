@@ -0,0 +1,171 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/crowcolumnview.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// builds a nested layout of alternating row and column views with stretched and autosized
+// children, like the layouts of a plug-in editor which follows the size of its window, resizes the
+// window step by step and reports the layout passes and the time per step. The synchronous layout
+// done before the frame layout phase is emulated by a subclass which lays out on every change.
+// Additionally the time to add child views to an attached container is reported.
+namespace {
+
+constexpr auto kDepth = 5;
+constexpr auto kNumChildren = 3;
+constexpr auto kNumResizeSteps = 100;
+constexpr auto kNumAddedViews = 500;
+constexpr CCoord kMinSize = 400.;
+
+uint64_t gNumLayouts = 0;
+
+//------------------------------------------------------------------------
+class CountingRowColumnView : public CRowColumnView
+{
+public:
+	CountingRowColumnView (const CRect& size, Style style)
+	: CRowColumnView (size, style, kStretchEqualy)
+	{
+	}
+
+	void layoutViews () override
+	{
+		++gNumLayouts;
+		CRowColumnView::layoutViews ();
+	}
+};
+
+//------------------------------------------------------------------------
+class SynchronousRowColumnView : public CountingRowColumnView
+{
+public:
+	using CountingRowColumnView::CountingRowColumnView;
+
+	void setViewSize (const CRect& rect, bool invalid = true) override
+	{
+		CViewContainer::setViewSize (rect, invalid);
+		if (isAttached ())
+			layoutViews ();
+	}
+
+	bool addView (CView* pView, CView* pBefore = nullptr) override
+	{
+		if (!CViewContainer::addView (pView, pBefore))
+			return false;
+		if (isAttached ())
+			layoutViews ();
+		return true;
+	}
+
+	CMessageResult notify (CBaseObject* sender, IdStringPtr message) override
+	{
+		if (message == kMsgViewSizeChanged && isAttached ())
+			layoutViews ();
+		return CViewContainer::notify (sender, message);
+	}
+};
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (Proc proc)
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	proc ();
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	return std::chrono::duration<double, std::milli> (duration).count ();
+}
+
+//------------------------------------------------------------------------
+template <typename ContainerType>
+CView* createLayout (int32_t depth, const CRect& size)
+{
+	if (depth == kDepth)
+	{
+		auto view = new CView (size);
+		view->setAutosizeFlags (kAutosizeAll);
+		return view;
+	}
+	auto style = depth % 2 ? CRowColumnView::kColumnStyle : CRowColumnView::kRowStyle;
+	auto container = new ContainerType (size, style);
+	container->setAutosizeFlags (kAutosizeAll);
+	CRect childSize (size);
+	childSize.originize ();
+	if (style == CRowColumnView::kRowStyle)
+		childSize.setHeight (size.getHeight () / kNumChildren);
+	else
+		childSize.setWidth (size.getWidth () / kNumChildren);
+	for (auto i = 0; i < kNumChildren; ++i)
+		container->addView (createLayout<ContainerType> (depth + 1, childSize));
+	return container;
+}
+
+//------------------------------------------------------------------------
+template <typename ContainerType>
+void runResize (const char* name, bool deferred)
+{
+	CRect size (0, 0, kMinSize, kMinSize);
+	auto frame = new CFrame (size, nullptr);
+	frame->addView (createLayout<ContainerType> (0, size));
+	frame->attached (frame);
+	frame->flushLayout ();
+
+	gNumLayouts = 0;
+	auto time = measure ([&] () {
+		for (auto step = 1; step <= kNumResizeSteps; ++step)
+		{
+			frame->setSize (kMinSize + step, kMinSize + step / 2);
+			// the frame would draw now
+			if (deferred)
+				frame->flushLayout ();
+		}
+	});
+	printf ("  %-12s: %10.1f layouts/step %10.3f ms/step\n", name,
+	        static_cast<double> (gNumLayouts) / kNumResizeSteps, time / kNumResizeSteps);
+	frame->forget ();
+}
+
+//------------------------------------------------------------------------
+template <typename ContainerType>
+void runAddViews (const char* name)
+{
+	CRect size (0, 0, kMinSize, kMinSize);
+	auto frame = new CFrame (size, nullptr);
+	auto container = new ContainerType (size, CRowColumnView::kRowStyle);
+	frame->addView (container);
+	frame->attached (frame);
+
+	gNumLayouts = 0;
+	auto time = measure ([&] () {
+		for (auto i = 0; i < kNumAddedViews; ++i)
+			container->addView (new CView (CRect (0, 0, 20, 20)));
+		frame->flushLayout ();
+	});
+	printf ("  %-12s: %10llu layouts %14.3f ms\n", name,
+	        static_cast<unsigned long long> (gNumLayouts), time);
+	frame->forget ();
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	printf ("window resize, %d levels with %d children each, %d steps\n", kDepth, kNumChildren,
+	        kNumResizeSteps);
+	runResize<SynchronousRowColumnView> ("synchronous", false);
+	runResize<CountingRowColumnView> ("deferred", true);
+	printf ("add %d views to an attached container\n", kNumAddedViews);
+	runAddViews<SynchronousRowColumnView> ("synchronous");
+	runAddViews<CountingRowColumnView> ("deferred");
+	return 0;
+}
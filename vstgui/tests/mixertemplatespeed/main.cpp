@@ -0,0 +1,134 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cview.h"
+#include "vstgui/uidescription/uidescription.h"
+#include "vstgui/uidescription/xmlparser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// creates a mixer template with 64 channel strips, each one a sub template with knobs, a fader,
+// buttons and labels referencing colors, fonts and control tags, and reports the time needed to
+// create the template the first time and again afterwards
+namespace {
+
+constexpr auto kNumStrips = 64;
+constexpr auto kNumKnobs = 4;
+constexpr auto kNumRuns = 20;
+constexpr auto kStripWidth = 60;
+
+//------------------------------------------------------------------------
+std::string createDescription ()
+{
+	std::string xml = "<vstgui-ui-description version=\"1\">\n";
+	xml += "\t<colors>\n"
+	       "\t\t<color name=\"strip\" rgba=\"#303030ff\"/>\n"
+	       "\t\t<color name=\"label\" rgba=\"#e0e0e0ff\"/>\n"
+	       "\t\t<color name=\"frame\" rgba=\"#808080ff\"/>\n"
+	       "\t\t<color name=\"corona\" rgba=\"#ff8000ff\"/>\n"
+	       "\t</colors>\n";
+	xml += "\t<fonts>\n"
+	       "\t\t<font name=\"label\" font-name=\"Arial\" size=\"11\"/>\n"
+	       "\t\t<font name=\"value\" font-name=\"Arial\" size=\"9\" bold=\"true\"/>\n"
+	       "\t</fonts>\n";
+	xml += "\t<control-tags>\n";
+	for (auto i = 0; i < kNumKnobs + 3; ++i)
+	{
+		xml += "\t\t<control-tag name=\"param" + std::to_string (i) + "\" tag=\"" +
+		       std::to_string (i) + "\"/>\n";
+	}
+	xml += "\t</control-tags>\n";
+
+	xml += "\t<template class=\"CViewContainer\" name=\"strip\" origin=\"0, 0\" size=\"" +
+	       std::to_string (kStripWidth) + ", 400\" background-color=\"strip\">\n";
+	xml += "\t\t<view class=\"CTextLabel\" origin=\"0, 0\" size=\"60, 20\" title=\"Channel\" "
+	       "font=\"label\" font-color=\"label\" back-color=\"strip\" frame-color=\"frame\" "
+	       "text-alignment=\"center\" transparent=\"true\"/>\n";
+	for (auto i = 0; i < kNumKnobs; ++i)
+	{
+		auto top = std::to_string (20 + i * 50);
+		xml += "\t\t<view class=\"CKnob\" origin=\"10, " + top +
+		       "\" size=\"40, 40\" control-tag=\"param" + std::to_string (i) +
+		       "\" min-value=\"0\" max-value=\"1\" default-value=\"0.5\" corona-color=\"corona\" "
+		       "handle-color=\"label\" handle-line-width=\"2\" corona-inset=\"2\" "
+		       "angle-start=\"135\" angle-range=\"270\" corona-drawing=\"true\" "
+		       "wheel-inc-value=\"0.1\"/>\n";
+	}
+	xml += "\t\t<view class=\"CSlider\" origin=\"20, 220\" size=\"20, 120\" control-tag=\"param" +
+	       std::to_string (kNumKnobs) + "\" orientation=\"vertical\" min-value=\"0\" "
+	       "max-value=\"1\" default-value=\"0.75\" draw-frame-color=\"frame\" "
+	       "draw-back-color=\"strip\" draw-value-color=\"corona\" draw-frame=\"true\" "
+	       "draw-back=\"true\" draw-value=\"true\" handle-offset=\"0, 0\" "
+	       "bitmap-offset=\"0, 0\"/>\n";
+	xml += "\t\t<view class=\"CTextButton\" origin=\"5, 345\" size=\"24, 20\" control-tag=\"param" +
+	       std::to_string (kNumKnobs + 1) + "\" title=\"M\" font=\"value\" "
+	       "text-color=\"label\" frame-color=\"frame\" kick-style=\"false\"/>\n";
+	xml += "\t\t<view class=\"CTextButton\" origin=\"31, 345\" size=\"24, 20\" "
+	       "control-tag=\"param" + std::to_string (kNumKnobs + 2) + "\" title=\"S\" font=\"value\" "
+	       "text-color=\"label\" frame-color=\"frame\" kick-style=\"false\"/>\n";
+	xml += "\t\t<view class=\"CTextLabel\" origin=\"0, 370\" size=\"60, 20\" title=\"-inf\" "
+	       "font=\"value\" font-color=\"label\" back-color=\"strip\" text-alignment=\"center\" "
+	       "transparent=\"true\"/>\n";
+	xml += "\t</template>\n";
+
+	xml += "\t<template class=\"CViewContainer\" name=\"mixer\" origin=\"0, 0\" size=\"" +
+	       std::to_string (kNumStrips * kStripWidth) + ", 400\">\n";
+	for (auto i = 0; i < kNumStrips; ++i)
+	{
+		xml += "\t\t<view template=\"strip\" origin=\"" + std::to_string (i * kStripWidth) +
+		       ", 0\" size=\"" + std::to_string (kStripWidth) + ", 400\"/>\n";
+	}
+	xml += "\t</template>\n</vstgui-ui-description>\n";
+	return xml;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (Proc proc)
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	proc ();
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	return std::chrono::duration<double, std::milli> (duration).count ();
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	auto xml = createDescription ();
+	Xml::MemoryContentProvider provider (xml.data (), static_cast<uint32_t> (xml.size ()));
+	UIDescription desc (&provider);
+	if (!desc.parse ())
+	{
+		printf ("parsing failed\n");
+		return 1;
+	}
+
+	auto firstCreateTime = measure ([&] () {
+		if (auto view = desc.createView ("mixer", nullptr))
+			view->forget ();
+	});
+	auto createTime = measure ([&] () {
+		for (auto run = 0; run < kNumRuns; ++run)
+		{
+			if (auto view = desc.createView ("mixer", nullptr))
+				view->forget ();
+		}
+	});
+
+	printf ("%d strips, %d views per strip\n", kNumStrips, kNumKnobs + 6);
+	printf ("  create (first)  : %8.2f ms\n", firstCreateTime);
+	printf ("  create (cached) : %8.2f ms\n", createTime / kNumRuns);
+	return 0;
+}
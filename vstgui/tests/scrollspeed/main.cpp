@@ -0,0 +1,250 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cdatabrowser.h"
+#include "vstgui/lib/cdrawcontext.h"
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/cstring.h"
+#include "vstgui/lib/idatabrowserdelegate.h"
+#include "vstgui/lib/platform/iplatformframe.h"
+#include "vstgui/lib/platform/platform_x11.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <xcb/xcb.h>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// scrolls a data browser with 100k rows in an X11 frame and reports the time per scroll step the
+// frame takes to draw and present the result, once with an opaque scroll container which lets
+// CFrame::scrollRect move the content inside the back buffer and only draws the exposed rows, and
+// once with the default transparent scroll container which redraws the whole browser.
+// Needs an X server, for example Xvfb.
+namespace {
+
+constexpr CCoord kBrowserWidth = 600.;
+constexpr CCoord kBrowserHeight = 400.;
+constexpr CCoord kRowHeight = 20.;
+constexpr auto kNumRows = 100000;
+constexpr auto kNumColumns = 4;
+constexpr auto kRowsPerStep = 3;
+constexpr auto kNumScrollSteps = 200;
+
+using Clock = std::chrono::steady_clock;
+
+//------------------------------------------------------------------------
+class EventLoop : public X11::IRunLoop, public NonAtomicReferenceCounted
+{
+public:
+	bool registerEventHandler (int fd, X11::IEventHandler* handler) override
+	{
+		eventHandlers.push_back ({fd, handler});
+		return true;
+	}
+
+	bool unregisterEventHandler (X11::IEventHandler* handler) override
+	{
+		eventHandlers.erase (std::remove_if (eventHandlers.begin (), eventHandlers.end (),
+											 [&] (const EventHandler& h) { return h.handler == handler; }),
+							 eventHandlers.end ());
+		return true;
+	}
+
+	bool registerTimer (uint64_t interval, X11::ITimerHandler* handler) override
+	{
+		timers.push_back ({handler, std::chrono::milliseconds (interval),
+						   Clock::now () + std::chrono::milliseconds (interval)});
+		return true;
+	}
+
+	bool unregisterTimer (X11::ITimerHandler* handler) override
+	{
+		timers.erase (std::remove_if (timers.begin (), timers.end (),
+									  [&] (const Timer& t) { return t.handler == handler; }),
+					  timers.end ());
+		return true;
+	}
+
+	template<typename Proc>
+	bool runUntil (Proc proc, std::chrono::milliseconds timeout = std::chrono::milliseconds (2000))
+	{
+		auto end = Clock::now () + timeout;
+		while (!proc ())
+		{
+			auto now = Clock::now ();
+			if (now >= end)
+				return false;
+			auto next = end;
+			for (const auto& timer : timers)
+				next = std::min (next, timer.fireTime);
+			auto wait = std::chrono::duration_cast<std::chrono::milliseconds> (next - now).count ();
+			std::vector<pollfd> fds;
+			for (const auto& h : eventHandlers)
+				fds.push_back ({h.fd, POLLIN, 0});
+			if (poll (fds.data (), fds.size (), static_cast<int> (std::max<int64_t> (wait, 0))) > 0)
+			{
+				auto handlers = eventHandlers;
+				for (auto i = 0u; i < fds.size (); ++i)
+				{
+					if (fds[i].revents & POLLIN)
+						handlers[i].handler->onEvent ();
+				}
+			}
+			fireTimers ();
+		}
+		return true;
+	}
+
+private:
+	struct EventHandler
+	{
+		int fd;
+		X11::IEventHandler* handler;
+	};
+
+	struct Timer
+	{
+		X11::ITimerHandler* handler;
+		Clock::duration interval;
+		Clock::time_point fireTime;
+	};
+
+	void fireTimers ()
+	{
+		auto now = Clock::now ();
+		auto dueTimers = timers;
+		for (const auto& timer : dueTimers)
+		{
+			if (timer.fireTime > now)
+				continue;
+			auto it = std::find_if (timers.begin (), timers.end (),
+									[&] (const Timer& t) { return t.handler == timer.handler; });
+			if (it == timers.end ())
+				continue;
+			it->fireTime = now + it->interval;
+			timer.handler->onTimer ();
+		}
+	}
+
+	std::vector<EventHandler> eventHandlers;
+	std::vector<Timer> timers;
+};
+
+//------------------------------------------------------------------------
+class Delegate : public DataBrowserDelegateAdapter
+{
+public:
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return kNumRows; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return kNumColumns; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return kRowHeight; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override
+	{
+		return (kBrowserWidth - 20.) / kNumColumns;
+	}
+	void dbDrawCell (CDrawContext* context, const CRect& size, int32_t row, int32_t column,
+	                 int32_t flags, CDataBrowser* browser) override
+	{
+		context->setFillColor (row % 2 ? CColor (50, 50, 50) : CColor (64, 64, 64));
+		context->drawRect (size, kDrawFilled);
+		context->setFont (kNormalFont);
+		context->setFontColor (kWhiteCColor);
+		auto text = "Preset " + std::to_string (row) + " - " + std::to_string (column);
+		context->drawString (UTF8String (text), size, kLeftText);
+	}
+};
+
+//------------------------------------------------------------------------
+struct Result
+{
+	double drawTime {0.};
+	double frameTime {0.};
+};
+
+//------------------------------------------------------------------------
+bool run (xcb_connection_t* connection, bool opaqueScrollContainer, Result& result)
+{
+	CRect size (0., 0., kBrowserWidth, kBrowserHeight);
+	auto runLoop = makeOwned<EventLoop> ();
+	X11::FrameConfig config;
+	config.runLoop = runLoop;
+	auto frame = new CFrame (size, nullptr);
+	Delegate delegate;
+	auto browser = new CDataBrowser (
+		size, &delegate, CScrollView::kVerticalScrollbar | CScrollView::kDontDrawFrame, 20.);
+	frame->addView (browser);
+	// only the content of an opaque scroll container is moved with CFrame::scrollRect, a
+	// transparent one invalidates itself when it scrolls
+	std::vector<CViewContainer*> containers;
+	browser->getChildViewsOfType<CViewContainer> (containers);
+	for (auto container : containers)
+	{
+		container->setTransparency (!opaqueScrollContainer);
+		container->setBackgroundColor (kBlackCColor);
+	}
+	auto root = xcb_setup_roots_iterator (xcb_get_setup (connection)).data->root;
+	if (!frame->open (reinterpret_cast<void*> (static_cast<uintptr_t> (root)),
+	                  PlatformType::kX11EmbedWindowID, &config))
+	{
+		frame->forget ();
+		return false;
+	}
+	auto window = reinterpret_cast<uintptr_t> (frame->getPlatformFrame ()->getPlatformRepresentation ());
+	xcb_map_window (connection, static_cast<xcb_window_t> (window));
+	xcb_flush (connection);
+	auto stats = dynamic_cast<IPlatformFrameTimingStatsExtension*> (frame->getPlatformFrame ());
+	auto frameCount = [&] () { return stats->getTimingStats ().frameCount; };
+	auto success = runLoop->runUntil ([&] () { return frameCount () > 0; });
+
+	auto visibleRows = static_cast<int32_t> (kBrowserHeight / kRowHeight);
+	for (auto step = 0; success && step < kNumScrollSteps; ++step)
+	{
+		auto count = frameCount ();
+		browser->makeRowVisible (visibleRows - 1 + (step + 1) * kRowsPerStep);
+		success = runLoop->runUntil ([&] () { return frameCount () > count; });
+		result.drawTime += stats->getTimingStats ().lastDrawTime;
+		result.frameTime += stats->getTimingStats ().lastFrameTime;
+	}
+	result.drawTime /= kNumScrollSteps;
+	result.frameTime /= kNumScrollSteps;
+	frame->close ();
+	return success;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	auto connection = xcb_connect (nullptr, nullptr);
+	if (xcb_connection_has_error (connection))
+	{
+		printf ("scrollspeed needs an X server\n");
+		xcb_disconnect (connection);
+		return -1;
+	}
+	Result scrollCopy;
+	Result fullRedraw;
+	auto success = run (connection, true, scrollCopy) && run (connection, false, fullRedraw);
+	xcb_disconnect (connection);
+	if (!success)
+	{
+		printf ("the frame did not draw\n");
+		return -1;
+	}
+	printf ("%gx%g data browser, %d rows, %g pixels per scroll step, %d steps\n", kBrowserWidth,
+	        kBrowserHeight, kNumRows, kRowHeight * kRowsPerStep, kNumScrollSteps);
+	printf ("  scroll copy : draw %8.3f ms, frame %8.3f ms per step\n", scrollCopy.drawTime,
+	        scrollCopy.frameTime);
+	printf ("  full redraw : draw %8.3f ms, frame %8.3f ms per step\n", fullRedraw.drawTime,
+	        fullRedraw.frameTime);
+	return 0;
+}
@@ -0,0 +1,88 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cdrawmethods.h"
+#include "vstgui/lib/cfont.h"
+#include "vstgui/lib/cstring.h"
+#include "vstgui/lib/platform/linux/cairobitmap.h"
+#include "vstgui/lib/platform/linux/cairocontext.h"
+#include "vstgui/lib/platform/linux/cairotextlayout.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// draws 10000 parameter labels per frame into an offscreen cairo context, half of them
+// truncated to the width of their cell, and reports the time per frame with and without the
+// text layout cache
+namespace {
+
+constexpr auto kNumFrames = 20;
+constexpr auto kNumLabels = 10000;
+constexpr auto kNumDistinctLabels = 500;
+constexpr CCoord kCellWidth = 80.;
+constexpr CCoord kCellHeight = 16.;
+constexpr auto kColumns = 12;
+
+//------------------------------------------------------------------------
+double run (CDrawContext* context, CFontRef font, const std::vector<UTF8String>& labels)
+{
+	context->setFont (font);
+	context->setFontColor (kWhiteCColor);
+	auto start = std::chrono::high_resolution_clock::now ();
+	for (auto frame = 0; frame < kNumFrames; ++frame)
+	{
+		context->beginDraw ();
+		for (auto i = 0; i < kNumLabels; ++i)
+		{
+			CRect cell (0., 0., kCellWidth, kCellHeight);
+			cell.offset ((i % kColumns) * kCellWidth, ((i / kColumns) % 48) * kCellHeight);
+			const auto& label = labels[i % labels.size ()];
+			if (i % 2)
+			{
+				auto truncated = CDrawMethods::createTruncatedText (
+					CDrawMethods::kTextTruncateTail, label, font, cell.getWidth ());
+				context->drawString (truncated.getPlatformString (), cell, kLeftText);
+			}
+			else
+				context->drawString (label.getPlatformString (), cell, kLeftText);
+		}
+		context->endDraw ();
+	}
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	return std::chrono::duration<double, std::milli> (duration).count () / kNumFrames;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	std::vector<UTF8String> labels;
+	for (auto i = 0; i < kNumDistinctLabels; ++i)
+		labels.emplace_back ("Parameter " + std::to_string (i) + " Cutoff Frequency");
+
+	CPoint size (kColumns * kCellWidth, 48 * kCellHeight);
+	auto bitmap = owned (new Cairo::Bitmap (&size));
+	auto context = owned (new Cairo::Context (bitmap));
+	auto font = makeOwned<CFontDesc> ("Liberation Sans", 11.);
+
+	auto& cache = Cairo::TextLayoutCache::instance ();
+	cache.setCapacity (0);
+	auto uncached = run (context, font, labels);
+	cache.setCapacity (Cairo::TextLayoutCache::kDefaultCapacity);
+	auto cached = run (context, font, labels);
+
+	printf ("%d labels per frame, %d distinct strings\n", kNumLabels, kNumDistinctLabels);
+	printf ("  uncached layout : %8.2f ms/frame\n", uncached);
+	printf ("  cached layout   : %8.2f ms/frame\n", cached);
+	return 0;
+}
@@ -0,0 +1,102 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/platform/linux/cairobitmap.h"
+#include "vstgui/lib/platform/linux/cairocontext.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// fills a full window with a tiled background bitmap and with a nine-part bitmap with a 1 pixel
+// repeating edge and center and reports the time per fill, once drawing every tile separately and
+// once with one repeating pattern per part
+namespace {
+
+constexpr CCoord kWindowWidth = 1920.;
+constexpr CCoord kWindowHeight = 1080.;
+constexpr CCoord kCornerSize = 10.;
+constexpr auto kNumRuns = 10;
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> createBitmap (CPoint size)
+{
+	auto bitmap = makeOwned<CBitmap> (makeOwned<Cairo::Bitmap> (&size));
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap, false)))
+	{
+		do
+		{
+			auto x = accessor->getX ();
+			auto y = accessor->getY ();
+			accessor->setColor (CColor (static_cast<uint8_t> (x * 8), static_cast<uint8_t> (y * 8),
+			                            128, static_cast<uint8_t> (200 + (x + y) % 56)));
+		} while (++(*accessor));
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+void drawNinePartTiles (CDrawContext* context, CBitmap* bitmap, const CRect& dest,
+                        const CNinePartTiledDescription& desc)
+{
+	CRect srcRects[CNinePartTiledDescription::kPartCount];
+	CRect dstRects[CNinePartTiledDescription::kPartCount];
+	desc.calcRects (CRect (0., 0., bitmap->getWidth (), bitmap->getHeight ()), srcRects);
+	desc.calcRects (dest, dstRects);
+	for (auto i = 0; i < CNinePartTiledDescription::kPartCount; ++i)
+		context->CDrawContext::fillRectWithBitmap (bitmap, srcRects[i], dstRects[i], 1.f);
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (CDrawContext* context, Proc proc)
+{
+	context->beginDraw ();
+	auto start = std::chrono::high_resolution_clock::now ();
+	for (auto i = 0; i < kNumRuns; ++i)
+		proc ();
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	context->endDraw ();
+	return std::chrono::duration<double, std::milli> (duration).count () / kNumRuns;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	CRect window (0., 0., kWindowWidth, kWindowHeight);
+	auto windowSize = window.getSize ();
+	auto target = owned (new Cairo::Bitmap (&windowSize));
+	auto context = owned (new Cairo::Context (window, target->getSurface ()));
+
+	auto background = createBitmap ({64., 64.});
+	CRect backgroundRect (0., 0., 64., 64.);
+	auto backgroundTiles = measure (context, [&] () {
+		context->CDrawContext::fillRectWithBitmap (background, backgroundRect, window, 1.f);
+	});
+	auto backgroundPattern = measure (context, [&] () {
+		context->fillRectWithBitmap (background, backgroundRect, window, 1.f);
+	});
+
+	auto ninePart = createBitmap ({kCornerSize * 2. + 1., kCornerSize * 2. + 1.});
+	CNinePartTiledDescription desc (kCornerSize, kCornerSize, kCornerSize, kCornerSize);
+	auto ninePartTiles =
+		measure (context, [&] () { drawNinePartTiles (context, ninePart, window, desc); });
+	auto ninePartPattern =
+		measure (context, [&] () { context->drawBitmapNinePartTiled (ninePart, window, desc); });
+
+	printf ("%gx%g window\n", kWindowWidth, kWindowHeight);
+	printf ("  64x64 background tiles   : %8.3f ms\n", backgroundTiles);
+	printf ("  64x64 background pattern : %8.3f ms\n", backgroundPattern);
+	printf ("  nine-part tiles          : %8.3f ms\n", ninePartTiles);
+	printf ("  nine-part pattern        : %8.3f ms\n", ninePartPattern);
+	return 0;
+}
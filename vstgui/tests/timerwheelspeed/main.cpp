@@ -0,0 +1,180 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/platform/linux/x11timer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// starts 1000 timers with the periods typical for animations, meters and idle timers one after
+// another and runs them for 60 seconds of simulated time, once with every timer registered at the
+// run loop and once with the timers in the timer scheduler, and reports the wakeups of the run loop
+// and the late fires per second
+namespace {
+
+constexpr auto kNumTimers = 1000;
+constexpr uint64_t kDuration = 60000;
+constexpr uint64_t kStartInterval = 3;
+constexpr uint32_t kPeriods[] = {16, 20, 25, 30, 33, 40, 50, 100, 250, 500, 1000};
+
+uint64_t gTime = 0;
+
+//------------------------------------------------------------------------
+uint64_t simulatedClock ()
+{
+	return gTime;
+}
+
+//------------------------------------------------------------------------
+// a run loop which wakes up once for all timers due at the same time
+class SimulatedRunLoop : public X11::IRunLoop, public NonAtomicReferenceCounted
+{
+public:
+	bool registerEventHandler (int fd, X11::IEventHandler* handler) override { return false; }
+	bool unregisterEventHandler (X11::IEventHandler* handler) override { return false; }
+
+	bool registerTimer (uint64_t interval, X11::ITimerHandler* handler) override
+	{
+		timers[handler] = {interval, ++generation};
+		queue.push ({gTime + interval, generation, handler});
+		return true;
+	}
+
+	bool unregisterTimer (X11::ITimerHandler* handler) override
+	{
+		return timers.erase (handler) != 0;
+	}
+
+	void run (uint64_t duration)
+	{
+		auto end = gTime + duration;
+		while (!queue.empty () && queue.top ().time <= end)
+		{
+			auto event = queue.top ();
+			queue.pop ();
+			auto it = timers.find (event.handler);
+			if (it == timers.end () || it->second.generation != event.generation)
+				continue;
+			if (event.time != gTime)
+				++wakeups;
+			gTime = event.time;
+			queue.push ({event.time + it->second.interval, event.generation, event.handler});
+			event.handler->onTimer ();
+		}
+		gTime = end;
+	}
+
+	uint64_t wakeups {0};
+
+private:
+	struct Registration
+	{
+		uint64_t interval;
+		uint64_t generation;
+	};
+
+	struct Event
+	{
+		uint64_t time;
+		uint64_t generation;
+		X11::ITimerHandler* handler;
+
+		bool operator< (const Event& other) const { return time > other.time; }
+	};
+
+	std::unordered_map<X11::ITimerHandler*, Registration> timers;
+	std::priority_queue<Event> queue;
+	uint64_t generation {0};
+};
+
+//------------------------------------------------------------------------
+struct TestTimer : X11::ITimerHandler
+{
+	void onTimer () override { ++fires; }
+
+	uint64_t fires {0};
+};
+
+//------------------------------------------------------------------------
+uint32_t periodForTimer (int index)
+{
+	return kPeriods[index % (sizeof (kPeriods) / sizeof (kPeriods[0]))];
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (Proc proc)
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	proc ();
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	return std::chrono::duration<double, std::milli> (duration).count ();
+}
+
+//------------------------------------------------------------------------
+void print (const char* name, uint64_t wakeups, uint64_t fires, uint64_t lateFires, double time)
+{
+	auto seconds = kDuration / 1000.;
+	printf ("  %-22s: %8.1f wakeups/s %8.1f fires/s %6.1f late fires/s %8.2f ms\n", name,
+	        wakeups / seconds, fires / seconds, lateFires / seconds, time);
+}
+
+//------------------------------------------------------------------------
+void runDirect ()
+{
+	gTime = 0;
+	SimulatedRunLoop runLoop;
+	std::vector<TestTimer> timers (kNumTimers);
+	for (auto i = 0; i < kNumTimers; ++i)
+	{
+		runLoop.run (kStartInterval);
+		runLoop.registerTimer (periodForTimer (i), &timers[i]);
+	}
+	auto time = measure ([&] () { runLoop.run (kDuration); });
+	uint64_t fires = 0;
+	for (auto& timer : timers)
+		fires += timer.fires;
+	print ("run loop timers", runLoop.wakeups, fires, 0, time);
+}
+
+//------------------------------------------------------------------------
+void runScheduler (const char* name, uint32_t tolerance)
+{
+	gTime = 0;
+	SimulatedRunLoop runLoop;
+	X11::TimerScheduler scheduler (&runLoop, simulatedClock);
+	std::vector<TestTimer> timers (kNumTimers);
+	for (auto i = 0; i < kNumTimers; ++i)
+	{
+		auto period = periodForTimer (i);
+		runLoop.run (kStartInterval);
+		scheduler.add (&timers[i], period, tolerance ? tolerance : period);
+	}
+	auto time = measure ([&] () { runLoop.run (kDuration); });
+	const auto& statistics = scheduler.getStatistics ();
+	print (name, statistics.wakeups, statistics.fires, statistics.lateFires, time);
+	for (auto& timer : timers)
+		scheduler.remove (&timer);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	printf ("%d timers, %g s simulated\n", kNumTimers, kDuration / 1000.);
+	runDirect ();
+	runScheduler ("scheduler", 0);
+	runScheduler ("scheduler (5 ms slack)", 5);
+	return 0;
+}
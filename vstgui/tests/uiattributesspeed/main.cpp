@@ -0,0 +1,223 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/crect.h"
+#include "vstgui/lib/cviewcontainer.h"
+#include "vstgui/uidescription/uiattributes.h"
+#include "vstgui/uidescription/uidescription.h"
+#include "vstgui/uidescription/uiviewfactory.h"
+#include "vstgui/uidescription/xmlparser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <locale>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// converts 20000 numeric attribute values (rects, points, doubles and integers) from and to
+// strings with string streams, the way UIAttributes did it before, and with UIAttributes, then
+// parses a description with 4000 sliders with five numeric attributes each, creates the template
+// and collects the attributes of the views like the editor does when saving
+namespace {
+
+constexpr auto kNumValues = 20000;
+constexpr auto kNumViews = 4000;
+constexpr auto kNumRuns = 10;
+
+//------------------------------------------------------------------------
+double streamStringToDouble (const std::string& str)
+{
+	std::istringstream sstream (str);
+	sstream.imbue (std::locale::classic ());
+	double value = 0.;
+	sstream >> value;
+	return value;
+}
+
+//------------------------------------------------------------------------
+std::string streamDoubleToString (double value, uint32_t precision)
+{
+	std::stringstream str;
+	str.imbue (std::locale::classic ());
+	str.precision (precision);
+	str << value;
+	return str.str ();
+}
+
+//------------------------------------------------------------------------
+CRect streamStringToRect (const std::string& str)
+{
+	std::vector<std::string> subStrings;
+	size_t start = 0;
+	size_t pos;
+	while ((pos = str.find (',', start)) != std::string::npos)
+	{
+		subStrings.emplace_back (str.substr (start, pos - start));
+		start = pos + 1;
+	}
+	subStrings.emplace_back (str.substr (start));
+	CRect r;
+	if (subStrings.size () == 4)
+	{
+		r.left = streamStringToDouble (subStrings[0]);
+		r.top = streamStringToDouble (subStrings[1]);
+		r.right = streamStringToDouble (subStrings[2]);
+		r.bottom = streamStringToDouble (subStrings[3]);
+	}
+	return r;
+}
+
+//------------------------------------------------------------------------
+std::string streamRectToString (const CRect& r)
+{
+	return streamDoubleToString (r.left, 6) + ", " + streamDoubleToString (r.top, 6) + ", " +
+	       streamDoubleToString (r.right, 6) + ", " + streamDoubleToString (r.bottom, 6);
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (Proc proc)
+{
+	auto best = 0.;
+	for (auto run = 0; run < kNumRuns; ++run)
+	{
+		auto start = std::chrono::high_resolution_clock::now ();
+		proc ();
+		auto duration = std::chrono::high_resolution_clock::now () - start;
+		auto ms = std::chrono::duration<double, std::milli> (duration).count ();
+		if (run == 0 || ms < best)
+			best = ms;
+	}
+	return best;
+}
+
+//------------------------------------------------------------------------
+std::string createDescription ()
+{
+	std::string xml = "<vstgui-ui-description version=\"1\">\n";
+	xml += "\t<template class=\"CViewContainer\" name=\"main\" origin=\"0, 0\" size=\"2000, 1600\">\n";
+	for (auto i = 0; i < kNumViews; ++i)
+	{
+		xml += "\t\t<view class=\"CSlider\" origin=\"" + std::to_string ((i % 80) * 25) + ", " +
+		       std::to_string ((i / 80) * 32) + "\" size=\"24.5, 31.75\" min-value=\"-" +
+		       std::to_string (i % 10) + ".5\" max-value=\"" + std::to_string (i % 100) +
+		       ".25\" default-value=\"0." + std::to_string (i % 1000) + "\"/>\n";
+	}
+	xml += "\t</template>\n</vstgui-ui-description>\n";
+	return xml;
+}
+
+//------------------------------------------------------------------------
+void runCodec ()
+{
+	std::default_random_engine rnd;
+	std::uniform_int_distribution<int32_t> coordinates (0, 2000);
+	std::uniform_real_distribution<double> values (-100., 100.);
+	std::vector<CRect> rects;
+	std::vector<double> doubles;
+	std::vector<std::string> rectStrings;
+	std::vector<std::string> doubleStrings;
+	for (auto i = 0; i < kNumValues / 2; ++i)
+	{
+		CRect r (coordinates (rnd), coordinates (rnd), 0, 0);
+		r.setSize (CPoint (coordinates (rnd) / 4., coordinates (rnd) / 8.));
+		rects.push_back (r);
+		rectStrings.push_back (UIAttributes::rectToString (r));
+		doubles.push_back (values (rnd));
+		doubleStrings.push_back (UIAttributes::doubleToString (doubles.back (), 17));
+	}
+
+	double sum = 0.;
+	auto streamParse = measure ([&] () {
+		for (auto& str : rectStrings)
+			sum += streamStringToRect (str).left;
+		for (auto& str : doubleStrings)
+			sum += streamStringToDouble (str);
+	});
+	auto codecParse = measure ([&] () {
+		CRect r;
+		double d;
+		for (auto& str : rectStrings)
+		{
+			UIAttributes::stringToRect (str, r);
+			sum += r.left;
+		}
+		for (auto& str : doubleStrings)
+		{
+			UIAttributes::stringToDouble (str, d);
+			sum += d;
+		}
+	});
+	size_t size = 0;
+	auto streamFormat = measure ([&] () {
+		for (auto& r : rects)
+			size += streamRectToString (r).size ();
+		for (auto& d : doubles)
+			size += streamDoubleToString (d, 17).size ();
+	});
+	auto codecFormat = measure ([&] () {
+		for (auto& r : rects)
+			size += UIAttributes::rectToString (r).size ();
+		for (auto& d : doubles)
+			size += UIAttributes::doubleToString (d, 17).size ();
+	});
+	printf ("%d values (%g, %zu)\n", kNumValues, sum, size);
+	printf ("  %-14s: %8.2f ms parse %8.2f ms format\n", "string streams", streamParse,
+	        streamFormat);
+	printf ("  %-14s: %8.2f ms parse %8.2f ms format\n", "UIAttributes", codecParse, codecFormat);
+}
+
+//------------------------------------------------------------------------
+void runDescription ()
+{
+	auto xml = createDescription ();
+	auto createTime = measure ([&] () {
+		Xml::MemoryContentProvider provider (xml.data (), static_cast<uint32_t> (xml.size ()));
+		UIDescription desc (&provider);
+		desc.parse ();
+		if (auto view = desc.createView ("main", nullptr))
+			view->forget ();
+	});
+	printf ("%d views, %d numeric attributes\n", kNumViews, kNumViews * 5);
+	printf ("  parse and create  : %8.2f ms\n", createTime);
+
+#if VSTGUI_LIVE_EDITING
+	Xml::MemoryContentProvider provider (xml.data (), static_cast<uint32_t> (xml.size ()));
+	UIDescription desc (&provider);
+	desc.parse ();
+	auto view = desc.createView ("main", nullptr);
+	auto container = view ? view->asViewContainer () : nullptr;
+	auto factory = dynamic_cast<const UIViewFactory*> (desc.getViewFactory ());
+	if (container && factory)
+	{
+		auto saveTime = measure ([&] () {
+			container->forEachChild ([&] (CView* child) {
+				UIAttributes attributes;
+				factory->getAttributesForView (child, &desc, attributes);
+			});
+		});
+		printf ("  collect attributes: %8.2f ms\n", saveTime);
+	}
+	if (view)
+		view->forget ();
+#endif
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	runCodec ();
+	runDescription ();
+	return 0;
+}
@@ -0,0 +1,139 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/uidescription/cstream.h"
+#include "vstgui/uidescription/uidescription.h"
+#include "vstgui/uidescription/xmlparser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// creates a large description with embedded bitmaps, many resources and templates, converts it
+// to the binary form and reports the time needed to parse the xml and the binary form
+namespace {
+
+constexpr auto kNumBitmaps = 200;
+constexpr auto kBitmapDataSize = 8192;
+constexpr auto kNumTags = 2000;
+constexpr auto kNumColors = 500;
+constexpr auto kNumTemplates = 50;
+constexpr auto kNumViewsPerTemplate = 200;
+constexpr auto kNumRuns = 10;
+
+//------------------------------------------------------------------------
+std::string createDescription ()
+{
+	static const char base64Chars[] =
+	    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	std::default_random_engine rnd;
+	std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+	xml += "<vstgui-ui-description version=\"1\">\n\t<bitmaps>\n";
+	for (auto i = 0; i < kNumBitmaps; ++i)
+	{
+		xml += "\t\t<bitmap name=\"bitmap" + std::to_string (i) + "\" path=\"bitmap" +
+		       std::to_string (i) + ".png\">\n\t\t\t<data encoding=\"base64\">";
+		for (auto c = 0; c < kBitmapDataSize; ++c)
+			xml += base64Chars[rnd () % 64];
+		xml += "</data>\n\t\t</bitmap>\n";
+	}
+	xml += "\t</bitmaps>\n\t<control-tags>\n";
+	for (auto i = 0; i < kNumTags; ++i)
+	{
+		xml += "\t\t<control-tag name=\"tag" + std::to_string (i) + "\" tag=\"" +
+		       std::to_string (i) + "\"/>\n";
+	}
+	xml += "\t</control-tags>\n\t<colors>\n";
+	for (auto i = 0; i < kNumColors; ++i)
+	{
+		char rgba[10];
+		snprintf (rgba, sizeof (rgba), "#%08x", static_cast<uint32_t> (rnd ()));
+		xml += "\t\t<color name=\"color" + std::to_string (i) + "\" rgba=\"" + rgba + "\"/>\n";
+	}
+	xml += "\t</colors>\n";
+	for (auto t = 0; t < kNumTemplates; ++t)
+	{
+		xml += "\t<template class=\"CViewContainer\" name=\"template" + std::to_string (t) +
+		       "\" origin=\"0, 0\" size=\"1000, 1000\" background-color=\"color0\">\n";
+		for (auto i = 0; i < kNumViewsPerTemplate; ++i)
+		{
+			auto index = t * kNumViewsPerTemplate + i;
+			xml += "\t\t<view class=\"CKickButton\" bitmap=\"bitmap" +
+			       std::to_string (index % kNumBitmaps) + "\" control-tag=\"tag" +
+			       std::to_string (index % kNumTags) + "\" origin=\"" +
+			       std::to_string ((i % 20) * 50) + ", " + std::to_string ((i / 20) * 50) +
+			       "\" size=\"50, 50\" transparent=\"false\" mouse-enabled=\"true\"/>\n";
+		}
+		xml += "\t</template>\n";
+	}
+	xml += "</vstgui-ui-description>\n";
+	return xml;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (Proc proc)
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	proc ();
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	return std::chrono::duration<double, std::milli> (duration).count ();
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	auto xml = createDescription ();
+	Xml::MemoryContentProvider xmlProvider (xml.data (), static_cast<uint32_t> (xml.size ()));
+	CMemoryStream binaryStream (1024 * 1024, 1024 * 1024);
+	Xml::BinaryWriter writer;
+	if (!writer.write (&xmlProvider, binaryStream))
+	{
+		printf ("converting to the binary form failed\n");
+		return -1;
+	}
+	auto binaryData = binaryStream.getBuffer ();
+	auto binarySize = static_cast<uint32_t> (binaryStream.tell ());
+
+	double xmlTime = 0.;
+	double binaryTime = 0.;
+	double binaryStreamTime = 0.;
+	for (auto run = 0; run < kNumRuns; ++run)
+	{
+		xmlTime += measure ([&] () {
+			Xml::MemoryContentProvider provider (xml.data (), static_cast<uint32_t> (xml.size ()));
+			UIDescription desc (&provider);
+			if (!desc.parse ())
+				printf ("parsing the xml form failed\n");
+		});
+		binaryTime += measure ([&] () {
+			Xml::MemoryContentProvider provider (binaryData, binarySize);
+			UIDescription desc (&provider);
+			if (!desc.parse ())
+				printf ("parsing the binary form failed\n");
+		});
+		binaryStreamTime += measure ([&] () {
+			CMemoryStream stream (binaryData, binarySize);
+			Xml::InputStreamContentProvider provider (stream);
+			UIDescription desc (&provider);
+			if (!desc.parse ())
+				printf ("parsing the binary form from a stream failed\n");
+		});
+	}
+
+	printf ("xml %u bytes, binary %u bytes\n", static_cast<uint32_t> (xml.size ()), binarySize);
+	printf ("  parse xml             : %8.2f ms\n", xmlTime / kNumRuns);
+	printf ("  parse binary (memory) : %8.2f ms\n", binaryTime / kNumRuns);
+	printf ("  parse binary (stream) : %8.2f ms\n", binaryStreamTime / kNumRuns);
+	return 0;
+}
@@ -0,0 +1,133 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/ccolor.h"
+#include "vstgui/lib/cviewcontainer.h"
+#include "vstgui/uidescription/uidescription.h"
+#include "vstgui/uidescription/xmlparser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// builds an editor of 1000 views, labels and containers which use 32 colors, changes the value of
+// one color and applies the change the way it was done before, by parsing the description again
+// and creating the editor again, and with UIDescription::reload which only updates the views
+// using the color. The time to only parse the changed description is reported for comparison.
+namespace {
+
+constexpr auto kNumRows = 10;
+constexpr auto kNumViewsPerRow = 99;
+constexpr auto kNumColors = 32;
+constexpr auto kNumRuns = 20;
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (Proc proc)
+{
+	auto best = 0.;
+	for (auto run = 0; run < kNumRuns; ++run)
+	{
+		auto start = std::chrono::high_resolution_clock::now ();
+		proc ();
+		auto duration = std::chrono::high_resolution_clock::now () - start;
+		auto ms = std::chrono::duration<double, std::milli> (duration).count ();
+		if (run == 0 || ms < best)
+			best = ms;
+	}
+	return best;
+}
+
+//------------------------------------------------------------------------
+std::string colorName (int32_t index)
+{
+	return "color " + std::to_string (index % kNumColors);
+}
+
+//------------------------------------------------------------------------
+std::string createDescription (const char* changedColor)
+{
+	std::string xml = "<vstgui-ui-description version=\"1\">\n\t<colors>\n";
+	for (auto i = 0; i < kNumColors; ++i)
+	{
+		auto value = i == 0 ? std::string (changedColor) : "#" + std::to_string (100000 + i) + "ff";
+		xml += "\t\t<color name=\"" + colorName (i) + "\" rgba=\"" + value + "\"/>\n";
+	}
+	xml += "\t</colors>\n";
+	xml += "\t<template background-color=\"" + colorName (1) +
+	       "\" class=\"CViewContainer\" name=\"editor\" origin=\"0, 0\" size=\"2000, 400\">\n";
+	for (auto row = 0; row < kNumRows; ++row)
+	{
+		xml += "\t\t<view background-color=\"" + colorName (row) +
+		       "\" class=\"CViewContainer\" origin=\"0, " + std::to_string (row * 40) +
+		       "\" size=\"2000, 40\">\n";
+		for (auto i = 0; i < kNumViewsPerRow; ++i)
+		{
+			auto index = row * kNumViewsPerRow + i;
+			xml += "\t\t\t<view back-color=\"" + colorName (index) + "\" class=\"CTextLabel\" font-color=\"" +
+			       colorName (index + 7) + "\" frame-color=\"" + colorName (index + 13) + "\" origin=\"" +
+			       std::to_string (i * 20) + ", 0\" size=\"20, 40\" title=\"" + std::to_string (index) +
+			       "\"/>\n";
+		}
+		xml += "\t\t</view>\n";
+	}
+	xml += "\t</template>\n</vstgui-ui-description>\n";
+	return xml;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	std::string xml[] = {createDescription ("#ff0000ff"), createDescription ("#0000ffff")};
+	auto numChanges = 0;
+
+	Xml::MemoryContentProvider provider (xml[0].data (), static_cast<uint32_t> (xml[0].size ()));
+	auto desc = owned (new UIDescription (&provider));
+	desc->parse ();
+	auto parent = owned (new CViewContainer (CRect (0, 0, 2000, 400)));
+	parent->addView (desc->createView ("editor", nullptr));
+
+	auto createTime = measure ([&] () {
+		auto& newXml = xml[++numChanges % 2];
+		Xml::MemoryContentProvider newProvider (newXml.data (), static_cast<uint32_t> (newXml.size ()));
+		auto newDesc = owned (new UIDescription (&newProvider));
+		newDesc->parse ();
+		parent->removeAll ();
+		parent->addView (newDesc->createView ("editor", nullptr));
+		desc = newDesc;
+	});
+	auto parseTime = measure ([&] () {
+		auto& newXml = xml[++numChanges % 2];
+		Xml::MemoryContentProvider newProvider (newXml.data (), static_cast<uint32_t> (newXml.size ()));
+		UIDescription newDesc (&newProvider);
+		newDesc.parse ();
+	});
+
+	parent->removeAll ();
+	parent->addView (desc->createView ("editor", nullptr));
+	auto editor = parent->getView (0);
+	auto reloadTime = measure ([&] () {
+		auto& newXml = xml[++numChanges % 2];
+		Xml::MemoryContentProvider newProvider (newXml.data (), static_cast<uint32_t> (newXml.size ()));
+		desc->reload ({parent}, nullptr, &newProvider);
+	});
+	CColor color;
+	desc->getColor (colorName (0).data (), color);
+	if (parent->getView (0) != editor || color != CColor (255, 0, 0, 255))
+		return -1;
+
+	printf ("%d views, one of %d colors changed\n", kNumRows * (kNumViewsPerRow + 1), kNumColors);
+	printf ("  parse and create: %8.2f ms\n", createTime);
+	printf ("  parse only      : %8.2f ms\n", parseTime);
+	printf ("  reload          : %8.2f ms\n", reloadTime);
+	return 0;
+}
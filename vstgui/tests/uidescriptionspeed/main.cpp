@@ -0,0 +1,126 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cview.h"
+#include "vstgui/lib/platform/iplatformbitmap.h"
+#include "vstgui/uidescription/uiattributes.h"
+#include "vstgui/uidescription/uidescription.h"
+#include "vstgui/uidescription/xmlparser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// parses a description with 500 bitmaps plus a 2x variant of each, creates a template with 500
+// controls referencing them and reports the time needed for parsing, for creating the template
+// the first time (which resolves all bitmaps and their scale variants) and again afterwards
+namespace {
+
+constexpr auto kNumBitmaps = 500;
+constexpr auto kNumControls = 500;
+constexpr auto kNumRuns = 20;
+
+//------------------------------------------------------------------------
+class BitmapCreator : public IBitmapCreator
+{
+public:
+	SharedPointer<IPlatformBitmap> createBitmap (const UIAttributes& attributes) override
+	{
+		double scaleFactor = 1.;
+		attributes.getDoubleAttribute ("scale-factor", scaleFactor);
+		CPoint size (scaleFactor, scaleFactor);
+		auto bitmap = IPlatformBitmap::create (&size);
+		if (bitmap)
+			bitmap->setScaleFactor (scaleFactor);
+		return bitmap;
+	}
+};
+
+//------------------------------------------------------------------------
+std::string createDescription ()
+{
+	std::string xml = "<vstgui-ui-description version=\"1\">\n\t<bitmaps>\n";
+	for (auto i = 0; i < kNumBitmaps; ++i)
+	{
+		auto name = "bitmap" + std::to_string (i);
+		xml += "\t\t<bitmap name=\"" + name + "\" path=\"" + name + ".png\"/>\n";
+		xml += "\t\t<bitmap name=\"" + name + "#2x\" path=\"" + name +
+		       "#2x.png\" scale-factor=\"2\"/>\n";
+	}
+	xml += "\t</bitmaps>\n\t<control-tags>\n";
+	for (auto i = 0; i < kNumControls; ++i)
+	{
+		xml += "\t\t<control-tag name=\"tag" + std::to_string (i) + "\" tag=\"" +
+		       std::to_string (i) + "\"/>\n";
+	}
+	xml += "\t</control-tags>\n";
+	xml += "\t<template class=\"CViewContainer\" name=\"main\" origin=\"0, 0\" size=\"1000, 1000\">\n";
+	for (auto i = 0; i < kNumControls; ++i)
+	{
+		xml += "\t\t<view class=\"CKickButton\" bitmap=\"bitmap" +
+		       std::to_string ((i * 7) % kNumBitmaps) + "\" control-tag=\"tag" + std::to_string (i) +
+		       "\" origin=\"" + std::to_string ((i % 25) * 40) + ", " +
+		       std::to_string ((i / 25) * 40) + "\" size=\"40, 40\"/>\n";
+	}
+	xml += "\t</template>\n</vstgui-ui-description>\n";
+	return xml;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (Proc proc)
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	proc ();
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	return std::chrono::duration<double, std::milli> (duration).count ();
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	auto xml = createDescription ();
+	BitmapCreator bitmapCreator;
+
+	double parseTime = 0.;
+	double firstCreateTime = 0.;
+	double createTime = 0.;
+	for (auto run = 0; run < kNumRuns; ++run)
+	{
+		Xml::MemoryContentProvider provider (xml.data (), static_cast<uint32_t> (xml.size ()));
+		UIDescription desc (&provider);
+		desc.setBitmapCreator (&bitmapCreator);
+		parseTime += measure ([&] () { desc.parse (); });
+		firstCreateTime += measure ([&] () {
+			if (auto view = desc.createView ("main", nullptr))
+				view->forget ();
+		});
+		createTime += measure ([&] () {
+			if (auto view = desc.createView ("main", nullptr))
+				view->forget ();
+		});
+		if (run == 0)
+		{
+			auto bitmap = desc.getBitmap ("bitmap0");
+			if (bitmap == nullptr ||
+			    bitmap->getBestPlatformBitmapForScaleFactor (2.) == bitmap->getPlatformBitmap ())
+				printf ("scale variants missing\n");
+		}
+	}
+
+	printf ("%d bitmaps, %d controls\n", kNumBitmaps * 2, kNumControls);
+	printf ("  parse           : %8.2f ms\n", parseTime / kNumRuns);
+	printf ("  create (first)  : %8.2f ms\n", firstCreateTime / kNumRuns);
+	printf ("  create (cached) : %8.2f ms\n", createTime / kNumRuns);
+	return 0;
+}
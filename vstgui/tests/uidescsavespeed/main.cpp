@@ -0,0 +1,321 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/uidescription/cstream.h"
+#include "vstgui/uidescription/uidescription.h"
+#include "vstgui/uidescription/xmlparser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// builds a description of about 5 MB with templates of many views and bitmaps with embedded
+// base64 data and saves it to memory the way it was written before, with strings for every node
+// and attribute pushed one by one through a stream buffering byte by byte, and with
+// UIDescription, then reports how long a background save blocks the calling thread
+namespace {
+
+constexpr auto kNumTemplates = 20;
+constexpr auto kNumViewsPerTemplate = 700;
+constexpr auto kNumBitmaps = 16;
+constexpr auto kBitmapDataSize = 128 * 1024;
+constexpr auto kNumRuns = 10;
+constexpr auto kFileName = "uidescsavespeed.uidesc";
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (Proc proc)
+{
+	auto best = 0.;
+	for (auto run = 0; run < kNumRuns; ++run)
+	{
+		auto start = std::chrono::high_resolution_clock::now ();
+		proc ();
+		auto duration = std::chrono::high_resolution_clock::now () - start;
+		auto ms = std::chrono::duration<double, std::milli> (duration).count ();
+		if (run == 0 || ms < best)
+			best = ms;
+	}
+	return best;
+}
+
+//------------------------------------------------------------------------
+std::string createDescription ()
+{
+	std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+	xml += "<vstgui-ui-description version=\"1\">\n\t<bitmaps>\n";
+	static const char base64Chars[] =
+	    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	for (auto i = 0; i < kNumBitmaps; ++i)
+	{
+		auto name = "bitmap" + std::to_string (i);
+		xml += "\t\t<bitmap name=\"" + name + "\" path=\"" + name + ".png\">\n";
+		xml += "\t\t\t<data encoding=\"base64\">\n\t\t\t\t";
+		for (auto c = 0; c < kBitmapDataSize; ++c)
+			xml += base64Chars[(c * 7 + i) % 64];
+		xml += "\n\t\t\t</data>\n\t\t</bitmap>\n";
+	}
+	xml += "\t</bitmaps>\n";
+	for (auto t = 0; t < kNumTemplates; ++t)
+	{
+		xml += "\t<template class=\"CViewContainer\" name=\"template" + std::to_string (t) +
+		       "\" origin=\"0, 0\" size=\"2000, 1600\">\n";
+		for (auto i = 0; i < kNumViewsPerTemplate; ++i)
+		{
+			xml += "\t\t<view class=\"CTextLabel\" origin=\"" + std::to_string ((i % 40) * 50) +
+			       ", " + std::to_string ((i / 40) * 20) +
+			       "\" size=\"48, 18\" title=\"Gain &amp; Level &lt;" + std::to_string (i) +
+			       "&gt;\" font=\"~ NormalFontSmall\" font-color=\"~ WhiteCColor\" "
+			       "text-alignment=\"center\" tooltip=\"&quot;" +
+			       std::to_string (t) + "&quot;\" control-tag=\"tag" + std::to_string (i) +
+			       "\"/>\n";
+		}
+		xml += "\t</template>\n";
+	}
+	xml += "</vstgui-ui-description>\n";
+	return xml;
+}
+
+//------------------------------------------------------------------------
+struct Node
+{
+	std::string name;
+	std::vector<std::pair<std::string, std::string>> attributes;
+	std::string data;
+	std::vector<std::unique_ptr<Node>> children;
+};
+
+//------------------------------------------------------------------------
+class TreeBuilder : public Xml::IHandler
+{
+public:
+	void startXmlElement (Xml::Parser*, IdStringPtr elementName,
+	                      UTF8StringPtr* elementAttributes) override
+	{
+		auto node = std::unique_ptr<Node> (new Node);
+		node->name = elementName;
+		for (auto attr = elementAttributes; attr && *attr; attr += 2)
+			node->attributes.emplace_back (attr[0], attr[1]);
+		auto nodePtr = node.get ();
+		if (stack.empty ())
+			root = std::move (node);
+		else
+			stack.back ()->children.emplace_back (std::move (node));
+		stack.push_back (nodePtr);
+	}
+	void endXmlElement (Xml::Parser*, IdStringPtr) override { stack.pop_back (); }
+	void xmlCharData (Xml::Parser*, const int8_t* data, int32_t length) override
+	{
+		auto& str = stack.back ()->data;
+		for (auto i = 0; i < length; ++i)
+		{
+			auto c = static_cast<char> (data[i]);
+			if (c != '\n' && c != '\r' && c != '\t' && c != ' ')
+				str += c;
+		}
+	}
+	void xmlComment (Xml::Parser*, IdStringPtr) override {}
+
+	std::unique_ptr<Node> root;
+	std::vector<Node*> stack;
+};
+
+//------------------------------------------------------------------------
+class ByteBufferedOutputStream : public OutputStream
+{
+public:
+	explicit ByteBufferedOutputStream (OutputStream& stream) : stream (stream)
+	{
+		buffer.reserve (kBufferSize);
+	}
+	~ByteBufferedOutputStream () noexcept override { flush (); }
+	bool operator<< (const std::string& str) override
+	{
+		return writeRaw (str.c_str (), static_cast<uint32_t> (str.size ())) == str.size ();
+	}
+	uint32_t writeRaw (const void* inBuffer, uint32_t size) override
+	{
+		auto ptr = reinterpret_cast<const uint8_t*> (inBuffer);
+		for (uint32_t i = 0; i < size; ++i)
+		{
+			buffer.emplace_back (ptr[i]);
+			if (buffer.size () == kBufferSize)
+				flush ();
+		}
+		return size;
+	}
+	void flush ()
+	{
+		stream.writeRaw (buffer.data (), static_cast<uint32_t> (buffer.size ()));
+		buffer.clear ();
+	}
+
+private:
+	static constexpr size_t kBufferSize = 8192;
+	OutputStream& stream;
+	std::vector<uint8_t> buffer;
+};
+
+//------------------------------------------------------------------------
+class StringNodeWriter
+{
+public:
+	void write (OutputStream& stream, const Node& root)
+	{
+		intendLevel = 0;
+		stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+		writeNode (stream, root);
+	}
+
+private:
+	static void encodeAttributeString (std::string& str)
+	{
+		const char entities[] = {'&', '<', '>', '\'', '\"', 0};
+		const char* replacements[] = {"&amp;", "&lt;", "&gt;", "&apos;", "&quot;"};
+		for (auto i = 0; entities[i] != 0; ++i)
+		{
+			size_t pos = 0;
+			while ((pos = str.find (entities[i], pos)) != std::string::npos)
+			{
+				str.replace (pos, 1, replacements[i]);
+				pos++;
+			}
+		}
+	}
+
+	void writeIndent (OutputStream& stream)
+	{
+		for (auto i = 0; i < intendLevel; i++)
+			stream << "\t";
+	}
+
+	void writeNode (OutputStream& stream, const Node& node)
+	{
+		writeIndent (stream);
+		stream << "<";
+		stream << node.name;
+		std::map<std::string, std::string> sortedAttributes (node.attributes.begin (),
+		                                                     node.attributes.end ());
+		for (auto& attribute : sortedAttributes)
+		{
+			if (attribute.second.empty ())
+				continue;
+			stream << " ";
+			stream << attribute.first;
+			stream << "=\"";
+			std::string value (attribute.second);
+			encodeAttributeString (value);
+			stream << value;
+			stream << "\"";
+		}
+		if (node.children.empty () && node.data.empty ())
+		{
+			stream << "/>\n";
+			return;
+		}
+		stream << ">\n";
+		intendLevel++;
+		if (!node.data.empty ())
+		{
+			writeIndent (stream);
+			uint32_t i = 0;
+			for (auto c : node.data)
+			{
+				stream << static_cast<int8_t> (c);
+				if (i++ > 80)
+				{
+					stream << "\n";
+					i = 0;
+					writeIndent (stream);
+				}
+			}
+			stream << "\n";
+		}
+		for (auto& child : node.children)
+			writeNode (stream, *child);
+		intendLevel--;
+		writeIndent (stream);
+		stream << "</";
+		stream << node.name;
+		stream << ">\n";
+	}
+
+	int32_t intendLevel {0};
+};
+
+//------------------------------------------------------------------------
+struct SaveUIDescription : public UIDescription
+{
+	using UIDescription::UIDescription;
+	using UIDescription::saveToStream;
+};
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	auto xml = createDescription ();
+	constexpr auto flags = UIDescription::kWriteImagesIntoXMLFile |
+	                       UIDescription::kDoNotVerifyImageXMLData;
+
+	Xml::MemoryContentProvider treeProvider (xml.data (), static_cast<uint32_t> (xml.size ()));
+	TreeBuilder builder;
+	Xml::Parser parser;
+	if (!parser.parse (&treeProvider, &builder) || !builder.root)
+		return -1;
+
+	Xml::MemoryContentProvider provider (xml.data (), static_cast<uint32_t> (xml.size ()));
+	SaveUIDescription desc (&provider);
+	if (!desc.parse ())
+		return -1;
+
+	size_t stringSize = 0;
+	auto stringTime = measure ([&] () {
+		CMemoryStream stream (static_cast<uint32_t> (xml.size ()), 1024 * 1024, false);
+		{
+			ByteBufferedOutputStream bufferedStream (stream);
+			StringNodeWriter writer;
+			writer.write (bufferedStream, *builder.root);
+		}
+		stringSize = static_cast<size_t> (stream.tell ());
+	});
+	size_t writerSize = 0;
+	auto writerTime = measure ([&] () {
+		CMemoryStream stream (static_cast<uint32_t> (xml.size ()), 1024 * 1024, false);
+		desc.saveToStream (stream, flags);
+		writerSize = static_cast<size_t> (stream.tell ());
+	});
+	printf ("%.2f MB description, %d views, %d bitmaps\n", xml.size () / (1024. * 1024.),
+	        kNumTemplates * kNumViewsPerTemplate, kNumBitmaps);
+	printf ("  %-20s: %8.2f ms (%zu bytes)\n", "strings", stringTime, stringSize);
+	printf ("  %-20s: %8.2f ms (%zu bytes)\n", "streaming writer", writerTime, writerSize);
+
+	auto syncTime = measure ([&] () { desc.save (kFileName, flags); });
+	auto blockTime = 0.;
+	auto backgroundTime = measure ([&] () {
+		auto start = std::chrono::high_resolution_clock::now ();
+		desc.saveInBackground (kFileName, flags);
+		auto blocked = std::chrono::high_resolution_clock::now () - start;
+		auto ms = std::chrono::duration<double, std::milli> (blocked).count ();
+		if (blockTime == 0. || ms < blockTime)
+			blockTime = ms;
+		desc.finishBackgroundSave ();
+	});
+	std::remove (kFileName);
+	printf ("save to file\n");
+	printf ("  %-20s: %8.2f ms\n", "save", syncTime);
+	printf ("  %-20s: %8.2f ms blocking, %.2f ms until written\n", "saveInBackground", blockTime,
+	        backgroundTime);
+	return 0;
+}
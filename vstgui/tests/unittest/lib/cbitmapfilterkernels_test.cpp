@@ -0,0 +1,633 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cbitmapfilterkernels.h"
+#include "../../../lib/ccolor.h"
+#include "../unittests.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace VSTGUI {
+using namespace BitmapFilter::Kernels;
+
+namespace {
+
+using Pixels = std::vector<uint32_t>;
+
+constexpr uint32_t kRowLengths[] = {0, 1, 3, 7, 8, 9, 16, 31, 33, 100};
+constexpr ChannelLayout kLayouts[] = {{1, 2, 3, 0}, {0, 1, 2, 3}, {3, 2, 1, 0}, {2, 1, 0, 3}};
+constexpr ChannelLayout kRGBALayout = {0, 1, 2, 3};
+constexpr bool kAllPlanes[4] = {true, true, true, true};
+constexpr bool kFirstPlane[4] = {true, false, false, false};
+constexpr bool kLastPlane[4] = {false, false, false, true};
+constexpr uint32_t kSetColorInput[9] = {0x11223344, 0xAABBCCDD, 0, 0xFFFFFFFF, 1, 2, 3, 4, 5};
+constexpr uint32_t kReplaceInput[10] = {5, 1, 5, 5, 2, 5, 5, 5, 5, 3};
+constexpr uint32_t kReplaceExpected[10] = {7, 1, 7, 7, 2, 7, 7, 7, 7, 3};
+
+//------------------------------------------------------------------------
+Pixels randomPixels (size_t count, uint32_t seed)
+{
+	std::mt19937 rnd (seed);
+	Pixels pixels (count);
+	for (auto& p : pixels)
+		p = static_cast<uint32_t> (rnd ());
+	return pixels;
+}
+
+//------------------------------------------------------------------------
+std::vector<const RowKernels*> vectorKernels ()
+{
+	std::vector<const RowKernels*> result;
+	for (auto instructionSet : {InstructionSet::SSE2, InstructionSet::AVX2})
+	{
+		if (auto kernels = getRowKernels (instructionSet))
+			result.push_back (kernels);
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+template<typename Proc>
+bool compareRows (Proc proc)
+{
+	const auto& scalar = *getRowKernels (InstructionSet::Scalar);
+	for (auto kernels : vectorKernels ())
+	{
+		for (auto count : kRowLengths)
+		{
+			auto src = randomPixels (count, count);
+			Pixels expected (count);
+			Pixels result (count);
+			proc (scalar, src.data (), expected.data (), count);
+			proc (*kernels, src.data (), result.data (), count);
+			if (expected != result)
+				return false;
+			// in place
+			proc (*kernels, src.data (), src.data (), count);
+			if (expected != src)
+				return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool compareScale (uint32_t srcWidth, uint32_t dstWidth)
+{
+	const auto& scalar = *getRowKernels (InstructionSet::Scalar);
+	auto row0 = randomPixels (srcWidth, srcWidth);
+	auto row1 = randomPixels (srcWidth, srcWidth + 1);
+	std::vector<int32_t> index (dstWidth);
+	std::vector<int32_t> nextIndex (dstWidth);
+	std::vector<float> xDiff (dstWidth);
+	float ratio = static_cast<float> (srcWidth - 1) / static_cast<float> (dstWidth);
+	for (auto i = 0u; i < dstWidth; ++i)
+	{
+		auto x = static_cast<uint32_t> (ratio * i);
+		index[i] = static_cast<int32_t> (x);
+		nextIndex[i] = static_cast<int32_t> (std::min (x + 1, srcWidth - 1));
+		xDiff[i] = (ratio * i) - x;
+	}
+	for (auto kernels : vectorKernels ())
+	{
+		Pixels expected (dstWidth);
+		Pixels result (dstWidth);
+		scalar.gather (row0.data (), index.data (), expected.data (), dstWidth);
+		kernels->gather (row0.data (), index.data (), result.data (), dstWidth);
+		if (expected != result)
+			return false;
+		for (auto yDiff : {0.f, 0.25f, 0.3333f, 0.9f})
+		{
+			scalar.bilinear (row0.data (), row1.data (), index.data (), nextIndex.data (),
+							 xDiff.data (), yDiff, expected.data (), dstWidth);
+			kernels->bilinear (row0.data (), row1.data (), index.data (), nextIndex.data (),
+							   xDiff.data (), yDiff, result.data (), dstWidth);
+			if (expected != result)
+				return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool compareBoxBlur (int32_t width, int32_t height, int32_t radius, const bool (&usePlane)[4])
+{
+	const auto& scalar = *getRowKernels (InstructionSet::Scalar);
+	auto area = static_cast<size_t> (width * height);
+	auto src = randomPixels (area, static_cast<uint32_t> (width * 1000 + height));
+	int32_t div = radius * 2 + 1;
+	std::vector<uint8_t> divTable (static_cast<size_t> (256 * div));
+	for (auto i = 0u; i < divTable.size (); ++i)
+		divTable[i] = static_cast<uint8_t> (i / div);
+
+	auto blur = [&] (const RowKernels& kernels, Pixels& dst, uint32_t numThreads) {
+		std::vector<uint8_t> planeData[4];
+		BoxBlurPlanes planes;
+		for (auto i = 0; i < 4; ++i)
+		{
+			planes.plane[i] = nullptr;
+			if (usePlane[i])
+			{
+				planeData[i].resize (area);
+				planes.plane[i] = planeData[i].data ();
+			}
+		}
+		planes.width = width;
+		planes.height = height;
+		planes.radius = radius;
+		planes.divTable = divTable.data ();
+		runTiled (height, 1, numThreads, [&] (int32_t begin, int32_t end) {
+			kernels.boxBlurRows (reinterpret_cast<const uint8_t*> (src.data ()), planes, begin, end);
+		});
+		runTiled (height, 1, numThreads, [&] (int32_t begin, int32_t end) {
+			kernels.boxBlurColumns (planes, reinterpret_cast<uint8_t*> (dst.data ()), begin, end);
+		});
+	};
+
+	Pixels expected (src);
+	blur (scalar, expected, 1);
+	auto allKernels = vectorKernels ();
+	allKernels.push_back (&scalar);
+	for (auto kernels : allKernels)
+	{
+		for (auto numThreads : {1u, 3u})
+		{
+			Pixels result (src);
+			blur (*kernels, result, numThreads);
+			if (expected != result)
+				return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+// the original filter implementations, the scalar kernels must produce the same pixels
+//------------------------------------------------------------------------
+void originalSetColor (const Pixels& src, Pixels& dst, CColor inputColor, bool ignoreAlpha)
+{
+	for (auto i = 0u; i < src.size (); ++i)
+	{
+		uint8_t bytes[4];
+		memcpy (bytes, &src[i], sizeof (bytes));
+		CColor color (bytes[0], bytes[1], bytes[2], bytes[3]);
+		if (ignoreAlpha)
+			inputColor.alpha = color.alpha;
+		color = inputColor;
+		bytes[0] = color.red;
+		bytes[1] = color.green;
+		bytes[2] = color.blue;
+		bytes[3] = color.alpha;
+		memcpy (&dst[i], bytes, sizeof (bytes));
+	}
+}
+
+//------------------------------------------------------------------------
+void originalScaleLinear (const Pixels& src, uint32_t origWidth, uint32_t origHeight, Pixels& dst,
+						  uint32_t newWidth, uint32_t newHeight)
+{
+	float xRatio = (float)origWidth / (float)newWidth;
+	float yRatio = (float)origHeight / (float)newHeight;
+
+	int32_t ix;
+	int32_t iy = -1;
+	const uint32_t* origPixel = nullptr;
+	float origY = 0;
+	float origX = 0;
+	for (uint32_t y = 0; y < newHeight; y++, origY += yRatio)
+	{
+		uint32_t* copyPixel = dst.data () + y * newWidth;
+		if (iy != (int32_t)origY)
+			iy = (int32_t)origY;
+		ix = -1;
+		origX = 0;
+		for (uint32_t x = 0; x < newWidth; x++, origX += xRatio, copyPixel++)
+		{
+			if (ix != (int32_t)origX || origPixel == nullptr)
+			{
+				ix = (int32_t)origX;
+				origPixel = src.data () + static_cast<uint32_t> (iy) * origWidth + ix;
+			}
+			*copyPixel = *origPixel;
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+void originalScaleBilinear (const Pixels& src, uint32_t origWidth, uint32_t origHeight,
+							Pixels& dst, uint32_t newWidth, uint32_t newHeight)
+{
+	auto getColor = [&] (uint32_t x, uint32_t y) {
+		uint8_t bytes[4];
+		memcpy (bytes, &src[y * origWidth + x], sizeof (bytes));
+		return CColor (bytes[0], bytes[1], bytes[2], bytes[3]);
+	};
+
+	float xRatio = ((float)(origWidth-1)) / (float)newWidth;
+	float yRatio = ((float)(origHeight-1)) / (float)newHeight;
+	float xDiff, yDiff, r, g, b, a;
+	uint32_t x, y;
+	CColor color[4];
+
+	for (uint32_t i = 0; i < newHeight; i++)
+	{
+		y = static_cast<uint32_t> (yRatio * i);
+		yDiff = (yRatio * i) - y;
+
+		for (uint32_t j = 0; j < newWidth; j++)
+		{
+			x = static_cast<uint32_t> (xRatio * j);
+			xDiff = (xRatio * j) - x;
+			color[0] = getColor (x, y);
+			color[1] = getColor (x + 1, y);
+			color[2] = getColor (x, y + 1);
+			color[3] = getColor (x + 1, y + 1);
+			r = color[0].red * (1.f - xDiff) * (1.f - yDiff) + color[1].red * xDiff * (1.f - yDiff)
+			+ color[2].red * yDiff * (1.f - xDiff) + color[3].red * xDiff * yDiff;
+			g = color[0].green * (1.f - xDiff) * (1.f - yDiff) + color[1].green * xDiff * (1.f - yDiff)
+			+ color[2].green * yDiff * (1.f - xDiff) + color[3].green * xDiff * yDiff;
+			b = color[0].blue * (1.f - xDiff) * (1.f - yDiff) + color[1].blue * xDiff * (1.f - yDiff)
+			+ color[2].blue * yDiff * (1.f - xDiff) + color[3].blue * xDiff * yDiff;
+			a = color[0].alpha * (1.f - xDiff) * (1.f - yDiff) + color[1].alpha * xDiff * (1.f - yDiff)
+			+ color[2].alpha * yDiff * (1.f - xDiff) + color[3].alpha * xDiff * yDiff;
+			uint8_t bytes[4] = {(uint8_t)r, (uint8_t)g, (uint8_t)b, (uint8_t)a};
+			memcpy (&dst[i * newWidth + j], bytes, sizeof (bytes));
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+void originalBoxBlur (const uint8_t* inPixel, uint8_t* outPixel, int32_t width, int32_t height,
+					  int32_t radius, const bool (&usePlane)[4])
+{
+	constexpr int32_t numComponents = 4;
+
+	int32_t wm = width - 1;
+	int32_t hm = height - 1;
+	int32_t areaSize = width * height;
+	int32_t div = radius + radius + 1;
+
+	std::vector<uint8_t> pc[4];
+	for (auto& plane : pc)
+		plane.resize (static_cast<size_t> (areaSize));
+	std::vector<int32_t> vMin (static_cast<size_t> (std::max (width, height)));
+	std::vector<int32_t> vMax (static_cast<size_t> (std::max (width, height)));
+	std::vector<uint8_t> dv (static_cast<size_t> (256 * div));
+	for (auto i = 0u; i < dv.size (); ++i)
+		dv[i] = static_cast<uint8_t> (i / div);
+
+	int32_t sum[4];
+	for (auto y = 0, yw = 0, yi = 0; y < height; ++y, yw += width)
+	{
+		sum[0] = sum[1] = sum[2] = sum[3] = 0;
+		for (auto i = -radius; i <= radius; i++)
+		{
+			auto p = (yi + std::min (wm, std::max (i, 0))) * numComponents;
+			for (auto c = 0; c < 4; ++c)
+				sum[c] += inPixel[p + c];
+		}
+		for (auto x = 0; x < width; ++x, ++yi)
+		{
+			for (auto c = 0; c < 4; ++c)
+				pc[c][yi] = dv[sum[c]];
+			if (y == 0)
+			{
+				vMin[x] = std::min (x + radius + 1, wm);
+				vMax[x] = std::max (x - radius, 0);
+			}
+			auto p1 = (yw + vMin[x]) * numComponents;
+			auto p2 = (yw + vMax[x]) * numComponents;
+			for (auto c = 0; c < 4; ++c)
+				sum[c] += inPixel[p1 + c] - inPixel[p2 + c];
+		}
+	}
+
+	for (auto y = 0; y < height; ++y)
+	{
+		vMin[y] = std::min (y + radius + 1, hm) * width;
+		vMax[y] = std::max (y - radius, 0) * width;
+	}
+	for (auto x = 0; x < width; ++x)
+	{
+		sum[0] = sum[1] = sum[2] = sum[3] = 0;
+		for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
+		{
+			auto yi = std::max (0, yp) + x;
+			for (auto c = 0; c < 4; ++c)
+				sum[c] += pc[c][yi];
+		}
+		for (auto y = 0, yi = x; y < height; ++y, yi += width)
+		{
+			auto pos = yi * numComponents;
+			for (auto c = 0; c < 4; ++c)
+			{
+				if (usePlane[c])
+					outPixel[pos + c] = dv[sum[c]];
+			}
+			auto p1 = x + vMin[y];
+			auto p2 = x + vMax[y];
+			for (auto c = 0; c < 4; ++c)
+				sum[c] += pc[c][p1] - pc[c][p2];
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+bool compareWithOriginalScale (uint32_t origWidth, uint32_t origHeight, uint32_t newWidth,
+							   uint32_t newHeight)
+{
+	const auto& scalar = *getRowKernels (InstructionSet::Scalar);
+	auto src = randomPixels (origWidth * origHeight, origWidth * 31 + newWidth);
+	Pixels expected (newWidth * newHeight);
+	Pixels result (newWidth * newHeight);
+
+	// linear, the indices are computed like the ScaleLinear filter does
+	originalScaleLinear (src, origWidth, origHeight, expected, newWidth, newHeight);
+	float xRatio = (float)origWidth / (float)newWidth;
+	float yRatio = (float)origHeight / (float)newHeight;
+	std::vector<int32_t> xIndex (newWidth);
+	float origX = 0;
+	for (uint32_t x = 0; x < newWidth; x++, origX += xRatio)
+		xIndex[x] = std::min ((int32_t)origX, (int32_t)origWidth - 1);
+	float origY = 0;
+	for (uint32_t y = 0; y < newHeight; y++, origY += yRatio)
+	{
+		auto iy = std::min ((int32_t)origY, (int32_t)origHeight - 1);
+		scalar.gather (src.data () + iy * origWidth, xIndex.data (), result.data () + y * newWidth,
+					   newWidth);
+	}
+	if (expected != result)
+		return false;
+
+	// bilinear, the indices and weights are computed like the ScaleBiliniear filter does
+	originalScaleBilinear (src, origWidth, origHeight, expected, newWidth, newHeight);
+	xRatio = ((float)(origWidth-1)) / (float)newWidth;
+	yRatio = ((float)(origHeight-1)) / (float)newHeight;
+	std::vector<int32_t> xNextIndex (newWidth);
+	std::vector<float> xDiffs (newWidth);
+	for (uint32_t j = 0; j < newWidth; j++)
+	{
+		auto x = static_cast<uint32_t> (xRatio * j);
+		xIndex[j] = static_cast<int32_t> (x);
+		xNextIndex[j] = static_cast<int32_t> (std::min (x + 1, origWidth - 1));
+		xDiffs[j] = (xRatio * j) - x;
+	}
+	for (uint32_t i = 0; i < newHeight; i++)
+	{
+		auto y = static_cast<uint32_t> (yRatio * i);
+		auto yDiff = (yRatio * i) - y;
+		scalar.bilinear (src.data () + y * origWidth,
+						 src.data () + std::min (y + 1, origHeight - 1) * origWidth,
+						 xIndex.data (), xNextIndex.data (), xDiffs.data (), yDiff,
+						 result.data () + i * newWidth, newWidth);
+	}
+	return expected == result;
+}
+
+//------------------------------------------------------------------------
+bool compareWithOriginalBoxBlur (int32_t width, int32_t height, int32_t radius,
+								 const bool (&usePlane)[4])
+{
+	const auto& scalar = *getRowKernels (InstructionSet::Scalar);
+	auto area = static_cast<size_t> (width * height);
+	auto src = randomPixels (area, static_cast<uint32_t> (width * 7 + height));
+	Pixels expected (src);
+	originalBoxBlur (reinterpret_cast<const uint8_t*> (src.data ()),
+					 reinterpret_cast<uint8_t*> (expected.data ()), width, height, radius, usePlane);
+
+	int32_t div = radius * 2 + 1;
+	std::vector<uint8_t> divTable (static_cast<size_t> (256 * div));
+	for (auto i = 0u; i < divTable.size (); ++i)
+		divTable[i] = static_cast<uint8_t> (i / div);
+	std::vector<uint8_t> planeData[4];
+	BoxBlurPlanes planes;
+	for (auto i = 0; i < 4; ++i)
+	{
+		planes.plane[i] = nullptr;
+		if (usePlane[i])
+		{
+			planeData[i].resize (area);
+			planes.plane[i] = planeData[i].data ();
+		}
+	}
+	planes.width = width;
+	planes.height = height;
+	planes.radius = radius;
+	planes.divTable = divTable.data ();
+	Pixels result (src);
+	scalar.boxBlurRows (reinterpret_cast<const uint8_t*> (src.data ()), planes, 0, height);
+	scalar.boxBlurColumns (planes, reinterpret_cast<uint8_t*> (result.data ()), 0, height);
+	return expected == result;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+TESTCASE(CBitmapFilterKernelsTest,
+
+	TEST(scalarKernelsAlwaysAvailable,
+		auto kernels = getRowKernels (InstructionSet::Scalar);
+		EXPECT(kernels != nullptr)
+		EXPECT(kernels->instructionSet == InstructionSet::Scalar)
+		EXPECT(getRowKernels ().setColor != nullptr)
+	);
+
+	TEST(setColor,
+		EXPECT(compareRows ([] (const RowKernels& k, const uint32_t* src, uint32_t* dst, uint32_t count) {
+			k.setColor (src, dst, count, 0x00123456, 0xFF000000);
+		}))
+		EXPECT(compareRows ([] (const RowKernels& k, const uint32_t* src, uint32_t* dst, uint32_t count) {
+			k.setColor (src, dst, count, 0x78123456, 0);
+		}))
+	);
+
+	TEST(setColorKeepsMaskedBits,
+		const auto& kernels = getRowKernels ();
+		uint32_t dst[9];
+		kernels.setColor (kSetColorInput, dst, 9, 0x00010203, 0xFF000000);
+		EXPECT(dst[0] == 0x11010203)
+		EXPECT(dst[1] == 0xAA010203)
+		EXPECT(dst[3] == 0xFF010203)
+		EXPECT(dst[8] == 0x00010203)
+	);
+
+	TEST(replaceColor,
+		EXPECT(compareRows ([] (const RowKernels& k, const uint32_t* src, uint32_t* dst, uint32_t count) {
+			// replace the value of the first pixel, so there is at least one match
+			auto from = count ? src[0] : 0u;
+			k.replaceColor (src, dst, count, from, 0x01020304);
+		}))
+	);
+
+	TEST(replaceColorOnlyMatches,
+		const auto& kernels = getRowKernels ();
+		uint32_t pixels[10];
+		kernels.replaceColor (kReplaceInput, pixels, 10, 5, 7);
+		EXPECT(std::equal (pixels, pixels + 10, kReplaceExpected))
+	);
+
+	TEST(grayscale,
+		for (auto layout : kLayouts)
+		{
+			EXPECT(compareRows ([&] (const RowKernels& k, const uint32_t* src, uint32_t* dst, uint32_t count) {
+				k.grayscale (src, dst, count, layout);
+			}))
+		}
+	);
+
+	TEST(grayscaleMatchesLuma,
+		const auto& kernels = getRowKernels ();
+		uint8_t pixels[9 * 4];
+		for (auto i = 0u; i < sizeof (pixels); ++i)
+			pixels[i] = static_cast<uint8_t> (i * 29);
+		uint32_t src[9];
+		uint32_t dst[9];
+		memcpy (src, pixels, sizeof (src));
+		kernels.grayscale (src, dst, 9, kRGBALayout);
+		uint8_t result[9 * 4];
+		memcpy (result, dst, sizeof (result));
+		for (auto i = 0u; i < 9; ++i)
+		{
+			CColor c (pixels[i * 4], pixels[i * 4 + 1], pixels[i * 4 + 2], pixels[i * 4 + 3]);
+			EXPECT(result[i * 4] == c.getLuma ())
+			EXPECT(result[i * 4 + 1] == c.getLuma ())
+			EXPECT(result[i * 4 + 2] == c.getLuma ())
+			EXPECT(result[i * 4 + 3] == c.alpha)
+		}
+	);
+
+	TEST(scale,
+		EXPECT(compareScale (1, 7))
+		EXPECT(compareScale (10, 33))
+		EXPECT(compareScale (33, 10))
+		EXPECT(compareScale (100, 257))
+	);
+
+	TEST(boxBlurAllPlanes,
+		EXPECT(compareBoxBlur (1, 1, 1, kAllPlanes))
+		EXPECT(compareBoxBlur (7, 5, 1, kAllPlanes))
+		EXPECT(compareBoxBlur (33, 17, 2, kAllPlanes))
+		EXPECT(compareBoxBlur (64, 64, 5, kAllPlanes))
+		EXPECT(compareBoxBlur (21, 40, 30, kAllPlanes))
+	);
+
+	TEST(boxBlurSinglePlane,
+		EXPECT(compareBoxBlur (33, 17, 2, kFirstPlane))
+		EXPECT(compareBoxBlur (33, 17, 2, kLastPlane))
+		EXPECT(compareBoxBlur (9, 50, 7, kLastPlane))
+	);
+
+	TEST(setColorMatchesOriginalFilter,
+		const auto& scalar = *getRowKernels (InstructionSet::Scalar);
+		auto src = randomPixels (100, 1);
+		Pixels expected (src.size ());
+		Pixels result (src.size ());
+		CColor inputColor (0x12, 0x34, 0x56, 0x78);
+		for (auto ignoreAlpha : {false, true})
+		{
+			originalSetColor (src, expected, inputColor, ignoreAlpha);
+			// packed like the SetColor filter does for RGBA pixels
+			uint32_t color = 0x78563412;
+			uint32_t keepMask = ignoreAlpha ? 0xFF000000 : 0;
+			scalar.setColor (src.data (), result.data (), 100, color & ~keepMask, keepMask);
+			EXPECT(expected == result)
+		}
+	);
+
+	TEST(scaleMatchesOriginalFilters,
+		EXPECT(compareWithOriginalScale (2, 2, 7, 5))
+		EXPECT(compareWithOriginalScale (10, 3, 33, 8))
+		EXPECT(compareWithOriginalScale (33, 17, 10, 9))
+		EXPECT(compareWithOriginalScale (100, 40, 257, 99))
+		EXPECT(compareWithOriginalScale (64, 64, 64, 64))
+	);
+
+	TEST(boxBlurMatchesOriginalFilter,
+		EXPECT(compareWithOriginalBoxBlur (7, 5, 1, kAllPlanes))
+		EXPECT(compareWithOriginalBoxBlur (33, 17, 2, kAllPlanes))
+		EXPECT(compareWithOriginalBoxBlur (64, 64, 5, kAllPlanes))
+		EXPECT(compareWithOriginalBoxBlur (40, 21, 20, kAllPlanes))
+		EXPECT(compareWithOriginalBoxBlur (33, 17, 2, kLastPlane))
+	);
+
+	TEST(runTiledCoversRangeOnce,
+		for (auto numThreads : {0u, 1u, 2u, 5u})
+		{
+			std::vector<std::atomic<int32_t>> hits (1000);
+			runTiled (1000, 7, numThreads, [&] (int32_t begin, int32_t end) {
+				for (auto i = begin; i < end; ++i)
+					++hits[i];
+			});
+			for (auto& hit : hits)
+				EXPECT(hit == 1)
+		}
+	);
+
+	TEST(runTiledKeepsMinTileSize,
+		std::atomic<int32_t> minSize {1000};
+		runTiled (100, 30, 8, [&] (int32_t begin, int32_t end) {
+			auto size = end - begin;
+			auto current = minSize.load ();
+			while (size < current && !minSize.compare_exchange_weak (current, size)) {}
+		});
+		EXPECT(minSize >= 30)
+	);
+
+	TEST(runTiledUsesCallingThreadOnWorkerThreads,
+		auto callingThread = std::this_thread::get_id ();
+		std::atomic<int32_t> otherThreads {0};
+		runTiled (1000, 1, 4, [&] (int32_t begin, int32_t end) {
+			// nested calls from the tiles must not start threads
+			auto tileThread = std::this_thread::get_id ();
+			runTiled (100, 1, 4, [&] (int32_t begin, int32_t end) {
+				if (std::this_thread::get_id () != tileThread)
+					++otherThreads;
+			});
+		});
+		EXPECT(WorkerThreadScope::isWorkerThread () == false)
+		{
+			WorkerThreadScope workerThreadScope;
+			EXPECT(WorkerThreadScope::isWorkerThread ())
+			runTiled (1000, 1, 4, [&] (int32_t begin, int32_t end) {
+				if (std::this_thread::get_id () != callingThread)
+					++otherThreads;
+			});
+		}
+		EXPECT(WorkerThreadScope::isWorkerThread () == false)
+		EXPECT(otherThreads == 0)
+	);
+
+	TEST(boxBlurFlatImageStaysFlat,
+		const auto& kernels = getRowKernels ();
+		constexpr int32_t width = 19;
+		constexpr int32_t height = 11;
+		constexpr int32_t radius = 3;
+		Pixels pixels (width * height, 0x80402010);
+		std::vector<uint8_t> divTable (256 * (radius * 2 + 1));
+		for (auto i = 0u; i < divTable.size (); ++i)
+			divTable[i] = static_cast<uint8_t> (i / (radius * 2 + 1));
+		std::vector<uint8_t> planeData[4];
+		BoxBlurPlanes planes;
+		for (auto i = 0; i < 4; ++i)
+		{
+			planeData[i].resize (pixels.size ());
+			planes.plane[i] = planeData[i].data ();
+		}
+		planes.width = width;
+		planes.height = height;
+		planes.radius = radius;
+		planes.divTable = divTable.data ();
+		auto data = reinterpret_cast<uint8_t*> (pixels.data ());
+		kernels.boxBlurRows (data, planes, 0, height);
+		kernels.boxBlurColumns (planes, data, 0, height);
+		for (auto p : pixels)
+			EXPECT(p == 0x80402010)
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,130 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../unittests.h"
+#include "../../../lib/cdatabrowser.h"
+#include "../../../lib/idatabrowserdelegate.h"
+
+namespace VSTGUI {
+
+namespace {
+
+class DataBrowserDelegate : public DataBrowserDelegateAdapter
+{
+public:
+	DataBrowserDelegate (int32_t numRows, bool variableRowHeight = false)
+	: numRows (numRows), variableRowHeight (variableRowHeight)
+	{
+	}
+
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return numRows; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return 2; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return 10; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override { return 50; }
+	void dbDrawCell (CDrawContext* context, const CRect& size, int32_t row, int32_t column,
+	                 int32_t flags, CDataBrowser* browser) override
+	{
+	}
+	bool dbHasVariableRowHeight (CDataBrowser* browser) override { return variableRowHeight; }
+	CCoord dbGetVariableRowHeight (int32_t row, CDataBrowser* browser) override
+	{
+		return 10 * (row + 1);
+	}
+
+private:
+	int32_t numRows;
+	bool variableRowHeight;
+};
+
+class SelectionEditingDataBrowser : public CDataBrowser
+{
+public:
+	using CDataBrowser::CDataBrowser;
+
+	void replaceSelection (const Selection& rows)
+	{
+		selection = rows;
+		selectionModified ();
+	}
+};
+
+} // anonymous
+
+TESTCASE(CDataBrowserTest,
+
+	TEST(cellBounds,
+		DataBrowserDelegate delegate (100);
+		auto browser = owned (new CDataBrowser (CRect (0, 0, 100, 100), &delegate));
+		browser->recalculateLayout ();
+		EXPECT (browser->getCellBounds ({0, 0}) == CRect (0, 0, 50, 10));
+		EXPECT (browser->getCellBounds ({5, 1}) == CRect (50, 50, 100, 60));
+		EXPECT (browser->getCellBounds ({99, 0}) == CRect (0, 990, 50, 1000));
+	);
+
+	TEST(cellBoundsWithVariableRowHeight,
+		DataBrowserDelegate delegate (100, true);
+		auto browser = owned (new CDataBrowser (CRect (0, 0, 100, 100), &delegate));
+		browser->recalculateLayout ();
+		EXPECT (browser->getCellBounds ({0, 0}) == CRect (0, 0, 50, 10));
+		EXPECT (browser->getCellBounds ({1, 0}) == CRect (0, 10, 50, 30));
+		EXPECT (browser->getCellBounds ({2, 1}) == CRect (50, 30, 100, 60));
+		EXPECT (browser->getCellBounds ({99, 0}) == CRect (0, 49500, 50, 50500));
+	);
+
+	TEST(singleSelection,
+		DataBrowserDelegate delegate (100);
+		auto browser = owned (new CDataBrowser (CRect (0, 0, 100, 100), &delegate));
+		browser->recalculateLayout ();
+		browser->setSelectedRow (5);
+		EXPECT (browser->isRowSelected (5));
+		EXPECT (browser->getSelectedRow () == 5);
+		browser->selectRow (7);
+		EXPECT (browser->isRowSelected (5) == false);
+		EXPECT (browser->isRowSelected (7));
+		EXPECT (browser->getSelection ().size () == 1);
+		browser->unselectAll ();
+		EXPECT (browser->isRowSelected (7) == false);
+		EXPECT (browser->getSelection ().empty ());
+	);
+
+	TEST(multiSelection,
+		DataBrowserDelegate delegate (100);
+		auto browser = owned (new CDataBrowser (CRect (0, 0, 100, 100), &delegate,
+		                                        CDataBrowser::kMultiSelectionStyle));
+		browser->recalculateLayout ();
+		for (auto row = 10; row < 20; ++row)
+			browser->selectRow (row);
+		EXPECT (browser->getSelection ().size () == 10);
+		EXPECT (browser->getSelectedRow () == 10);
+		EXPECT (browser->isRowSelected (9) == false);
+		EXPECT (browser->isRowSelected (15));
+		EXPECT (browser->isRowSelected (20) == false);
+		EXPECT (browser->isRowSelected (1000) == false);
+		EXPECT (browser->isRowSelected (-1) == false);
+		browser->unselectRow (15);
+		EXPECT (browser->isRowSelected (15) == false);
+		EXPECT (browser->getSelection ().size () == 9);
+		browser->setSelectedRow (3);
+		EXPECT (browser->isRowSelected (3));
+		EXPECT (browser->isRowSelected (10) == false);
+		EXPECT (browser->getSelection ().size () == 1);
+	);
+
+	TEST(selectionChangedBySubclass,
+		DataBrowserDelegate delegate (100);
+		auto browser = owned (new SelectionEditingDataBrowser (
+			CRect (0, 0, 100, 100), &delegate, CDataBrowser::kMultiSelectionStyle));
+		browser->recalculateLayout ();
+		browser->selectRow (3);
+		browser->replaceSelection ({20, 40});
+		EXPECT (browser->isRowSelected (3) == false);
+		EXPECT (browser->isRowSelected (20));
+		EXPECT (browser->isRowSelected (40));
+		browser->unselectAll ();
+		EXPECT (browser->isRowSelected (20) == false);
+		EXPECT (browser->isRowSelected (40) == false);
+	);
+);
+
+} // VSTGUI
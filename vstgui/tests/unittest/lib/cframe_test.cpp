@@ -4,6 +4,8 @@
 
 #include "../../../lib/cframe.h"
 #include "../../../lib/ccolor.h"
+#include "../../../lib/crowcolumnview.h"
+#include "../../../lib/platform/iplatformframecallback.h"
 #include "../unittests.h"
 #include "platform_helper.h"
 #include <vector>
@@ -132,6 +134,27 @@ public:
 	
 };
 
+class LayoutCountingView : public CRowColumnView
+{
+public:
+	LayoutCountingView (const CRect& size, std::vector<CView*>& layoutOrder)
+	: CRowColumnView (size), layoutOrder (layoutOrder) {}
+
+	void layoutViews () override
+	{
+		layoutOrder.push_back (this);
+		CRowColumnView::layoutViews ();
+	}
+
+	CMouseEventResult onMouseDown (CPoint& p, const CButtonState& buttons) override
+	{
+		setViewSize (CRect (0, 0, 90, 90));
+		return kMouseEventHandled;
+	}
+
+	std::vector<CView*>& layoutOrder;
+};
+
 } // anonymouse
 
 TESTCASE(CFrameTest,
@@ -292,6 +315,78 @@ TESTCASE(CFrameTest,
 		frame->unregisterMouseObserver (&observer);
 	);
 	
+	TEST(deferredLayout,
+		std::vector<CView*> layoutOrder;
+		auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+		auto outer = new LayoutCountingView (CRect (0, 0, 80, 80), layoutOrder);
+		auto inner = new LayoutCountingView (CRect (0, 0, 50, 50), layoutOrder);
+		outer->addView (inner);
+		frame->addView (outer);
+		frame->attached (frame);
+		layoutOrder.clear ();
+		inner->addView (new CView (CRect (0, 0, 10, 10)));
+		inner->addView (new CView (CRect (0, 0, 10, 10)));
+		inner->setSpacing (5.);
+		outer->setViewSize (CRect (0, 0, 60, 60));
+		outer->setMargin (CRect (1, 1, 1, 1));
+		EXPECT (layoutOrder.empty ());
+		EXPECT (inner->isLayoutPending ());
+		EXPECT (outer->isLayoutPending ());
+		frame->flushLayout ();
+		EXPECT (layoutOrder == std::vector<CView*> ({outer, inner}));
+		EXPECT (inner->getView (1)->getViewSize ().top == 15.);
+		frame->flushLayout ();
+		EXPECT (layoutOrder.size () == 2);
+	);
+
+	TEST(removeScheduledLayout,
+		std::vector<CView*> layoutOrder;
+		auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+		auto outer = new LayoutCountingView (CRect (0, 0, 80, 80), layoutOrder);
+		auto inner = new LayoutCountingView (CRect (0, 0, 50, 50), layoutOrder);
+		outer->addView (inner);
+		frame->addView (outer);
+		frame->attached (frame);
+		layoutOrder.clear ();
+		inner->setSpacing (5.);
+		EXPECT (inner->isLayoutPending ());
+		outer->removeView (inner, false);
+		EXPECT (inner->isLayoutPending () == false);
+		frame->flushLayout ();
+		EXPECT (layoutOrder == std::vector<CView*> ({outer}));
+		inner->forget ();
+	);
+
+	TEST(layoutAfterEvent,
+		std::vector<CView*> layoutOrder;
+		auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+		auto view = new LayoutCountingView (CRect (0, 0, 80, 80), layoutOrder);
+		frame->addView (view);
+		frame->attached (frame);
+		layoutOrder.clear ();
+		auto platformFrameCallback = dynamic_cast<IPlatformFrameCallback*> (frame.get ());
+		CPoint p (10, 10);
+		platformFrameCallback->platformOnMouseDown (p, kLButton);
+		EXPECT (view->getViewSize () == CRect (0, 0, 90, 90));
+		EXPECT (layoutOrder.size () == 1);
+		EXPECT (view->isLayoutPending () == false);
+	);
+
+	TEST(layoutBeforeDraw,
+		std::vector<CView*> layoutOrder;
+		auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+		auto view = new LayoutCountingView (CRect (0, 0, 80, 80), layoutOrder);
+		frame->addView (view);
+		frame->attached (frame);
+		layoutOrder.clear ();
+		view->setSpacing (5.);
+		EXPECT (view->isLayoutPending ());
+		auto platformFrameCallback = dynamic_cast<IPlatformFrameCallback*> (frame.get ());
+		platformFrameCallback->platformOnBeforeDraw ();
+		EXPECT (layoutOrder.size () == 1);
+		EXPECT (view->isLayoutPending () == false);
+	);
+
 	TEST(focusSettings,
 		auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
 		EXPECT (frame->getFocusColor () == kRedCColor);
@@ -0,0 +1,125 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cinvalidrectlist.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+bool noOverlaps (const CInvalidRectList& list)
+{
+	for (auto it = list.begin (); it != list.end (); ++it)
+	{
+		for (auto it2 = it + 1; it2 != list.end (); ++it2)
+		{
+			CRect r (*it);
+			if (!r.bound (*it2).isEmpty ())
+				return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+TESTCASE(CInvalidRectListTest,
+
+	TEST(ignoreEmptyRect,
+		CInvalidRectList list;
+		EXPECT(list.add (CRect (10, 10, 10, 20)) == false)
+		EXPECT(list.empty ())
+	);
+
+	TEST(ignoreContainedRect,
+		CInvalidRectList list;
+		EXPECT(list.add (CRect (0, 0, 100, 100)))
+		EXPECT(list.add (CRect (10, 10, 20, 20)) == false)
+		EXPECT(list.size () == 1)
+		EXPECT(list.data ()[0] == CRect (0, 0, 100, 100))
+	);
+
+	TEST(containingRectReplacesContained,
+		CInvalidRectList list;
+		list.add (CRect (10, 10, 20, 20));
+		list.add (CRect (0, 0, 100, 100));
+		EXPECT(list.size () == 1)
+		EXPECT(list.data ()[0] == CRect (0, 0, 100, 100))
+	);
+
+	TEST(mergeHorizontalNeighbours,
+		CInvalidRectList list (0.);
+		list.add (CRect (0, 0, 50, 10));
+		list.add (CRect (50, 0, 100, 10));
+		EXPECT(list.size () == 1)
+		EXPECT(list.data ()[0] == CRect (0, 0, 100, 10))
+	);
+
+	TEST(mergeVerticalNeighbours,
+		CInvalidRectList list (0.);
+		list.add (CRect (0, 0, 50, 10));
+		list.add (CRect (0, 10, 50, 20));
+		EXPECT(list.size () == 1)
+		EXPECT(list.data ()[0] == CRect (0, 0, 50, 20))
+	);
+
+	TEST(overlappingRectsAreBanded,
+		CInvalidRectList list (0.);
+		list.add (CRect (0, 0, 100, 100));
+		list.add (CRect (50, 50, 150, 150));
+		EXPECT(list.size () == 3)
+		EXPECT(noOverlaps (list))
+		EXPECT(list.getArea () == 100 * 100 * 2 - 50 * 50)
+		EXPECT(list.getBounds () == CRect (0, 0, 150, 150))
+		EXPECT(list.data ()[0] == CRect (0, 0, 100, 50))
+		EXPECT(list.data ()[1] == CRect (0, 50, 150, 100))
+		EXPECT(list.data ()[2] == CRect (50, 100, 150, 150))
+	);
+
+	TEST(disjointRectsStaySeparate,
+		CInvalidRectList list (0.);
+		list.add (CRect (0, 0, 10, 10));
+		list.add (CRect (100, 0, 110, 10));
+		list.add (CRect (0, 100, 10, 110));
+		EXPECT(list.size () == 3)
+		EXPECT(list.getArea () == 300)
+	);
+
+	TEST(collapseToBoundsWhenCheaper,
+		CInvalidRectList list (100.);
+		list.add (CRect (0, 0, 10, 10));
+		list.add (CRect (12, 0, 22, 10));
+		EXPECT(list.size () == 1)
+		EXPECT(list.data ()[0] == CRect (0, 0, 22, 10))
+	);
+
+	TEST(collapseWhenExceedingMaxRects,
+		CInvalidRectList list (0., 4);
+		for (auto i = 0; i < 5; ++i)
+			list.add (CRect (i * 20, i * 20, i * 20 + 10, i * 20 + 10));
+		EXPECT(list.size () == 1)
+		EXPECT(list.data ()[0] == CRect (0, 0, 90, 90))
+	);
+
+	TEST(manyOverlappingRectsDoNotOverlapInList,
+		CInvalidRectList list (0., 1000);
+		for (auto i = 0; i < 20; ++i)
+			list.add (CRect (i * 7, (i % 5) * 9, i * 7 + 30, (i % 5) * 9 + 25));
+		EXPECT(noOverlaps (list))
+	);
+
+	TEST(clear,
+		CInvalidRectList list;
+		list.add (CRect (0, 0, 10, 10));
+		list.clear ();
+		EXPECT(list.empty ())
+		EXPECT(list.getArea () == 0.)
+	);
+
+);
+
+} // VSTGUI
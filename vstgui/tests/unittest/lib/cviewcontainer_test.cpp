@@ -542,6 +542,52 @@ TESTCASE(CViewContainerTest,
 		res = container->getContainerAt (CPoint(0, 0), GetViewOptions (GetViewOptions::kDeep | GetViewOptions::kMouseEnabled));
 		EXPECT(res == c1);
 	);
+
+	TEST(spatialIndex,
+		CFrame* frame = new CFrame (CRect (0, 0, 200, 200), nullptr);
+		EXPECT(container->getSpatialIndexEnabled () == false);
+		container->setSpatialIndexEnabled (true);
+		EXPECT(container->getSpatialIndexEnabled ());
+		std::vector<CView*> views;
+		for (auto i = 0; i < 100; ++i)
+		{
+			CRect r (0, 0, 20, 20);
+			r.offset ((i % 10) * 20, (i / 10) * 20);
+			views.emplace_back (new CView (r));
+			container->addView (views.back ());
+		}
+		frame->addView (container);
+		container->remember ();
+		frame->attached (frame);
+
+		EXPECT(container->getViewAt (CPoint (5, 5)) == views[0]);
+		EXPECT(container->getViewAt (CPoint (195, 195)) == views[99]);
+		views[0]->setViewSize (CRect (150, 150, 170, 170));
+		EXPECT(container->getViewAt (CPoint (5, 5)) == nullptr);
+		EXPECT(container->getViewAt (CPoint (155, 155)) == views[77]);
+		container->changeViewZOrder (views[0], 99);
+		EXPECT(container->getViewAt (CPoint (155, 155)) == views[0]);
+		views[1]->setMouseableArea (CRect (0, 0, 40, 20));
+		EXPECT(container->getViewAt (CPoint (5, 5)) == views[1]);
+		auto top = new CView (CRect (0, 0, 200, 200));
+		container->addView (top);
+		EXPECT(container->getViewAt (CPoint (100, 100)) == top);
+		container->removeView (top);
+		EXPECT(container->getViewAt (CPoint (100, 100)) == views[55]);
+		auto bottom = new CView (CRect (0, 0, 5, 5));
+		container->addView (bottom, views[1]);
+		EXPECT(container->getViewAt (CPoint (2, 2)) == views[1]);
+		views[1]->setMouseableArea (views[1]->getViewSize ());
+		EXPECT(container->getViewAt (CPoint (2, 2)) == bottom);
+		CViewContainer::ViewList hits;
+		EXPECT(container->getViewsAt (CPoint (155, 155), hits));
+		EXPECT(hits.size () == 2);
+		EXPECT(hits.front () == views[0]);
+		EXPECT(hits.back () == views[77]);
+		container->setSpatialIndexEnabled (false);
+		EXPECT(container->getViewAt (CPoint (155, 155)) == views[0]);
+		frame->close ();
+	);
 	
 ); // TESTCASE
 
@@ -0,0 +1,192 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/cbitmap.h"
+#include "../../../../../lib/platform/linux/cairobitmap.h"
+#include "../../../../../lib/platform/linux/cairocontext.h"
+#include "../../../unittests.h"
+#include <cstdlib>
+#include <functional>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> createSourceBitmap (CPoint size)
+{
+	auto bitmap = makeOwned<CBitmap> (makeOwned<Cairo::Bitmap> (&size));
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap, false)))
+	{
+		do
+		{
+			auto x = accessor->getX ();
+			auto y = accessor->getY ();
+			accessor->setColor (CColor (static_cast<uint8_t> (x * 40), static_cast<uint8_t> (y * 50),
+										static_cast<uint8_t> (x * y * 7),
+										static_cast<uint8_t> (255 - (x + y) * 10)));
+		} while (++(*accessor));
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> render (CPoint size, const std::function<void (CDrawContext*)>& proc)
+{
+	auto platformBitmap = makeOwned<Cairo::Bitmap> (&size);
+	auto context = makeOwned<Cairo::Context> (CRect (0, 0, size.x, size.y),
+											  platformBitmap->getSurface ());
+	context->beginDraw ();
+	proc (context);
+	context->endDraw ();
+	return makeOwned<CBitmap> (platformBitmap);
+}
+
+//------------------------------------------------------------------------
+bool samePixels (CBitmap* b1, CBitmap* b2, int32_t tolerance = 0)
+{
+	auto a1 = owned (CBitmapPixelAccess::create (b1));
+	auto a2 = owned (CBitmapPixelAccess::create (b2));
+	if (!a1 || !a2)
+		return false;
+	do
+	{
+		CColor c1, c2;
+		a1->getColor (c1);
+		a2->getColor (c2);
+		if (std::abs (c1.red - c2.red) > tolerance || std::abs (c1.green - c2.green) > tolerance ||
+			std::abs (c1.blue - c2.blue) > tolerance || std::abs (c1.alpha - c2.alpha) > tolerance)
+			return false;
+	} while (++(*a1) && ++(*a2));
+	return true;
+}
+
+} // anonymous
+
+TESTCASE(CairoContextTest,
+
+	TEST(fillRectWithBitmapMatchesTiles,
+		auto source = createSourceBitmap ({7, 5});
+		CRect srcRect (1, 1, 6, 4);
+		CRect dstRect (3, 2, 90, 61);
+		auto tiled = render ({100, 70}, [&] (CDrawContext* context) {
+			context->CDrawContext::fillRectWithBitmap (source, srcRect, dstRect, 1.f);
+		});
+		auto pattern = render ({100, 70}, [&] (CDrawContext* context) {
+			context->fillRectWithBitmap (source, srcRect, dstRect, 1.f);
+		});
+		EXPECT (samePixels (tiled, pattern));
+	);
+
+	TEST(fillRectWithWholeBitmapMatchesTiles,
+		auto source = createSourceBitmap ({7, 5});
+		CRect srcRect (0, 0, 7, 5);
+		CRect dstRect (0, 0, 64, 64);
+		auto tiled = render ({64, 64}, [&] (CDrawContext* context) {
+			context->CDrawContext::fillRectWithBitmap (source, srcRect, dstRect, 1.f);
+		});
+		auto pattern = render ({64, 64}, [&] (CDrawContext* context) {
+			context->fillRectWithBitmap (source, srcRect, dstRect, 1.f);
+		});
+		EXPECT (samePixels (tiled, pattern));
+	);
+
+	TEST(fillRectWithBitmapAlphaMatchesTiles,
+		auto source = createSourceBitmap ({7, 5});
+		CRect srcRect (2, 0, 5, 5);
+		CRect dstRect (5, 5, 45, 35);
+		auto tiled = render ({50, 40}, [&] (CDrawContext* context) {
+			context->setGlobalAlpha (0.8f);
+			context->CDrawContext::fillRectWithBitmap (source, srcRect, dstRect, 0.5f);
+		});
+		auto pattern = render ({50, 40}, [&] (CDrawContext* context) {
+			context->setGlobalAlpha (0.8f);
+			context->fillRectWithBitmap (source, srcRect, dstRect, 0.5f);
+		});
+		EXPECT (samePixels (tiled, pattern, 1));
+	);
+
+	TEST(fillRectWithBitmapTransformedMatchesTiles,
+		auto source = createSourceBitmap ({7, 5});
+		CRect srcRect (1, 0, 4, 5);
+		CRect dstRect (0, 0, 30, 20);
+		auto transform = CGraphicsTransform ().translate (8, 6);
+		auto tiled = render ({50, 40}, [&] (CDrawContext* context) {
+			CDrawContext::Transform t (*context, transform);
+			context->CDrawContext::fillRectWithBitmap (source, srcRect, dstRect, 1.f);
+		});
+		auto pattern = render ({50, 40}, [&] (CDrawContext* context) {
+			CDrawContext::Transform t (*context, transform);
+			context->fillRectWithBitmap (source, srcRect, dstRect, 1.f);
+		});
+		EXPECT (samePixels (tiled, pattern));
+	);
+
+	TEST(ninePartTiledMatchesTiles,
+		auto source = createSourceBitmap ({7, 7});
+		CNinePartTiledDescription desc (3, 3, 3, 3);
+		CRect dstRect (2, 4, 95, 77);
+		auto tiled = render ({100, 80}, [&] (CDrawContext* context) {
+			CRect srcRects[CNinePartTiledDescription::kPartCount];
+			CRect dstRects[CNinePartTiledDescription::kPartCount];
+			desc.calcRects (CRect (0, 0, 7, 7), srcRects);
+			desc.calcRects (dstRect, dstRects);
+			for (auto i = 0; i < CNinePartTiledDescription::kPartCount; ++i)
+				context->CDrawContext::fillRectWithBitmap (source, srcRects[i], dstRects[i], 1.f);
+		});
+		auto pattern = render ({100, 80}, [&] (CDrawContext* context) {
+			context->drawBitmapNinePartTiled (source, dstRect, desc, 1.f);
+		});
+		EXPECT (samePixels (tiled, pattern));
+	);
+
+	TEST(drawBitmapPixelAligned,
+		auto source = createSourceBitmap ({7, 5});
+		CRect dest (4, 3, 10, 7);
+		CPoint offset (2, 1);
+		for (auto clipRect : {CRect (0, 0, 20, 20), CRect (6, 6, 9, 8)})
+		{
+			auto result = render ({20, 20}, [&] (CDrawContext* context) {
+				context->setClipRect (clipRect);
+				CDrawContext::Transform t (*context, CGraphicsTransform ().translate (1, 2));
+				context->drawBitmap (source, dest, offset, 1.f);
+			});
+			// the destination is (5, 5) to (11, 9) and starts at (2, 1) of the source
+			CRect expectedRect (5, 5, 10, 9);
+			expectedRect.bound (clipRect);
+			auto sourceAccess = owned (CBitmapPixelAccess::create (source));
+			auto resultAccess = owned (CBitmapPixelAccess::create (result));
+			EXPECT (sourceAccess && resultAccess);
+			do
+			{
+				CPoint p (resultAccess->getX (), resultAccess->getY ());
+				CColor color;
+				resultAccess->getColor (color);
+				CColor expectedColor (0, 0, 0, 0);
+				if (expectedRect.pointInside (p))
+				{
+					sourceAccess->setPosition (static_cast<uint32_t> (p.x - 3),
+											   static_cast<uint32_t> (p.y - 4));
+					sourceAccess->getColor (expectedColor);
+				}
+				EXPECT (color == expectedColor);
+			} while (++(*resultAccess));
+		}
+	);
+
+	TEST(fillRectWithBitmapOutsideOfBitmap,
+		auto source = createSourceBitmap ({7, 5});
+		CRect srcRect (4, 2, 9, 5);
+		CRect dstRect (0, 0, 20, 20);
+		auto tiled = render ({20, 20}, [&] (CDrawContext* context) {
+			context->CDrawContext::fillRectWithBitmap (source, srcRect, dstRect, 1.f);
+		});
+		auto pattern = render ({20, 20}, [&] (CDrawContext* context) {
+			context->fillRectWithBitmap (source, srcRect, dstRect, 1.f);
+		});
+		EXPECT (samePixels (tiled, pattern));
+	);
+);
+
+} // VSTGUI
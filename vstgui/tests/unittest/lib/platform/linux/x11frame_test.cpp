@@ -0,0 +1,296 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/cframe.h"
+#include "../../../../../lib/clayeredviewcontainer.h"
+#include "../../../../../lib/crowcolumnview.h"
+#include "../../../../../lib/cview.h"
+#include "../../../../../lib/platform/iplatformframe.h"
+#include "../../../../../lib/platform/linux/cairoviewlayer.h"
+#include "../../../../../lib/platform/platform_x11.h"
+#include "../../../unittests.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <poll.h>
+#include <xcb/xcb.h>
+
+namespace VSTGUI {
+namespace X11 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+//------------------------------------------------------------------------
+/** processes the events of the X server connection and the timers of the frame */
+class EventLoop : public IRunLoop, public NonAtomicReferenceCounted
+{
+public:
+	bool registerEventHandler (int fd, IEventHandler* handler) override
+	{
+		eventHandlers.push_back ({fd, handler});
+		return true;
+	}
+
+	bool unregisterEventHandler (IEventHandler* handler) override
+	{
+		eventHandlers.erase (std::remove_if (eventHandlers.begin (), eventHandlers.end (),
+											 [&] (const EventHandler& h) { return h.handler == handler; }),
+							 eventHandlers.end ());
+		return true;
+	}
+
+	bool registerTimer (uint64_t interval, ITimerHandler* handler) override
+	{
+		timers.push_back ({handler, std::chrono::milliseconds (interval),
+						   Clock::now () + std::chrono::milliseconds (interval)});
+		return true;
+	}
+
+	bool unregisterTimer (ITimerHandler* handler) override
+	{
+		timers.erase (std::remove_if (timers.begin (), timers.end (),
+									  [&] (const Timer& t) { return t.handler == handler; }),
+					  timers.end ());
+		return true;
+	}
+
+	/** run until proc returns true, returns false if the timeout is reached first */
+	template<typename Proc>
+	bool runUntil (Proc proc, std::chrono::milliseconds timeout = std::chrono::milliseconds (2000))
+	{
+		auto end = Clock::now () + timeout;
+		while (!proc ())
+		{
+			auto now = Clock::now ();
+			if (now >= end)
+				return false;
+			auto next = end;
+			for (const auto& timer : timers)
+				next = std::min (next, timer.fireTime);
+			auto wait = std::chrono::duration_cast<std::chrono::milliseconds> (next - now).count ();
+			std::vector<pollfd> fds;
+			for (const auto& h : eventHandlers)
+				fds.push_back ({h.fd, POLLIN, 0});
+			if (poll (fds.data (), fds.size (), static_cast<int> (std::max<int64_t> (wait, 0))) > 0)
+			{
+				auto handlers = eventHandlers;
+				for (auto i = 0u; i < fds.size (); ++i)
+				{
+					if (fds[i].revents & POLLIN)
+						handlers[i].handler->onEvent ();
+				}
+			}
+			fireTimers ();
+		}
+		return true;
+	}
+
+private:
+	struct EventHandler
+	{
+		int fd;
+		IEventHandler* handler;
+	};
+
+	struct Timer
+	{
+		ITimerHandler* handler;
+		Clock::duration interval;
+		Clock::time_point fireTime;
+	};
+
+	void fireTimers ()
+	{
+		auto now = Clock::now ();
+		auto dueTimers = timers;
+		for (const auto& timer : dueTimers)
+		{
+			if (timer.fireTime > now)
+				continue;
+			// an earlier timer callback may have removed it
+			auto it = std::find_if (timers.begin (), timers.end (),
+									[&] (const Timer& t) { return t.handler == timer.handler; });
+			if (it == timers.end ())
+				continue;
+			it->fireTime = now + it->interval;
+			timer.handler->onTimer ();
+		}
+	}
+
+	std::vector<EventHandler> eventHandlers;
+	std::vector<Timer> timers;
+};
+
+//------------------------------------------------------------------------
+/** the root window of the default screen, 0 if no X server is available */
+struct Display
+{
+	Display ()
+	{
+		connection = xcb_connect (nullptr, nullptr);
+		if (xcb_connection_has_error (connection))
+			return;
+		root = xcb_setup_roots_iterator (xcb_get_setup (connection)).data->root;
+	}
+
+	~Display () noexcept { xcb_disconnect (connection); }
+
+	void map (CFrame* frame)
+	{
+		auto window = reinterpret_cast<uintptr_t> (frame->getPlatformFrame ()->getPlatformRepresentation ());
+		xcb_map_window (connection, static_cast<xcb_window_t> (window));
+		xcb_flush (connection);
+	}
+
+	xcb_connection_t* connection {nullptr};
+	xcb_window_t root {0};
+};
+
+//------------------------------------------------------------------------
+/** invalidates scattered rects while it is drawn the first time */
+class InvalidatingView : public CView
+{
+public:
+	using CView::CView;
+
+	void draw (CDrawContext* context) override
+	{
+		++numDraws;
+		if (numDraws > 1)
+			return;
+		// more rects than the dirty rect list keeps, so it is rebuilt while the frame is drawn
+		for (auto i = 0; i < 64; ++i)
+		{
+			CRect r (0, 0, 2, 2);
+			r.offset ((i * 37) % 190, (i * 53) % 190);
+			invalidRect (r);
+		}
+	}
+
+	int32_t numDraws {0};
+};
+
+//------------------------------------------------------------------------
+/** schedules its layout again each time it is laid out */
+class RelayoutView : public CRowColumnView
+{
+public:
+	using CRowColumnView::CRowColumnView;
+
+	void layoutViews () override
+	{
+		++numLayouts;
+		CRowColumnView::layoutViews ();
+		invalidLayout ();
+	}
+
+	int32_t numLayouts {0};
+};
+
+} // anonymous
+
+TESTCASE(X11FrameTest,
+
+	TEST(invalidRectWhileDrawing,
+		Display display;
+		if (display.root == 0)
+		{
+			context->print ("no X server available, skipped");
+			return true;
+		}
+		auto runLoop = makeOwned<EventLoop> ();
+		FrameConfig config;
+		config.runLoop = runLoop;
+		auto frame = new CFrame (CRect (0, 0, 200, 200), nullptr);
+		auto view = new InvalidatingView (CRect (0, 0, 200, 200));
+		frame->addView (view);
+		EXPECT (frame->open (reinterpret_cast<void*> (static_cast<uintptr_t> (display.root)),
+							 PlatformType::kX11EmbedWindowID, &config));
+		display.map (frame);
+		EXPECT (runLoop->runUntil ([&] () { return view->numDraws > 0; }));
+		// the rects invalidated while drawing are drawn with the next frame
+		EXPECT (runLoop->runUntil ([&] () { return view->numDraws > 1; }));
+		frame->close ();
+	);
+
+	TEST(layoutBeforeDraw,
+		Display display;
+		if (display.root == 0)
+		{
+			context->print ("no X server available, skipped");
+			return true;
+		}
+		auto runLoop = makeOwned<EventLoop> ();
+		FrameConfig config;
+		config.runLoop = runLoop;
+		auto frame = new CFrame (CRect (0, 0, 200, 200), nullptr);
+		auto view = new CRowColumnView (CRect (0, 0, 200, 200));
+		frame->addView (view);
+		EXPECT (frame->open (reinterpret_cast<void*> (static_cast<uintptr_t> (display.root)),
+							 PlatformType::kX11EmbedWindowID, &config));
+		display.map (frame);
+		auto stats = dynamic_cast<IPlatformFrameTimingStatsExtension*> (frame->getPlatformFrame ());
+		EXPECT (runLoop->runUntil ([&] () { return stats->getTimingStats ().frameCount > 0; }));
+		// scheduled outside of the event handling, the frame lays it out before it draws
+		auto frameCount = stats->getTimingStats ().frameCount;
+		view->setSpacing (5.);
+		EXPECT (view->isLayoutPending ());
+		EXPECT (runLoop->runUntil ([&] () { return stats->getTimingStats ().frameCount > frameCount; }));
+		EXPECT (view->isLayoutPending () == false);
+		frame->close ();
+	);
+
+	TEST(layoutLeftAfterMaxLayoutRounds,
+		Display display;
+		if (display.root == 0)
+		{
+			context->print ("no X server available, skipped");
+			return true;
+		}
+		auto runLoop = makeOwned<EventLoop> ();
+		FrameConfig config;
+		config.runLoop = runLoop;
+		auto frame = new CFrame (CRect (0, 0, 200, 200), nullptr);
+		auto view = new RelayoutView (CRect (0, 0, 200, 200));
+		frame->addView (view);
+		EXPECT (frame->open (reinterpret_cast<void*> (static_cast<uintptr_t> (display.root)),
+							 PlatformType::kX11EmbedWindowID, &config));
+		display.map (frame);
+		view->invalidLayout ();
+		frame->flushLayout ();
+		// the flush stops after its maximum rounds, the layouts left are done later on their own
+		auto numLayouts = view->numLayouts;
+		EXPECT (view->isLayoutPending ());
+		EXPECT (runLoop->runUntil ([&] () { return view->numLayouts > numLayouts; }));
+		frame->close ();
+	);
+
+	TEST(viewLayerStartsWithFrameScaleFactor,
+		Display display;
+		if (display.root == 0)
+		{
+			context->print ("no X server available, skipped");
+			return true;
+		}
+		auto runLoop = makeOwned<EventLoop> ();
+		FrameConfig config;
+		config.runLoop = runLoop;
+		auto frame = new CFrame (CRect (0, 0, 200, 200), nullptr);
+		EXPECT (frame->open (reinterpret_cast<void*> (static_cast<uintptr_t> (display.root)),
+							 PlatformType::kX11EmbedWindowID, &config));
+		frame->setZoom (2.);
+		// the layer is created after the zoom changed, so it is never notified about the change
+		auto container = new CLayeredViewContainer (CRect (10, 10, 60, 60));
+		frame->addView (container);
+		auto layer = dynamic_cast<Cairo::ViewLayer*> (container->getPlatformLayer ());
+		EXPECT (layer);
+		EXPECT (layer->getScaleFactor () == 2.);
+		frame->close ();
+	);
+);
+
+} // X11
+} // VSTGUI
@@ -0,0 +1,246 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/cvstguitimer.h"
+#include "../../../../../lib/platform/linux/x11platform.h"
+#include "../../../../../lib/platform/linux/x11timer.h"
+#include "../../../unittests.h"
+#include <functional>
+#include <vector>
+#include <xcb/xcb.h>
+
+namespace VSTGUI {
+namespace X11 {
+
+namespace {
+
+uint64_t gTime = 0;
+
+//------------------------------------------------------------------------
+uint64_t testClock ()
+{
+	return gTime;
+}
+
+//------------------------------------------------------------------------
+class TestRunLoop : public IRunLoop, public NonAtomicReferenceCounted
+{
+public:
+	bool registerEventHandler (int fd, IEventHandler* handler) override { return false; }
+	bool unregisterEventHandler (IEventHandler* handler) override { return false; }
+
+	bool registerTimer (uint64_t _interval, ITimerHandler* _handler) override
+	{
+		interval = _interval;
+		handler = _handler;
+		return true;
+	}
+
+	bool unregisterTimer (ITimerHandler* _handler) override
+	{
+		interval = 0;
+		handler = nullptr;
+		return true;
+	}
+
+	// advances the time and calls the registered timer like a run loop would
+	void run (uint64_t duration)
+	{
+		auto end = gTime + duration;
+		while (handler && gTime + interval <= end)
+		{
+			gTime += interval;
+			handler->onTimer ();
+		}
+		gTime = end;
+	}
+
+	uint64_t interval {0};
+	ITimerHandler* handler {nullptr};
+};
+
+//------------------------------------------------------------------------
+struct TestTimer : ITimerHandler
+{
+	void onTimer () override
+	{
+		fireTimes.push_back (gTime);
+		if (proc)
+			proc ();
+	}
+
+	size_t count () const { return fireTimes.size (); }
+
+	std::vector<uint64_t> fireTimes;
+	std::function<void ()> proc;
+};
+
+} // anonymous
+
+TESTCASE(X11TimerSchedulerTest,
+
+	TEST(coalesceTimers,
+		gTime = 0;
+		TestRunLoop runLoop;
+		TimerScheduler scheduler (&runLoop, testClock);
+		TestTimer t1;
+		TestTimer t2;
+		TestTimer t3;
+		scheduler.add (&t1, 10, 10);
+		scheduler.add (&t2, 20, 20);
+		scheduler.add (&t3, 30, 30);
+		EXPECT (runLoop.interval == 10);
+		runLoop.run (600);
+		EXPECT (t1.count () == 60);
+		EXPECT (t2.count () == 30);
+		EXPECT (t3.count () == 20);
+		EXPECT (scheduler.getStatistics ().wakeups == 60);
+		EXPECT (scheduler.getStatistics ().fires == 110);
+		EXPECT (scheduler.getStatistics ().lateFires == 0);
+	);
+
+	TEST(neverFireEarly,
+		gTime = 0;
+		TestRunLoop runLoop;
+		TimerScheduler scheduler (&runLoop, testClock);
+		TestTimer t1;
+		TestTimer t2;
+		scheduler.add (&t1, 10, 10);
+		scheduler.add (&t2, 15, 15);
+		runLoop.run (60);
+		EXPECT (t2.fireTimes == std::vector<uint64_t> ({20, 30, 50, 60}));
+	);
+
+	TEST(tickIntervalFollowsTolerance,
+		gTime = 0;
+		TestRunLoop runLoop;
+		TimerScheduler scheduler (&runLoop, testClock);
+		TestTimer t1;
+		TestTimer t2;
+		scheduler.add (&t1, 100, 5);
+		scheduler.add (&t2, 50, 50);
+		EXPECT (runLoop.interval == 5);
+		scheduler.remove (&t1);
+		EXPECT (runLoop.interval == 50);
+		scheduler.remove (&t2);
+		EXPECT (runLoop.interval == 0);
+		EXPECT (runLoop.handler == nullptr);
+		EXPECT (scheduler.getNumTimers () == 0);
+	);
+
+	TEST(removeInCallback,
+		gTime = 0;
+		TestRunLoop runLoop;
+		TimerScheduler scheduler (&runLoop, testClock);
+		TestTimer t1;
+		TestTimer t2;
+		t1.proc = [&] () { scheduler.remove (&t2); };
+		t2.proc = [&] () { scheduler.remove (&t1); };
+		scheduler.add (&t1, 10, 10);
+		scheduler.add (&t2, 10, 10);
+		runLoop.run (100);
+		// the timer firing first removes the other one before it fires
+		EXPECT (t1.count () == 0 || t2.count () == 0);
+		EXPECT (t1.count () + t2.count () == 10);
+		EXPECT (scheduler.getNumTimers () == 1);
+	);
+
+	TEST(releaseSchedulerInCallback,
+		gTime = 0;
+		TestRunLoop runLoop;
+		auto scheduler = makeOwned<TimerScheduler> (&runLoop, testClock);
+		TestTimer t1;
+		// like the last X11::Timer which stops in its callback
+		t1.proc = [&] () {
+			scheduler->remove (&t1);
+			scheduler = nullptr;
+		};
+		scheduler->add (&t1, 10, 10);
+		runLoop.run (100);
+		EXPECT (t1.count () == 1);
+		EXPECT (runLoop.handler == nullptr);
+		EXPECT (runLoop.getNbReference () == 1);
+	);
+
+	TEST(restartInCallback,
+		gTime = 0;
+		TestRunLoop runLoop;
+		TimerScheduler scheduler (&runLoop, testClock);
+		TestTimer t1;
+		t1.proc = [&] () {
+			if (t1.count () == 1)
+				scheduler.add (&t1, 5, 5);
+		};
+		scheduler.add (&t1, 20, 20);
+		runLoop.run (20);
+		EXPECT (t1.count () == 1);
+		EXPECT (runLoop.interval == 5);
+		runLoop.run (20);
+		EXPECT (t1.fireTimes == std::vector<uint64_t> ({20, 25, 30, 35, 40}));
+	);
+
+	TEST(lateFires,
+		gTime = 0;
+		TestRunLoop runLoop;
+		TimerScheduler scheduler (&runLoop, testClock);
+		TestTimer t1;
+		scheduler.add (&t1, 10, 10);
+		gTime = 45;
+		scheduler.onTimer ();
+		EXPECT (t1.count () == 1);
+		EXPECT (scheduler.getStatistics ().lateFires == 1);
+		// the missed periods are skipped, the next fire is due at 55
+		runLoop.run (10);
+		EXPECT (t1.count () == 1);
+		runLoop.run (10);
+		EXPECT (t1.count () == 2);
+		EXPECT (scheduler.getStatistics ().lateFires == 1);
+	);
+
+	TEST(longPeriods,
+		gTime = 0;
+		TestRunLoop runLoop;
+		TimerScheduler scheduler (&runLoop, testClock);
+		TestTimer t1;
+		TestTimer t2;
+		TestTimer t3;
+		scheduler.add (&t1, 10, 10);
+		scheduler.add (&t2, 1000, 1000);
+		scheduler.add (&t3, 50000, 50000);
+		runLoop.run (100000);
+		EXPECT (t1.count () == 10000);
+		EXPECT (t2.count () == 100);
+		EXPECT (t3.fireTimes == std::vector<uint64_t> ({50000, 100000}));
+		EXPECT (scheduler.getStatistics ().lateFires == 0);
+	);
+);
+
+TESTCASE(X11TimerTest,
+
+	TEST(toleranceOfVSTGUITimer,
+		auto connection = xcb_connect (nullptr, nullptr);
+		auto hasServer = !xcb_connection_has_error (connection);
+		xcb_disconnect (connection);
+		if (!hasServer)
+		{
+			context->print ("no X server available, skipped");
+			return true;
+		}
+		auto runLoop = makeOwned<TestRunLoop> ();
+		RunLoop::init (runLoop);
+		auto timer = makeOwned<CVSTGUITimer> ([] (CVSTGUITimer*) {}, 100, true);
+		EXPECT (runLoop->interval == 100);
+		EXPECT (timer->setTolerance (5));
+		EXPECT (runLoop->interval == 5);
+		EXPECT (timer->setTolerance (0));
+		EXPECT (runLoop->interval == 100);
+		timer->stop ();
+		EXPECT (runLoop->handler == nullptr);
+		timer = nullptr;
+		RunLoop::exit ();
+	);
+);
+
+} // X11
+} // VSTGUI
@@ -0,0 +1,132 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../standalone/source/platform/gdk/gdkasync.h"
+#include "../../../unittests.h"
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace VSTGUI {
+namespace Standalone {
+
+TESTCASE(GDKAsyncTest,
+
+	TEST(serialQueueKeepsOrder,
+		std::vector<int> order;
+		auto queue = Async::makeSerialQueue ("test");
+		for (auto i = 0; i < 1000; ++i)
+			Async::schedule (queue, [&, i] () { order.push_back (i); });
+		Async::waitAllTasksDone ();
+		EXPECT(order.size () == 1000);
+		for (auto i = 0; i < 1000; ++i)
+			EXPECT(order[i] == i);
+	);
+
+	TEST(serialQueueUsesOneBackgroundThread,
+		auto mainThread = std::this_thread::get_id ();
+		std::set<std::thread::id> threads;
+		auto queue = Async::makeSerialQueue (nullptr);
+		for (auto i = 0; i < 100; ++i)
+			Async::schedule (queue, [&] () { threads.insert (std::this_thread::get_id ()); });
+		Async::waitAllTasksDone ();
+		EXPECT(threads.size () == 1);
+		EXPECT(*threads.begin () != mainThread);
+	);
+
+	TEST(serialQueuesRunInParallel,
+		std::atomic<bool> firstStarted {false};
+		std::atomic<bool> secondDone {false};
+		bool firstSawSecondDone = false;
+		auto queue1 = Async::makeSerialQueue ("first");
+		auto queue2 = Async::makeSerialQueue ("second");
+		Async::schedule (queue1, [&] () {
+			firstStarted = true;
+			while (!secondDone)
+				std::this_thread::yield ();
+			firstSawSecondDone = true;
+		});
+		Async::schedule (queue2, [&] () {
+			while (!firstStarted)
+				std::this_thread::yield ();
+			secondDone = true;
+		});
+		Async::waitAllTasksDone ();
+		EXPECT(firstSawSecondDone);
+	);
+
+	TEST(serialQueuePerformsTasksAfterRelease,
+		std::atomic<int> count {0};
+		auto queue = Async::makeSerialQueue ("released");
+		for (auto i = 0; i < 100; ++i)
+			Async::schedule (queue, [&] () { ++count; });
+		queue = nullptr;
+		Async::waitAllTasksDone ();
+		EXPECT(count == 100);
+	);
+
+	TEST(backgroundQueuePerformsAllTasksOffMainThread,
+		auto mainThread = std::this_thread::get_id ();
+		std::atomic<int> count {0};
+		std::atomic<int> onMainThread {0};
+		for (auto i = 0; i < 10000; ++i)
+		{
+			Async::schedule (Async::backgroundQueue (), [&] () {
+				if (std::this_thread::get_id () == mainThread)
+					++onMainThread;
+				++count;
+			});
+		}
+		Async::waitAllTasksDone ();
+		EXPECT(count == 10000);
+		EXPECT(onMainThread == 0);
+	);
+
+	TEST(backgroundQueueTasksCanScheduleTasks,
+		std::atomic<int> count {0};
+		for (auto i = 0; i < 100; ++i)
+		{
+			Async::schedule (Async::backgroundQueue (), [&] () {
+				for (auto j = 0; j < 100; ++j)
+					Async::schedule (Async::backgroundQueue (), [&] () { ++count; });
+			});
+		}
+		Async::waitAllTasksDone ();
+		EXPECT(count == 10000);
+	);
+
+	TEST(mainQueueKeepsOrderOnMainThread,
+		auto mainThread = std::this_thread::get_id ();
+		std::vector<int> order;
+		bool allOnMainThread = true;
+		Async::schedule (Async::backgroundQueue (), [&] () {
+			for (auto i = 0; i < 1000; ++i)
+			{
+				Async::schedule (Async::mainQueue (), [&, i] () {
+					if (std::this_thread::get_id () != mainThread)
+						allOnMainThread = false;
+					order.push_back (i);
+				});
+			}
+		});
+		Async::waitAllTasksDone ();
+		EXPECT(allOnMainThread);
+		EXPECT(order.size () == 1000);
+		for (auto i = 0; i < 1000; ++i)
+			EXPECT(order[i] == i);
+	);
+
+	TEST(mainQueueIsAsynchronous,
+		bool done = false;
+		Async::schedule (Async::mainQueue (), [&] () { done = true; });
+		EXPECT(done == false);
+		Async::waitAllTasksDone ();
+		EXPECT(done);
+	);
+);
+
+} // Standalone
+} // VSTGUI
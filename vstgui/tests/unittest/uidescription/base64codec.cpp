@@ -4,10 +4,40 @@
 
 #include "../unittests.h"
 #include "../../../uidescription/base64codec.h"
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <vector>
 
 namespace VSTGUI {
 
+namespace {
+
+//------------------------------------------------------------------------
+std::vector<uint8_t> makeTestData (size_t size)
+{
+	std::vector<uint8_t> data (size);
+	for (auto i = 0u; i < size; ++i)
+		data[i] = static_cast<uint8_t> (i * 131 + (i >> 3));
+	return data;
+}
+
+//------------------------------------------------------------------------
+bool equals (const Base64Codec::Result& result, const std::vector<uint8_t>& data)
+{
+	return result.dataSize == data.size () &&
+		   (data.empty () || std::memcmp (result.data.get (), data.data (), data.size ()) == 0);
+}
+
+//------------------------------------------------------------------------
+bool equals (const Base64Codec::Result& r1, const Base64Codec::Result& r2)
+{
+	return r1.dataSize == r2.dataSize &&
+		   std::memcmp (r1.data.get (), r2.data.get (), r1.dataSize) == 0;
+}
+
+} // anonymous
+
 TESTCASE(Base64CodecTest,
 
 	TEST(encodeAscii,
@@ -69,6 +99,70 @@ TESTCASE(Base64CodecTest,
 		 EXPECT (ptr[4] == 0x0D);
 		 EXPECT (ptr[5] == 0x0A);
 	);
+
+	TEST(encodeShortData,
+		 uint8_t binary[2];
+		 binary[0] = 0x89;
+		 binary[1] = 0x50;
+		 EXPECT (Base64Codec::encode (binary, 0).dataSize == 0);
+		 auto result1 = Base64Codec::encode (binary, 1);
+		 EXPECT (result1.dataSize == 4);
+		 EXPECT (std::string (reinterpret_cast<char*> (result1.data.get ()), 4) == "iQ==");
+		 auto result2 = Base64Codec::encode (binary, 2);
+		 EXPECT (result2.dataSize == 4);
+		 EXPECT (std::string (reinterpret_cast<char*> (result2.data.get ()), 4) == "iVA=");
+	);
+
+	TEST(decodePadding,
+		 auto result = Base64Codec::decode (std::string ("iVA=iVBO"));
+		 EXPECT (result.dataSize == 2);
+		 EXPECT (result.data.get ()[0] == 0x89);
+		 EXPECT (result.data.get ()[1] == 0x50);
+	);
+
+	TEST(decodeSkipsWhiteSpace,
+		 auto data = makeTestData (300);
+		 auto encoded = Base64Codec::encode (data.data (), data.size ());
+		 std::string text;
+		 for (auto i = 0u; i < encoded.dataSize; ++i)
+		 {
+			 text += static_cast<char> (encoded.data.get ()[i]);
+			 if (i % 76 == 75)
+				 text += "\n\t";
+		 }
+		 EXPECT (equals (Base64Codec::decode (text), data));
+	);
+
+	TEST(decoderChunks,
+		 auto data = makeTestData (1000);
+		 auto encoded = Base64Codec::encode (data.data (), data.size ());
+		 for (auto chunkSize : {1u, 3u, 7u, 64u, 333u})
+		 {
+			 Base64Codec::Decoder decoder;
+			 for (auto pos = 0u; pos < encoded.dataSize; pos += chunkSize)
+				 decoder.write (encoded.data.get () + pos, std::min (chunkSize, encoded.dataSize - pos));
+			 EXPECT (equals (decoder.finish (), data));
+		 }
+	);
+
+	TEST(instructionSetsProduceSameResults,
+		 auto instructionSet = Base64Codec::getInstructionSet ();
+		 for (auto size = 0u; size < 200; ++size)
+		 {
+			 auto data = makeTestData (size);
+			 EXPECT (Base64Codec::setInstructionSet (Base64Codec::InstructionSet::Scalar));
+			 auto scalar = Base64Codec::encode (data.data (), data.size ());
+			 for (auto other : {Base64Codec::InstructionSet::SSSE3, Base64Codec::InstructionSet::AVX2})
+			 {
+				 if (!Base64Codec::setInstructionSet (other))
+					 continue;
+				 auto encoded = Base64Codec::encode (data.data (), data.size ());
+				 EXPECT (equals (encoded, scalar));
+				 EXPECT (equals (Base64Codec::decode (encoded.data.get (), encoded.dataSize), data));
+			 }
+		 }
+		 Base64Codec::setInstructionSet (instructionSet);
+	);
 );
 
 }
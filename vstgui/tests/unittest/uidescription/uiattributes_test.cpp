@@ -7,11 +7,44 @@
 #include "../../../uidescription/cstream.h"
 #include "../../../lib/cpoint.h"
 #include "../../../lib/crect.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
 
 namespace VSTGUI {
 
 static UTF8StringPtr attributes [] = {"K1", "V1", "K2", "V2", nullptr};
 
+//------------------------------------------------------------------------
+static bool roundTrips (double value)
+{
+	double result;
+	if (!UIAttributes::stringToDouble (UIAttributes::doubleToString (value, 17), result))
+		return false;
+	return result == value && std::signbit (result) == std::signbit (value);
+}
+
+//------------------------------------------------------------------------
+static std::string printfString (double value, uint32_t precision)
+{
+	char buffer[64];
+	snprintf (buffer, sizeof (buffer), "%.*g", static_cast<int> (precision), value);
+	return buffer;
+}
+
+//------------------------------------------------------------------------
+static double randomDouble (std::mt19937_64& generator)
+{
+	double value;
+	do
+	{
+		auto bits = generator ();
+		memcpy (&value, &bits, sizeof (value));
+	} while (std::isnan (value) || std::isinf (value));
+	return value;
+}
+
 TESTCASE(UIAttributesTest,
 
 	TEST(arrayConstructor,
@@ -170,6 +203,72 @@ TESTCASE(UIAttributesTest,
 		EXPECT(UIAttributes::stringToDouble (" -0.5", d) && d == -0.5)
 	)
 
+	TEST(stringToDoubleWithExponent,
+		double d;
+		EXPECT(UIAttributes::stringToDouble ("1e+20", d) && d == 1e20)
+		EXPECT(UIAttributes::stringToDouble ("1.5e-3", d) && d == 1.5e-3)
+		EXPECT(UIAttributes::stringToDouble ("2.2250738585072014e-308", d) && d == 2.2250738585072014e-308)
+		EXPECT(UIAttributes::stringToDouble ("1e400", d) == false)
+		EXPECT(UIAttributes::stringToDouble ("e5", d) == false)
+		EXPECT(UIAttributes::stringToDouble ("1e5e5", d) == false)
+	)
+
+	TEST(doubleToStringIsShortest,
+		EXPECT(UIAttributes::doubleToString (0.1, 17) == "0.1")
+		EXPECT(UIAttributes::doubleToString (0.1 + 0.2, 17) == "0.30000000000000004")
+		EXPECT(UIAttributes::doubleToString (-1768.25, 17) == "-1768.25")
+		EXPECT(UIAttributes::doubleToString (1e20, 17) == "1e+20")
+		EXPECT(UIAttributes::doubleToString (5e-324, 17) == "5e-324")
+		EXPECT(UIAttributes::doubleToString (-0., 17) == "-0")
+	)
+
+	TEST(doubleRoundTrip,
+		for (auto i = -100000; i <= 100000; ++i)
+		{
+			EXPECT(roundTrips (i))
+			EXPECT(roundTrips (i / 100.))
+			EXPECT(roundTrips (i / 3.))
+		}
+		std::mt19937_64 generator;
+		for (auto i = 0; i < 100000; ++i)
+			EXPECT(roundTrips (randomDouble (generator)))
+		EXPECT(roundTrips (std::numeric_limits<double>::max ()))
+		EXPECT(roundTrips (std::numeric_limits<double>::min ()))
+		EXPECT(roundTrips (std::numeric_limits<double>::denorm_min ()))
+		EXPECT(roundTrips (std::numeric_limits<double>::epsilon ()))
+	)
+
+	TEST(doubleToStringWithPrecision,
+		EXPECT(UIAttributes::doubleToString (1234567., 6) == "1.23457e+06")
+		EXPECT(UIAttributes::doubleToString (0.0001, 6) == "0.0001")
+		EXPECT(UIAttributes::doubleToString (0.00001, 6) == "1e-05")
+		EXPECT(UIAttributes::doubleToString (100., 2) == "1e+02")
+		std::mt19937_64 generator;
+		std::uniform_real_distribution<double> distribution (-10000., 10000.);
+		for (auto i = 0; i < 20000; ++i)
+		{
+			auto value = i % 2 ? distribution (generator) : randomDouble (generator);
+			for (auto precision = 1u; precision <= 15u; ++precision)
+				EXPECT(UIAttributes::doubleToString (value, precision) == printfString (value, precision))
+		}
+	)
+
+	TEST(integerRoundTrip,
+		int32_t i;
+		for (auto value = -100000; value <= 100000; ++value)
+		{
+			EXPECT(UIAttributes::stringToInteger (UIAttributes::integerToString (value), i) && i == value)
+		}
+		auto max = std::numeric_limits<int32_t>::max ();
+		auto min = std::numeric_limits<int32_t>::min ();
+		EXPECT(UIAttributes::integerToString (max) == "2147483647")
+		EXPECT(UIAttributes::integerToString (min) == "-2147483648")
+		EXPECT(UIAttributes::stringToInteger ("2147483647", i) && i == max)
+		EXPECT(UIAttributes::stringToInteger ("-2147483648", i) && i == min)
+		EXPECT(UIAttributes::stringToInteger ("2147483648", i) == false)
+		EXPECT(UIAttributes::stringToInteger ("-", i) == false)
+	)
+
 	TEST(stringToPoint,
 		CPoint p;
 		EXPECT(UIAttributes::stringToPoint ("30, 20, 50", p) == false)
@@ -189,6 +288,49 @@ TESTCASE(UIAttributesTest,
 		EXPECT(UIAttributes::stringToRect ("a, b, c, d", r) == false)
 
 		EXPECT(UIAttributes::stringToRect ("0, 12.5, 5, 8", r) && r == CRect (0, 12.5, 5, 8))
+		EXPECT(UIAttributes::stringToRect ("30, 20, 50,", r) == false)
+	)
+
+	TEST(rectToString,
+		EXPECT(UIAttributes::rectToString (CRect (0, 12.5, -5, 8)) == "0, 12.5, -5, 8")
+		EXPECT(UIAttributes::rectToString (CRect (0, 0, 1234567, 1)) == "0, 0, 1.23457e+06, 1")
+		EXPECT(UIAttributes::pointToString (CPoint (1.768, 25)) == "1.768, 25")
+	)
+
+	TEST(parsedValueFollowsChanges,
+		UIAttributes a;
+		a.setAttribute ("Key", "10");
+		double d;
+		int32_t i;
+		EXPECT(a.getDoubleAttribute ("Key", d) && d == 10.)
+		EXPECT(a.getIntegerAttribute ("Key", i) && i == 10)
+		a.setAttribute ("Key", "20");
+		EXPECT(a.getDoubleAttribute ("Key", d) && d == 20.)
+		EXPECT(a.getIntegerAttribute ("Key", i) && i == 20)
+		a.setAttribute ("Key", "a");
+		EXPECT(a.getDoubleAttribute ("Key", d) == false)
+		a.removeAttribute ("Key");
+		EXPECT(a.getDoubleAttribute ("Key", d) == false)
+		a.setRectAttribute ("Key", CRect (1, 2, 3, 4));
+		CRect r;
+		EXPECT(a.getRectAttribute ("Key", r) && r == CRect (1, 2, 3, 4))
+		a.removeAll ();
+		a.setPointAttribute ("Key", CPoint (5, 6));
+		CPoint p;
+		EXPECT(a.getPointAttribute ("Key", p) && p == CPoint (5, 6))
+	)
+
+	TEST(copyParsesOwnValues,
+		UIAttributes a;
+		a.setAttribute ("Key", "true");
+		bool b = false;
+		EXPECT(a.getBooleanAttribute ("Key", b) && b)
+		UIAttributes a2 (a);
+		a.setAttribute ("Key", "false");
+		EXPECT(a2.getBooleanAttribute ("Key", b) && b)
+		EXPECT(a.getBooleanAttribute ("Key", b) && b == false)
+		a2 = a;
+		EXPECT(a2.getBooleanAttribute ("Key", b) && b == false)
 	)
 
 );
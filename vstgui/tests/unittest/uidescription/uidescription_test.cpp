@@ -6,6 +6,7 @@
 #include "../../../uidescription/uidescription.h"
 #include "../../../uidescription/uidescriptionlistener.h"
 #include "../../../uidescription/uiattributes.h"
+#include "../../../uidescription/uiviewswitchcontainer.h"
 #include "../../../uidescription/icontroller.h"
 #include "../../../uidescription/xmlparser.h"
 #include "../../../uidescription/detail/uiviewcreatorattributes.h"
@@ -13,6 +14,8 @@
 #include "../../../lib/cbitmap.h"
 #include "../../../lib/cgradient.h"
 #include "../../../lib/cviewcontainer.h"
+#include <cstdio>
+#include <cstdlib>
 
 namespace VSTGUI {
 
@@ -180,6 +183,53 @@ constexpr auto sharedResourcesUIDesc = R"(<?xml version="1.0" encoding="UTF-8"?>
 </vstgui-ui-description>
 )";
 
+constexpr auto escapedAttributesUIDesc = R"(<?xml version="1.0" encoding="UTF-8"?>
+<vstgui-ui-description version="1">
+	<custom>
+		<attributes name="escaped" z="1" a="&lt;a href=&quot;x&quot;&gt;&apos;&amp;&apos;&lt;/a&gt;" m="" b="plain"/>
+	</custom>
+</vstgui-ui-description>
+)";
+
+constexpr auto escapedAttributesWritten = R"(<?xml version="1.0" encoding="UTF-8"?>
+<vstgui-ui-description version="1">
+	<custom>
+		<attributes a="&lt;a href=&quot;x&quot;&gt;&apos;&amp;&apos;&lt;/a&gt;" b="plain" name="escaped" z="1"/>
+	</custom>
+	<fonts>
+	</fonts>
+	<colors>
+	</colors>
+	<bitmaps/>
+</vstgui-ui-description>
+)";
+
+//------------------------------------------------------------------------
+static std::string readFile (const char* path)
+{
+	std::string content;
+	if (FILE* file = fopen (path, "rb"))
+	{
+		char buffer[4096];
+		size_t numRead;
+		while ((numRead = fread (buffer, 1, sizeof (buffer), file)) > 0)
+			content.append (buffer, numRead);
+		fclose (file);
+	}
+	return content;
+}
+
+//------------------------------------------------------------------------
+static std::string tempFilePath (const char* name)
+{
+	for (auto variable : {"TMPDIR", "TEMP", "TMP"})
+	{
+		if (const char* dir = std::getenv (variable))
+			return std::string (dir) + "/" + name;
+	}
+	return std::string ("/tmp/") + name;
+}
+
 struct SaveUIDescription : public UIDescription
 {
 	SaveUIDescription (Xml::IContentProvider* xmlContentProvider)
@@ -315,6 +365,127 @@ constexpr auto completeExample = R"(
 </vstgui-ui-description>
 )";
 
+constexpr auto reloadUIDesc = R"(
+<vstgui-ui-description version="1">
+	<colors>
+		<color name="c1" rgba="#ff0000ff"/>
+		<color name="c2" rgba="#00ff00ff"/>
+	</colors>
+	<template background-color="c1" class="CViewContainer" name="view" origin="0, 0" size="400, 235">
+		<view background-color="c2" class="CViewContainer" origin="4, 10" size="392, 40"/>
+	</template>
+</vstgui-ui-description>
+)";
+
+constexpr auto reloadColorChangedUIDesc = R"(
+<vstgui-ui-description version="1">
+	<colors>
+		<color name="c1" rgba="#ff0000ff"/>
+		<color name="c2" rgba="#0000ffff"/>
+	</colors>
+	<template background-color="c1" class="CViewContainer" name="view" origin="0, 0" size="400, 235">
+		<view background-color="c2" class="CViewContainer" origin="4, 10" size="392, 40"/>
+	</template>
+</vstgui-ui-description>
+)";
+
+constexpr auto reloadAttributeChangedUIDesc = R"(
+<vstgui-ui-description version="1">
+	<colors>
+		<color name="c1" rgba="#ff0000ff"/>
+		<color name="c2" rgba="#00ff00ff"/>
+	</colors>
+	<template background-color="c1" class="CViewContainer" name="view" origin="0, 0" size="400, 235">
+		<view background-color="c1" class="CViewContainer" origin="4, 10" size="392, 50"/>
+	</template>
+</vstgui-ui-description>
+)";
+
+constexpr auto reloadViewAddedUIDesc = R"(
+<vstgui-ui-description version="1">
+	<colors>
+		<color name="c1" rgba="#ff0000ff"/>
+		<color name="c2" rgba="#00ff00ff"/>
+	</colors>
+	<template background-color="c1" class="CViewContainer" name="view" origin="0, 0" size="400, 235">
+		<view background-color="c2" class="CViewContainer" origin="4, 10" size="392, 40"/>
+		<view background-color="c2" class="CViewContainer" origin="4, 60" size="392, 40"/>
+	</template>
+</vstgui-ui-description>
+)";
+
+constexpr auto reloadVariableUIDesc = R"(
+<vstgui-ui-description version="1">
+	<variables>
+		<var name="child-size" type="string" value="392, 40"/>
+	</variables>
+	<template class="CViewContainer" name="view" origin="0, 0" size="400, 235">
+		<view class="CViewContainer" origin="4, 10" size="child-size"/>
+	</template>
+</vstgui-ui-description>
+)";
+
+constexpr auto reloadVariableChangedUIDesc = R"(
+<vstgui-ui-description version="1">
+	<variables>
+		<var name="child-size" type="string" value="392, 50"/>
+	</variables>
+	<template class="CViewContainer" name="view" origin="0, 0" size="400, 235">
+		<view class="CViewContainer" origin="4, 10" size="child-size"/>
+	</template>
+</vstgui-ui-description>
+)";
+
+constexpr auto reloadSubControllerUIDesc = R"(
+<vstgui-ui-description version="1">
+	<template class="CViewContainer" name="view" origin="0, 0" size="400, 235">
+		<view class="CViewContainer" origin="0, 0" size="400, 100" sub-controller="sub">
+			<view class="CViewContainer" origin="0, 0" size="400, 50" template="inner"/>
+		</view>
+	</template>
+	<template class="CViewContainer" name="inner" origin="0, 0" size="400, 50">
+		<view class="CViewContainer" origin="0, 0" size="100, 20"/>
+	</template>
+</vstgui-ui-description>
+)";
+
+constexpr auto reloadSubControllerViewAddedUIDesc = R"(
+<vstgui-ui-description version="1">
+	<template class="CViewContainer" name="view" origin="0, 0" size="400, 235">
+		<view class="CViewContainer" origin="0, 0" size="400, 100" sub-controller="sub">
+			<view class="CViewContainer" origin="0, 0" size="400, 50" template="inner"/>
+		</view>
+	</template>
+	<template class="CViewContainer" name="inner" origin="0, 0" size="400, 50">
+		<view class="CViewContainer" origin="0, 0" size="100, 20"/>
+		<view class="CViewContainer" origin="0, 20" size="100, 20"/>
+	</template>
+</vstgui-ui-description>
+)";
+
+struct SubControllerMock : public Controller
+{
+	explicit SubControllerMock (int32_t& numViews) : numViews (numViews) {}
+
+	CView* verifyView (CView* view, const UIAttributes& attributes, const IUIDescription* description) override
+	{
+		++numViews;
+		return view;
+	}
+
+	int32_t& numViews;
+};
+
+struct ParentControllerMock : public Controller
+{
+	IController* createSubController (UTF8StringPtr name, const IUIDescription* description) override
+	{
+		return new SubControllerMock (numSubControllerViews);
+	}
+
+	int32_t numSubControllerViews {0};
+};
+
 enum class UIDescTestCase
 {
 	TagChanged,
@@ -530,6 +701,41 @@ TESTCASE(UIDescriptionTests,
 		bitmap = desc.getBitmap ("added bitmap node");
 		EXPECT(dynamic_cast<CNinePartTiledBitmap*>(bitmap) == nullptr);
 	);
+
+	TEST(bitmapScaleVariantsFollowChanges,
+		Xml::MemoryContentProvider provider (bitmapNodesUIDesc, static_cast<uint32_t> (strlen(bitmapNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		desc.changeBitmapName ("b1#2.0x", "b2#2.0x");
+		EXPECT(desc.getBitmap ("b1#2.0x") == nullptr);
+		EXPECT(desc.getBitmap ("b2#2.0x"));
+		EXPECT(desc.getBitmap ("b1"));
+		desc.changeBitmap ("b2", "b2.png", nullptr);
+		desc.changeBitmap ("b2#3.0x", "b2#3.0x.png", nullptr);
+		desc.removeBitmap ("b2#2.0x");
+		EXPECT(desc.hasBitmapName ("b2#2.0x") == false);
+		EXPECT(desc.getBitmap ("b2"));
+		EXPECT(desc.getBitmap ("b2#3.0x"));
+		desc.removeBitmap ("b2#3.0x");
+		desc.removeBitmap ("b2");
+		EXPECT(desc.getBitmap ("b2") == nullptr);
+	);
+
+	TEST(preloadBitmaps,
+		Xml::MemoryContentProvider provider (withAllNodesUIDesc, static_cast<uint32_t> (strlen(withAllNodesUIDesc)));
+		UIDescription desc (&provider);
+		desc.setPreloadBitmaps (true, 2);
+		EXPECT(desc.parse () == true);
+		auto bitmap = desc.getBitmap ("b1");
+		EXPECT(bitmap);
+		EXPECT(bitmap->getPlatformBitmap ());
+		EXPECT(desc.getBitmap ("b1") == bitmap);
+		EXPECT(desc.getBitmap ("dataBitmap"));
+		auto name = desc.lookupBitmapName (bitmap);
+		EXPECT(name == std::string ("b1"));
+		desc.changeBitmap ("dataBitmap", "other.png");
+		EXPECT(desc.getBitmap ("dataBitmap"));
+	);
 	
 	TEST(tags,
 		Xml::MemoryContentProvider provider (tagNodesUIDesc, static_cast<uint32_t> (strlen(tagNodesUIDesc)));
@@ -654,6 +860,248 @@ TESTCASE(UIDescriptionTests,
 		EXPECT(result == str);
 	);
 
+	TEST(writeDecodedBitmapData,
+		// the bitmap data is decoded while parsing and encoded again for writing
+		std::string str (withAllNodesUIDesc);
+		Xml::MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+		SaveUIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		CMemoryStream outputStream (1024, 1024, false);
+		EXPECT(desc.saveToStream (outputStream, SaveUIDescription::kWriteImagesIntoXMLFile | SaveUIDescription::kDoNotVerifyImageXMLData));
+		outputStream.end ();
+		std::string result (reinterpret_cast<const char*> (outputStream.getBuffer ()));
+		EXPECT(result == str);
+	);
+
+	TEST(writeToStreamWhilePreloadingBitmaps,
+		std::string str (withAllNodesUIDesc);
+		Xml::MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+		SaveUIDescription desc (&provider);
+		desc.setPreloadBitmaps (true);
+		EXPECT(desc.parse () == true);
+		CMemoryStream outputStream (1024, 1024, false);
+		EXPECT(desc.saveToStream (outputStream, SaveUIDescription::kWriteImagesIntoXMLFile));
+		outputStream.end ();
+		std::string result (reinterpret_cast<const char*> (outputStream.getBuffer ()));
+		EXPECT(result == str);
+	);
+
+	TEST(writeBinaryRoundTrip,
+		std::string str (withAllNodesUIDesc);
+		Xml::MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+		CMemoryStream binaryStream;
+		Xml::BinaryWriter writer;
+		EXPECT(writer.write (&provider, binaryStream));
+		EXPECT(static_cast<size_t> (binaryStream.tell ()) < str.size ());
+
+		Xml::MemoryContentProvider binaryProvider (binaryStream.getBuffer (),
+		                                           static_cast<uint32_t> (binaryStream.tell ()));
+		SaveUIDescription desc (&binaryProvider);
+		EXPECT(desc.parse () == true);
+		CMemoryStream outputStream (1024, 1024, false);
+		EXPECT(desc.saveToStream (outputStream, SaveUIDescription::kWriteImagesIntoXMLFile));
+		outputStream.end ();
+		std::string result (reinterpret_cast<const char*> (outputStream.getBuffer ()));
+		EXPECT(result == str);
+	);
+
+	TEST(writeEscapedAndSortedAttributes,
+		Xml::MemoryContentProvider provider (escapedAttributesUIDesc, static_cast<uint32_t> (strlen (escapedAttributesUIDesc)));
+		SaveUIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		CMemoryStream outputStream (1024, 1024, false);
+		EXPECT(desc.saveToStream (outputStream, 0));
+		outputStream.end ();
+		std::string result (reinterpret_cast<const char*> (outputStream.getBuffer ()));
+		EXPECT(result == escapedAttributesWritten);
+	);
+
+	TEST(saveInBackground,
+		auto filePath = tempFilePath ("uidescription_test_background_save.uidesc");
+		auto path = filePath.c_str ();
+		std::string str (withAllNodesUIDesc);
+		Xml::MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		EXPECT(desc.finishBackgroundSave () == false);
+		EXPECT(desc.saveInBackground (path, UIDescription::kWriteImagesIntoXMLFile));
+		// changes after the snapshot do not end up in the file
+		desc.changeColor ("c1", kRedCColor);
+		EXPECT(desc.finishBackgroundSave ());
+		EXPECT(desc.isBackgroundSaveRunning () == false);
+		EXPECT(readFile (path) == str);
+		EXPECT(desc.saveInBackground (path, UIDescription::kWriteImagesIntoXMLFile));
+		EXPECT(desc.finishBackgroundSave ());
+		EXPECT(readFile (path) != str);
+		std::remove (path);
+	);
+
+	TEST(reloadChangedColor,
+		Xml::MemoryContentProvider provider (reloadUIDesc, static_cast<uint32_t> (strlen (reloadUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		auto view = owned (desc.createView ("view", nullptr));
+		EXPECT(view);
+		auto child = view.cast<CViewContainer> ()->getView (0);
+		auto container = dynamic_cast<CViewContainer*> (child);
+		EXPECT(container);
+		EXPECT(container->getBackgroundColor () == CColor (0, 255, 0, 255));
+
+		DescriptionListenerMock mok (UIDescTestCase::ColorChanged);
+		desc.registerListener (&mok);
+		Xml::MemoryContentProvider newProvider (reloadColorChangedUIDesc, static_cast<uint32_t> (strlen (reloadColorChangedUIDesc)));
+		EXPECT(desc.reload ({view}, nullptr, &newProvider));
+		EXPECT(mok.callCount () == 1);
+		EXPECT(view.cast<CViewContainer> ()->getView (0) == child);
+		EXPECT(container->getBackgroundColor () == CColor (0, 0, 255, 255));
+		EXPECT(view.cast<CViewContainer> ()->getBackgroundColor () == CColor (255, 0, 0, 255));
+		CColor color;
+		EXPECT(desc.getColor ("c2", color));
+		EXPECT(color == CColor (0, 0, 255, 255));
+
+		// nothing changed
+		EXPECT(desc.reload ({view}, nullptr, &newProvider));
+		EXPECT(mok.callCount () == 1);
+		desc.unregisterListener (&mok);
+	);
+
+	TEST(reloadClearsCachedViewSwitchPages,
+		Xml::MemoryContentProvider provider (reloadUIDesc, static_cast<uint32_t> (strlen (reloadUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		auto rootView = owned (new CViewContainer (CRect (0, 0, 400, 235)));
+		auto container = owned (new CViewContainer (CRect (0, 0, 400, 235)));
+		auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 400, 235));
+		viewSwitch->setAnimationTime (0);
+		viewSwitch->setCachePolicy (UIViewSwitchContainer::kKeepViewsAlive);
+		auto controller = new UIDescriptionViewSwitchController (viewSwitch, &desc, nullptr);
+		controller->setTemplateNames ("view,view");
+		container->addView (viewSwitch);
+		container->attached (rootView);
+		viewSwitch->setCurrentViewIndex (0);
+		viewSwitch->setCurrentViewIndex (1);
+		EXPECT(viewSwitch->getNumCachedPages () == 1);
+
+		// the cached page was created with the old color, it is created again when it is shown
+		Xml::MemoryContentProvider newProvider (reloadColorChangedUIDesc, static_cast<uint32_t> (strlen (reloadColorChangedUIDesc)));
+		EXPECT(desc.reload ({container}, nullptr, &newProvider));
+		EXPECT(viewSwitch->getNumCachedPages () == 0);
+		viewSwitch->setCurrentViewIndex (0);
+		auto page = dynamic_cast<CViewContainer*> (viewSwitch->getView (0));
+		EXPECT(page);
+		auto child = dynamic_cast<CViewContainer*> (page->getView (0));
+		EXPECT(child);
+		EXPECT(child->getBackgroundColor () == CColor (0, 0, 255, 255));
+		container->removed (rootView);
+	);
+
+	TEST(reloadChangedTemplateAttributes,
+		Xml::MemoryContentProvider provider (reloadUIDesc, static_cast<uint32_t> (strlen (reloadUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		auto view = owned (desc.createView ("view", nullptr));
+		EXPECT(view);
+		auto container = dynamic_cast<CViewContainer*> (view.cast<CViewContainer> ()->getView (0));
+		EXPECT(container);
+
+		DescriptionListenerMock mok (UIDescTestCase::TemplateChanged);
+		desc.registerListener (&mok);
+		Xml::MemoryContentProvider newProvider (reloadAttributeChangedUIDesc, static_cast<uint32_t> (strlen (reloadAttributeChangedUIDesc)));
+		EXPECT(desc.reload ({view}, nullptr, &newProvider));
+		EXPECT(mok.callCount () == 1);
+		EXPECT(view.cast<CViewContainer> ()->getView (0) == container);
+		EXPECT(container->getViewSize () == CRect (4, 10, 396, 60));
+		EXPECT(container->getBackgroundColor () == CColor (255, 0, 0, 255));
+		desc.unregisterListener (&mok);
+	);
+
+	TEST(reloadChangedTemplateViews,
+		Xml::MemoryContentProvider provider (reloadUIDesc, static_cast<uint32_t> (strlen (reloadUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		auto parent = owned (new CViewContainer (CRect (0, 0, 400, 235)));
+		auto view = desc.createView ("view", nullptr);
+		EXPECT(view);
+		parent->addView (view);
+
+		Xml::MemoryContentProvider newProvider (reloadViewAddedUIDesc, static_cast<uint32_t> (strlen (reloadViewAddedUIDesc)));
+		EXPECT(desc.reload ({parent}, nullptr, &newProvider));
+		EXPECT(parent->getNbViews () == 1);
+		auto newView = dynamic_cast<CViewContainer*> (parent->getView (0));
+		EXPECT(newView);
+		EXPECT(newView->getNbViews () == 2);
+		std::string name;
+		EXPECT(desc.getTemplateNameFromView (newView, name));
+		EXPECT(name == "view");
+	);
+
+	TEST(reloadDoesNotReplacePassedViews,
+		Xml::MemoryContentProvider provider (reloadUIDesc, static_cast<uint32_t> (strlen (reloadUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		auto parent = owned (new CViewContainer (CRect (0, 0, 400, 235)));
+		auto view = desc.createView ("view", nullptr);
+		EXPECT(view);
+		parent->addView (view);
+
+		Xml::MemoryContentProvider newProvider (reloadViewAddedUIDesc, static_cast<uint32_t> (strlen (reloadViewAddedUIDesc)));
+		EXPECT(desc.reload ({view}, nullptr, &newProvider));
+		EXPECT(parent->getNbViews () == 1);
+		EXPECT(parent->getView (0) == view);
+	);
+
+	TEST(reloadReplacesViewsWithSubController,
+		Xml::MemoryContentProvider provider (reloadSubControllerUIDesc, static_cast<uint32_t> (strlen (reloadSubControllerUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		ParentControllerMock controller;
+		auto parent = owned (new CViewContainer (CRect (0, 0, 400, 235)));
+		auto view = desc.createView ("view", &controller);
+		EXPECT(view);
+		parent->addView (view);
+		// the sub-controller container and the two views of the inner template
+		EXPECT(controller.numSubControllerViews == 3);
+
+		Xml::MemoryContentProvider newProvider (reloadSubControllerViewAddedUIDesc, static_cast<uint32_t> (strlen (reloadSubControllerViewAddedUIDesc)));
+		EXPECT(desc.reload ({parent}, &controller, &newProvider));
+		EXPECT(controller.numSubControllerViews == 6);
+		auto container = dynamic_cast<CViewContainer*> (view->asViewContainer ()->getView (0));
+		EXPECT(container);
+		auto inner = dynamic_cast<CViewContainer*> (container->getView (0));
+		EXPECT(inner);
+		EXPECT(inner->getNbViews () == 2);
+	);
+
+	TEST(reloadChangedVariable,
+		Xml::MemoryContentProvider provider (reloadVariableUIDesc, static_cast<uint32_t> (strlen (reloadVariableUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		auto view = owned (desc.createView ("view", nullptr));
+		EXPECT(view);
+		auto child = view.cast<CViewContainer> ()->getView (0);
+		EXPECT(child->getViewSize () == CRect (4, 10, 396, 50));
+
+		Xml::MemoryContentProvider newProvider (reloadVariableChangedUIDesc, static_cast<uint32_t> (strlen (reloadVariableChangedUIDesc)));
+		EXPECT(desc.reload ({view}, nullptr, &newProvider));
+		EXPECT(child->getViewSize () == CRect (4, 10, 396, 60));
+		auto newView = owned (desc.createView ("view", nullptr));
+		EXPECT(newView);
+		EXPECT(newView.cast<CViewContainer> ()->getView (0)->getViewSize () == CRect (4, 10, 396, 60));
+	);
+
+	TEST(reloadInvalidContent,
+		Xml::MemoryContentProvider provider (reloadUIDesc, static_cast<uint32_t> (strlen (reloadUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.reload () == false);
+		EXPECT(desc.parse () == true);
+		constexpr auto invalid = "<vstgui-ui-description version=\"1\"><colors>";
+		Xml::MemoryContentProvider newProvider (invalid, static_cast<uint32_t> (strlen (invalid)));
+		EXPECT(desc.reload ({}, nullptr, &newProvider) == false);
+		CColor color;
+		EXPECT(desc.getColor ("c2", color));
+		EXPECT(color == CColor (0, 255, 0, 255));
+	);
+
 	TEST(getViewAttributes,
 		 Xml::MemoryContentProvider provider (createViewUIDesc, static_cast<uint32_t> (strlen(createViewUIDesc)));
 		 UIDescription desc (&provider);
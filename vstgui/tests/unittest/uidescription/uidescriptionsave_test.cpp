@@ -0,0 +1,86 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../unittests.h"
+#include "../../../uidescription/uidescription.h"
+#include "../../../uidescription/xmlparser.h"
+#include "../../../uidescription/cstream.h"
+#include <string>
+
+namespace VSTGUI {
+
+namespace {
+
+// no comments, as they are only kept with live editing
+constexpr auto bitmapDataUIDesc = R"(<?xml version="1.0" encoding="UTF-8"?>
+<vstgui-ui-description version="1">
+	<colors>
+		<color name="c1" rgba="#000000ff"/>
+	</colors>
+	<fonts>
+		<font font-name="Arial" name="f1" size="8"/>
+	</fonts>
+	<bitmaps>
+		<bitmap name="b1" path="b1.png">
+			<data encoding="base64">
+				iVBORw0KGgoAAAANSUhEUgAAAAwAAAAMCAYAAABWdVznAAABe2lDQ1BJQ0MgUHJvZmlsZQAAKJF9kE0rRF
+				EYx38zXjNkwcLC4jaG1RCjvGyUmYSaxTRGedvcueZFmXG7c4VsLJTtFCU23hZ8AjYWylopRUrKVyA20vUc
+				Q+OlPHXO+Z3nPM+/5/zB7ddNc7a0HTJZ24oOBrWx8Qmt4gEX5XjQ8OpGzuyPRMJIfJ0/4+VaqiWuWpXW3/
+				d/wzOdyBngqhTuM0zLFh4SblqwTcVKr96SoYRXFKcKvKE4XuCjj5pYNCR8KqwZaX1a+E7Yb6StDLiVvi/+
+				rSb1jTOz88bnPOon1Yns6IicXlmN5IgySFC8GGaAEF100Ct7F60EaJMbdmLRVs2hOXPJmkmlba1fnEhow1
+				mjza8F2ju6Qfn6269ibm4Xep6hJF/MxTfhZA0abos53w7UrsLxualb+keqRJY7mYTHQ6gZh7pLqJrMJTsD
+				hR9VB6Hs3nGemqFiHd7yjvO65zhv+9IsHp1lCx59anFwA7FlCF/A1ja0iHbt1Dv7WWccXX/QZQAAAExJRE
+				FUKBVjZEAALSAzDMFFYa0C8q6BRJhQhBEcUSAThIkGDUCVIIwBcNmAoRAmMKoBFhL4aEagJLYYhkXaazTN
+				q1jQBGBcdIUwcQYAOGIGVqwWW9EAAAAASUVORK5CYII=
+			</data>
+		</bitmap>
+		<bitmap name="b2" path="b2.png"/>
+	</bitmaps>
+</vstgui-ui-description>
+)";
+
+struct SaveUIDescription : public UIDescription
+{
+	SaveUIDescription (Xml::IContentProvider* xmlContentProvider)
+	: UIDescription (xmlContentProvider) {}
+
+	using UIDescription::saveToStream;
+};
+
+std::string saveToString (SaveUIDescription& desc)
+{
+	CMemoryStream outputStream (1024, 1024, false);
+	if (!desc.saveToStream (outputStream, SaveUIDescription::kWriteImagesIntoXMLFile |
+	                                          SaveUIDescription::kDoNotVerifyImageXMLData))
+		return {};
+	outputStream.end ();
+	return reinterpret_cast<const char*> (outputStream.getBuffer ());
+}
+
+} // anonymous
+
+// these tests are built with and without live editing. Without it only the decoded bitmap data
+// is kept while parsing and the base64 text is encoded from it again when it is saved
+TESTCASE(UIDescriptionSaveTest,
+
+	TEST(writeBitmapData,
+		std::string str (bitmapDataUIDesc);
+		Xml::MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+		SaveUIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		EXPECT(saveToString (desc) == str);
+	);
+
+	TEST(writeBitmapDataTwice,
+		std::string str (bitmapDataUIDesc);
+		Xml::MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+		SaveUIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		EXPECT(saveToString (desc) == str);
+		// the text encoded for the first save is reused
+		EXPECT(saveToString (desc) == str);
+	);
+);
+
+} // VSTGUI
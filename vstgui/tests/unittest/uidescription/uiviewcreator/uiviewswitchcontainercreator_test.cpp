@@ -85,6 +85,38 @@ TESTCASE(UIViewSwitchContainerCreatorTest,
 		testPossibleValues (kUIViewSwitchContainer, kAttrAnimationTimingFunction, &uidesc, {"linear", "easy-in", "easy-out", "easy-in-out", "easy"});
 	);
 	
+	TEST(cachePolicy,
+		DummyUIDescription uidesc;
+		testAttribute<UIViewSwitchContainer>(kUIViewSwitchContainer, kAttrCachePolicy, "recreate", &uidesc, [] (UIViewSwitchContainer* v) {
+			return v->getCachePolicy() == UIViewSwitchContainer::kRecreateViews;
+		});
+		testAttribute<UIViewSwitchContainer>(kUIViewSwitchContainer, kAttrCachePolicy, "keep-alive", &uidesc, [] (UIViewSwitchContainer* v) {
+			return v->getCachePolicy() == UIViewSwitchContainer::kKeepViewsAlive;
+		});
+		testAttribute<UIViewSwitchContainer>(kUIViewSwitchContainer, kAttrCachePolicy, "preload", &uidesc, [] (UIViewSwitchContainer* v) {
+			return v->getCachePolicy() == UIViewSwitchContainer::kPreloadViews;
+		});
+	);
+
+	TEST(cachePolicyValues,
+		DummyUIDescription uidesc;
+		testPossibleValues (kUIViewSwitchContainer, kAttrCachePolicy, &uidesc, {"recreate", "keep-alive", "preload"});
+	);
+
+	TEST(cacheSize,
+		DummyUIDescription uidesc;
+		testAttribute<UIViewSwitchContainer>(kUIViewSwitchContainer, kAttrCacheSize, 8, &uidesc, [] (UIViewSwitchContainer* v) {
+			return v->getCacheSize() == 8;
+		});
+	);
+
+	TEST(cacheViewLimit,
+		DummyUIDescription uidesc;
+		testAttribute<UIViewSwitchContainer>(kUIViewSwitchContainer, kAttrCacheViewLimit, 500, &uidesc, [] (UIViewSwitchContainer* v) {
+			return v->getCacheViewLimit() == 500;
+		});
+	);
+
 );
 
 } // VSTGUI
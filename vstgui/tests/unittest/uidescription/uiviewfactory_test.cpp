@@ -238,6 +238,19 @@ TESTCASE(UIViewFactoryTests,
 		EXPECT(view->value == 1);
 	);
 
+	TEST(createViewsFromSameAttributes,
+		UIAttributes a;
+		a.setAttribute (UIViewCreator::kAttrClass, viewCreator.getViewName ());
+		a.setIntegerAttribute (viewAttr, 3);
+		auto v1 = owned (factory->createView (a, nullptr));
+		auto v2 = owned (factory->createView (a, nullptr));
+		EXPECT(v1.cast<View> ()->value == 3);
+		EXPECT(v2.cast<View> ()->value == 3);
+		a.setIntegerAttribute (viewAttr, 5);
+		auto v3 = owned (factory->createView (a, nullptr));
+		EXPECT(v3.cast<View> ()->value == 5);
+	);
+
 	TEST(getAttributeValue,
 		auto v = createView (factory);
 		std::string value;
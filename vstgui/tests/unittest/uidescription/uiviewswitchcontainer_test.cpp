@@ -114,6 +114,82 @@ TESTCASE(UIViewSwitchControllerTest,
 		container->removed (rootView);
 	);
 
+	TEST (recreateViews,
+		TestUIDescription uiDesc;
+		auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 100, 100));
+		viewSwitch->setAnimationTime (0);
+		auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+		controller->setTemplateNames ("v1,v2");
+		EXPECT(container->addView (viewSwitch));
+		container->attached (rootView);
+		viewSwitch->setCurrentViewIndex (0);
+		auto view = shared (viewSwitch->getView (0));
+		viewSwitch->setCurrentViewIndex (1);
+		EXPECT(viewSwitch->getNumCachedPages () == 0);
+		viewSwitch->setCurrentViewIndex (0);
+		EXPECT(dynamic_cast<View1*> (viewSwitch->getView (0)));
+		EXPECT(viewSwitch->getView (0) != view);
+		container->removed (rootView);
+	);
+
+	TEST (keepViewsAlive,
+		TestUIDescription uiDesc;
+		auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 100, 100));
+		viewSwitch->setAnimationTime (0);
+		viewSwitch->setCachePolicy (UIViewSwitchContainer::kKeepViewsAlive);
+		auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+		controller->setTemplateNames ("v1,v2");
+		EXPECT(container->addView (viewSwitch));
+		container->attached (rootView);
+		viewSwitch->setCurrentViewIndex (0);
+		auto view = viewSwitch->getView (0);
+		viewSwitch->setCurrentViewIndex (1);
+		EXPECT(viewSwitch->getNumCachedPages () == 1);
+		EXPECT(viewSwitch->getNumCachedViews () == 1);
+		viewSwitch->setCurrentViewIndex (0);
+		EXPECT(viewSwitch->getView (0) == view);
+		EXPECT(viewSwitch->getNumCachedPages () == 1);
+		container->removed (rootView);
+		EXPECT(viewSwitch->getNumCachedPages () == 2);
+		container->attached (rootView);
+		viewSwitch->setCurrentViewIndex (0);
+		EXPECT(viewSwitch->getView (0) == view);
+		container->removed (rootView);
+	);
+
+	TEST (cacheSize,
+		TestUIDescription uiDesc;
+		auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+		auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 100, 100));
+		viewSwitch->setAnimationTime (0);
+		viewSwitch->setCachePolicy (UIViewSwitchContainer::kKeepViewsAlive);
+		viewSwitch->setCacheSize (1);
+		auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+		controller->setTemplateNames ("v1,v2,v3");
+		EXPECT(container->addView (viewSwitch));
+		container->attached (rootView);
+		viewSwitch->setCurrentViewIndex (0);
+		auto view1 = shared (viewSwitch->getView (0));
+		viewSwitch->setCurrentViewIndex (1);
+		auto view2 = viewSwitch->getView (0);
+		viewSwitch->setCurrentViewIndex (2);
+		EXPECT(viewSwitch->getNumCachedPages () == 1);
+		viewSwitch->setCurrentViewIndex (1);
+		EXPECT(viewSwitch->getView (0) == view2);
+		viewSwitch->setCurrentViewIndex (0);
+		EXPECT(viewSwitch->getView (0) != view1);
+		viewSwitch->setCacheViewLimit (1);
+		EXPECT(viewSwitch->getNumCachedViews () == 1);
+		viewSwitch->setCachePolicy (UIViewSwitchContainer::kRecreateViews);
+		EXPECT(viewSwitch->getNumCachedPages () == 0);
+		container->removed (rootView);
+	);
+
 );
 
 } // VSTGUI
@@ -4,6 +4,7 @@
 
 #include "../unittests.h"
 #include "../../../uidescription/xmlparser.h"
+#include "../../../uidescription/cstream.h"
 #include <string>
 
 namespace VSTGUI {
@@ -31,6 +32,73 @@ struct Handler : public IHandler
 
 };
 
+struct RecordingHandler : public IHandler
+{
+	std::string events;
+	std::string charData;
+
+	void flushCharData ()
+	{
+		if (charData.find_first_not_of (" \t\r\n") != std::string::npos)
+			events += "[" + charData + "]";
+		charData.clear ();
+	}
+	void startXmlElement (Parser* parser, IdStringPtr elementName, UTF8StringPtr* elementAttributes) override
+	{
+		flushCharData ();
+		events += "<" + std::string (elementName);
+		for (auto attr = elementAttributes; attr && *attr; attr += 2)
+			events += " " + std::string (attr[0]) + "=" + std::string (attr[1]);
+		events += ">";
+	}
+	void endXmlElement (Parser* parser, IdStringPtr name) override
+	{
+		flushCharData ();
+		events += "</" + std::string (name) + ">";
+	}
+	void xmlCharData (Parser* parser, const int8_t* data, int32_t length) override
+	{
+		charData.append (reinterpret_cast<const char*> (data), static_cast<size_t> (length));
+	}
+	void xmlComment (Parser* parser, IdStringPtr comment) override
+	{
+		flushCharData ();
+		events += "<!--" + std::string (comment) + "-->";
+	}
+};
+
+std::string writeBinary (const char* xml)
+{
+	MemoryContentProvider provider (xml, static_cast<uint32_t> (strlen (xml)));
+	CMemoryStream stream;
+	BinaryWriter writer;
+	if (!writer.write (&provider, stream))
+		return {};
+	return std::string (reinterpret_cast<const char*> (stream.getBuffer ()),
+	                    static_cast<size_t> (stream.tell ()));
+}
+
+// a binary document with the string table "tag" and the events
+std::string binaryWithEvents (const std::string& events)
+{
+	auto uint32 = [] (uint32_t value) {
+		std::string result;
+		for (auto i = 0; i < 4; ++i)
+			result += static_cast<char> ((value >> (i * 8)) & 0xFF);
+		return result;
+	};
+	return std::string ("VGUIXB01") + uint32 (1) + uint32 (4) + std::string ("tag", 4) +
+	       uint32 (static_cast<uint32_t> (events.size ())) + events;
+}
+
+bool parseBinary (const std::string& binary)
+{
+	MemoryContentProvider provider (binary.data (), static_cast<uint32_t> (binary.size ()));
+	Handler handler;
+	Parser p;
+	return p.parse (&provider, &handler);
+}
+
 } // anonymous
 
 constexpr auto validXML =
@@ -89,6 +157,73 @@ TESTCASE(XMLParserTest,
 		EXPECT(p.parse (&provider, &handler) == false);
 	);
 
+	TEST(binaryParseMatchesXML,
+		MemoryContentProvider xmlProvider (validXML, static_cast<uint32_t> (strlen (validXML)));
+		RecordingHandler xmlHandler;
+		Parser p;
+		EXPECT(p.parse (&xmlProvider, &xmlHandler) == true);
+
+		auto binary = writeBinary (validXML);
+		EXPECT(BinaryWriter::isBinary (binary.data (), static_cast<uint32_t> (binary.size ())));
+		EXPECT(BinaryWriter::isBinary (validXML, static_cast<uint32_t> (strlen (validXML))) == false);
+		MemoryContentProvider binaryProvider (binary.data (), static_cast<uint32_t> (binary.size ()));
+		RecordingHandler binaryHandler;
+		Parser binaryParser;
+		EXPECT(binaryParser.parse (&binaryProvider, &binaryHandler) == true);
+		EXPECT(binaryHandler.events == xmlHandler.events);
+		EXPECT(binaryHandler.events == "<tag attr=bla>[\nCHARDATA\n]<!-- comment --></tag>");
+	);
+
+	TEST(binaryParseFromStream,
+		auto binary = writeBinary (validXML);
+		CMemoryStream stream (reinterpret_cast<const int8_t*> (binary.data ()),
+		                      static_cast<uint32_t> (binary.size ()));
+		InputStreamContentProvider provider (stream);
+		RecordingHandler handler;
+		Parser p;
+		EXPECT(p.parse (&provider, &handler) == true);
+		EXPECT(handler.events == "<tag attr=bla>[\nCHARDATA\n]<!-- comment --></tag>");
+	);
+
+	TEST(invalidBinaryParse,
+		auto binary = writeBinary (validXML);
+		for (auto size = 8u; size < binary.size (); ++size)
+		{
+			MemoryContentProvider provider (binary.data (), size);
+			Handler handler;
+			Parser p;
+			EXPECT(p.parse (&provider, &handler) == false);
+		}
+	);
+
+	TEST(binaryParseChecksLengths,
+		// start element "tag" without attributes, end element "tag"
+		EXPECT(parseBinary (binaryWithEvents (std::string ("\x01\x00\x00\x02\x00", 5))));
+		// string index out of range
+		EXPECT(parseBinary (binaryWithEvents (std::string ("\x01\x01\x00", 3))) == false);
+		// more attributes than bytes left
+		EXPECT(parseBinary (binaryWithEvents (std::string ("\x01\x00\x10\x00\x00", 5))) == false);
+		// char data longer than the rest of the data
+		EXPECT(parseBinary (binaryWithEvents ("\x03\x05" "abcd")) == false);
+		EXPECT(parseBinary (binaryWithEvents ("\x03\xFF\xFF\xFF\xFF\x07" "abcd")) == false);
+		// a length with more than 32 bits must not wrap around to a small length
+		EXPECT(parseBinary (binaryWithEvents ("\x03\x81\x80\x80\x80\x10" "a")) == false);
+		EXPECT(parseBinary (binaryWithEvents ("\x03\x81\x80\x80\x80\x80\x00" "a")) == false);
+		// more strings than the string table can hold
+		auto binary = binaryWithEvents ("");
+		binary[8] = 5;
+		EXPECT(parseBinary (binary) == false);
+	);
+
+	TEST(stopBinaryParse,
+		auto binary = writeBinary (validXML);
+		MemoryContentProvider provider (binary.data (), static_cast<uint32_t> (binary.size ()));
+		Handler handler;
+		handler.stopOnStartElement = true;
+		Parser p;
+		EXPECT(p.parse (&provider, &handler) == false);
+	);
+
 );
 
 } // VSTGUI
@@ -0,0 +1,117 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/cgraphicspath.h"
+#include "vstgui/lib/controls/cknob.h"
+#include "vstgui/lib/platform/linux/cairobitmap.h"
+#include "vstgui/lib/platform/linux/cairocontext.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// automates 300 vector knobs with a corona and a corona outline and reports the time per frame to
+// redraw the dirty rects of all knobs, once creating the corona outline path on every draw and once
+// with the persistent outline path of CKnob. The corona itself changes with the value, so it is
+// created on every draw in both cases.
+namespace {
+
+constexpr CCoord kKnobSize = 40.;
+constexpr auto kNumKnobs = 300;
+constexpr auto kColumns = 20;
+constexpr auto kNumRuns = 100;
+constexpr int32_t kDrawStyle =
+	CKnob::kHandleCircleDrawing | CKnob::kCoronaDrawing | CKnob::kCoronaOutline;
+
+//------------------------------------------------------------------------
+// draws the corona outline the way CKnob did before it kept its path
+class UncachedKnob : public CKnob
+{
+public:
+	UncachedKnob (const CRect& size, int32_t tag)
+	: CKnob (size, nullptr, tag, nullptr, nullptr, CPoint (0, 0), kDrawStyle)
+	{
+	}
+
+protected:
+	void drawCoronaOutline (CDrawContext* context) const override
+	{
+		auto path = owned (context->createGraphicsPath ());
+		if (path == nullptr)
+			return;
+		addArc (path, CRect (getViewSize ()).inset (coronaInset, coronaInset), startAngle,
+		        rangeAngle);
+		context->setFrameColor (colorShadowHandle);
+		CLineStyle lineStyle (kLineSolid);
+		lineStyle.setLineCap (CLineStyle::kLineCapRound);
+		context->setLineStyle (lineStyle);
+		context->setLineWidth (handleLineWidth + coronaOutlineWidthAdd);
+		context->setDrawMode (kAntiAliasing | kNonIntegralMode);
+		context->drawGraphicsPath (path, CDrawContext::kPathStroked);
+	}
+};
+
+//------------------------------------------------------------------------
+template <typename CreateProc>
+double run (CreateProc createKnob)
+{
+	auto rows = (kNumKnobs + kColumns - 1) / kColumns;
+	CRect size (0., 0., kColumns * kKnobSize, rows * kKnobSize);
+	auto frame = new CFrame (size, nullptr);
+	std::vector<CKnob*> knobs;
+	for (auto i = 0; i < kNumKnobs; ++i)
+	{
+		CRect r (0., 0., kKnobSize, kKnobSize);
+		r.offset ((i % kColumns) * kKnobSize, (i / kColumns) * kKnobSize);
+		auto knob = createKnob (r, i);
+		knob->setCoronaInset (4.);
+		knob->setHandleLineWidth (3.);
+		knob->setCoronaOutlineWidthAdd (2.);
+		frame->addView (knob);
+		knobs.push_back (knob);
+	}
+	frame->attached (frame);
+
+	auto surfaceSize = size.getSize ();
+	auto bitmap = owned (new Cairo::Bitmap (&surfaceSize));
+	auto context = owned (new Cairo::Context (size, bitmap->getSurface ()));
+	context->beginDraw ();
+	auto start = std::chrono::high_resolution_clock::now ();
+	for (auto run = 0; run < kNumRuns; ++run)
+	{
+		for (auto i = 0; i < kNumKnobs; ++i)
+		{
+			knobs[i]->setValueNormalized (static_cast<float> ((run + i) % 100) / 100.f);
+			auto r = knobs[i]->getViewSize ();
+			context->setClipRect (r);
+			frame->drawRect (context, r);
+		}
+	}
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	context->endDraw ();
+	frame->close ();
+	return std::chrono::duration<double, std::milli> (duration).count () / kNumRuns;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	printf ("%d vector knobs (%gx%g)\n", kNumKnobs, kKnobSize, kKnobSize);
+	auto uncached = run ([] (const CRect& r, int32_t tag) { return new UncachedKnob (r, tag); });
+	auto cached = run ([] (const CRect& r, int32_t tag) {
+		return new CKnob (r, nullptr, tag, nullptr, nullptr, CPoint (0, 0), kDrawStyle);
+	});
+	printf ("  outline per draw : %8.3f ms per frame\n", uncached);
+	printf ("  persistent path  : %8.3f ms per frame\n", cached);
+	return 0;
+}
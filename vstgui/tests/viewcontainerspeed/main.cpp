@@ -0,0 +1,113 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cdrawcontext.h"
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/platform/linux/cairobitmap.h"
+#include "vstgui/lib/platform/linux/cairocontext.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// fills a container with a grid of small views and reports the time per hit test (the way
+// CFrame::checkMouseViews looks up the view under the mouse) and per partial redraw of a single
+// view for different child counts, without and with the spatial index of the container
+namespace {
+
+constexpr CCoord kViewSize = 20.;
+constexpr auto kNumHitTests = 20000;
+constexpr auto kNumRedraws = 2000;
+
+//------------------------------------------------------------------------
+class MeterView : public CView
+{
+public:
+	using CView::CView;
+
+	void draw (CDrawContext* context) override
+	{
+		context->setFillColor (kGreenCColor);
+		context->drawRect (getViewSize (), kDrawFilled);
+		setDirty (false);
+	}
+};
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (int32_t numRuns, Proc proc)
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	for (auto i = 0; i < numRuns; ++i)
+		proc (i);
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	return std::chrono::duration<double, std::micro> (duration).count () / numRuns;
+}
+
+//------------------------------------------------------------------------
+void run (int32_t numViews, bool spatialIndex)
+{
+	auto columns = 50;
+	auto rows = (numViews + columns - 1) / columns;
+	CRect size (0, 0, columns * kViewSize, rows * kViewSize);
+	auto frame = new CFrame (size, nullptr);
+	auto container = new CViewContainer (size);
+	container->setSpatialIndexEnabled (spatialIndex);
+	for (auto i = 0; i < numViews; ++i)
+	{
+		CRect r (0, 0, kViewSize, kViewSize);
+		r.offset ((i % columns) * kViewSize, (i / columns) * kViewSize);
+		container->addView (new MeterView (r));
+	}
+	frame->addView (container);
+	frame->attached (frame);
+
+	std::default_random_engine rnd;
+	std::uniform_real_distribution<CCoord> x (0., size.getWidth ());
+	std::uniform_real_distribution<CCoord> y (0., size.getHeight ());
+	std::vector<CPoint> points (kNumHitTests);
+	for (auto& p : points)
+		p (x (rnd), y (rnd));
+	auto options = GetViewOptions ().deep ().mouseEnabled ().includeViewContainer ();
+	CView* hit = nullptr;
+	auto hitTest = measure (kNumHitTests, [&] (int32_t i) {
+		hit = frame->getViewAt (points[i], options);
+	});
+	if (hit == nullptr)
+		printf ("hit test failed\n");
+
+	auto surfaceSize = size.getSize ();
+	auto bitmap = owned (new Cairo::Bitmap (&surfaceSize));
+	auto context = owned (new Cairo::Context (bitmap));
+	context->beginDraw ();
+	auto redraw = measure (kNumRedraws, [&] (int32_t i) {
+		auto view = container->getView (static_cast<uint32_t> (i % numViews));
+		frame->drawRect (context, view->getViewSize ());
+	});
+	context->endDraw ();
+
+	printf ("  %5d views %-8s: hit test %8.3f us, partial redraw %8.3f us\n", numViews,
+	        spatialIndex ? "indexed" : "linear", hitTest, redraw);
+	frame->close ();
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	for (auto numViews : {100, 500, 1500, 5000})
+	{
+		run (numViews, false);
+		run (numViews, true);
+	}
+	return 0;
+}
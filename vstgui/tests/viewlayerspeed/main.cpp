@@ -0,0 +1,170 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cdrawcontext.h"
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/platform/linux/cairobitmap.h"
+#include "vstgui/lib/platform/linux/cairocontext.h"
+#include "vstgui/lib/platform/linux/cairoviewlayer.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// draws a static panel of expensive views behind an animating meter and reports the time per
+// frame to redraw the dirty rect of the meter, once drawing the panel directly and once drawing
+// it from a Cairo view layer which caches the rendering of the panel
+namespace {
+
+constexpr CCoord kPanelWidth = 800.;
+constexpr CCoord kPanelHeight = 400.;
+constexpr CCoord kKnobSize = 100.;
+constexpr auto kNumFrames = 500;
+
+//------------------------------------------------------------------------
+class KnobFaceView : public CView
+{
+public:
+	using CView::CView;
+
+	void draw (CDrawContext* context) override
+	{
+		auto r = getViewSize ();
+		context->setDrawMode (kAntiAliasing);
+		for (auto i = 0; i < 16; ++i)
+		{
+			context->setFrameColor (CColor (static_cast<uint8_t> (i * 16), 80, 160));
+			context->drawEllipse (CRect (r).inset (4. + i * 2., 4. + i * 2.), kDrawStroked);
+		}
+		auto center = r.getCenter ();
+		for (auto i = 0; i < 36; ++i)
+		{
+			auto angle = i * M_PI / 18.;
+			CPoint p1 (center.x + std::cos (angle) * 40., center.y + std::sin (angle) * 40.);
+			CPoint p2 (center.x + std::cos (angle) * 48., center.y + std::sin (angle) * 48.);
+			context->drawLine (p1, p2);
+		}
+		setDirty (false);
+	}
+};
+
+//------------------------------------------------------------------------
+class MeterView : public CView
+{
+public:
+	using CView::CView;
+
+	void setValue (float v)
+	{
+		value = v;
+		invalid ();
+	}
+
+	void draw (CDrawContext* context) override
+	{
+		auto r = getViewSize ();
+		r.top = r.bottom - r.getHeight () * value;
+		context->setFillColor (kGreenCColor);
+		context->drawRect (r, kDrawFilled);
+		setDirty (false);
+	}
+
+private:
+	float value {0.f};
+};
+
+//------------------------------------------------------------------------
+// draws its children into a Cairo view layer the way CLayeredViewContainer does it with the
+// layer of the platform frame
+class LayeredPanel : public CViewContainer, public IPlatformViewLayerDelegate
+{
+public:
+	LayeredPanel (const CRect& r, bool useLayer) : CViewContainer (r)
+	{
+		setTransparency (true);
+		if (useLayer)
+		{
+			layer = makeOwned<Cairo::ViewLayer> (this, nullptr, 1., [] (const CRect&) {});
+			layer->setSize (r);
+		}
+	}
+
+	void drawRect (CDrawContext* context, const CRect& updateRect) override
+	{
+		if (layer)
+			layer->draw (context, updateRect);
+		else
+			CViewContainer::drawRect (context, updateRect);
+	}
+
+	void drawViewLayer (CDrawContext* context, const CRect& dirtyRect) override
+	{
+		auto origin = getViewSize ().getTopLeft ();
+		CDrawContext::Transform transform (
+			*context, CGraphicsTransform ().translate (-origin.x, -origin.y));
+		CViewContainer::drawRect (context, CRect (dirtyRect).offset (origin.x, origin.y));
+	}
+
+private:
+	SharedPointer<Cairo::ViewLayer> layer;
+};
+
+//------------------------------------------------------------------------
+void run (bool useLayer)
+{
+	CRect size (0., 0., kPanelWidth, kPanelHeight);
+	auto frame = new CFrame (size, nullptr);
+	auto panel = new LayeredPanel (size, useLayer);
+	for (CCoord y = 0.; y < kPanelHeight; y += kKnobSize)
+	{
+		for (CCoord x = 0.; x < kPanelWidth; x += kKnobSize)
+			panel->addView (new KnobFaceView (CRect (x, y, x + kKnobSize, y + kKnobSize)));
+	}
+	frame->addView (panel);
+	auto meter = new MeterView (CRect (380., 20., 420., 380.));
+	frame->addView (meter);
+	frame->attached (frame);
+
+	auto surfaceSize = size.getSize ();
+	auto bitmap = owned (new Cairo::Bitmap (&surfaceSize));
+	auto context = owned (new Cairo::Context (bitmap));
+	context->beginDraw ();
+
+	auto start = std::chrono::high_resolution_clock::now ();
+	frame->drawRect (context, size);
+	auto firstFrame = std::chrono::high_resolution_clock::now () - start;
+
+	start = std::chrono::high_resolution_clock::now ();
+	for (auto i = 0; i < kNumFrames; ++i)
+	{
+		meter->setValue (static_cast<float> (i % 100) / 100.f);
+		context->setClipRect (meter->getViewSize ());
+		frame->drawRect (context, meter->getViewSize ());
+	}
+	auto frames = std::chrono::high_resolution_clock::now () - start;
+	context->endDraw ();
+
+	printf ("  %-7s: first frame %8.3f ms, meter frame %8.3f us\n", useLayer ? "layer" : "direct",
+	        std::chrono::duration<double, std::milli> (firstFrame).count (),
+	        std::chrono::duration<double, std::micro> (frames).count () / kNumFrames);
+	frame->close ();
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	printf ("%d knob faces behind a meter, %d frames\n",
+	        static_cast<int> ((kPanelWidth / kKnobSize) * (kPanelHeight / kKnobSize)), kNumFrames);
+	run (false);
+	run (true);
+	return 0;
+}
@@ -0,0 +1,168 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/vstguidebug.h"
+#include "vstgui/uidescription/uidescription.h"
+#include "vstgui/uidescription/uiviewswitchcontainer.h"
+#include "vstgui/uidescription/xmlparser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace VSTGUI { void* soHandle = nullptr; }
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// switches the pages of a view switch container with 8 pages of 150 controls each and reports the
+// time per page switch for every cache policy, once flipping between two pages and once cycling
+// through all pages, together with the time spent preloading in idle time and the number of
+// cached views
+namespace {
+
+constexpr auto kNumPages = 8;
+constexpr auto kNumControls = 150;
+constexpr auto kNumSwitches = 64;
+
+//------------------------------------------------------------------------
+// there is no run loop firing the preload timer, so the idle time is simulated by calling the
+// preloading directly
+class ViewSwitch : public UIViewSwitchContainer
+{
+public:
+	using UIViewSwitchContainer::UIViewSwitchContainer;
+
+	bool idle ()
+	{
+		if (getCachePolicy () != kPreloadViews)
+			return false;
+		auto numPages = getNumCachedPages ();
+		preloadNextView ();
+		return getNumCachedPages () != numPages;
+	}
+};
+
+//------------------------------------------------------------------------
+std::string createDescription ()
+{
+	std::string xml = "<vstgui-ui-description version=\"1\">\n";
+	xml += "\t<colors>\n"
+	       "\t\t<color name=\"back\" rgba=\"#303030ff\"/>\n"
+	       "\t\t<color name=\"text\" rgba=\"#e0e0e0ff\"/>\n"
+	       "\t</colors>\n";
+	for (auto page = 0; page < kNumPages; ++page)
+	{
+		xml += "\t<template class=\"CViewContainer\" name=\"page" + std::to_string (page) +
+		       "\" origin=\"0, 0\" size=\"1000, 600\" background-color=\"back\" "
+		       "autosize=\"left right top bottom\">\n";
+		for (auto i = 0; i < kNumControls; ++i)
+		{
+			auto origin = std::to_string ((i % 15) * 66) + ", " + std::to_string ((i / 15) * 60);
+			if (i % 3 == 0)
+			{
+				xml += "\t\t<view class=\"CTextLabel\" origin=\"" + origin +
+				       "\" size=\"60, 20\" title=\"Label\" font-color=\"text\" "
+				       "back-color=\"back\"/>\n";
+			}
+			else if (i % 3 == 1)
+			{
+				xml += "\t\t<view class=\"CKnob\" origin=\"" + origin +
+				       "\" size=\"40, 40\" corona-color=\"text\" handle-color=\"text\" "
+				       "default-value=\"0.5\"/>\n";
+			}
+			else
+			{
+				xml += "\t\t<view class=\"CSlider\" origin=\"" + origin +
+				       "\" size=\"20, 50\" orientation=\"vertical\" draw-frame-color=\"text\" "
+				       "draw-back-color=\"back\" draw-value-color=\"text\"/>\n";
+			}
+		}
+		xml += "\t</template>\n";
+	}
+	xml += "</vstgui-ui-description>\n";
+	return xml;
+}
+
+//------------------------------------------------------------------------
+std::string templateNames ()
+{
+	std::string names;
+	for (auto page = 0; page < kNumPages; ++page)
+	{
+		if (page)
+			names += ",";
+		names += "page" + std::to_string (page);
+	}
+	return names;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (Proc proc)
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	proc ();
+	auto duration = std::chrono::high_resolution_clock::now () - start;
+	return std::chrono::duration<double, std::milli> (duration).count ();
+}
+
+//------------------------------------------------------------------------
+void run (UIDescription& desc, UIViewSwitchContainer::CachePolicy policy, const char* name)
+{
+	CRect size (0., 0., 1000., 600.);
+	auto frame = new CFrame (size, nullptr);
+	auto viewSwitch = new ViewSwitch (size);
+	viewSwitch->setAnimationTime (0);
+	viewSwitch->setCachePolicy (policy);
+	auto controller = new UIDescriptionViewSwitchController (viewSwitch, &desc, nullptr);
+	controller->setTemplateNames (templateNames ().data ());
+	frame->addView (viewSwitch);
+	frame->attached (frame);
+	viewSwitch->setCurrentViewIndex (0);
+
+	auto preloadTime = measure ([&] () {
+		while (viewSwitch->idle ())
+			;
+	});
+	auto flipTime = measure ([&] () {
+		for (auto i = 1; i <= kNumSwitches; ++i)
+			viewSwitch->setCurrentViewIndex (i % 2);
+	});
+	auto cycleTime = measure ([&] () {
+		for (auto i = 1; i <= kNumSwitches; ++i)
+			viewSwitch->setCurrentViewIndex (i % kNumPages);
+	});
+
+	printf ("  %-10s: flip %8.3f ms, cycle %8.3f ms, preload %8.2f ms, %5u cached views\n",
+	        name, flipTime / kNumSwitches, cycleTime / kNumSwitches, preloadTime,
+	        viewSwitch->getNumCachedViews ());
+	frame->close ();
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	// the platform timer of the preloading asserts without a run loop
+	setAssertionHandler ([] (const char*, const char*, const char*) {});
+
+	auto xml = createDescription ();
+	Xml::MemoryContentProvider provider (xml.data (), static_cast<uint32_t> (xml.size ()));
+	UIDescription desc (&provider);
+	if (!desc.parse ())
+	{
+		printf ("parsing failed\n");
+		return 1;
+	}
+
+	printf ("%d pages with %d controls, time per page switch\n", kNumPages, kNumControls);
+	run (desc, UIViewSwitchContainer::kRecreateViews, "recreate");
+	run (desc, UIViewSwitchContainer::kKeepViewsAlive, "keep-alive");
+	run (desc, UIViewSwitchContainer::kPreloadViews, "preload");
+	return 0;
+}
@@ -39,6 +39,7 @@ int main (int argv, char* argc[])
 	std::string inputPath;
 	std::string outputPath;
 	bool noCompression = false;
+	bool binary = false;
 	uint32_t compressionLevel = 1;
 	for (auto i = 0; i < argv; ++i)
 	{
@@ -65,13 +66,17 @@ int main (int argv, char* argc[])
 		{
 			noCompression = true;
 		}
+		else if (arg == "--binary")
+		{
+			binary = true;
+		}
 	}
 	if (inputPath.empty () || outputPath.empty ())
 	{
 		printAndTerminate ("No input or output path specified!");
 	}
-	printf ("Copy %s to %s%s\n", inputPath.data (), outputPath.data (),
-	        noCompression ? " [uncompressed]" : "[compressed]");
+	printf ("Copy %s to %s%s%s\n", inputPath.data (), outputPath.data (),
+	        noCompression ? " [uncompressed]" : "[compressed]", binary ? "[binary]" : "");
 
 	CompressedUIDescription uiDesc (CResourceDescription (inputPath.data ()));
 	if (!uiDesc.parse ())
@@ -79,7 +84,20 @@ int main (int argv, char* argc[])
 		printAndTerminate ("Parsing failed!");
 	}
 	int32_t flags = UIDescription::kWriteImagesIntoXMLFile;
-	if (noCompression)
+	if (binary)
+	{
+		flags |= CompressedUIDescription::kNoPlainXmlFileBackup |
+		         CompressedUIDescription::kWriteBinaryDesc |
+		         CompressedUIDescription::kDoNotVerifyImageXMLData;
+		if (!noCompression)
+			flags |= CompressedUIDescription::kForceWriteCompressedDesc;
+		uiDesc.setCompressionLevel (compressionLevel);
+		if (!uiDesc.save (outputPath.data (), flags))
+		{
+			printAndTerminate ("saving failed");
+		}
+	}
+	else if (noCompression)
 	{
 		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == false)
 			return 0;
@@ -0,0 +1,418 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "base64codec.h"
+#include "../lib/cpufeatures.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#if VSTGUI_CPU_X86
+#define VSTGUI_BASE64_X86 1
+#include <immintrin.h>
+#include <tmmintrin.h>
+#else
+#define VSTGUI_BASE64_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VSTGUI_TARGET_SSSE3 __attribute__ ((target ("ssse3")))
+#define VSTGUI_TARGET_AVX2 __attribute__ ((target ("avx2")))
+#else
+#define VSTGUI_TARGET_SSSE3
+#define VSTGUI_TARGET_AVX2
+#endif
+
+namespace VSTGUI {
+namespace {
+
+//-----------------------------------------------------------------------------
+/** the vector kernels store whole vectors, so the output buffer needs this many bytes more */
+constexpr size_t kOutputSlack = 8;
+
+constexpr uint8_t kInvalid = 0xFF;
+constexpr uint8_t kPadding = 0xFE;
+
+constexpr uint8_t cb64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+//-----------------------------------------------------------------------------
+std::array<uint8_t, 256> makeDecodeTable ()
+{
+	std::array<uint8_t, 256> table;
+	table.fill (kInvalid);
+	for (uint8_t i = 0; i < 64; ++i)
+		table[cb64[i]] = i;
+	table['='] = kPadding;
+	return table;
+}
+
+const std::array<uint8_t, 256>& decodeTable ()
+{
+	static const auto table = makeDecodeTable ();
+	return table;
+}
+
+//-----------------------------------------------------------------------------
+struct Kernels
+{
+	Base64Codec::InstructionSet instructionSet;
+	/** decodes groups of 4 base64 characters until the first group with a character outside of
+	 *	the alphabet, returns the number of characters decoded */
+	size_t (*decode) (const uint8_t* src, size_t size, uint8_t* dst);
+	/** encodes groups of 3 bytes, returns the number of bytes encoded */
+	size_t (*encode) (const uint8_t* src, size_t size, uint8_t* dst);
+};
+
+//-----------------------------------------------------------------------------
+size_t decodeScalar (const uint8_t* src, size_t size, uint8_t* dst)
+{
+	const auto& table = decodeTable ();
+	size_t pos = 0;
+	for (; pos + 4 <= size; pos += 4, dst += 3)
+	{
+		uint32_t a = table[src[pos]];
+		uint32_t b = table[src[pos + 1]];
+		uint32_t c = table[src[pos + 2]];
+		uint32_t d = table[src[pos + 3]];
+		if ((a | b | c | d) > 63)
+			break;
+		auto value = (a << 18) | (b << 12) | (c << 6) | d;
+		dst[0] = static_cast<uint8_t> (value >> 16);
+		dst[1] = static_cast<uint8_t> (value >> 8);
+		dst[2] = static_cast<uint8_t> (value);
+	}
+	return pos;
+}
+
+//-----------------------------------------------------------------------------
+size_t encodeScalar (const uint8_t* src, size_t size, uint8_t* dst)
+{
+	size_t pos = 0;
+	for (; pos + 3 <= size; pos += 3, dst += 4)
+	{
+		auto value = (static_cast<uint32_t> (src[pos]) << 16) |
+					 (static_cast<uint32_t> (src[pos + 1]) << 8) | src[pos + 2];
+		dst[0] = cb64[value >> 18];
+		dst[1] = cb64[(value >> 12) & 0x3F];
+		dst[2] = cb64[(value >> 6) & 0x3F];
+		dst[3] = cb64[value & 0x3F];
+	}
+	return pos;
+}
+
+const Kernels scalarKernels = {Base64Codec::InstructionSet::Scalar, decodeScalar, encodeScalar};
+
+#if VSTGUI_BASE64_X86
+//-----------------------------------------------------------------------------
+// The vector kernels translate the characters with nibble lookup tables and pack the 6 bit values
+// with multiply-add instructions, see Wojciech Mula, Daniel Lemire: "Faster Base64 Encoding and
+// Decoding Using AVX2 Instructions"
+//-----------------------------------------------------------------------------
+VSTGUI_TARGET_SSSE3 size_t decodeSSSE3 (const uint8_t* src, size_t size, uint8_t* dst)
+{
+	// the bits of lutLo and lutHi of a character only have a common bit if the character is not
+	// part of the alphabet
+	const auto lutLo = _mm_setr_epi8 (0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+									  0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	const auto lutHi = _mm_setr_epi8 (0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10,
+									  0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const auto lutRoll = _mm_setr_epi8 (0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const auto mask2F = _mm_set1_epi8 (0x2F);
+	const auto zero = _mm_setzero_si128 ();
+	size_t pos = 0;
+	for (; pos + 16 <= size; pos += 16, dst += 12)
+	{
+		auto str = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + pos));
+		auto hiNibbles = _mm_and_si128 (_mm_srli_epi32 (str, 4), mask2F);
+		auto loNibbles = _mm_and_si128 (str, mask2F);
+		auto hi = _mm_shuffle_epi8 (lutHi, hiNibbles);
+		auto lo = _mm_shuffle_epi8 (lutLo, loNibbles);
+		if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_and_si128 (lo, hi), zero)) != 0xFFFF)
+			break;
+		auto eq2F = _mm_cmpeq_epi8 (str, mask2F);
+		auto roll = _mm_shuffle_epi8 (lutRoll, _mm_add_epi8 (eq2F, hiNibbles));
+		str = _mm_add_epi8 (str, roll);
+		auto mergedAB = _mm_maddubs_epi16 (str, _mm_set1_epi32 (0x01400140));
+		auto merged = _mm_madd_epi16 (mergedAB, _mm_set1_epi32 (0x00011000));
+		merged = _mm_shuffle_epi8 (
+			merged, _mm_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst), merged);
+	}
+	return pos + decodeScalar (src + pos, size - pos, dst);
+}
+
+//-----------------------------------------------------------------------------
+VSTGUI_TARGET_SSSE3 inline __m128i encodeTranslateSSSE3 (__m128i in)
+{
+	in = _mm_shuffle_epi8 (in, _mm_setr_epi8 (1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+	auto t0 = _mm_and_si128 (in, _mm_set1_epi32 (0x0FC0FC00));
+	auto t1 = _mm_mulhi_epu16 (t0, _mm_set1_epi32 (0x04000040));
+	auto t2 = _mm_and_si128 (in, _mm_set1_epi32 (0x003F03F0));
+	auto t3 = _mm_mullo_epi16 (t2, _mm_set1_epi32 (0x01000010));
+	auto indices = _mm_or_si128 (t1, t3);
+	// 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+	auto reduced = _mm_subs_epu8 (indices, _mm_set1_epi8 (51));
+	auto less = _mm_cmpgt_epi8 (_mm_set1_epi8 (26), indices);
+	reduced = _mm_or_si128 (reduced, _mm_and_si128 (less, _mm_set1_epi8 (13)));
+	const auto shiftLut = _mm_setr_epi8 ('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+										 '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+										 '/' - 63, 'A', 0, 0);
+	return _mm_add_epi8 (_mm_shuffle_epi8 (shiftLut, reduced), indices);
+}
+
+//-----------------------------------------------------------------------------
+VSTGUI_TARGET_SSSE3 size_t encodeSSSE3 (const uint8_t* src, size_t size, uint8_t* dst)
+{
+	size_t pos = 0;
+	// 16 bytes are loaded to encode 12 bytes
+	for (; pos + 16 <= size; pos += 12, dst += 16)
+	{
+		auto in = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + pos));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst), encodeTranslateSSSE3 (in));
+	}
+	return pos + encodeScalar (src + pos, size - pos, dst);
+}
+
+const Kernels ssse3Kernels = {Base64Codec::InstructionSet::SSSE3, decodeSSSE3, encodeSSSE3};
+
+//-----------------------------------------------------------------------------
+VSTGUI_TARGET_AVX2 size_t decodeAVX2 (const uint8_t* src, size_t size, uint8_t* dst)
+{
+	const auto lutLo = _mm256_setr_epi8 (
+		0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B,
+		0x1A, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B,
+		0x1B, 0x1A);
+	const auto lutHi = _mm256_setr_epi8 (
+		0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+		0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+		0x10, 0x10);
+	const auto lutRoll = _mm256_setr_epi8 (0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0,
+										   0, 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0,
+										   0, 0);
+	const auto mask2F = _mm256_set1_epi8 (0x2F);
+	const auto shuffle = _mm256_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+										   2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	const auto permute = _mm256_setr_epi32 (0, 1, 2, 4, 5, 6, 3, 7);
+	size_t pos = 0;
+	for (; pos + 32 <= size; pos += 32, dst += 24)
+	{
+		auto str = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (src + pos));
+		auto hiNibbles = _mm256_and_si256 (_mm256_srli_epi32 (str, 4), mask2F);
+		auto loNibbles = _mm256_and_si256 (str, mask2F);
+		auto hi = _mm256_shuffle_epi8 (lutHi, hiNibbles);
+		auto lo = _mm256_shuffle_epi8 (lutLo, loNibbles);
+		if (!_mm256_testz_si256 (lo, hi))
+			break;
+		auto eq2F = _mm256_cmpeq_epi8 (str, mask2F);
+		auto roll = _mm256_shuffle_epi8 (lutRoll, _mm256_add_epi8 (eq2F, hiNibbles));
+		str = _mm256_add_epi8 (str, roll);
+		auto mergedAB = _mm256_maddubs_epi16 (str, _mm256_set1_epi32 (0x01400140));
+		auto merged = _mm256_madd_epi16 (mergedAB, _mm256_set1_epi32 (0x00011000));
+		merged = _mm256_permutevar8x32_epi32 (_mm256_shuffle_epi8 (merged, shuffle), permute);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (dst), merged);
+	}
+	return pos + decodeSSSE3 (src + pos, size - pos, dst);
+}
+
+//-----------------------------------------------------------------------------
+VSTGUI_TARGET_AVX2 size_t encodeAVX2 (const uint8_t* src, size_t size, uint8_t* dst)
+{
+	const auto shuffle = _mm256_setr_epi8 (1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0,
+										   2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+	const auto shiftLut = _mm256_setr_epi8 (
+		'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0, 'a' - 26, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63,
+		'A', 0, 0);
+	size_t pos = 0;
+	// each lane loads 16 bytes to encode 12 bytes
+	for (; pos + 28 <= size; pos += 24, dst += 32)
+	{
+		auto lo = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + pos));
+		auto hi = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + pos + 12));
+		auto in = _mm256_inserti128_si256 (_mm256_castsi128_si256 (lo), hi, 1);
+		in = _mm256_shuffle_epi8 (in, shuffle);
+		auto t0 = _mm256_and_si256 (in, _mm256_set1_epi32 (0x0FC0FC00));
+		auto t1 = _mm256_mulhi_epu16 (t0, _mm256_set1_epi32 (0x04000040));
+		auto t2 = _mm256_and_si256 (in, _mm256_set1_epi32 (0x003F03F0));
+		auto t3 = _mm256_mullo_epi16 (t2, _mm256_set1_epi32 (0x01000010));
+		auto indices = _mm256_or_si256 (t1, t3);
+		auto reduced = _mm256_subs_epu8 (indices, _mm256_set1_epi8 (51));
+		auto less = _mm256_cmpgt_epi8 (_mm256_set1_epi8 (26), indices);
+		reduced = _mm256_or_si256 (reduced, _mm256_and_si256 (less, _mm256_set1_epi8 (13)));
+		auto result = _mm256_add_epi8 (_mm256_shuffle_epi8 (shiftLut, reduced), indices);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (dst), result);
+	}
+	return pos + encodeSSSE3 (src + pos, size - pos, dst);
+}
+
+const Kernels avx2Kernels = {Base64Codec::InstructionSet::AVX2, decodeAVX2, encodeAVX2};
+
+#endif // VSTGUI_BASE64_X86
+
+//-----------------------------------------------------------------------------
+const Kernels* getKernels (Base64Codec::InstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+		case Base64Codec::InstructionSet::Scalar:
+			return &scalarKernels;
+#if VSTGUI_BASE64_X86
+		case Base64Codec::InstructionSet::SSSE3:
+			return CPUFeatures::isSupported (CPUFeatures::Feature::SSSE3) ? &ssse3Kernels : nullptr;
+		case Base64Codec::InstructionSet::AVX2:
+			return CPUFeatures::isSupported (CPUFeatures::Feature::AVX2) ? &avx2Kernels : nullptr;
+#else
+		case Base64Codec::InstructionSet::SSSE3:
+		case Base64Codec::InstructionSet::AVX2:
+			break;
+#endif
+	}
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+const Kernels* bestKernels ()
+{
+	for (auto instructionSet : {Base64Codec::InstructionSet::AVX2, Base64Codec::InstructionSet::SSSE3})
+	{
+		if (auto result = getKernels (instructionSet))
+			return result;
+	}
+	return &scalarKernels;
+}
+
+//-----------------------------------------------------------------------------
+std::atomic<const Kernels*>& currentKernels ()
+{
+	static std::atomic<const Kernels*> kernels {bestKernels ()};
+	return kernels;
+}
+
+//-----------------------------------------------------------------------------
+} // anonymous
+
+//-----------------------------------------------------------------------------
+bool Base64Codec::setInstructionSet (InstructionSet instructionSet)
+{
+	if (auto kernels = getKernels (instructionSet))
+	{
+		currentKernels () = kernels;
+		return true;
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+auto Base64Codec::getInstructionSet () -> InstructionSet
+{
+	return currentKernels ().load ()->instructionSet;
+}
+
+//-----------------------------------------------------------------------------
+auto Base64Codec::encode (const void* binaryData, size_t binaryDataSize) -> Result
+{
+	Result r;
+	r.data.allocate ((binaryDataSize + 2) / 3 * 4 + kOutputSlack);
+	auto src = static_cast<const uint8_t*> (binaryData);
+	auto dst = r.data.get ();
+	auto pos = currentKernels ().load ()->encode (src, binaryDataSize, dst);
+	dst += pos / 3 * 4;
+	auto remaining = binaryDataSize - pos;
+	if (remaining > 0)
+	{
+		uint32_t value = static_cast<uint32_t> (src[pos]) << 16;
+		if (remaining > 1)
+			value |= static_cast<uint32_t> (src[pos + 1]) << 8;
+		dst[0] = cb64[value >> 18];
+		dst[1] = cb64[(value >> 12) & 0x3F];
+		dst[2] = remaining > 1 ? cb64[(value >> 6) & 0x3F] : '=';
+		dst[3] = '=';
+		dst += 4;
+	}
+	r.dataSize = static_cast<uint32_t> (dst - r.data.get ());
+	return r;
+}
+
+//-----------------------------------------------------------------------------
+void Base64Codec::Decoder::grow (size_t minSize)
+{
+	if (result.data.size () >= minSize)
+		return;
+	Buffer<uint8_t> data (std::max (minSize, result.data.size () * 2));
+	if (result.dataSize)
+		std::memcpy (data.get (), result.data.get (), result.dataSize);
+	result.data.deallocate ();
+	result.data = std::move (data);
+}
+
+//-----------------------------------------------------------------------------
+void Base64Codec::Decoder::reserve (size_t base64Size)
+{
+	grow (result.dataSize + (base64Size + 3) / 4 * 3 + kOutputSlack);
+}
+
+//-----------------------------------------------------------------------------
+void Base64Codec::Decoder::write (const void* base64Data, size_t size)
+{
+	if (padding || size == 0)
+		return;
+	reserve (size);
+	const auto& table = decodeTable ();
+	auto kernels = currentKernels ().load ();
+	auto src = static_cast<const uint8_t*> (base64Data);
+	auto dst = result.data.get () + result.dataSize;
+	while (size)
+	{
+		if (numQuad == 0)
+		{
+			auto decoded = kernels->decode (src, size, dst);
+			src += decoded;
+			size -= decoded;
+			dst += decoded / 4 * 3;
+			if (size == 0)
+				break;
+		}
+		auto value = table[*src++];
+		--size;
+		if (value == kPadding)
+		{
+			padding = true;
+			break;
+		}
+		if (value == kInvalid)
+			continue;
+		quad[numQuad++] = value;
+		if (numQuad == 4)
+		{
+			dst[0] = static_cast<uint8_t> ((quad[0] << 2) | (quad[1] >> 4));
+			dst[1] = static_cast<uint8_t> ((quad[1] << 4) | (quad[2] >> 2));
+			dst[2] = static_cast<uint8_t> ((quad[2] << 6) | quad[3]);
+			dst += 3;
+			numQuad = 0;
+		}
+	}
+	result.dataSize = static_cast<uint32_t> (dst - result.data.get ());
+}
+
+//-----------------------------------------------------------------------------
+auto Base64Codec::Decoder::finish () -> Result
+{
+	if (numQuad > 1)
+	{
+		grow (result.dataSize + 2);
+		auto dst = result.data.get () + result.dataSize;
+		dst[0] = static_cast<uint8_t> ((quad[0] << 2) | (quad[1] >> 4));
+		if (numQuad > 2)
+			dst[1] = static_cast<uint8_t> ((quad[1] << 4) | (quad[2] >> 2));
+		result.dataSize += numQuad - 1;
+	}
+	numQuad = 0;
+	padding = false;
+	Result r = std::move (result);
+	result.dataSize = 0;
+	return r;
+}
+
+} // VSTGUI
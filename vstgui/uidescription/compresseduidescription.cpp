@@ -119,11 +119,27 @@ bool CompressedUIDescription::parse ()
 	return result;
 }
 
+//-----------------------------------------------------------------------------
+bool CompressedUIDescription::saveBinaryToStream (OutputStream& stream, int32_t flags)
+{
+	CMemoryStream xmlStream (1024 * 1024, 1024 * 1024, false);
+	if (!saveToStream (xmlStream, flags))
+		return false;
+	Xml::MemoryContentProvider xmlContentProvider (
+	    reinterpret_cast<const char*> (xmlStream.getBuffer ()),
+	    static_cast<uint32_t> (xmlStream.tell ()));
+	Xml::BinaryWriter writer;
+	return writer.write (&xmlContentProvider, stream);
+}
+
 //-----------------------------------------------------------------------------
 bool CompressedUIDescription::save (UTF8StringPtr filename, int32_t flags)
 {
+	finishBackgroundSave ();
 	bool result = false;
-	if (originalIsCompressed || (flags & kForceWriteCompressedDesc))
+	bool compress = originalIsCompressed || (flags & kForceWriteCompressedDesc);
+	bool binary = (flags & kWriteBinaryDesc) != 0;
+	if (compress || binary)
 	{
 		CFileStream fileStream;
 		if (fileStream.open (filename,
@@ -131,13 +147,20 @@ bool CompressedUIDescription::save (UTF8StringPtr filename, int32_t flags)
 		                         CFileStream::kTruncateMode,
 		                     kLittleEndianByteOrder))
 		{
-			fileStream << kUIDescIdentifier;
-			ZLibOutputStream zout;
-			if (zout.open (fileStream, compressionLevel))
+			if (!compress)
 			{
-				if (saveToStream (zout, flags))
+				result = saveBinaryToStream (fileStream, flags);
+			}
+			else
+			{
+				fileStream << kUIDescIdentifier;
+				ZLibOutputStream zout;
+				if (zout.open (fileStream, compressionLevel))
 				{
-					result = zout.close ();
+					if (binary ? saveBinaryToStream (zout, flags) : saveToStream (zout, flags))
+					{
+						result = zout.close ();
+					}
 				}
 			}
 		}
@@ -146,7 +169,7 @@ bool CompressedUIDescription::save (UTF8StringPtr filename, int32_t flags)
 	{
 		// make a xml backup
 		std::string xmlFileName (filename);
-		if (originalIsCompressed|| (flags & kForceWriteCompressedDesc))
+		if (compress || binary)
 			xmlFileName.append (".xml");
 		CFileStream xmlFileStream;
 		if (xmlFileStream.open (xmlFileName.data (),
@@ -159,6 +182,17 @@ bool CompressedUIDescription::save (UTF8StringPtr filename, int32_t flags)
 	return result;
 }
 
+//-----------------------------------------------------------------------------
+bool CompressedUIDescription::saveInBackground (UTF8StringPtr filename, int32_t flags)
+{
+	bool compress = originalIsCompressed || (flags & kForceWriteCompressedDesc);
+	bool binary = (flags & kWriteBinaryDesc) != 0;
+	if (compress || binary || (flags & kNoPlainXmlFileBackup))
+		return save (filename, flags);
+	// save () does not write the windows resource file
+	return UIDescription::saveInBackground (filename, flags & ~kWriteWindowsResourceFile);
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -17,6 +17,7 @@ protected:
 	{
 		NoPlainXmlFileBackupBit = UIDescription::LastSaveFlagBit,
 		ForceWriteCompressedDesc,
+		WriteBinaryDesc,
 		LastCompressedSaveFlagBit,
 	};
 public:
@@ -25,17 +26,24 @@ public:
 	enum SaveFlags
 	{
 		kNoPlainXmlFileBackup = 1 << NoPlainXmlFileBackupBit,
-		kForceWriteCompressedDesc = 1 << ForceWriteCompressedDesc
+		kForceWriteCompressedDesc = 1 << ForceWriteCompressedDesc,
+		/** write the precompiled binary form (see Xml::BinaryWriter) instead of XML, compressed
+		 *  only if the original was compressed or kForceWriteCompressedDesc is set */
+		kWriteBinaryDesc = 1 << WriteBinaryDesc
 	};
 
 	bool parse () override;
 	bool save (UTF8StringPtr filename, int32_t flags = kWriteWindowsResourceFile) override;
+	/** only the plain XML file is written in the background, the compressed and binary
+	 *	descriptions are saved right away */
+	bool saveInBackground (UTF8StringPtr filename, int32_t flags = kWriteWindowsResourceFile) override;
 
 	bool getOriginalIsCompressed () const { return originalIsCompressed; }
 	void setCompressionLevel (uint32_t level) { compressionLevel = level; }
 
 private:
 	bool parseWithStream (InputStream& stream);
+	bool saveBinaryToStream (OutputStream& stream, int32_t flags);
 
 	bool originalIsCompressed {false};
 	uint32_t compressionLevel {1};
@@ -249,8 +249,8 @@ public:
 		const uint8_t* ptr = reinterpret_cast<const uint8_t*> (inBuffer);
 		while (size)
 		{
-			auto toWrite = 1;
-			buffer.emplace_back (*ptr);
+			auto toWrite = static_cast<uint32_t> (std::min<size_t> (size, bufferSize - buffer.size ()));
+			buffer.insert (buffer.end (), ptr, ptr + toWrite);
 			if (buffer.size () == bufferSize)
 			{
 				if (!flush ())
@@ -280,6 +280,9 @@ static const std::string kAttrTemplateNames = "template-names";
 static const std::string kAttrTemplateSwitchControl = "template-switch-control";
 static const std::string kAttrAnimationStyle = "animation-style";
 static const std::string kAttrAnimationTimingFunction = "animation-timing-function";
+static const std::string kAttrCachePolicy = "cache-policy";
+static const std::string kAttrCacheSize = "cache-size";
+static const std::string kAttrCacheViewLimit = "cache-view-limit";
 
 //-----------------------------------------------------------------------------
 // CSplitViewCreator attributes
@@ -7,104 +7,394 @@
 #include "../lib/cpoint.h"
 #include "../lib/crect.h"
 #include "../lib/cstring.h"
-#include <sstream>
 #include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
 
 namespace VSTGUI {
 namespace {
 
 //------------------------------------------------------------------------
+// locale independent conversion between numbers and their strings without heap allocations
+
+// the longest number written is a negative double with 17 digits and a three digit exponent
+constexpr size_t kMaxNumberLength = 32;
+// the characters of a number read, without white space
+constexpr size_t kMaxNumericalStringLength = 128;
+constexpr uint32_t kShortestPrecision = 17;
+constexpr uint64_t kMaxExactInteger = 1ull << 53;
+
+constexpr double kPowersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                  1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+constexpr int32_t kMaxExactPowerOf10 = 22;
+
+//------------------------------------------------------------------------
+struct NumericalString
+{
+	char chars[kMaxNumericalStringLength];
+	size_t size {0};
+};
+
+//------------------------------------------------------------------------
+/** copies the characters of a number and removes the white space. Returns false if the string has
+ *	characters which are not part of a number or is too long.
+ */
 template<bool OnlyInteger>
-Optional<std::string> trimmedNumericalString (const std::string& str, size_t from, size_t numChars)
+bool trimmedNumericalString (const std::string& str, size_t from, size_t numChars,
+                             NumericalString& result)
 {
-	std::string result;
+	result.size = 0;
 	auto strSize = str.size ();
 	if (from >= strSize)
-		return {};
+		return false;
 	auto points = 0u;
+	auto exponents = 0u;
+	auto digits = 0u;
 	auto to = numChars == std::string::npos ? strSize : from + numChars;
 	for (auto i = from; i < to && i < strSize; ++i)
 	{
 		auto c = str[i];
 		if (!std::isspace (c))
 		{
-			if (!std::isdigit (c) && c != '-' && c != '+')
+			if (std::isdigit (c))
+				++digits;
+			else if (c != '-' && c != '+')
 			{
 				if (!OnlyInteger && c == '.' && points == 0u)
 					++points;
-				else if (points == 1u && c == 'e')
-				{
-				}
+				else if (!OnlyInteger && c == 'e' && exponents == 0u && (points == 1u || digits))
+					++exponents;
 				else
-					return {};
+					return false;
 			}
-			result.push_back (c);
+			if (result.size == kMaxNumericalStringLength - 1)
+				return false;
+			result.chars[result.size++] = c;
 		}
 	}
-	return Optional<std::string> {std::move (result)};
+	result.chars[result.size] = 0;
+	return true;
 }
 
-} // anonymous
-
-//-----------------------------------------------------------------------------
-std::string UIAttributes::pointToString (CPoint p)
+//------------------------------------------------------------------------
+inline bool isDigit (char c)
 {
-	return doubleToString (p.x) + ", " + doubleToString (p.y);
+	return c >= '0' && c <= '9';
 }
 
-//-----------------------------------------------------------------------------
-bool UIAttributes::stringToPoint (const std::string& str, CPoint& p)
+//------------------------------------------------------------------------
+/** the decimal point of the C library is the one of the global locale */
+bool parseDoubleWithCLibrary (const char* str, double& value)
 {
-	size_t start = 0;
-	size_t pos = str.find (",", start, 1);
-	if (pos != std::string::npos)
+	char buffer[kMaxNumericalStringLength];
+	auto decimalPoint = *std::localeconv ()->decimal_point;
+	size_t i = 0;
+	for (; str[i]; ++i)
+		buffer[i] = str[i] == '.' ? decimalPoint : str[i];
+	buffer[i] = 0;
+	errno = 0;
+	value = std::strtod (buffer, nullptr);
+	return !(errno == ERANGE && std::isinf (value));
+}
+
+//------------------------------------------------------------------------
+/** parses the number at the start of the string like an input stream with the classic locale, the
+ *	characters after the number are ignored
+ */
+bool parseDouble (const char* str, double& value)
+{
+	auto p = str;
+	auto negative = false;
+	if (*p == '+' || *p == '-')
+		negative = *p++ == '-';
+	uint64_t mantissa = 0;
+	int32_t exponent = 0;
+	auto hasDigits = false;
+	auto exact = true;
+	auto addDigit = [&] (char c) {
+		hasDigits = true;
+		if (mantissa < kMaxExactInteger / 10)
+		{
+			mantissa = mantissa * 10 + static_cast<uint64_t> (c - '0');
+			return true;
+		}
+		if (c != '0')
+			exact = false;
+		return false;
+	};
+	for (; isDigit (*p); ++p)
 	{
-		std::vector<std::string> subStrings;
-		while (pos != std::string::npos)
+		if (!addDigit (*p))
+			++exponent;
+	}
+	if (*p == '.')
+	{
+		for (++p; isDigit (*p); ++p)
 		{
-			if (!subStrings.empty ())
-				return false;
-			if (auto subStr = trimmedNumericalString<false> (str, start, pos - start))
-				subStrings.emplace_back (std::move (*subStr));
-			else
-				return false;
-			start = pos + 1;
-			pos = str.find (",", start, 1);
+			if (addDigit (*p))
+				--exponent;
 		}
-		if (auto subStr = trimmedNumericalString<false> (str, start, std::string::npos))
-			subStrings.emplace_back (std::move (*subStr));
-		else
+	}
+	if (!hasDigits)
+		return false;
+	if (*p == 'e' || *p == 'E')
+	{
+		auto e = p + 1;
+		auto negativeExponent = false;
+		if (*e == '+' || *e == '-')
+			negativeExponent = *e++ == '-';
+		if (isDigit (*e))
+		{
+			int32_t exp = 0;
+			for (; isDigit (*e); ++e)
+			{
+				if (exp < 10000)
+					exp = exp * 10 + (*e - '0');
+			}
+			exponent += negativeExponent ? -exp : exp;
+		}
+	}
+	// the product or quotient of two exactly representable numbers is correctly rounded
+	if (exact && exponent >= -kMaxExactPowerOf10 && exponent <= kMaxExactPowerOf10)
+	{
+		auto m = static_cast<double> (mantissa);
+		value = exponent < 0 ? m / kPowersOf10[-exponent] : m * kPowersOf10[exponent];
+		if (negative)
+			value = -value;
+		return true;
+	}
+	if (mantissa == 0)
+	{
+		value = negative ? -0. : 0.;
+		return true;
+	}
+	return parseDoubleWithCLibrary (str, value);
+}
+
+//------------------------------------------------------------------------
+bool parseInteger (const char* str, int32_t& value)
+{
+	auto p = str;
+	auto negative = false;
+	if (*p == '+' || *p == '-')
+		negative = *p++ == '-';
+	if (!isDigit (*p))
+		return false;
+	int64_t result = 0;
+	for (; isDigit (*p); ++p)
+	{
+		result = result * 10 + (*p - '0');
+		if (result > static_cast<int64_t> (std::numeric_limits<int32_t>::max ()) + 1)
 			return false;
-		if (subStrings.size () == 2)
+	}
+	if (negative)
+		result = -result;
+	if (result > std::numeric_limits<int32_t>::max ())
+		return false;
+	value = static_cast<int32_t> (result);
+	return true;
+}
+
+//------------------------------------------------------------------------
+/** writes the digits of the value in reverse order and returns the number of digits */
+size_t writeReverseDigits (uint64_t value, char* buffer)
+{
+	size_t size = 0;
+	do
+	{
+		buffer[size++] = static_cast<char> ('0' + value % 10);
+		value /= 10;
+	} while (value);
+	return size;
+}
+
+//------------------------------------------------------------------------
+size_t formatInteger (int64_t value, char* buffer)
+{
+	char digits[24];
+	auto magnitude = value < 0 ? 0 - static_cast<uint64_t> (value) : static_cast<uint64_t> (value);
+	auto numDigits = writeReverseDigits (magnitude, digits);
+	size_t size = 0;
+	if (value < 0)
+		buffer[size++] = '-';
+	while (numDigits)
+		buffer[size++] = digits[--numDigits];
+	return size;
+}
+
+//------------------------------------------------------------------------
+/** formats the value like printf with "%.*g" and the classic locale */
+size_t formatDoubleWithCLibrary (double value, uint32_t precision, char* buffer)
+{
+	auto size = std::snprintf (buffer, kMaxNumberLength, "%.*g", static_cast<int> (precision), value);
+	if (size <= 0)
+		return 0;
+	auto decimalPoint = *std::localeconv ()->decimal_point;
+	if (decimalPoint != '.')
+		std::replace (buffer, buffer + size, decimalPoint, '.');
+	return static_cast<size_t> (size);
+}
+
+//------------------------------------------------------------------------
+/** formats the value with the fewest decimal places which read back to the same value if it has
+ *	no more than maxDigits significant digits and does not need an exponent
+ */
+size_t formatFixedPointDouble (double value, uint32_t maxDigits, char* buffer)
+{
+	auto magnitude = std::abs (value);
+	if (magnitude >= 1e15 || magnitude < 1e-4)
+		return 0;
+	for (auto decimals = 0; decimals <= kMaxExactPowerOf10; ++decimals)
+	{
+		auto scaled = magnitude * kPowersOf10[decimals];
+		if (scaled >= static_cast<double> (kMaxExactInteger))
+			return 0;
+		auto mantissa = static_cast<uint64_t> (scaled + 0.5);
+		if (static_cast<double> (mantissa) / kPowersOf10[decimals] != magnitude)
+			continue;
+		char digits[24];
+		auto numDigits = writeReverseDigits (mantissa, digits);
+		while (numDigits <= static_cast<size_t> (decimals))
+			digits[numDigits++] = '0';
+		auto numSignificantDigits = numDigits;
+		while (numSignificantDigits > 1 && digits[numSignificantDigits - 1] == '0')
+			--numSignificantDigits;
+		if (numSignificantDigits > maxDigits)
+			return 0;
+		size_t size = 0;
+		if (value < 0.)
+			buffer[size++] = '-';
+		while (numDigits > static_cast<size_t> (decimals))
+			buffer[size++] = digits[--numDigits];
+		if (decimals)
 		{
-			p.x = UTF8StringView (subStrings[0].data ()).toDouble ();
-			p.y = UTF8StringView (subStrings[1].data ()).toDouble ();
-			return true;
+			buffer[size++] = '.';
+			while (numDigits)
+				buffer[size++] = digits[--numDigits];
 		}
+		return size;
 	}
-	return false;
+	return 0;
+}
+
+//------------------------------------------------------------------------
+/** formats the value like an output stream with the classic locale and the precision. With a
+ *	precision of kShortestPrecision or more, the shortest string which reads back to the same value
+ *	is written.
+ */
+size_t formatDouble (double value, uint32_t precision, char* buffer)
+{
+	if (std::isnan (value))
+	{
+		std::strcpy (buffer, "nan");
+		return 3;
+	}
+	if (std::isinf (value))
+	{
+		std::strcpy (buffer, value < 0. ? "-inf" : "inf");
+		return value < 0. ? 4 : 3;
+	}
+	if (value == 0.)
+	{
+		std::strcpy (buffer, std::signbit (value) ? "-0" : "0");
+		return std::signbit (value) ? 2 : 1;
+	}
+	auto shortest = precision >= kShortestPrecision;
+	auto maxDigits = shortest ? kShortestPrecision : std::max (precision, 1u);
+	if (auto size = formatFixedPointDouble (value, maxDigits, buffer))
+		return size;
+	if (!shortest)
+		return formatDoubleWithCLibrary (value, maxDigits, buffer);
+	// all normal numbers with up to 15 digits are read back as the same value, subnormal numbers
+	// have less precision
+	auto minDigits = std::abs (value) < std::numeric_limits<double>::min () ? 1u : 15u;
+	for (auto digits = minDigits; digits < kShortestPrecision; ++digits)
+	{
+		auto size = formatDoubleWithCLibrary (value, digits, buffer);
+		buffer[size] = 0;
+		double result;
+		if (parseDouble (buffer, result) && result == value)
+			return size;
+	}
+	return formatDoubleWithCLibrary (value, kShortestPrecision, buffer);
+}
+
+//------------------------------------------------------------------------
+/** parses the comma separated values of a point or rect */
+template<size_t NumValues>
+bool parseDoubleList (const std::string& str, double (&values)[NumValues])
+{
+	size_t start = 0;
+	size_t pos = str.find (",", start, 1);
+	if (pos == std::string::npos)
+		return false;
+	NumericalString subStr;
+	size_t index = 0;
+	while (true)
+	{
+		if (index == NumValues)
+			return false;
+		auto numChars = pos == std::string::npos ? pos : pos - start;
+		if (!trimmedNumericalString<false> (str, start, numChars, subStr))
+			return false;
+		// like an input stream, characters which are not a number are read as zero
+		if (!parseDouble (subStr.chars, values[index]))
+			values[index] = 0.;
+		++index;
+		if (pos == std::string::npos)
+			break;
+		start = pos + 1;
+		pos = str.find (",", start, 1);
+	}
+	return index == NumValues;
+}
+
+} // anonymous
+
+//-----------------------------------------------------------------------------
+std::string UIAttributes::pointToString (CPoint p)
+{
+	char buffer[kMaxNumberLength * 2 + 2];
+	auto size = formatDouble (p.x, 6, buffer);
+	buffer[size++] = ',';
+	buffer[size++] = ' ';
+	size += formatDouble (p.y, 6, buffer + size);
+	return std::string (buffer, size);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::stringToPoint (const std::string& str, CPoint& p)
+{
+	double values[2];
+	if (!parseDoubleList (str, values))
+		return false;
+	p.x = values[0];
+	p.y = values[1];
+	return true;
 }
 
 //------------------------------------------------------------------------
+/** a precision of 17 or more writes the shortest string which reads back to the same value */
 std::string UIAttributes::doubleToString (double value, uint32_t precision)
 {
-	std::stringstream str;
-	str.imbue (std::locale::classic ());
-	str.precision (precision);
-	str << value;
-	return str.str ();
+	char buffer[kMaxNumberLength];
+	return std::string (buffer, formatDouble (value, precision, buffer));
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::stringToDouble (const std::string& str, double& value)
 {
-	if (auto string = trimmedNumericalString<false> (str, 0, str.size ()))
-	{
-		std::istringstream sstream (*string);
-		sstream.imbue (std::locale::classic ());
-		sstream >> value;
-		return sstream.fail () == false;
-	}
+	NumericalString string;
+	if (trimmedNumericalString<false> (str, 0, str.size (), string))
+		return parseDouble (string.chars, value);
 	return false;
 }
 
@@ -133,64 +423,47 @@ bool UIAttributes::stringToBool (const std::string& str, bool& value)
 //-----------------------------------------------------------------------------
 std::string UIAttributes::integerToString (int32_t value)
 {
-	std::stringstream str;
-	str << value;
-	return str.str ();
+	char buffer[kMaxNumberLength];
+	return std::string (buffer, formatInteger (value, buffer));
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::stringToInteger (const std::string& str, int32_t& value)
 {
-	if (auto string = trimmedNumericalString<true> (str, 0, str.size ()))
-	{
-		std::istringstream sstream (*string);
-		sstream.imbue (std::locale::classic ());
-		sstream >> value;
-		return sstream.fail () == false;
-	}
+	NumericalString string;
+	if (trimmedNumericalString<true> (str, 0, str.size (), string))
+		return parseInteger (string.chars, value);
 	return false;
 }
 
 //-----------------------------------------------------------------------------
 std::string UIAttributes::rectToString (CRect r, uint32_t precision)
 {
-	return doubleToString (r.left) + ", " + doubleToString (r.top) + ", " +
-	       doubleToString (r.right) + ", " + doubleToString (r.bottom);
+	char buffer[kMaxNumberLength * 4 + 6];
+	size_t size = 0;
+	for (auto value : {r.left, r.top, r.right, r.bottom})
+	{
+		if (size)
+		{
+			buffer[size++] = ',';
+			buffer[size++] = ' ';
+		}
+		size += formatDouble (value, precision, buffer + size);
+	}
+	return std::string (buffer, size);
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::stringToRect (const std::string& str, CRect& r)
 {
-	size_t start = 0;
-	size_t pos = str.find (",", start, 1);
-	if (pos != std::string::npos)
-	{
-		std::vector<std::string> subStrings;
-		while (pos != std::string::npos)
-		{
-			if (subStrings.size () >= 3)
-				return false;
-			if (auto subStr = trimmedNumericalString<false> (str, start, pos - start))
-				subStrings.emplace_back (std::move (*subStr));
-			else
-				return false;
-			start = pos + 1;
-			pos = str.find (",", start, 1);
-		}
-		if (auto subStr = trimmedNumericalString<false> (str, start, std::string::npos))
-			subStrings.emplace_back (std::move (*subStr));
-		else
-			return false;
-		if (subStrings.size () == 4)
-		{
-			r.left = UTF8StringView (subStrings[0].data ()).toDouble ();
-			r.top = UTF8StringView (subStrings[1].data ()).toDouble ();
-			r.right = UTF8StringView (subStrings[2].data ()).toDouble ();
-			r.bottom = UTF8StringView (subStrings[3].data ()).toDouble ();
-			return true;
-		}
-	}
-	return false;
+	double values[4];
+	if (!parseDoubleList (str, values))
+		return false;
+	r.left = values[0];
+	r.top = values[1];
+	r.right = values[2];
+	r.bottom = values[3];
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -255,39 +528,111 @@ const std::string* UIAttributes::getAttributeValue (const std::string& name) con
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, const std::string& value)
 {
-	iterator iter = find (name);
+	UIAttributesMap::iterator iter = find (name);
 	if (iter != end ())
+	{
+		valueChanged (&iter->second);
 		iter->second = value;
+	}
 	else
+	{
+		valueChanged (nullptr);
 		emplace (name, value);
+	}
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, std::string&& value)
 {
-	iterator iter = find (name);
+	UIAttributesMap::iterator iter = find (name);
 	if (iter != end ())
+	{
+		valueChanged (&iter->second);
 		iter->second = std::move (value);
+	}
 	else
+	{
+		valueChanged (nullptr);
 		emplace (name, std::move (value));
+	}
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (std::string&& name, std::string&& value)
 {
-	iterator iter = find (name);
+	UIAttributesMap::iterator iter = find (name);
 	if (iter != end ())
+	{
+		valueChanged (&iter->second);
 		iter->second = std::move (value);
+	}
 	else
+	{
+		valueChanged (nullptr);
 		emplace (std::move (name), std::move (value));
+	}
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::removeAttribute (const std::string& name)
 {
-	iterator iter = find (name);
+	UIAttributesMap::iterator iter = find (name);
 	if (iter != end ())
+	{
+		valueChanged (&iter->second);
 		erase (iter);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::clearEvaluatedAttributes () const
+{
+	evaluatedAttributes = nullptr;
+	evaluatedDescription = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @param value the string of the changed attribute or nullptr if all attributes changed
+ */
+void UIAttributes::valueChanged (const std::string* value)
+{
+	if (value)
+	{
+		valueCache.erase (std::remove_if (valueCache.begin (), valueCache.end (),
+		                                  [&] (const CachedValue& entry) {
+			                                  return entry.string == value;
+		                                  }),
+		                  valueCache.end ());
+	}
+	else
+		valueCache.clear ();
+	clearEvaluatedAttributes ();
+}
+
+//-----------------------------------------------------------------------------
+/** the values of an attribute are parsed once and then taken from the cache until the attribute
+ *	changes. Views created from the same template read the same attributes again and again. */
+template <typename ParseProc>
+bool UIAttributes::getCachedValue (const std::string& name, ValueType type, double* values,
+                                   size_t numValues, ParseProc parse) const
+{
+	auto str = getAttributeValue (name);
+	if (str == nullptr)
+		return false;
+	auto it = std::find_if (valueCache.begin (), valueCache.end (), [&] (const CachedValue& entry) {
+		return entry.string == str && entry.type == type;
+	});
+	if (it == valueCache.end ())
+	{
+		CachedValue entry {str, type, false, {}};
+		entry.valid = parse (*str, entry.values);
+		it = valueCache.emplace (valueCache.end (), entry);
+	}
+	if (!it->valid)
+		return false;
+	std::copy (it->values, it->values + numValues, values);
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -299,9 +644,10 @@ void UIAttributes::setDoubleAttribute (const std::string& name, double value)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getDoubleAttribute (const std::string& name, double& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToDouble (*str, value);
-	return false;
+	return getCachedValue (name, ValueType::kDouble, &value, 1,
+	                       [] (const std::string& str, double* values) {
+		                       return stringToDouble (str, values[0]);
+	                       });
 }
 
 //-----------------------------------------------------------------------------
@@ -313,9 +659,18 @@ void UIAttributes::setBooleanAttribute (const std::string& name, bool value)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getBooleanAttribute (const std::string& name, bool& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToBool (*str, value);
-	return false;
+	double v;
+	if (!getCachedValue (name, ValueType::kBoolean, &v, 1,
+	                     [] (const std::string& str, double* values) {
+		                     bool b;
+		                     if (!stringToBool (str, b))
+			                     return false;
+		                     values[0] = b ? 1. : 0.;
+		                     return true;
+	                     }))
+		return false;
+	value = v != 0.;
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -327,9 +682,18 @@ void UIAttributes::setIntegerAttribute (const std::string& name, int32_t value)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getIntegerAttribute (const std::string& name, int32_t& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToInteger(*str, value);
-	return false;
+	double v;
+	if (!getCachedValue (name, ValueType::kInteger, &v, 1,
+	                     [] (const std::string& str, double* values) {
+		                     int32_t i;
+		                     if (!stringToInteger (str, i))
+			                     return false;
+		                     values[0] = i;
+		                     return true;
+	                     }))
+		return false;
+	value = static_cast<int32_t> (v);
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -341,9 +705,19 @@ void UIAttributes::setPointAttribute (const std::string& name, const CPoint& p)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getPointAttribute (const std::string& name, CPoint& p) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToPoint (*str, p);
-	return false;
+	double v[2];
+	if (!getCachedValue (name, ValueType::kPoint, v, 2,
+	                     [] (const std::string& str, double* values) {
+		                     CPoint point;
+		                     if (!stringToPoint (str, point))
+			                     return false;
+		                     values[0] = point.x;
+		                     values[1] = point.y;
+		                     return true;
+	                     }))
+		return false;
+	p (v[0], v[1]);
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -355,9 +729,24 @@ void UIAttributes::setRectAttribute (const std::string& name, const CRect& r)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getRectAttribute (const std::string& name, CRect& r) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToRect (*str, r);
-	return false;
+	double v[4];
+	if (!getCachedValue (name, ValueType::kRect, v, 4,
+	                     [] (const std::string& str, double* values) {
+		                     CRect rect;
+		                     if (!stringToRect (str, rect))
+			                     return false;
+		                     values[0] = rect.left;
+		                     values[1] = rect.top;
+		                     values[2] = rect.right;
+		                     values[3] = rect.bottom;
+		                     return true;
+	                     }))
+		return false;
+	r.left = v[0];
+	r.top = v[1];
+	r.right = v[2];
+	r.bottom = v[3];
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 namespace VSTGUI {
 class OutputStream;
 class InputStream;
+class IUIDescription;
 
 using UIAttributesMap = std::unordered_map<std::string,std::string>;
 
@@ -25,11 +26,13 @@ public:
 	explicit UIAttributes (UTF8StringPtr* attributes = nullptr);
 	~UIAttributes () noexcept override = default;
 
-	using UIAttributesMap::begin;
-	using UIAttributesMap::end;
-	using UIAttributesMap::iterator;
+	// the attributes can only be changed via the setters, so that the cached values are updated
+	using iterator = UIAttributesMap::const_iterator;
 	using UIAttributesMap::const_iterator;
 
+	const_iterator begin () const { return UIAttributesMap::begin (); }
+	const_iterator end () const { return UIAttributesMap::end (); }
+
 	bool hasAttribute (const std::string& name) const;
 	const std::string* getAttributeValue (const std::string& name) const;
 	void setAttribute (const std::string& name, const std::string& value);
@@ -55,7 +58,15 @@ public:
 	void setStringArrayAttribute (const std::string& name, const StringArray& values);
 	bool getStringArrayAttribute (const std::string& name, StringArray& values) const;
 	
-	void removeAll () { clear (); }
+	void removeAll ()
+	{
+		clear ();
+		valueChanged (nullptr);
+	}
+
+	/** forget the attributes the UIViewFactory evaluated from these, they have to be evaluated
+	 *	again when the variables of the description changed */
+	void clearEvaluatedAttributes () const;
 
 	bool store (OutputStream& stream) const;
 	bool restore (InputStream& stream);
@@ -72,7 +83,49 @@ public:
 	static bool stringToRect (const std::string& str, CRect& r);
 	static std::string stringArrayToString (const StringArray& values);
 	static bool stringToStringArray (const std::string& str, StringArray& values);
-	
+
+private:
+	friend class UIViewFactory;
+
+	enum class ValueType : uint8_t
+	{
+		kBoolean,
+		kInteger,
+		kDouble,
+		kPoint,
+		kRect
+	};
+
+	struct CachedValue
+	{
+		const std::string* string;
+		ValueType type;
+		bool valid;
+		double values[4];
+	};
+
+	// values parsed by the typed getters. The entries point to the strings in the map they were
+	// parsed from, so copies start with an empty cache
+	struct ValueCache : std::vector<CachedValue>
+	{
+		ValueCache () = default;
+		ValueCache (const ValueCache&) {}
+		ValueCache& operator= (const ValueCache&)
+		{
+			clear ();
+			return *this;
+		}
+	};
+
+	template <typename ParseProc>
+	bool getCachedValue (const std::string& name, ValueType type, double* values, size_t numValues,
+	                     ParseProc parse) const;
+	void valueChanged (const std::string* value);
+
+	mutable ValueCache valueCache;
+	// the attributes evaluated by the UIViewFactory for evaluatedDescription
+	mutable SharedPointer<UIAttributes> evaluatedAttributes;
+	mutable const IUIDescription* evaluatedDescription {nullptr};
 };
 
 } // VSTGUI
@@ -19,6 +19,7 @@
 #include "../lib/cgraphicspath.h"
 #include "../lib/cbitmap.h"
 #include "../lib/cbitmapfilter.h"
+#include "../lib/cbitmapfilterkernels.h"
 #include "../lib/dispatchlist.h"
 #include "../lib/platform/std_unorderedmap.h"
 #include "../lib/platform/iplatformbitmap.h"
@@ -27,8 +28,15 @@
 #include <sstream>
 #include <fstream>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <cstring>
 #include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
 
 namespace VSTGUI {
 
@@ -133,6 +141,7 @@ public:
 	
 	void sortChildren ();
 	virtual void freePlatformResources () {}
+	virtual bool hasEqualData (const UINode* node) const { return data == node->data; }
 
 protected:
 	std::string name;
@@ -185,12 +194,56 @@ protected:
 	int32_t tag;
 };
 
+//-----------------------------------------------------------------------------
+using UIBitmapFilterList = std::list<SharedPointer<BitmapFilter::IFilter>>;
+
+//-----------------------------------------------------------------------------
+/** everything needed to load the bitmap of a bitmap node without touching the node, so that it
+ *	can run on another thread than the one the description is used on */
+struct UIBitmapLoadJob
+{
+	UTF8StringPtr path {nullptr};
+	std::string absolutePath;
+	bool hasPartDesc {false};
+	CNinePartTiledDescription partDesc;
+	const Base64Codec::Result* bitmapData {nullptr};
+	double scaleFactor {0.};
+	UIBitmapFilterList filters;
+
+	SharedPointer<CBitmap> result;
+	double decodedScaleFactor {0.};
+	bool filtersProcessed {false};
+
+	void run ();
+};
+
+//-----------------------------------------------------------------------------
+/** the base64 encoded image of a bitmap node. The character data is decoded while it is parsed,
+ *	the text is only kept for live editing, otherwise it is encoded again when it is saved. */
+class UIBitmapDataNode : public UINode
+{
+public:
+	UIBitmapDataNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
+
+	void setDecodedData (Base64Codec::Result&& result);
+	const Base64Codec::Result& getDecodedData () const { return decodedData; }
+	bool hasDecodedData () const { return decodedData.dataSize > 0; }
+	/** create the base64 text from the decoded data if it was not kept */
+	void encodeData ();
+
+	bool hasEqualData (const UINode* node) const override;
+private:
+	Base64Codec::Result decodedData;
+};
+
 //-----------------------------------------------------------------------------
 class UIBitmapNode : public UINode
 {
 public:
 	UIBitmapNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	CBitmap* getBitmap (const std::string& pathHint);
+	bool createLoadJob (const std::string& pathHint, UIBitmapLoadJob& job) const;
+	void setLoadedBitmap (const UIBitmapLoadJob& job);
 	void setBitmap (UTF8StringPtr bitmapName);
 	void setNinePartTiledOffset (const CRect* offsets);
 	void invalidBitmap ();
@@ -200,16 +253,16 @@ public:
 	void setScaledBitmapsAdded () { scaledBitmapsAdded = true; }
 	
 	void createXMLData (const std::string& pathHint);
+	void encodeXMLData ();
 	void removeXMLData ();
 	bool hasXMLData () const;
 
 	void freePlatformResources () override;
 protected:
 	~UIBitmapNode () noexcept override;
-	CBitmap* createBitmap (const std::string& str, CNinePartTiledDescription* partDesc) const;
 	SharedPointer<IPlatformBitmap> createBitmapFromDataNode () const;
 	static bool imagesEqual (IPlatformBitmap* b1, IPlatformBitmap* b2);
-	UINode* dataNode () const;
+	UIBitmapDataNode* dataNode () const;
 	CBitmap* bitmap;
 	bool filterProcessed;
 	bool scaledBitmapsAdded;
@@ -315,6 +368,81 @@ private:
 	ChildMap childMap;
 };
 
+namespace UIDescriptionPrivate {
+static std::string removeScaleFactorFromName (const std::string& name);
+}
+
+//-----------------------------------------------------------------------------
+class UIBitmapDescList : public UIDescListWithFastFindAttributeNameChild
+{
+private:
+	using ScaleVariantMap = std::unordered_map<std::string, UIDescListContainerType>;
+public:
+	UIBitmapDescList () {}
+
+	void add (UINode* obj) override
+	{
+		UIDescListWithFastFindAttributeNameChild::add (obj);
+		if (const std::string* nameAttributeValue = obj->getAttributes ()->getAttributeValue ("name"))
+			addScaleVariant (obj, *nameAttributeValue);
+	}
+
+	void remove (UINode* obj) override
+	{
+		if (const std::string* nameAttributeValue = obj->getAttributes ()->getAttributeValue ("name"))
+			removeScaleVariant (obj, *nameAttributeValue);
+		UIDescListWithFastFindAttributeNameChild::remove (obj);
+	}
+
+	void removeAll () override
+	{
+		scaleVariants.clear ();
+		UIDescListWithFastFindAttributeNameChild::removeAll ();
+	}
+
+	void nodeAttributeChanged (UINode* node, const std::string& attributeName, const std::string& oldAttributeValue) override
+	{
+		UIDescListWithFastFindAttributeNameChild::nodeAttributeChanged (node, attributeName, oldAttributeValue);
+		if (attributeName != "name")
+			return;
+		removeScaleVariant (node, oldAttributeValue);
+		if (const std::string* nameAttributeValue = node->getAttributes ()->getAttributeValue ("name"))
+			addScaleVariant (node, *nameAttributeValue);
+	}
+
+	/** returns the nodes whose name is baseName with a scale factor appended */
+	const UIDescListContainerType* findScaleVariants (const std::string& baseName) const
+	{
+		ScaleVariantMap::const_iterator it = scaleVariants.find (baseName);
+		if (it != scaleVariants.end ())
+			return &it->second;
+		return nullptr;
+	}
+private:
+	void addScaleVariant (UINode* node, const std::string& nodeName)
+	{
+		std::string baseName = UIDescriptionPrivate::removeScaleFactorFromName (nodeName);
+		if (!baseName.empty ())
+			scaleVariants[baseName].emplace_back (node);
+	}
+
+	void removeScaleVariant (UINode* node, const std::string& nodeName)
+	{
+		std::string baseName = UIDescriptionPrivate::removeScaleFactorFromName (nodeName);
+		if (baseName.empty ())
+			return;
+		ScaleVariantMap::iterator it = scaleVariants.find (baseName);
+		if (it == scaleVariants.end ())
+			return;
+		auto& variants = it->second;
+		variants.erase (std::remove (variants.begin (), variants.end (), node), variants.end ());
+		if (variants.empty ())
+			scaleVariants.erase (it);
+	}
+
+	ScaleVariantMap scaleVariants;
+};
+
 
 //-----------------------------------------------------------------------------
 UIDescList::UIDescList (bool ownsObjects)
@@ -402,145 +530,405 @@ void UIDescList::sort ()
 }
 
 //-----------------------------------------------------------------------------
+/** writes a node tree as XML.
+ *
+ *	The text is collected in a buffer which is handed to the stream when it is full. Special
+ *	characters of attribute values are replaced while the values are copied into the buffer and the
+ *	attributes are written in the order of their names by sorting pointers to them, so no strings
+ *	are copied.
+ */
 class UIDescWriter
 {
 public:
+	/** copy of the exported part of a node tree, which can be written on another thread.
+	 *
+	 *	All strings are stored in one text and the nodes in depth-first order, so taking the
+	 *	snapshot needs only a few allocations, and the attributes are sorted when they are written.
+	 *	A snapshot can be reused for the next one to keep its memory.
+	 */
+	struct Snapshot
+	{
+		struct Range
+		{
+			size_t offset {0};
+			size_t size {0};
+		};
+		struct Attribute
+		{
+			Range name;
+			Range value;
+		};
+		struct Node
+		{
+			Range name;
+			Range data;
+			size_t firstAttribute {0};
+			size_t numAttributes {0};
+			size_t numChildren {0};
+			bool hasContent {false};
+			bool comment {false};
+		};
+
+		std::string text;
+		std::vector<Node> nodes;
+		std::vector<Attribute> attributes;
+	};
+
+	static void createSnapshot (UINode* rootNode, Snapshot& snapshot);
+
 	bool write (OutputStream& stream, UINode* rootNode);
+	bool write (OutputStream& stream, const Snapshot& snapshot);
 protected:
-	static void encodeAttributeString (std::string& str);
+	struct Text
+	{
+		Text (const std::string& str) : data (str.data ()), size (str.size ()) {}
+		Text (const Snapshot& snapshot, Snapshot::Range range)
+		: data (snapshot.text.data () + range.offset), size (range.size) {}
 
-	bool writeNode (UINode* node, OutputStream& stream);
-	bool writeComment (UICommentNode* node, OutputStream& stream);
-	bool writeNodeData (UINode::DataStorage& str, OutputStream& stream);
-	bool writeAttributes (UIAttributes* attr, OutputStream& stream);
-	int32_t intendLevel;
+		const char* data;
+		size_t size;
+	};
+	using SortedAttributes = std::vector<const UIAttributesMap::value_type*>;
+
+	using SortedSnapshotAttributes = std::vector<const Snapshot::Attribute*>;
+
+	static void sortAttributes (const UIAttributes& attributes, SortedAttributes& sorted);
+	static void sortAttributes (const Snapshot& snapshot, const Snapshot::Node& node,
+	                            SortedSnapshotAttributes& sorted);
+	static void addToSnapshot (UINode* node, Snapshot& snapshot);
+	static Snapshot::Range addToSnapshot (const std::string& str, Snapshot& snapshot);
+
+	bool begin (OutputStream& stream);
+	bool end ();
+	void writeNode (UINode* node);
+	size_t writeNode (const Snapshot& snapshot, size_t index);
+	void writeStartTag (Text name);
+	void writeAttribute (Text name, Text value);
+	void writeEndTag (Text name, bool hasContent);
+	void writeNodeData (Text data);
+	void writeComment (Text data);
+	void writeIndent ();
+	void writeEscaped (Text str);
+	void write (const char* str, size_t size);
+	void write (Text str) { write (str.data, str.size); }
+	template<size_t size>
+	void write (const char (&str)[size]) { write (str, size - 1); }
+	void flush ();
+
+	static constexpr size_t kBufferSize = 64 * 1024;
+
+	OutputStream* stream {nullptr};
+	std::string buffer;
+	SortedAttributes sortedAttributes;
+	SortedSnapshotAttributes sortedSnapshotAttributes;
+	int32_t intendLevel {0};
+	bool failed {false};
 };
 
 //-----------------------------------------------------------------------------
-bool UIDescWriter::write (OutputStream& stream, UINode* rootNode)
+void UIDescWriter::createSnapshot (UINode* rootNode, Snapshot& snapshot)
+{
+	snapshot.text.clear ();
+	snapshot.nodes.clear ();
+	snapshot.attributes.clear ();
+	if (rootNode->noExport ())
+		return;
+	addToSnapshot (rootNode, snapshot);
+}
+
+//-----------------------------------------------------------------------------
+auto UIDescWriter::addToSnapshot (const std::string& str, Snapshot& snapshot) -> Snapshot::Range
+{
+	Snapshot::Range range;
+	range.offset = snapshot.text.size ();
+	range.size = str.size ();
+	snapshot.text.append (str);
+	return range;
+}
+
+//-----------------------------------------------------------------------------
+void UIDescWriter::addToSnapshot (UINode* node, Snapshot& snapshot)
+{
+	auto index = snapshot.nodes.size ();
+	snapshot.nodes.emplace_back ();
+	Snapshot::Node snapshotNode;
+	snapshotNode.data = addToSnapshot (node->getData (), snapshot);
+	if (dynamic_cast<UICommentNode*> (node))
+	{
+		snapshotNode.comment = true;
+		snapshot.nodes[index] = snapshotNode;
+		return;
+	}
+	snapshotNode.name = addToSnapshot (node->getName (), snapshot);
+	snapshotNode.firstAttribute = snapshot.attributes.size ();
+	for (auto& attribute : *node->getAttributes ())
+	{
+		if (attribute.second.empty ())
+			continue;
+		Snapshot::Attribute snapshotAttribute;
+		snapshotAttribute.name = addToSnapshot (attribute.first, snapshot);
+		snapshotAttribute.value = addToSnapshot (attribute.second, snapshot);
+		snapshot.attributes.emplace_back (snapshotAttribute);
+	}
+	snapshotNode.numAttributes = snapshot.attributes.size () - snapshotNode.firstAttribute;
+	auto& children = node->getChildren ();
+	snapshotNode.hasContent = !children.empty () || !node->getData ().empty ();
+	for (auto& childNode : children)
+	{
+		if (childNode->noExport ())
+			continue;
+		addToSnapshot (childNode, snapshot);
+		++snapshotNode.numChildren;
+	}
+	snapshot.nodes[index] = snapshotNode;
+}
+
+//-----------------------------------------------------------------------------
+void UIDescWriter::sortAttributes (const UIAttributes& attributes, SortedAttributes& sorted)
+{
+	sorted.clear ();
+	for (auto& attribute : attributes)
+		sorted.emplace_back (&attribute);
+	std::sort (sorted.begin (), sorted.end (), [] (const UIAttributesMap::value_type* lhs,
+	                                                 const UIAttributesMap::value_type* rhs) {
+		return lhs->first < rhs->first;
+	});
+}
+
+//-----------------------------------------------------------------------------
+void UIDescWriter::sortAttributes (const Snapshot& snapshot, const Snapshot::Node& node,
+                                   SortedSnapshotAttributes& sorted)
 {
+	sorted.clear ();
+	for (auto i = node.firstAttribute; i < node.firstAttribute + node.numAttributes; ++i)
+		sorted.emplace_back (&snapshot.attributes[i]);
+	auto text = snapshot.text.data ();
+	// same order as std::string::operator<
+	std::sort (sorted.begin (), sorted.end (), [text] (const Snapshot::Attribute* lhs,
+	                                                   const Snapshot::Attribute* rhs) {
+		auto result = std::char_traits<char>::compare (text + lhs->name.offset,
+		                                               text + rhs->name.offset,
+		                                               std::min (lhs->name.size, rhs->name.size));
+		return result < 0 || (result == 0 && lhs->name.size < rhs->name.size);
+	});
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescWriter::write (OutputStream& outputStream, UINode* rootNode)
+{
+	if (!begin (outputStream))
+		return false;
+	writeNode (rootNode);
+	return end ();
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescWriter::write (OutputStream& outputStream, const Snapshot& snapshot)
+{
+	if (!begin (outputStream))
+		return false;
+	if (!snapshot.nodes.empty ())
+		writeNode (snapshot, 0);
+	return end ();
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescWriter::begin (OutputStream& outputStream)
+{
+	stream = &outputStream;
 	intendLevel = 0;
-	stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-	return writeNode (rootNode, stream);
+	failed = false;
+	buffer.clear ();
+	buffer.reserve (kBufferSize);
+	write ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+	return true;
 }
 
 //-----------------------------------------------------------------------------
-void UIDescWriter::encodeAttributeString (std::string& str)
+bool UIDescWriter::end ()
 {
-	const int8_t entities[] = {'&', '<','>', '\'', '\"', 0};
-	const char* replacements[] = {"&amp;", "&lt;", "&gt;", "&apos;", "&quot;"};
-	int32_t i = 0;
-	while (entities[i] != 0)
+	flush ();
+	stream = nullptr;
+	return !failed;
+}
+
+//-----------------------------------------------------------------------------
+void UIDescWriter::flush ()
+{
+	if (buffer.empty ())
+		return;
+	if (!failed)
+	{
+		auto size = static_cast<uint32_t> (buffer.size ());
+		failed = stream->writeRaw (buffer.data (), size) != size;
+	}
+	buffer.clear ();
+}
+
+//-----------------------------------------------------------------------------
+void UIDescWriter::write (const char* str, size_t size)
+{
+	if (buffer.size () + size > kBufferSize)
 	{
-		size_t pos = 0;
-		while ((pos = str.find (entities[i], pos)) != std::string::npos)
+		flush ();
+		if (size > kBufferSize)
 		{
-			str.replace (pos, 1, replacements[i]);
-			pos++;
+			if (!failed)
+				failed = stream->writeRaw (str, static_cast<uint32_t> (size)) != size;
+			return;
 		}
-		i++;
 	}
+	buffer.append (str, size);
+}
+
+//-----------------------------------------------------------------------------
+void UIDescWriter::writeIndent ()
+{
+	static const char tabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+	constexpr int32_t kNumTabs = sizeof (tabs) - 1;
+	for (auto level = intendLevel; level > 0; level -= kNumTabs)
+		write (tabs, static_cast<size_t> (std::min (level, kNumTabs)));
 }
 
 //-----------------------------------------------------------------------------
-bool UIDescWriter::writeAttributes (UIAttributes* attr, OutputStream& stream)
+void UIDescWriter::writeEscaped (Text str)
 {
-	bool result = true;
-	using SortedAttributes = std::map<std::string,std::string>;
-	SortedAttributes sortedAttributes (attr->begin (), attr->end ());
-	for (auto& sa : sortedAttributes)
+	auto start = str.data;
+	auto strEnd = start + str.size;
+	for (auto pos = start; pos != strEnd; ++pos)
 	{
-		if (sa.second.length () > 0)
+		const char* replacement = nullptr;
+		size_t replacementSize = 0;
+		switch (*pos)
 		{
-			stream << " ";
-			stream << sa.first;
-			stream << "=\"";
-			std::string value (sa.second);
-			encodeAttributeString (value);
-			stream << value;
-			stream << "\"";
+			case '&': replacement = "&amp;"; replacementSize = 5; break;
+			case '<': replacement = "&lt;"; replacementSize = 4; break;
+			case '>': replacement = "&gt;"; replacementSize = 4; break;
+			case '\'': replacement = "&apos;"; replacementSize = 6; break;
+			case '\"': replacement = "&quot;"; replacementSize = 6; break;
+			default: continue;
 		}
+		write (start, static_cast<size_t> (pos - start));
+		write (replacement, replacementSize);
+		start = pos + 1;
 	}
-	return result;
+	write (start, static_cast<size_t> (strEnd - start));
+}
+
+//-----------------------------------------------------------------------------
+void UIDescWriter::writeStartTag (Text name)
+{
+	writeIndent ();
+	write ("<");
+	write (name);
+}
+
+//-----------------------------------------------------------------------------
+void UIDescWriter::writeAttribute (Text name, Text value)
+{
+	if (value.size == 0)
+		return;
+	write (" ");
+	write (name);
+	write ("=\"");
+	writeEscaped (value);
+	write ("\"");
+}
+
+//-----------------------------------------------------------------------------
+void UIDescWriter::writeEndTag (Text name, bool hasContent)
+{
+	if (!hasContent)
+	{
+		write ("/>\n");
+		return;
+	}
+	--intendLevel;
+	writeIndent ();
+	write ("</");
+	write (name);
+	write (">\n");
 }
 
 //-----------------------------------------------------------------------------
-bool UIDescWriter::writeNodeData (UINode::DataStorage& str, OutputStream& stream)
+void UIDescWriter::writeNodeData (Text data)
 {
-	for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
-	uint32_t i = 0;
-	for (auto c : str)
+	constexpr size_t kDataLineLength = 82;
+	writeIndent ();
+	for (size_t pos = 0; pos < data.size; pos += kDataLineLength)
 	{
-		stream << static_cast<int8_t> (c);
-		if (i++ > 80)
+		auto length = std::min (kDataLineLength, data.size - pos);
+		write (data.data + pos, length);
+		if (length == kDataLineLength)
 		{
-			stream << "\n";
-			i = 0;
-			for (int32_t i2 = 0; i2 < intendLevel; i2++) stream << "\t";
+			write ("\n");
+			writeIndent ();
 		}
 	}
-	stream << "\n";
-	return true;
+	write ("\n");
 }
 
 //-----------------------------------------------------------------------------
-bool UIDescWriter::writeComment (UICommentNode* node, OutputStream& stream)
+void UIDescWriter::writeComment (Text data)
 {
-	stream << "<!--";
-	stream << node->getData ();
-	stream << "-->\n";
-	return true;
+	writeIndent ();
+	write ("<!--");
+	write (data);
+	write ("-->\n");
 }
 
 //-----------------------------------------------------------------------------
-bool UIDescWriter::writeNode (UINode* node, OutputStream& stream)
+void UIDescWriter::writeNode (UINode* node)
 {
-	bool result = true;
 	if (node->noExport ())
-		return result;
-	for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
-	if (auto* commentNode = dynamic_cast<UICommentNode*> (node))
+		return;
+	if (dynamic_cast<UICommentNode*> (node))
 	{
-		return writeComment (commentNode, stream);
+		writeComment (node->getData ());
+		return;
 	}
-	stream << "<";
-	stream << node->getName ();
-	result = writeAttributes (node->getAttributes (), stream);
-	if (result)
+	writeStartTag (node->getName ());
+	sortAttributes (*node->getAttributes (), sortedAttributes);
+	for (auto attribute : sortedAttributes)
+		writeAttribute (attribute->first, attribute->second);
+	auto& children = node->getChildren ();
+	bool hasContent = !children.empty () || !node->getData ().empty ();
+	if (hasContent)
 	{
-		UIDescList& children = node->getChildren ();
-		if (!children.empty ())
-		{
-			stream << ">\n";
-			intendLevel++;
-			if (!node->getData ().empty ())
-				result = writeNodeData (node->getData (), stream);
-			for (auto& childNode : children)
-			{
-				if (!writeNode (childNode, stream))
-					return false;
-			}
-			intendLevel--;
-			for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
-			stream << "</";
-			stream << node->getName ();
-			stream << ">\n";
-		}
-		else if (!node->getData ().empty ())
-		{
-			stream << ">\n";
-			intendLevel++;
-			result = writeNodeData (node->getData (), stream);
-			intendLevel--;
-			for (int32_t i = 0; i < intendLevel; i++) stream << "\t";
-			stream << "</";
-			stream << node->getName ();
-			stream << ">\n";
-		}
-		else
-			stream << "/>\n";
+		write (">\n");
+		++intendLevel;
+		if (!node->getData ().empty ())
+			writeNodeData (node->getData ());
+		for (auto& childNode : children)
+			writeNode (childNode);
 	}
-	return result;
+	writeEndTag (node->getName (), hasContent);
+}
+
+//-----------------------------------------------------------------------------
+size_t UIDescWriter::writeNode (const Snapshot& snapshot, size_t index)
+{
+	const auto& node = snapshot.nodes[index++];
+	if (node.comment)
+	{
+		writeComment ({snapshot, node.data});
+		return index;
+	}
+	writeStartTag ({snapshot, node.name});
+	sortAttributes (snapshot, node, sortedSnapshotAttributes);
+	for (auto attribute : sortedSnapshotAttributes)
+		writeAttribute ({snapshot, attribute->name}, {snapshot, attribute->value});
+	if (node.hasContent)
+	{
+		write (">\n");
+		++intendLevel;
+		if (node.data.size)
+			writeNodeData ({snapshot, node.data});
+		for (size_t child = 0; child < node.numChildren; ++child)
+			index = writeNode (snapshot, index);
+	}
+	writeEndTag ({snapshot, node.name}, node.hasContent);
+	return index;
 }
 /// @endcond
 
@@ -660,6 +1048,16 @@ static std::string removeScaleFactorFromName (const std::string& name)
 	return result;
 }
 
+//-----------------------------------------------------------------------------
+static UINode* createMainNode (const std::string& name, const SharedPointer<UIAttributes>& attributes = {})
+{
+	if (name == MainNodeNames::kBitmap)
+		return new UINode (name, makeOwned<UIBitmapDescList> (), attributes);
+	bool needsFastChildNameAttributeLookup = name == MainNodeNames::kControlTag || name == MainNodeNames::kColor
+											|| name == MainNodeNames::kFont || name == MainNodeNames::kGradient;
+	return new UINode (name, attributes, needsFastChildNameAttributeLookup);
+}
+
 //-----------------------------------------------------------------------------
 struct Parser : public Xml::IHandler
 {
@@ -675,6 +1073,8 @@ struct Parser : public Xml::IHandler
 private:
 	SharedPointer<UINode> nodes;
 	std::deque<UINode*> nodeStack;
+	UIBitmapDataNode* bitmapDataNode {nullptr};
+	Base64Codec::Decoder base64Decoder;
 	bool restoreViewsMode {false};
 };
 
@@ -708,11 +1108,11 @@ void Parser::startXmlElement (Xml::Parser* parser, IdStringPtr elementName, UTF8
 			if (parent == nodes)
 			{
 				// only allowed second level elements
-				if (name == MainNodeNames::kControlTag || name == MainNodeNames::kColor || name == MainNodeNames::kBitmap)
-					newNode = new UINode (name, makeOwned<UIAttributes> (elementAttributes), true);
-				else if (name == MainNodeNames::kFont || name == MainNodeNames::kTemplate
-					  || name == MainNodeNames::kControlTag || name == MainNodeNames::kCustom
-					  || name == MainNodeNames::kVariable || name == MainNodeNames::kGradient)
+				if (name == MainNodeNames::kControlTag || name == MainNodeNames::kColor || name == MainNodeNames::kBitmap
+				 || name == MainNodeNames::kFont || name == MainNodeNames::kGradient)
+					newNode = createMainNode (name, makeOwned<UIAttributes> (elementAttributes));
+				else if (name == MainNodeNames::kTemplate || name == MainNodeNames::kCustom
+					  || name == MainNodeNames::kVariable)
 					newNode = new UINode (name, makeOwned<UIAttributes> (elementAttributes));
 				else
 					parser->stop ();
@@ -759,6 +1159,15 @@ void Parser::startXmlElement (Xml::Parser* parser, IdStringPtr elementName, UTF8
 				else
 					parser->stop ();
 			}
+			else if (name == "data" && dynamic_cast<UIBitmapNode*> (parent))
+			{
+				auto attributes = makeOwned<UIAttributes> (elementAttributes);
+				const std::string* encoding = attributes->getAttributeValue ("encoding");
+				if (encoding && *encoding == "base64")
+					newNode = bitmapDataNode = new UIBitmapDataNode (name, attributes);
+				else
+					newNode = new UINode (name, attributes);
+			}
 			else
 				newNode = new UINode (name, makeOwned<UIAttributes> (elementAttributes));
 		}
@@ -787,6 +1196,11 @@ void Parser::endXmlElement (Xml::Parser* parser, IdStringPtr name)
 {
 	if (nodeStack.back () == nodes)
 		restoreViewsMode = false;
+	else if (nodeStack.back () == bitmapDataNode)
+	{
+		bitmapDataNode->setDecodedData (base64Decoder.finish ());
+		bitmapDataNode = nullptr;
+	}
 	nodeStack.pop_back ();
 }
 
@@ -795,6 +1209,14 @@ void Parser::xmlCharData (Xml::Parser* parser, const int8_t* data, int32_t lengt
 {
 	if (nodeStack.empty ())
 		return;
+	if (nodeStack.back () == bitmapDataNode)
+	{
+		// the decoder skips the white space itself
+		base64Decoder.write (data, static_cast<size_t> (length));
+#if !VSTGUI_LIVE_EDITING
+		return;
+#endif
+	}
 	auto& nodeData = nodeStack.back ()->getData ();
 	const int8_t* dataStart = nullptr;
 	uint32_t validChars = 0;
@@ -839,8 +1261,810 @@ void Parser::xmlComment (Xml::Parser* parser, IdStringPtr comment)
 			parent->getChildren ().add (commentNode);
 		}
 	}
-#endif
-}
+#endif
+}
+
+//-----------------------------------------------------------------------------
+static void createBitmapFilters (const IUIDescription* desc, UINode* bitmapNode, UIBitmapFilterList& filters)
+{
+	for (auto& childNode : bitmapNode->getChildren ())
+	{
+		const std::string* filterName = nullptr;
+		if (childNode->getName () == "filter" && (filterName = childNode->getAttributes ()->getAttributeValue ("name")))
+		{
+			auto filter = owned (BitmapFilter::Factory::getInstance().createFilter (filterName->c_str ()));
+			if (filter == nullptr)
+				continue;
+			filters.emplace_back (filter);
+			for (auto& propertyNode : childNode->getChildren ())
+			{
+				if (propertyNode->getName () != "property")
+					continue;
+				const std::string* propName = propertyNode->getAttributes ()->getAttributeValue ("name");
+				if (propName == nullptr)
+					continue;
+				switch (filter->getProperty (propName->c_str ()).getType ())
+				{
+					case BitmapFilter::Property::kInteger:
+					{
+						int32_t intValue;
+						if (propertyNode->getAttributes ()->getIntegerAttribute ("value", intValue))
+							filter->setProperty (propName->c_str (), intValue);
+						break;
+					}
+					case BitmapFilter::Property::kFloat:
+					{
+						double floatValue;
+						if (propertyNode->getAttributes ()->getDoubleAttribute ("value", floatValue))
+							filter->setProperty (propName->c_str (), floatValue);
+						break;
+					}
+					case BitmapFilter::Property::kPoint:
+					{
+						CPoint pointValue;
+						if (propertyNode->getAttributes ()->getPointAttribute ("value", pointValue))
+							filter->setProperty (propName->c_str (), pointValue);
+						break;
+					}
+					case BitmapFilter::Property::kRect:
+					{
+						CRect rectValue;
+						if (propertyNode->getAttributes ()->getRectAttribute ("value", rectValue))
+							filter->setProperty (propName->c_str (), rectValue);
+						break;
+					}
+					case BitmapFilter::Property::kColor:
+					{
+						const std::string* colorString = propertyNode->getAttributes()->getAttributeValue ("value");
+						if (colorString)
+						{
+							CColor color;
+							if (desc->getColor (colorString->c_str (), color))
+								filter->setProperty(propName->c_str (), color);
+						}
+						break;
+					}
+					case BitmapFilter::Property::kTransformMatrix:
+					{
+						// TODO
+						break;
+					}
+					case BitmapFilter::Property::kObject: // objects can not be stored/restored
+					case BitmapFilter::Property::kUnknown:
+						break;
+				}
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+static void runBitmapFilters (CBitmap* bitmap, const UIBitmapFilterList& filters)
+{
+	for (auto& filter : filters)
+	{
+		filter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
+		if (filter->run ())
+		{
+			auto obj = filter->getProperty (BitmapFilter::Standard::Property::kOutputBitmap).getObject ();
+			if (auto* outputBitmap = dynamic_cast<CBitmap*>(obj))
+			{
+				bitmap->setPlatformBitmap (outputBitmap->getPlatformBitmap ());
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+/** loads the bitmaps of a description on worker threads.
+ *
+ *	The jobs are prepared on the thread the description is used on and the workers only touch
+ *	the job data. A loaded bitmap is handed to its node when the description asks for it via
+ *	adopt (), which waits for this one bitmap only or loads it directly if no worker has picked
+ *	it up yet.
+ */
+class BitmapPreloader
+{
+public:
+	struct Job
+	{
+		SharedPointer<UIBitmapNode> node;
+		UIBitmapLoadJob load;
+		std::atomic<bool> claimed {false};
+		bool done {false};
+	};
+	using JobList = std::vector<std::unique_ptr<Job>>;
+
+	BitmapPreloader (JobList&& jobList, uint32_t maxThreads)
+	: jobs (std::move (jobList))
+	{
+		for (auto& job : jobs)
+			jobMap.emplace (job->node, job.get ());
+		if (maxThreads == 0)
+			maxThreads = std::max (1u, std::thread::hardware_concurrency ());
+		auto numWorkers = std::min<size_t> (maxThreads, jobs.size ());
+		try
+		{
+			for (auto i = 0u; i < numWorkers; ++i)
+				workers.emplace_back ([this] () { work (); });
+		}
+		catch (const std::system_error&)
+		{
+			// the remaining jobs are loaded by adopt ()
+		}
+	}
+
+	~BitmapPreloader () noexcept
+	{
+		cancelled = true;
+		for (auto& worker : workers)
+			worker.join ();
+	}
+
+	void adopt (UIBitmapNode* node)
+	{
+		auto it = jobMap.find (node);
+		if (it == jobMap.end ())
+			return;
+		auto job = it->second;
+		jobMap.erase (it);
+		if (job->claimed.exchange (true) == false)
+			job->load.run ();
+		else
+		{
+			std::unique_lock<std::mutex> lock (mutex);
+			jobDone.wait (lock, [&] () { return job->done; });
+		}
+		node->setLoadedBitmap (job->load);
+		job->load = {};
+		job->node = nullptr;
+	}
+
+	void finish ()
+	{
+		while (!jobMap.empty ())
+			adopt (jobMap.begin ()->first);
+	}
+
+private:
+	void work ()
+	{
+		// the workers already use the CPU cores, the filters must not start more threads
+		BitmapFilter::Kernels::WorkerThreadScope workerThreadScope;
+		while (!cancelled)
+		{
+			auto index = nextJob++;
+			if (index >= jobs.size ())
+				break;
+			auto& job = *jobs[index];
+			if (job.claimed.exchange (true))
+				continue;
+			job.load.run ();
+			{
+				std::lock_guard<std::mutex> guard (mutex);
+				job.done = true;
+			}
+			jobDone.notify_all ();
+		}
+	}
+
+	JobList jobs;
+	std::unordered_map<UIBitmapNode*, Job*> jobMap;
+	std::atomic<size_t> nextJob {0};
+	std::atomic<bool> cancelled {false};
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable jobDone;
+};
+
+//-----------------------------------------------------------------------------
+static std::string moveOldFile (UTF8StringPtr filename)
+{
+	FILE* file = fopen (filename, "r");
+	if (file)
+	{
+		fclose (file);
+		std::string newName = filename;
+		newName += ".old";
+		if (std::rename (filename, newName.c_str ()) == 0)
+			return newName;
+	}
+	return "";
+}
+
+//-----------------------------------------------------------------------------
+static std::string windowsRCFileName (const std::string& filename)
+{
+	size_t extPos = filename.find_last_of ('.');
+	if (extPos == std::string::npos)
+		return "";
+	return filename.substr (0, extPos + 1) + "rc";
+}
+
+//-----------------------------------------------------------------------------
+static std::string createWindowsRCFileContent (UINode* bitmapNodes)
+{
+	std::string content;
+	for (auto& childNode : bitmapNodes->getChildren ())
+	{
+		UIAttributes* attr = childNode->getAttributes ();
+		if (attr)
+		{
+			const std::string* path = attr->getAttributeValue ("path");
+			if (path && !path->empty ())
+			{
+				content += *path;
+				content += "\t PNG \"";
+				content += *path;
+				content += "\"\r";
+			}
+		}
+	}
+	return content;
+}
+
+//-----------------------------------------------------------------------------
+/** writes a snapshot of a description to a file on a worker thread.
+ *
+ *	The snapshot and the content of the resource file are created on the thread the description
+ *	is used on, so the worker does not touch the description. If no thread can be started the
+ *	files are written directly. The worker shares the task with the saver, so the job stays alive
+ *	if the worker can not be joined.
+ */
+class BackgroundSaver
+{
+public:
+	struct Job
+	{
+		std::string filename;
+		UIDescWriter::Snapshot snapshot;
+		std::string rcFileName;
+		std::string rcFileContent;
+	};
+
+	explicit BackgroundSaver (std::unique_ptr<Job>&& saveJob)
+	: task (std::make_shared<Task> ())
+	{
+		task->job = std::move (saveJob);
+		try
+		{
+			auto workerTask = task;
+			worker = std::thread ([workerTask] () { work (*workerTask); });
+		}
+		catch (const std::system_error&)
+		{
+			work (*task);
+		}
+	}
+
+	~BackgroundSaver () noexcept { finish (); }
+
+	bool finish () noexcept
+	{
+		if (worker.joinable ())
+		{
+			try
+			{
+				worker.join ();
+			}
+			catch (const std::system_error&)
+			{
+				worker.detach ();
+			}
+		}
+		return isDone () && task->result;
+	}
+
+	bool isDone () const { return task->done; }
+
+	/** waits for the save and returns the job, so its memory can be used for the next one */
+	std::unique_ptr<Job> takeJob ()
+	{
+		finish ();
+		if (!isDone ())
+			return nullptr;
+		return std::move (task->job);
+	}
+
+private:
+	struct Task
+	{
+		std::unique_ptr<Job> job;
+		bool result {false};
+		std::atomic<bool> done {false};
+	};
+
+	static void work (Task& task)
+	{
+		const Job& job = *task.job;
+		auto oldName = moveOldFile (job.filename.c_str ());
+		bool result = false;
+		{
+			CFileStream stream;
+			if (stream.open (job.filename.c_str (), CFileStream::kWriteMode|CFileStream::kTruncateMode))
+			{
+				UIDescWriter writer;
+				result = writer.write (stream, job.snapshot);
+			}
+		}
+		if (result && !job.rcFileName.empty ())
+		{
+			CFileStream stream;
+			if (stream.open (job.rcFileName.c_str (), CFileStream::kWriteMode|CFileStream::kTruncateMode))
+				stream << job.rcFileContent;
+		}
+		if (result && oldName.empty () == false)
+			std::remove (oldName.c_str ());
+		task.result = result;
+		task.done = true;
+	}
+
+	std::shared_ptr<Task> task;
+	std::thread worker;
+};
+
+//-----------------------------------------------------------------------------
+static bool attributesEqual (const UIAttributes& a1, const UIAttributes& a2)
+{
+	size_t numAttributes = 0;
+	for (const auto& attr : a1)
+	{
+		const std::string* value = a2.getAttributeValue (attr.first);
+		if (value == nullptr || *value != attr.second)
+			return false;
+		++numAttributes;
+	}
+	return numAttributes == static_cast<size_t> (std::distance (a2.begin (), a2.end ()));
+}
+
+//-----------------------------------------------------------------------------
+static bool nodesEqual (const UINode* n1, const UINode* n2)
+{
+	if (n1->getName () != n2->getName () || !n1->hasEqualData (n2))
+		return false;
+	if (!attributesEqual (*n1->getAttributes (), *n2->getAttributes ()))
+		return false;
+	const UIDescList& children1 = n1->getChildren ();
+	const UIDescList& children2 = n2->getChildren ();
+	if (children1.size () != children2.size ())
+		return false;
+	return std::equal (children1.begin (), children1.end (), children2.begin (), [] (const UINode* c1, const UINode* c2) {
+		return nodesEqual (c1, c2);
+	});
+}
+
+//-----------------------------------------------------------------------------
+static bool valuesEqual (const UIAttributes& a1, const UIAttributes& a2, const std::string& name)
+{
+	const std::string* value1 = a1.getAttributeValue (name);
+	const std::string* value2 = a2.getAttributeValue (name);
+	if (value1 && value2)
+		return *value1 == *value2;
+	return value1 == value2;
+}
+
+//-----------------------------------------------------------------------------
+using NodeVector = std::vector<SharedPointer<UINode>>;
+
+//-----------------------------------------------------------------------------
+static void replaceChildren (UINode* node, const NodeVector& newChildren)
+{
+	UIDescList& children = node->getChildren ();
+	if (children.size () == newChildren.size () && std::equal (children.begin (), children.end (), newChildren.begin (), [] (const UINode* n1, const SharedPointer<UINode>& n2) {
+		return n1 == n2.get ();
+	}))
+		return;
+	children.removeAll ();
+	for (auto& child : newChildren)
+	{
+		child->remember ();
+		children.add (child);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/** what a reload changed, collected while the new node tree is merged into the live one */
+struct ReloadChanges
+{
+	using NameSet = std::unordered_set<std::string>;
+
+	struct Template
+	{
+		SharedPointer<UINode> oldNode;
+		SharedPointer<UINode> newNode;
+	};
+	using TemplateMap = std::unordered_map<std::string, Template>;
+
+	NameSet colors;
+	NameSet fonts;
+	NameSet bitmaps;
+	NameSet gradients;
+	NameSet tags;
+	TemplateMap templates;
+	bool variables {false};
+
+	NameSet* getResourceNames (const std::string& mainNodeName)
+	{
+		if (mainNodeName == MainNodeNames::kColor)
+			return &colors;
+		if (mainNodeName == MainNodeNames::kFont)
+			return &fonts;
+		if (mainNodeName == MainNodeNames::kBitmap)
+			return &bitmaps;
+		if (mainNodeName == MainNodeNames::kGradient)
+			return &gradients;
+		if (mainNodeName == MainNodeNames::kControlTag)
+			return &tags;
+		return nullptr;
+	}
+
+	bool empty () const
+	{
+		return colors.empty () && fonts.empty () && bitmaps.empty () && gradients.empty () &&
+		       tags.empty () && templates.empty () && !variables;
+	}
+};
+
+//-----------------------------------------------------------------------------
+/** merges the children of a resource node like colors or bitmaps by their name. Children which
+ *	did not change keep the live node and with it the platform resource it already created. */
+static void mergeResourceNode (UINode* liveNode, const UINode* newNode, ReloadChanges::NameSet& changedNames)
+{
+	UIDescList& liveChildren = liveNode->getChildren ();
+	NodeVector merged;
+	merged.reserve (liveChildren.size () + (newNode ? newNode->getChildren ().size () : 0));
+	if (newNode)
+	{
+		for (auto& child : newNode->getChildren ())
+		{
+			const std::string* name = child->getAttributes ()->getAttributeValue ("name");
+			UINode* liveChild = name ? liveChildren.findChildNodeWithAttributeValue ("name", *name) : nullptr;
+			if (liveChild && !liveChild->noExport () && nodesEqual (liveChild, child))
+			{
+				merged.emplace_back (liveChild);
+				continue;
+			}
+			if (name)
+				changedNames.emplace (*name);
+			merged.emplace_back (child);
+		}
+	}
+	for (auto& child : liveChildren)
+	{
+		if (child->noExport ())
+		{
+			merged.emplace_back (child);
+			continue;
+		}
+		const std::string* name = child->getAttributes ()->getAttributeValue ("name");
+		if (name && (newNode == nullptr || newNode->getChildren ().findChildNodeWithAttributeValue ("name", *name) == nullptr))
+			changedNames.emplace (*name);
+	}
+	if (newNode && liveNode->getName () == MainNodeNames::kBitmap)
+	{
+		// the scale variants are added to the bitmap of the base name when it is loaded, so the
+		// base bitmap has to be loaded again if one of its variants changed
+		std::vector<std::string> baseNames;
+		for (auto& name : changedNames)
+		{
+			std::string baseName = removeScaleFactorFromName (name);
+			if (!baseName.empty () && changedNames.find (baseName) == changedNames.end ())
+				baseNames.emplace_back (std::move (baseName));
+		}
+		for (auto& baseName : baseNames)
+		{
+			UINode* baseNode = newNode->getChildren ().findChildNodeWithAttributeValue ("name", baseName);
+			if (baseNode == nullptr)
+				continue;
+			for (auto& node : merged)
+			{
+				if (!node->noExport () && valuesEqual (*node->getAttributes (), *baseNode->getAttributes (), "name"))
+					node = baseNode;
+			}
+			changedNames.emplace (baseName);
+		}
+	}
+	replaceChildren (liveNode, merged);
+}
+
+//-----------------------------------------------------------------------------
+/** merges a newly parsed node tree into the live one. Templates are matched by their name,
+ *	resources by the names of their children, everything else by the node name. Nodes which did
+ *	not change are kept, the order of the nodes is the one of the new tree. */
+static void mergeNodes (UINode* liveRoot, const UINode* newRoot, ReloadChanges& changes)
+{
+	UIDescList& liveChildren = liveRoot->getChildren ();
+	const UIDescList& newChildren = newRoot->getChildren ();
+	std::unordered_map<std::string, UINode*> liveTemplates;
+	for (auto& child : liveChildren)
+	{
+		if (child->getName () != MainNodeNames::kTemplate)
+			continue;
+		if (const std::string* name = child->getAttributes ()->getAttributeValue ("name"))
+			liveTemplates.emplace (*name, child);
+	}
+	NodeVector merged;
+	merged.reserve (newChildren.size ());
+	for (auto& child : newChildren)
+	{
+		const std::string& nodeName = child->getName ();
+		if (nodeName == MainNodeNames::kTemplate)
+		{
+			const std::string* name = child->getAttributes ()->getAttributeValue ("name");
+			if (name)
+			{
+				auto it = liveTemplates.find (*name);
+				UINode* liveChild = it != liveTemplates.end () ? it->second : nullptr;
+				if (liveChild)
+					liveTemplates.erase (it);
+				if (liveChild && nodesEqual (liveChild, child))
+				{
+					merged.emplace_back (liveChild);
+					continue;
+				}
+				changes.templates[*name] = {liveChild, child};
+			}
+			merged.emplace_back (child);
+		}
+		else if (ReloadChanges::NameSet* changedNames = changes.getResourceNames (nodeName))
+		{
+			if (UINode* liveChild = liveChildren.findChildNode (nodeName))
+			{
+				mergeResourceNode (liveChild, child, *changedNames);
+				merged.emplace_back (liveChild);
+				continue;
+			}
+			for (auto& resourceNode : child->getChildren ())
+			{
+				if (const std::string* name = resourceNode->getAttributes ()->getAttributeValue ("name"))
+					changedNames->emplace (*name);
+			}
+			merged.emplace_back (child);
+		}
+		else
+		{
+			UINode* liveChild = liveChildren.findChildNode (nodeName);
+			if (liveChild && nodesEqual (liveChild, child))
+			{
+				merged.emplace_back (liveChild);
+				continue;
+			}
+			if (nodeName == MainNodeNames::kVariable)
+				changes.variables = true;
+			merged.emplace_back (child);
+		}
+	}
+	for (auto& it : liveTemplates)
+		changes.templates[it.first] = {it.second, nullptr};
+	for (auto& child : liveChildren)
+	{
+		const std::string& nodeName = child->getName ();
+		if (newChildren.findChildNode (nodeName))
+			continue;
+		if (ReloadChanges::NameSet* changedNames = changes.getResourceNames (nodeName))
+		{
+			// keeps the default colors and fonts
+			mergeResourceNode (child, nullptr, *changedNames);
+			merged.emplace_back (child);
+		}
+		else if (nodeName == MainNodeNames::kVariable)
+			changes.variables = true;
+	}
+	replaceChildren (liveRoot, merged);
+}
+
+//-----------------------------------------------------------------------------
+/** the evaluated attributes of the template nodes are kept until they change, so they are
+ *	dropped when the variables they were evaluated with changed */
+static void clearEvaluatedAttributes (const UINode* node)
+{
+	node->getAttributes ()->clearEvaluatedAttributes ();
+	for (auto& child : node->getChildren ())
+		clearEvaluatedAttributes (child);
+}
+
+//-----------------------------------------------------------------------------
+/** updates the views created from a description after a reload.
+ *
+ *	The nodes of a template are walked in parallel to the views created from them. Attributes
+ *	which changed or which reference a changed resource are applied to the existing views. If the
+ *	structure of a template changed, its views are created again and replace the old ones in their
+ *	parent container. They are created with the controller which created the old ones, which is
+ *	the sub-controller of the nearest parent view created with one. The views passed to update ()
+ *	are owned by the caller and are never replaced.
+ */
+class ReloadViewUpdater
+{
+public:
+	ReloadViewUpdater (const UIDescription* desc, const UINode* rootNode, const ReloadChanges& changes)
+	: desc (desc)
+	, factory (desc->getViewFactory ())
+	, changes (changes)
+	{
+		for (auto& child : rootNode->getChildren ())
+		{
+			if (child->getName () != MainNodeNames::kTemplate)
+				continue;
+			if (const std::string* name = child->getAttributes ()->getAttributeValue ("name"))
+				templates.emplace (*name, child);
+		}
+		for (auto names : {&changes.colors, &changes.fonts, &changes.bitmaps, &changes.gradients, &changes.tags})
+			resourceNames.insert (names->begin (), names->end ());
+	}
+
+	/** controller is the one view was created with */
+	void update (CView* view, IController* controller)
+	{
+		CView* parent = view->getParentView ();
+		root = view;
+		update (view, parent ? parent->asViewContainer () : nullptr, controller);
+		root = nullptr;
+	}
+
+private:
+	/** views are only connected to their parent when they are attached, so the parent container
+	 *	and the controller are passed along while walking the views */
+	void update (CView* view, CViewContainer* parent, IController* controller)
+	{
+		std::string templateName;
+		if (desc->getTemplateNameFromView (view, templateName))
+		{
+			updateTemplateView (view, parent, templateName, nullptr, controller);
+		}
+		else if (CViewContainer* container = view->asViewContainer ())
+		{
+			IController* childController = getChildController (view, controller);
+			std::vector<CView*> children;
+			children.reserve (container->getNbViews ());
+			container->forEachChild ([&] (CView* child) { children.emplace_back (child); });
+			for (auto& child : children)
+				update (child, container, childController);
+		}
+	}
+
+	/** the children of a view created with a sub-controller were created with the sub-controller */
+	static IController* getChildController (CView* view, IController* controller)
+	{
+		IController* subController = nullptr;
+		if (view->getAttribute (kCViewControllerAttribute, subController) && subController)
+			return subController;
+		return controller;
+	}
+
+	void updateTemplateView (CView* view, CViewContainer* parent, const std::string& templateName, const UIAttributes* instanceAttributes, IController* controller)
+	{
+		auto changed = changes.templates.find (templateName);
+		if (changed == changes.templates.end ())
+		{
+			auto it = templates.find (templateName);
+			if (it != templates.end ())
+				updateView (view, parent, it->second, it->second, instanceAttributes, controller);
+			return;
+		}
+		if (changed->second.oldNode == nullptr || changed->second.newNode == nullptr)
+			return;
+		if (!updateView (view, parent, changed->second.oldNode, changed->second.newNode, instanceAttributes, controller))
+			replaceView (view, parent, templateName, instanceAttributes, controller);
+	}
+
+	/** returns false if the view has to be created again */
+	bool updateView (CView* view, CViewContainer* parent, const UINode* oldNode, const UINode* newNode, const UIAttributes* instanceAttributes, IController* controller)
+	{
+		const UIAttributes& oldAttributes = *oldNode->getAttributes ();
+		const UIAttributes& newAttributes = *newNode->getAttributes ();
+		if (oldNode != newNode)
+		{
+			static const std::string structuralAttributes[] = {UIViewCreator::kAttrClass, UIViewCreator::kAttrSubController, IUIDescription::kCustomViewName, MainNodeNames::kTemplate};
+			for (auto& name : structuralAttributes)
+			{
+				if (!valuesEqual (oldAttributes, newAttributes, name))
+					return false;
+			}
+			// an attribute which was removed can not be reset on the view
+			for (auto& attr : oldAttributes)
+			{
+				if (!newAttributes.hasAttribute (attr.first))
+					return false;
+			}
+		}
+		if (oldNode != newNode || changes.variables || !resourceNames.empty ())
+		{
+			UIAttributes changedAttributes;
+			bool hasChangedAttributes = false;
+			for (auto& attr : newAttributes)
+			{
+				if (instanceAttributes && instanceAttributes->hasAttribute (attr.first))
+					continue;
+				if (changes.variables || resourceNames.find (attr.second) != resourceNames.end () || !valuesEqual (oldAttributes, newAttributes, attr.first))
+				{
+					changedAttributes.setAttribute (attr.first, attr.second);
+					hasChangedAttributes = true;
+				}
+			}
+			if (hasChangedAttributes)
+			{
+				factory->applyAttributeValues (view, changedAttributes, desc);
+				view->invalid ();
+			}
+		}
+		if (const std::string* templateName = newAttributes.getAttributeValue (MainNodeNames::kTemplate))
+		{
+			updateTemplateView (view, parent, *templateName, &newAttributes, controller);
+			return true;
+		}
+		return updateChildren (view, oldNode, newNode, getChildController (view, controller));
+	}
+
+	bool updateChildren (CView* view, const UINode* oldNode, const UINode* newNode, IController* controller)
+	{
+		const UIDescList& oldChildren = oldNode->getChildren ();
+		const UIDescList& newChildren = newNode->getChildren ();
+		if (oldNode != newNode)
+		{
+			if (!childrenEqual (oldChildren, newChildren, "attribute"))
+				return false;
+		}
+		auto isView = [] (const UINode* node) { return node->getName () == "view"; };
+		auto numViews = std::count_if (newChildren.begin (), newChildren.end (), isView);
+		if (numViews != std::count_if (oldChildren.begin (), oldChildren.end (), isView))
+			return false;
+		if (numViews == 0)
+			return true;
+		// views added or removed by a controller can not be matched to the nodes
+		CViewContainer* container = view->asViewContainer ();
+		if (container == nullptr || container->getNbViews () != static_cast<uint32_t> (numViews))
+			return oldNode == newNode || childrenEqual (oldChildren, newChildren, "view");
+
+		std::vector<CView*> children;
+		children.reserve (numViews);
+		container->forEachChild ([&] (CView* child) { children.emplace_back (child); });
+		auto oldChild = std::find_if (oldChildren.begin (), oldChildren.end (), isView);
+		auto newChild = std::find_if (newChildren.begin (), newChildren.end (), isView);
+		for (auto& child : children)
+		{
+			if (!updateView (child, container, *oldChild, *newChild, nullptr, controller))
+				return false;
+			oldChild = std::find_if (++oldChild, oldChildren.end (), isView);
+			newChild = std::find_if (++newChild, newChildren.end (), isView);
+		}
+		return true;
+	}
+
+	static bool childrenEqual (const UIDescList& children1, const UIDescList& children2, const std::string& nodeName)
+	{
+		auto hasName = [&] (const UINode* node) { return node->getName () == nodeName; };
+		auto it1 = std::find_if (children1.begin (), children1.end (), hasName);
+		auto it2 = std::find_if (children2.begin (), children2.end (), hasName);
+		while (it1 != children1.end () && it2 != children2.end ())
+		{
+			if (!nodesEqual (*it1, *it2))
+				return false;
+			it1 = std::find_if (++it1, children1.end (), hasName);
+			it2 = std::find_if (++it2, children2.end (), hasName);
+		}
+		return it1 == children1.end () && it2 == children2.end ();
+	}
+
+	void replaceView (CView* view, CViewContainer* parent, const std::string& templateName, const UIAttributes* instanceAttributes, IController* controller)
+	{
+		if (parent == nullptr || view == root)
+			return;
+		CView* newView = desc->createView (templateName.c_str (), controller);
+		if (newView == nullptr)
+			return;
+		if (instanceAttributes)
+			factory->applyAttributeValues (newView, *instanceAttributes, desc);
+		parent->addView (newView, view);
+		parent->removeView (view);
+	}
+
+	const UIDescription* desc;
+	const IViewFactory* factory;
+	const ReloadChanges& changes;
+	CView* root {nullptr};
+	std::unordered_map<std::string, const UINode*> templates;
+	ReloadChanges::NameSet resourceNames;
+};
 
 //-----------------------------------------------------------------------------
 } // UIDescriptionPrivate
@@ -865,6 +2089,68 @@ struct UIDescription::Impl : ListenerProvider<Impl, UIDescriptionListener>
 	
 	Optional<UINode*> variableBaseNode;
 
+	bool preloadBitmaps {false};
+	uint32_t preloadBitmapThreads {0};
+	std::unique_ptr<UIDescriptionPrivate::BitmapPreloader> bitmapPreloader;
+	std::unique_ptr<UIDescriptionPrivate::BackgroundSaver> backgroundSaver;
+
+	void startBitmapPreload (const UIDescription* desc)
+	{
+		if (!preloadBitmaps || !nodes || bitmapPreloader)
+			return;
+		auto bitmapsNode = nodes->getChildren ().findChildNode (MainNodeNames::kBitmap);
+		if (bitmapsNode == nullptr)
+			return;
+		UIDescriptionPrivate::BitmapPreloader::JobList jobs;
+		for (auto& childNode : bitmapsNode->getChildren ())
+		{
+			auto bitmapNode = dynamic_cast<UIBitmapNode*> (childNode);
+			if (bitmapNode == nullptr)
+				continue;
+			auto job = std::unique_ptr<UIDescriptionPrivate::BitmapPreloader::Job> (new UIDescriptionPrivate::BitmapPreloader::Job);
+			if (!bitmapNode->createLoadJob (filePath, job->load))
+				continue;
+			if (!bitmapNode->getFilterProcessed ())
+				UIDescriptionPrivate::createBitmapFilters (desc, bitmapNode, job->load.filters);
+			job->node = bitmapNode;
+			jobs.emplace_back (std::move (job));
+		}
+		if (!jobs.empty ())
+			bitmapPreloader = std::unique_ptr<UIDescriptionPrivate::BitmapPreloader> (new UIDescriptionPrivate::BitmapPreloader (std::move (jobs), preloadBitmapThreads));
+	}
+
+	void finishBitmapPreload ()
+	{
+		if (bitmapPreloader)
+		{
+			bitmapPreloader->finish ();
+			bitmapPreloader = nullptr;
+		}
+	}
+
+	SharedPointer<UINode> parseNodes ()
+	{
+		UIDescriptionPrivate::Parser parser;
+		if (xmlContentProvider)
+			return parser.parse (xmlContentProvider);
+		CResourceInputStream resInputStream;
+		if (resInputStream.open (xmlFile))
+		{
+			Xml::InputStreamContentProvider contentProvider (resInputStream);
+			return parser.parse (&contentProvider);
+		}
+		if (xmlFile.type == CResourceDescription::kStringType)
+		{
+			CFileStream fileStream;
+			if (fileStream.open (xmlFile.u.name, CFileStream::kReadMode))
+			{
+				Xml::InputStreamContentProvider contentProvider (fileStream);
+				return parser.parse (&contentProvider);
+			}
+		}
+		return nullptr;
+	}
+
 	UINode* getVariableBaseNode ()
 	{
 		if (!variableBaseNode)
@@ -1013,47 +2299,75 @@ bool UIDescription::parse ()
 {
 	if (parsed ())
 		return true;
-	UIDescriptionPrivate::Parser parser;
-	if (impl->xmlContentProvider)
+	if ((impl->nodes = impl->parseNodes ()))
 	{
-		if ((impl->nodes = parser.parse (impl->xmlContentProvider)))
-		{
-			addDefaultNodes ();
-			return true;
-		}
+		addDefaultNodes ();
+		impl->startBitmapPreload (this);
+		return true;
+	}
+	impl->nodes = makeOwned<UINode> ("vstgui-ui-description");
+	addDefaultNodes ();
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::reload (const std::list<CView*>& views, IController* controller, Xml::IContentProvider* xmlContentProvider)
+{
+	if (!parsed ())
+		return false;
+	SharedPointer<UINode> newNodes;
+	if (xmlContentProvider)
+	{
+		UIDescriptionPrivate::Parser parser;
+		newNodes = parser.parse (xmlContentProvider);
 	}
 	else
+		newNodes = impl->parseNodes ();
+	if (!newNodes)
+		return false;
+
+	// the preloader works on the bitmap nodes which may be removed now
+	impl->finishBitmapPreload ();
+	UIDescriptionPrivate::ReloadChanges changes;
+	UIDescriptionPrivate::mergeNodes (impl->nodes, newNodes, changes);
+	if (changes.empty ())
+		return true;
+	impl->variableBaseNode.reset ();
+	if (changes.variables)
 	{
-		CResourceInputStream resInputStream;
-		if (resInputStream.open (impl->xmlFile))
-		{
-			Xml::InputStreamContentProvider contentProvider (resInputStream);
-			if ((impl->nodes = parser.parse (&contentProvider)))
-			{
-				addDefaultNodes ();
-				return true;
-			}
-		}
-		else if (impl->xmlFile.type == CResourceDescription::kStringType)
+		UIDescriptionPrivate::clearEvaluatedAttributes (impl->nodes);
+		// tags may be calculated from variables
+		if (UINode* tagsNode = impl->nodes->getChildren ().findChildNode (MainNodeNames::kControlTag))
 		{
-			CFileStream fileStream;
-			if (fileStream.open (impl->xmlFile.u.name, CFileStream::kReadMode))
+			for (auto& childNode : tagsNode->getChildren ())
 			{
-				Xml::InputStreamContentProvider contentProvider (fileStream);
-				if ((impl->nodes = parser.parse (&contentProvider)))
-				{
-					addDefaultNodes ();
-					return true;
-				}
+				if (auto* tagNode = dynamic_cast<UIControlTagNode*> (childNode))
+					tagNode->setTag (-1);
 			}
 		}
 	}
-	if (!impl->nodes)
+	if (!views.empty ())
 	{
-		impl->nodes = makeOwned<UINode> ("vstgui-ui-description");
-		addDefaultNodes ();
+		UIDescriptionPrivate::ReloadViewUpdater updater (this, impl->nodes, changes);
+		for (auto& view : views)
+			updater.update (view, controller);
 	}
-	return false;
+	impl->forEachListener ([&] (UIDescriptionListener* l) {
+		if (!changes.colors.empty ())
+			l->onUIDescColorChanged (this);
+		if (!changes.fonts.empty ())
+			l->onUIDescFontChanged (this);
+		if (!changes.bitmaps.empty ())
+			l->onUIDescBitmapChanged (this);
+		if (!changes.gradients.empty ())
+			l->onUIDescGradientChanged (this);
+		if (!changes.tags.empty () || changes.variables)
+			l->onUIDescTagChanged (this);
+		if (!changes.templates.empty ())
+			l->onUIDescTemplateChanged (this);
+	});
+	impl->startBitmapPreload (this);
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -1092,6 +2406,15 @@ void UIDescription::setBitmapCreator (IBitmapCreator* creator)
 	impl->bitmapCreator = creator;
 }
 
+//-----------------------------------------------------------------------------
+void UIDescription::setPreloadBitmaps (bool state, uint32_t maxThreads)
+{
+	impl->preloadBitmaps = state;
+	impl->preloadBitmapThreads = maxThreads;
+	if (!state)
+		impl->finishBitmapPreload ();
+}
+
 //-----------------------------------------------------------------------------
 static void FreeNodePlatformResources (UINode* node)
 {
@@ -1105,6 +2428,7 @@ static void FreeNodePlatformResources (UINode* node)
 //-----------------------------------------------------------------------------
 void UIDescription::freePlatformResources ()
 {
+	impl->finishBitmapPreload ();
 	if (impl->nodes)
 		FreeNodePlatformResources (impl->nodes);
 }
@@ -1121,46 +2445,18 @@ bool UIDescription::saveWindowsRCFile (UTF8StringPtr filename)
 		CFileStream stream;
 		if (stream.open (filename, CFileStream::kWriteMode|CFileStream::kTruncateMode))
 		{
-			for (auto& childNode : bitmapNodes->getChildren ())
-			{
-				UIAttributes* attr = childNode->getAttributes ();
-				if (attr)
-				{
-					const std::string* path = attr->getAttributeValue ("path");
-					if (path && !path->empty ())
-					{
-						stream << *path;
-						stream << "\t PNG \"";
-						stream << *path;
-						stream << "\"\r";
-					}
-				}
-			}
+			stream << UIDescriptionPrivate::createWindowsRCFileContent (bitmapNodes);
 			result = true;
 		}
 	}
 	return result;
 }
 
-//-----------------------------------------------------------------------------
-static std::string moveOldFile (UTF8StringPtr filename)
-{
-	FILE* file = fopen (filename, "r");
-	if (file)
-	{
-		fclose (file);
-		std::string newName = filename;
-		newName += ".old";
-		if (std::rename (filename, newName.c_str ()) == 0)
-			return newName;
-	}
-	return "";
-}
-
 //-----------------------------------------------------------------------------
 bool UIDescription::save (UTF8StringPtr filename, int32_t flags)
 {
-	std::string oldName = moveOldFile (filename);
+	finishBackgroundSave ();
+	std::string oldName = UIDescriptionPrivate::moveOldFile (filename);
 	bool result = false;
 	CFileStream stream;
 	if (stream.open (filename, CFileStream::kWriteMode|CFileStream::kTruncateMode))
@@ -1169,14 +2465,9 @@ bool UIDescription::save (UTF8StringPtr filename, int32_t flags)
 	}
 	if (result && flags & kWriteWindowsResourceFile)
 	{
-		std::string rcFileName (filename);
-		size_t extPos = rcFileName.find_last_of ('.');
-		if (extPos != std::string::npos)
-		{
-			rcFileName.erase (extPos+1);
-			rcFileName += "rc";
+		std::string rcFileName = UIDescriptionPrivate::windowsRCFileName (filename);
+		if (!rcFileName.empty ())
 			saveWindowsRCFile (rcFileName.c_str ());
-		}
 	}
 	if (result && oldName.empty () == false)
 		std::remove (oldName.c_str ());
@@ -1185,8 +2476,56 @@ bool UIDescription::save (UTF8StringPtr filename, int32_t flags)
 }
 
 //-----------------------------------------------------------------------------
-bool UIDescription::saveToStream (OutputStream& stream, int32_t flags)
+bool UIDescription::saveInBackground (UTF8StringPtr filename, int32_t flags)
+{
+	using BackgroundSaver = UIDescriptionPrivate::BackgroundSaver;
+	std::unique_ptr<BackgroundSaver::Job> job;
+	if (impl->backgroundSaver)
+	{
+		job = impl->backgroundSaver->takeJob ();
+		impl->backgroundSaver = nullptr;
+	}
+	if (!impl->nodes)
+		return false;
+	prepareSave (flags);
+
+	if (!job)
+		job = std::unique_ptr<BackgroundSaver::Job> (new BackgroundSaver::Job);
+	job->filename = filename;
+	job->rcFileName.clear ();
+	job->rcFileContent.clear ();
+	UIDescWriter::createSnapshot (impl->nodes, job->snapshot);
+	if (flags & kWriteWindowsResourceFile && !impl->sharedResources)
+	{
+		UINode* bitmapNodes = getBaseNode (MainNodeNames::kBitmap);
+		if (bitmapNodes && !bitmapNodes->getChildren ().empty ())
+		{
+			job->rcFileName = UIDescriptionPrivate::windowsRCFileName (filename);
+			job->rcFileContent = UIDescriptionPrivate::createWindowsRCFileContent (bitmapNodes);
+		}
+	}
+	impl->backgroundSaver = std::unique_ptr<BackgroundSaver> (new BackgroundSaver (std::move (job)));
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::finishBackgroundSave ()
+{
+	if (impl->backgroundSaver)
+		return impl->backgroundSaver->finish ();
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::isBackgroundSaveRunning () const
+{
+	return impl->backgroundSaver && !impl->backgroundSaver->isDone ();
+}
+
+//-----------------------------------------------------------------------------
+void UIDescription::prepareSave (int32_t flags)
 {
+	impl->finishBitmapPreload ();
 	impl->forEachListener ([this] (UIDescriptionListener* l) {
 		l->beforeUIDescSave (this);
 	});
@@ -1203,6 +2542,7 @@ bool UIDescription::saveToStream (OutputStream& stream, int32_t flags)
 					{
 						if (!(flags & kDoNotVerifyImageXMLData) || !bitmapNode->hasXMLData ())
 							bitmapNode->createXMLData (impl->filePath);
+						bitmapNode->encodeXMLData ();
 					}
 					else
 						bitmapNode->removeXMLData ();
@@ -1211,10 +2551,14 @@ bool UIDescription::saveToStream (OutputStream& stream, int32_t flags)
 		}
 	}
 	impl->nodes->getAttributes ()->setAttribute ("version", "1");
-	
-	BufferedOutputStream bufferedStream (stream);
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::saveToStream (OutputStream& stream, int32_t flags)
+{
+	prepareSave (flags);
 	UIDescWriter writer;
-	return writer.write (bufferedStream, impl->nodes);
+	return writer.write (stream, impl->nodes);
 }
 
 //-----------------------------------------------------------------------------
@@ -1555,7 +2899,7 @@ UINode* UIDescription::getBaseNode (UTF8StringPtr name) const
 		if (node)
 			return node;
 
-		node = new UINode (name);
+		node = UIDescriptionPrivate::createMainNode (name);
 		impl->nodes->getChildren ().add (node);
 		return node;
 	}
@@ -1645,6 +2989,8 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 	auto* bitmapNode = dynamic_cast<UIBitmapNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kBitmap), name));
 	if (bitmapNode)
 	{
+		if (impl->bitmapPreloader)
+			impl->bitmapPreloader->adopt (bitmapNode);
 		CBitmap* bitmap = bitmapNode->getBitmap (impl->filePath);
 		if (impl->bitmapCreator && bitmap && bitmap->getPlatformBitmap () == nullptr)
 		{
@@ -1659,88 +3005,9 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 		}
 		if (bitmap && bitmapNode->getFilterProcessed () == false)
 		{
-			std::list<SharedPointer<BitmapFilter::IFilter> > filters;
-			for (auto& childNode : bitmapNode->getChildren ())
-			{
-				const std::string* filterName = nullptr;
-				if (childNode->getName () == "filter" && (filterName = childNode->getAttributes ()->getAttributeValue ("name")))
-				{
-					auto filter = owned (BitmapFilter::Factory::getInstance().createFilter (filterName->c_str ()));
-					if (filter == nullptr)
-						continue;
-					filters.emplace_back (filter);
-					for (auto& propertyNode : childNode->getChildren ())
-					{
-						if (propertyNode->getName () != "property")
-							continue;
-						const std::string* propName = propertyNode->getAttributes ()->getAttributeValue ("name");
-						if (propName == nullptr)
-							continue;
-						switch (filter->getProperty (propName->c_str ()).getType ())
-						{
-							case BitmapFilter::Property::kInteger:
-							{
-								int32_t intValue;
-								if (propertyNode->getAttributes ()->getIntegerAttribute ("value", intValue))
-									filter->setProperty (propName->c_str (), intValue);
-								break;
-							}
-							case BitmapFilter::Property::kFloat:
-							{
-								double floatValue;
-								if (propertyNode->getAttributes ()->getDoubleAttribute ("value", floatValue))
-									filter->setProperty (propName->c_str (), floatValue);
-								break;
-							}
-							case BitmapFilter::Property::kPoint:
-							{
-								CPoint pointValue;
-								if (propertyNode->getAttributes ()->getPointAttribute ("value", pointValue))
-									filter->setProperty (propName->c_str (), pointValue);
-								break;
-							}
-							case BitmapFilter::Property::kRect:
-							{
-								CRect rectValue;
-								if (propertyNode->getAttributes ()->getRectAttribute ("value", rectValue))
-									filter->setProperty (propName->c_str (), rectValue);
-								break;
-							}
-							case BitmapFilter::Property::kColor:
-							{
-								const std::string* colorString = propertyNode->getAttributes()->getAttributeValue ("value");
-								if (colorString)
-								{
-									CColor color;
-									if (getColor (colorString->c_str (), color))
-										filter->setProperty(propName->c_str (), color);
-								}
-								break;
-							}
-							case BitmapFilter::Property::kTransformMatrix:
-							{
-								// TODO
-								break;
-							}
-							case BitmapFilter::Property::kObject: // objects can not be stored/restored
-							case BitmapFilter::Property::kUnknown:
-								break;
-						}
-					}
-				}
-			}
-			for (auto& filter : filters)
-			{
-				filter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
-				if (filter->run ())
-				{
-					auto obj = filter->getProperty (BitmapFilter::Standard::Property::kOutputBitmap).getObject ();
-					if (auto* outputBitmap = dynamic_cast<CBitmap*>(obj))
-					{
-						bitmap->setPlatformBitmap (outputBitmap->getPlatformBitmap ());
-					}
-				}
-			}
+			UIBitmapFilterList filters;
+			UIDescriptionPrivate::createBitmapFilters (this, bitmapNode, filters);
+			UIDescriptionPrivate::runBitmapFilters (bitmap, filters);
 			bitmapNode->setFilterProcessed ();
 		}
 		if (bitmap && bitmapNode->getScaledBitmapsAdded () == false)
@@ -1750,17 +3017,18 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 			{
 				// find scaled versions for this bitmap
 				UINode* bitmapsNode = getBaseNode (MainNodeNames::kBitmap);
-				for (auto& it : bitmapsNode->getChildren ())
+				auto* bitmapList = dynamic_cast<UIBitmapDescList*> (&bitmapsNode->getChildren ());
+				auto* variants = bitmapList ? bitmapList->findScaleVariants (name) : nullptr;
+				if (variants)
 				{
-					auto* childNode = dynamic_cast<UIBitmapNode*>(it);
-					if (childNode == nullptr || childNode == bitmapNode)
-						continue;
-					const std::string* childNodeBitmapName = childNode->getAttributes()->getAttributeValue ("name");
-					if (childNodeBitmapName == nullptr)
-						continue;
-					std::string nameWithoutScaleFactor = UIDescriptionPrivate::removeScaleFactorFromName (*childNodeBitmapName);
-					if (nameWithoutScaleFactor == name)
+					for (auto& it : *variants)
 					{
+						auto* childNode = dynamic_cast<UIBitmapNode*>(it);
+						if (childNode == nullptr || childNode == bitmapNode)
+							continue;
+						const std::string* childNodeBitmapName = childNode->getAttributes()->getAttributeValue ("name");
+						if (childNodeBitmapName == nullptr)
+							continue;
 						childNode->setScaledBitmapsAdded ();
 						CBitmap* childBitmap = getBitmap (childNodeBitmapName->c_str ());
 						if (childBitmap && childBitmap->getPlatformBitmap ())
@@ -1846,6 +3114,7 @@ UTF8StringPtr UIDescription::lookupFontName (const CFontRef font) const
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupBitmapName (const CBitmap* bitmap) const
 {
+	impl->finishBitmapPreload ();
 	return bitmap ? lookupName<UIBitmapNode> (bitmap, MainNodeNames::kBitmap, [] (const UIDescription* desc, UIBitmapNode* node, const CBitmap* bitmap) {
 		return node->getBitmap (desc->impl->filePath) == bitmap;
 	}) : nullptr;
@@ -2034,6 +3303,7 @@ void UIDescription::changeGradient (UTF8StringPtr name, CGradient* newGradient)
 //-----------------------------------------------------------------------------
 void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, const CRect* nineparttiledOffset)
 {
+	impl->finishBitmapPreload ();
 	UINode* bitmapsNode = getBaseNode (MainNodeNames::kBitmap);
 	auto* node = dynamic_cast<UIBitmapNode*> (findChildNodeByNameAttribute (bitmapsNode, name));
 	if (node)
@@ -2069,6 +3339,7 @@ void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, con
 //-----------------------------------------------------------------------------
 void UIDescription::changeBitmapFilters (UTF8StringPtr bitmapName, const std::list<SharedPointer<UIAttributes> >& filters)
 {
+	impl->finishBitmapPreload ();
 	auto* bitmapNode = dynamic_cast<UIBitmapNode*> (findChildNodeByNameAttribute (getBaseNode (MainNodeNames::kBitmap), bitmapName));
 	if (bitmapNode)
 	{
@@ -2135,15 +3406,10 @@ void UIDescription::collectBitmapFilters (UTF8StringPtr bitmapName, std::list<Sh
 static void removeChildNode (UINode* baseNode, UTF8StringPtr nodeName)
 {
 	UIDescList& children = baseNode->getChildren ();
-	for (const auto& itNode : children)
+	if (UINode* node = children.findChildNodeWithAttributeValue ("name", nodeName))
 	{
-		const std::string* name = itNode->getAttributes ()->getAttributeValue ("name");
-		if (name && *name == nodeName)
-		{
-			if (!itNode->noExport ())
-				children.remove (itNode);
-			return;
-		}
+		if (!node->noExport ())
+			children.remove (node);
 	}
 }
 
@@ -3145,6 +4411,46 @@ void UIControlTagNode::setTagString (const std::string& str)
 	tag = -1;
 }
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+UIBitmapDataNode::UIBitmapDataNode (const std::string& name, const SharedPointer<UIAttributes>& attributes)
+: UINode (name, attributes)
+{
+}
+
+//-----------------------------------------------------------------------------
+void UIBitmapDataNode::setDecodedData (Base64Codec::Result&& result)
+{
+	decodedData = std::move (result);
+	// the decoder grows its buffer while the data arrives, the node keeps the data only
+	if (decodedData.data.size () > decodedData.dataSize + decodedData.dataSize / 4)
+	{
+		Buffer<uint8_t> data (decodedData.dataSize);
+		if (decodedData.dataSize)
+			std::memcpy (data.get (), decodedData.data.get (), decodedData.dataSize);
+		decodedData.data = std::move (data);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void UIBitmapDataNode::encodeData ()
+{
+	if (!data.empty () || !hasDecodedData ())
+		return;
+	auto result = Base64Codec::encode (decodedData.data.get (), decodedData.dataSize);
+	data.assign (reinterpret_cast<const char*> (result.data.get ()), result.dataSize);
+}
+
+//-----------------------------------------------------------------------------
+bool UIBitmapDataNode::hasEqualData (const UINode* node) const
+{
+	auto dataNode = dynamic_cast<const UIBitmapDataNode*> (node);
+	if (dataNode == nullptr || dataNode->decodedData.dataSize != decodedData.dataSize)
+		return false;
+	return decodedData.dataSize == 0 || std::memcmp (decodedData.data.get (), dataNode->decodedData.data.get (), decodedData.dataSize) == 0;
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -3216,7 +4522,8 @@ void UIBitmapNode::createXMLData (const std::string& pathHint)
 	UINode* node = getChildren ().findChildNode ("data");
 	if (node)
 	{
-		if (node->getData ().empty ())
+		auto bitmapDataNode = dynamic_cast<UIBitmapDataNode*> (node);
+		if (bitmapDataNode ? !bitmapDataNode->hasDecodedData () : node->getData ().empty ())
 		{
 			getChildren ().remove (node);
 			node = nullptr;
@@ -3245,10 +4552,14 @@ void UIBitmapNode::createXMLData (const std::string& pathHint)
 				auto buffer = IPlatformBitmap::createMemoryPNGRepresentation (platformBitmap);
 				if (!buffer.empty ())
 				{
-					auto result = Base64Codec::encode (buffer.data(), static_cast<uint32_t> (buffer.size ()));
-					UINode* dataNode = new UINode ("data");
+					Base64Codec::Result decoded;
+					decoded.data.allocate (buffer.size ());
+					decoded.dataSize = static_cast<uint32_t> (buffer.size ());
+					std::memcpy (decoded.data.get (), buffer.data (), buffer.size ());
+					auto dataNode = new UIBitmapDataNode ("data", makeOwned<UIAttributes> ());
 					dataNode->getAttributes ()->setAttribute ("encoding", "base64");
-					dataNode->getData ().append (reinterpret_cast<const char*> (result.data.get ()), static_cast<std::streamsize> (result.dataSize));
+					dataNode->setDecodedData (std::move (decoded));
+					dataNode->encodeData ();
 					getChildren ().add (dataNode);
 				}
 			}
@@ -3257,26 +4568,25 @@ void UIBitmapNode::createXMLData (const std::string& pathHint)
 }
 
 //-----------------------------------------------------------------------------
-void UIBitmapNode::removeXMLData ()
+void UIBitmapNode::encodeXMLData ()
 {
-	UINode* node = getChildren ().findChildNode ("data");
-	if (node)
-		getChildren ().remove (node);
+	if (auto node = dynamic_cast<UIBitmapDataNode*> (getChildren ().findChildNode ("data")))
+		node->encodeData ();
 }
 
 //-----------------------------------------------------------------------------
-CBitmap* UIBitmapNode::createBitmap (const std::string& str, CNinePartTiledDescription* partDesc) const
+void UIBitmapNode::removeXMLData ()
 {
-	if (partDesc)
-		return new CNinePartTiledBitmap (CResourceDescription (str.c_str()), *partDesc);
-	return new CBitmap (CResourceDescription (str.c_str()));
+	UINode* node = getChildren ().findChildNode ("data");
+	if (node)
+		getChildren ().remove (node);
 }
 
 //------------------------------------------------------------------------
-UINode* UIBitmapNode::dataNode () const
+UIBitmapDataNode* UIBitmapNode::dataNode () const
 {
-	UINode* node = getChildren ().findChildNode ("data");
-	return (node && !node->getData ().empty ()) ? node : nullptr;
+	auto node = dynamic_cast<UIBitmapDataNode*> (getChildren ().findChildNode ("data"));
+	return (node && node->hasDecodedData ()) ? node : nullptr;
 }
 
 //------------------------------------------------------------------------
@@ -3284,17 +4594,13 @@ SharedPointer<IPlatformBitmap> UIBitmapNode::createBitmapFromDataNode () const
 {
 	if (auto node = dataNode ())
 	{
-		auto codecStr = node->getAttributes ()->getAttributeValue ("encoding");
-		if (codecStr && *codecStr == "base64")
+		const auto& data = node->getDecodedData ();
+		if (auto platformBitmap = IPlatformBitmap::createFromMemory (data.data.get (), data.dataSize))
 		{
-			auto result = Base64Codec::decode (node->getData ());
-			if (auto platformBitmap = IPlatformBitmap::createFromMemory (result.data.get (), result.dataSize))
-			{
-				double scaleFactor = 1.;
-				if (attributes->getDoubleAttribute ("scale-factor", scaleFactor))
-					platformBitmap->setScaleFactor (scaleFactor);
-				return platformBitmap;
-			}
+			double scaleFactor = 1.;
+			if (attributes->getDoubleAttribute ("scale-factor", scaleFactor))
+				platformBitmap->setScaleFactor (scaleFactor);
+			return platformBitmap;
 		}
 	}
 	return nullptr;
@@ -3305,45 +4611,94 @@ CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 {
 	if (bitmap == nullptr)
 	{
-		const std::string* path = attributes->getAttributeValue ("path");
-		if (path)
+		UIBitmapLoadJob job;
+		if (createLoadJob (pathHint, job))
 		{
-			CNinePartTiledDescription partDesc;
-			CNinePartTiledDescription* partDescPtr = nullptr;
-			CRect offsets;
-			if (attributes->getRectAttribute ("nineparttiled-offsets", offsets))
-			{
-				partDesc = CNinePartTiledDescription (offsets.left, offsets.top, offsets.right, offsets.bottom);
-				partDescPtr = &partDesc;
-			}
-			bitmap = createBitmap (*path, partDescPtr);
-			if (bitmap->getPlatformBitmap () == nullptr && pathIsAbsolute (pathHint))
-			{
-				std::string absPath = pathHint;
-				if (removeLastPathComponent (absPath))
-				{
-					absPath += "/" + *path;
-					if (auto platformBitmap = IPlatformBitmap::createFromPath (absPath.c_str ()))
-						bitmap->setPlatformBitmap (platformBitmap);
-				}
-			}
+			job.run ();
+			setLoadedBitmap (job);
 		}
-		if (bitmap && bitmap->getPlatformBitmap () == nullptr)
+	}
+	return bitmap;
+}
+
+//-----------------------------------------------------------------------------
+bool UIBitmapNode::createLoadJob (const std::string& pathHint, UIBitmapLoadJob& job) const
+{
+	if (bitmap)
+		return false;
+	const std::string* path = attributes->getAttributeValue ("path");
+	if (path == nullptr)
+		return false;
+	job.path = path->c_str ();
+	CRect offsets;
+	if (attributes->getRectAttribute ("nineparttiled-offsets", offsets))
+	{
+		job.partDesc = CNinePartTiledDescription (offsets.left, offsets.top, offsets.right, offsets.bottom);
+		job.hasPartDesc = true;
+	}
+	if (pathIsAbsolute (pathHint))
+	{
+		std::string absPath = pathHint;
+		if (removeLastPathComponent (absPath))
+			job.absolutePath = absPath + "/" + *path;
+	}
+	if (auto node = dataNode ())
+		job.bitmapData = &node->getDecodedData ();
+	attributes->getDoubleAttribute ("scale-factor", job.scaleFactor);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void UIBitmapNode::setLoadedBitmap (const UIBitmapLoadJob& job)
+{
+	if (bitmap || job.result == nullptr)
+		return;
+	bitmap = job.result;
+	bitmap->remember ();
+	if (job.decodedScaleFactor != 0.)
+		attributes->setDoubleAttribute ("scale-factor", job.decodedScaleFactor);
+	if (job.filtersProcessed)
+		filterProcessed = true;
+}
+
+//-----------------------------------------------------------------------------
+void UIBitmapLoadJob::run ()
+{
+	if (hasPartDesc)
+		result = makeOwned<CNinePartTiledBitmap> (CResourceDescription (path), partDesc);
+	else
+		result = makeOwned<CBitmap> (CResourceDescription (path));
+	if (result->getPlatformBitmap () == nullptr && !absolutePath.empty ())
+	{
+		if (auto platformBitmap = IPlatformBitmap::createFromPath (absolutePath.c_str ()))
+			result->setPlatformBitmap (platformBitmap);
+	}
+	if (result->getPlatformBitmap () == nullptr && bitmapData)
+	{
+		if (auto platformBitmap = IPlatformBitmap::createFromMemory (bitmapData->data.get (), bitmapData->dataSize))
 		{
-			if (auto platformBitmap = createBitmapFromDataNode ())
-				bitmap->setPlatformBitmap (platformBitmap);
+			if (scaleFactor != 0.)
+				platformBitmap->setScaleFactor (scaleFactor);
+			result->setPlatformBitmap (platformBitmap);
 		}
-		if (bitmap && path && bitmap->getPlatformBitmap () && bitmap->getPlatformBitmap ()->getScaleFactor () == 1.)
+	}
+	auto platformBitmap = result->getPlatformBitmap ();
+	if (platformBitmap == nullptr)
+		return;
+	if (platformBitmap->getScaleFactor () == 1.)
+	{
+		double factor = 1.;
+		if (UIDescriptionPrivate::decodeScaleFactorFromName (path, factor))
 		{
-			double scaleFactor = 1.;
-			if (UIDescriptionPrivate::decodeScaleFactorFromName (*path, scaleFactor))
-			{
-				bitmap->getPlatformBitmap ()->setScaleFactor (scaleFactor);
-				attributes->setDoubleAttribute ("scale-factor", scaleFactor);
-			}
+			platformBitmap->setScaleFactor (factor);
+			decodedScaleFactor = factor;
 		}
 	}
-	return bitmap;
+	if (!filters.empty ())
+	{
+		UIDescriptionPrivate::runBitmapFilters (result, filters);
+		filtersProcessed = true;
+	}
 }
 
 //-----------------------------------------------------------------------------
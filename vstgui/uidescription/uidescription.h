@@ -35,6 +35,17 @@ public:
 	~UIDescription () noexcept override;
 
 	virtual bool parse ();
+	/** parse the description again from xmlContentProvider or, if it is nullptr, from where it
+	 *	was parsed from and only replace the templates and resources which changed. The views
+	 *	created from the description are updated with the changed attributes, views of templates
+	 *	whose view hierarchy changed are created again and replace the old views in their parent
+	 *	container. controller has to be the one the views were created with, views below a view
+	 *	created with a sub-controller are created again with that sub-controller. The views passed
+	 *	in are never replaced, pass their parent container if they may have to be created again.
+	 *	The listeners are notified once for every kind of change.
+	 *	Returns false if the description was not parsed before or the new content can not be
+	 *	parsed, then nothing is changed. */
+	bool reload (const std::list<CView*>& views = {}, IController* controller = nullptr, Xml::IContentProvider* xmlContentProvider = nullptr);
 
 	enum SaveFlags {
 		kWriteWindowsResourceFile	= 1 << WriteWindowsResourceFileBit,
@@ -45,6 +56,17 @@ public:
 	virtual bool save (UTF8StringPtr filename, int32_t flags = kWriteWindowsResourceFile);
 	virtual bool saveWindowsRCFile (UTF8StringPtr filename);
 
+	/** save a snapshot of the description on a worker thread. The calling thread only prepares the
+	 *	description like save () does and copies the node tree, the file is written as plain XML
+	 *	like UIDescription::save () writes it. Subclasses which override save () to write another
+	 *	format have to override this too. A running background save is finished first and the
+	 *	memory of its snapshot is used for the new one. */
+	virtual bool saveInBackground (UTF8StringPtr filename, int32_t flags = kWriteWindowsResourceFile);
+	/** wait for the last background save and return its result, false if no save ran in the
+	 *	background */
+	bool finishBackgroundSave ();
+	bool isBackgroundSaveRunning () const;
+
 	bool storeViews (const std::list<CView*>& views, OutputStream& stream, UIAttributes* customData = nullptr) const;
 	bool restoreViews (InputStream& stream, std::list<SharedPointer<CView> >& views, UIAttributes** customData = nullptr);
 
@@ -134,6 +156,11 @@ public:
 
 	void setBitmapCreator (IBitmapCreator* bitmapCreator);
 
+	/** load and filter all bitmaps on worker threads right after parse (), getBitmap () then
+	 *	only waits for the requested bitmap. maxThreads 0 uses one thread per core. The platform
+	 *	bitmap implementation must support loading bitmaps on other threads. */
+	void setPreloadBitmaps (bool state, uint32_t maxThreads = 0);
+
 	using FocusDrawing = FocusDrawingSettings;
 	FocusDrawing getFocusDrawingSettings () const;
 	void setFocusDrawingSettings (const FocusDrawing& fd);
@@ -157,6 +184,7 @@ private:
 	UINode* getBaseNode (UTF8StringPtr name) const;
 	UINode* findChildNodeByNameAttribute (UINode* node, UTF8StringPtr nameAttribute) const;
 	UINode* findNodeForView (CView* view) const;
+	void prepareSave (int32_t flags);
 	bool updateAttributesForView (UINode* node, CView* view, bool deep = true);
 	void removeNode (UTF8StringPtr name, IdStringPtr mainNodeName);
 	template<typename NodeType, typename ObjType, typename CompareFunction> UTF8StringPtr lookupName (const ObjType& obj, IdStringPtr mainNodeName, CompareFunction compare) const;
@@ -148,8 +148,8 @@ CView* UIViewFactory::createViewByName (const std::string* className, const UIAt
 		{
 			IdStringPtr viewName = (*iter).second->getViewName ();
 			view->setAttribute (kViewNameAttribute, viewName);
-			UIAttributes evaluatedAttributes;
-			evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, description);
+			UIAttributes evaluatedAttributesStorage;
+			const auto& evaluatedAttributes = getEvaluatedAttributes (view, attributes, evaluatedAttributesStorage, description);
 			while (iter != registry.end () && (*iter).second->apply (view, evaluatedAttributes, description))
 			{
 				if ((*iter).second->getBaseViewName () == nullptr)
@@ -185,8 +185,8 @@ bool UIViewFactory::applyAttributeValues (CView* view, const UIAttributes& attri
 	auto& registry = getCreatorRegistry ();
 	auto iter = registry.find (getViewName (view));
 
-	UIAttributes evaluatedAttributes;
-	evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, desc);
+	UIAttributes evaluatedAttributesStorage;
+	const auto& evaluatedAttributes = getEvaluatedAttributes (view, attributes, evaluatedAttributesStorage, desc);
 	
 	while (iter != registry.end () && (result = (*iter).second->apply (view, evaluatedAttributes, desc)) && (*iter).second->getBaseViewName ())
 	{
@@ -206,8 +206,8 @@ bool UIViewFactory::applyCustomViewAttributeValues (CView* customView, IdStringP
 		IdStringPtr viewName = (*iter).second->getViewName ();
 		customView->setAttribute (kViewNameAttribute, viewName);
 	}
-	UIAttributes evaluatedAttributes;
-	evaluateAttributesAndRemember (customView, attributes, evaluatedAttributes, desc);
+	UIAttributes evaluatedAttributesStorage;
+	const auto& evaluatedAttributes = getEvaluatedAttributes (customView, attributes, evaluatedAttributesStorage, desc);
 	while (iter != registry.end () && (result = (*iter).second->apply (customView, evaluatedAttributes, desc)) && (*iter).second->getBaseViewName ())
 	{
 		iter = registry.find ((*iter).second->getBaseViewName ());
@@ -224,6 +224,28 @@ IdStringPtr UIViewFactory::getViewName (CView* view)
 	return viewName;
 }
 
+//-----------------------------------------------------------------------------
+/** Without live editing the evaluated attributes are kept with the source attributes until they
+ *	change, so that all views created from the same template node share them together with the
+ *	values parsed from them. Otherwise the attributes are evaluated into storage for every view.
+ */
+const UIAttributes& UIViewFactory::getEvaluatedAttributes (CView* view, const UIAttributes& attributes, UIAttributes& storage, const IUIDescription* description) const
+{
+#if VSTGUI_LIVE_EDITING
+	evaluateAttributesAndRemember (view, attributes, storage, description);
+	return storage;
+#else
+	if (attributes.evaluatedAttributes == nullptr || attributes.evaluatedDescription != description)
+	{
+		auto evaluatedAttributes = makeOwned<UIAttributes> ();
+		evaluateAttributesAndRemember (view, attributes, *evaluatedAttributes, description);
+		attributes.evaluatedAttributes = evaluatedAttributes;
+		attributes.evaluatedDescription = description;
+	}
+	return *attributes.evaluatedAttributes;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
 {
@@ -54,6 +54,7 @@ public:
 #endif
 
 protected:
+	const UIAttributes& getEvaluatedAttributes (CView* view, const UIAttributes& attributes, UIAttributes& storage, const IUIDescription* description) const;
 	void evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const;
 	CView* createViewByName (const std::string* className, const UIAttributes& attributes, const IUIDescription* description) const;
 
@@ -6,18 +6,44 @@
 #include "iviewcreator.h"
 #include "uidescription.h"
 #include "../lib/cframe.h"
+#include "../lib/cvstguitimer.h"
 #include "../lib/controls/ccontrol.h"
 #include "../lib/animation/timingfunctions.h"
 #include "../lib/animation/animations.h"
+#include <algorithm>
 
 namespace VSTGUI {
 
+//-----------------------------------------------------------------------------
+static uint32_t countViews (CView* view)
+{
+	uint32_t count = 1;
+	if (auto container = view->asViewContainer ())
+		container->forEachChild ([&] (CView* child) { count += countViews (child); });
+	return count;
+}
+
 //-----------------------------------------------------------------------------
 UIViewSwitchContainer::UIViewSwitchContainer (const CRect& size)
 : CViewContainer (size)
 {
 }
 
+//-----------------------------------------------------------------------------
+UIViewSwitchContainer::UIViewSwitchContainer (const UIViewSwitchContainer& other)
+: CViewContainer (other)
+, controller (other.controller)
+, currentViewIndex (other.currentViewIndex)
+, animationTime (other.animationTime)
+, animationStyle (other.animationStyle)
+, timingFunction (other.timingFunction)
+, cachePolicy (other.cachePolicy)
+, cacheSize (other.cacheSize)
+, cacheViewLimit (other.cacheViewLimit)
+{
+	// the cached views are not shared with the copy
+}
+
 //-----------------------------------------------------------------------------
 UIViewSwitchContainer::~UIViewSwitchContainer () noexcept
 {
@@ -27,6 +53,7 @@ UIViewSwitchContainer::~UIViewSwitchContainer () noexcept
 //-----------------------------------------------------------------------------
 void UIViewSwitchContainer::setController (IViewSwitchController* _controller)
 {
+	clearCache ();
 	if (controller)
 	{
 		auto obj = dynamic_cast<IReference*> (controller);
@@ -43,9 +70,14 @@ void UIViewSwitchContainer::setCurrentViewIndex (int32_t viewIndex)
 
 	if (controller && viewIndex != currentViewIndex)
 	{
-		CView* view = controller->createViewForIndex (viewIndex);
+		// a running animation must be finished first, as its old view may be in the cache
+		removeAnimation ("UIViewSwitchContainer::setCurrentViewIndex");
+		CView* view = takeCachedView (viewIndex);
+		if (view == nullptr)
+			view = controller->createViewForIndex (viewIndex);
 		if (view)
 		{
+			cacheCurrentView ();
 			if (view->getAutosizeFlags () & kAutosizeAll)
 			{
 				CRect vs (getViewSize ());
@@ -55,7 +87,6 @@ void UIViewSwitchContainer::setCurrentViewIndex (int32_t viewIndex)
 			}
 			if (isAttached () && animationTime)
 			{
-				removeAnimation ("UIViewSwitchContainer::setCurrentViewIndex");
 				CView* oldView = getView (0);
 				if (oldView)
 				{
@@ -139,11 +170,159 @@ void UIViewSwitchContainer::setCurrentViewIndex (int32_t viewIndex)
 				CViewContainer::addView (view);
 			}
 			currentViewIndex = viewIndex;
+			limitCache ();
 			invalid ();
 		}
 	}
 }
 
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::setCachePolicy (CachePolicy policy)
+{
+	if (policy == cachePolicy)
+		return;
+	cachePolicy = policy;
+	if (cachePolicy == kRecreateViews)
+		clearCache ();
+	else
+		limitCache ();
+	updatePreloadTimer ();
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::setCacheSize (uint32_t numPages)
+{
+	cacheSize = numPages;
+	limitCache ();
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::setCacheViewLimit (uint32_t numViews)
+{
+	cacheViewLimit = numViews;
+	limitCache ();
+}
+
+//-----------------------------------------------------------------------------
+uint32_t UIViewSwitchContainer::getNumCachedViews () const
+{
+	uint32_t numViews = 0;
+	for (const auto& cachedView : cachedViews)
+		numViews += cachedView.numViews;
+	return numViews;
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::clearCache ()
+{
+	cachedViews.clear ();
+	updatePreloadTimer ();
+}
+
+//-----------------------------------------------------------------------------
+auto UIViewSwitchContainer::findCachedView (int32_t index) -> CachedViews::iterator
+{
+	return std::find_if (cachedViews.begin (), cachedViews.end (),
+						 [&] (const CachedView& cachedView) { return cachedView.index == index; });
+}
+
+//-----------------------------------------------------------------------------
+CView* UIViewSwitchContainer::takeCachedView (int32_t index)
+{
+	auto it = findCachedView (index);
+	if (it == cachedViews.end ())
+		return nullptr;
+	// the animations change the size and the alpha value of the view which was switched out
+	CView* view = it->view;
+	view->setViewSize (it->viewSize);
+	view->setMouseableArea (it->viewSize);
+	view->setAlphaValue (it->alphaValue);
+	view->remember ();
+	cachedViews.erase (it);
+	return view;
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::cacheView (int32_t index, CView* view, bool mostRecent)
+{
+	CachedView cachedView {index, view, view->getViewSize (), view->getAlphaValue (),
+						   countViews (view)};
+	if (mostRecent)
+		cachedViews.emplace_back (std::move (cachedView));
+	else
+		cachedViews.emplace (cachedViews.begin (), std::move (cachedView));
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::cacheCurrentView ()
+{
+	if (cachePolicy == kRecreateViews || currentViewIndex < 0)
+		return;
+	if (auto view = getView (0))
+		cacheView (currentViewIndex, view);
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::limitCache ()
+{
+	// the least recently shown pages are at the front
+	if (cachePolicy == kKeepViewsAlive && cachedViews.size () > cacheSize)
+		cachedViews.erase (cachedViews.begin (), cachedViews.end () - cacheSize);
+	if (cacheViewLimit == 0)
+		return;
+	auto numViews = getNumCachedViews ();
+	auto it = cachedViews.begin ();
+	while (numViews > cacheViewLimit && it != cachedViews.end ())
+		numViews -= (it++)->numViews;
+	cachedViews.erase (cachedViews.begin (), it);
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::preloadNextView ()
+{
+	auto numIndices = controller ? controller->getNumViewIndices () : 0;
+	for (auto index = 0; index < numIndices; ++index)
+	{
+		if (index == currentViewIndex || findCachedView (index) != cachedViews.end ())
+			continue;
+		auto view = controller->createViewForIndex (index);
+		if (view == nullptr)
+			continue;
+		if (view->getAutosizeFlags () & kAutosizeAll)
+		{
+			CRect vs (getViewSize ());
+			vs.offset (-vs.left, -vs.top);
+			view->setViewSize (vs);
+			view->setMouseableArea (vs);
+		}
+		// preloaded pages were never shown, so they are the first ones to be dropped
+		bool fits = cacheViewLimit == 0 || getNumCachedViews () + countViews (view) <= cacheViewLimit;
+		if (fits)
+			cacheView (index, view, false);
+		view->forget ();
+		if (fits)
+			return;
+		break;
+	}
+	preloadTimer->stop ();
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::updatePreloadTimer ()
+{
+	if (cachePolicy == kPreloadViews && isAttached () && controller)
+	{
+		// one page per timer call to not block the event processing for too long
+		if (!preloadTimer)
+			preloadTimer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { preloadNextView (); },
+													10);
+		else
+			preloadTimer->start ();
+	}
+	else
+		preloadTimer = nullptr;
+}
+
 //-----------------------------------------------------------------------------
 void UIViewSwitchContainer::setAnimationTime (uint32_t ms)
 {
@@ -166,9 +345,12 @@ void UIViewSwitchContainer::setTimingFunction (TimingFunction t)
 bool UIViewSwitchContainer::attached (CView* parent)
 {
 	bool result = CViewContainer::attached (parent);
+	cacheCurrentView ();
 	CViewContainer::removeAll ();
+	currentViewIndex = -1;
 	if (result && controller)
 		controller->switchContainerAttached ();
+	updatePreloadTimer ();
 	return result;
 }
 
@@ -181,7 +363,11 @@ bool UIViewSwitchContainer::removed (CView* parent)
 		bool result = CViewContainer::removed (parent);
 		if (result && controller)
 			controller->switchContainerRemoved ();
+		cacheCurrentView ();
 		CViewContainer::removeAll ();
+		currentViewIndex = -1;
+		limitCache ();
+		updatePreloadTimer ();
 		return result;
 	}
 	return false;
@@ -199,6 +385,18 @@ UIDescriptionViewSwitchController::UIDescriptionViewSwitchController (
 , switchControl (nullptr)
 {
 	init ();
+	if (auto desc = dynamic_cast<const UIDescription*> (uiDescription))
+	{
+		listenedDescription = const_cast<UIDescription*> (desc);
+		listenedDescription->registerListener (this);
+	}
+}
+
+//-----------------------------------------------------------------------------
+UIDescriptionViewSwitchController::~UIDescriptionViewSwitchController () noexcept
+{
+	if (listenedDescription)
+		listenedDescription->unregisterListener (this);
 }
 
 //-----------------------------------------------------------------------------
@@ -211,6 +409,12 @@ CView* UIDescriptionViewSwitchController::createViewForIndex (int32_t index)
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+int32_t UIDescriptionViewSwitchController::getNumViewIndices () const
+{
+	return static_cast<int32_t> (templateNames.size ());
+}
+
 //-----------------------------------------------------------------------------
 static CControl* findControlForTag (CViewContainer* parent, int32_t tag, bool reverse = true)
 {
@@ -269,6 +473,42 @@ void UIDescriptionViewSwitchController::switchContainerRemoved ()
 	}
 }
 
+//-----------------------------------------------------------------------------
+void UIDescriptionViewSwitchController::onUIDescTagChanged (UIDescription* desc)
+{
+	viewSwitch->clearCache ();
+}
+
+//-----------------------------------------------------------------------------
+void UIDescriptionViewSwitchController::onUIDescColorChanged (UIDescription* desc)
+{
+	viewSwitch->clearCache ();
+}
+
+//-----------------------------------------------------------------------------
+void UIDescriptionViewSwitchController::onUIDescFontChanged (UIDescription* desc)
+{
+	viewSwitch->clearCache ();
+}
+
+//-----------------------------------------------------------------------------
+void UIDescriptionViewSwitchController::onUIDescBitmapChanged (UIDescription* desc)
+{
+	viewSwitch->clearCache ();
+}
+
+//-----------------------------------------------------------------------------
+void UIDescriptionViewSwitchController::onUIDescTemplateChanged (UIDescription* desc)
+{
+	viewSwitch->clearCache ();
+}
+
+//-----------------------------------------------------------------------------
+void UIDescriptionViewSwitchController::onUIDescGradientChanged (UIDescription* desc)
+{
+	viewSwitch->clearCache ();
+}
+
 //-----------------------------------------------------------------------------
 void UIDescriptionViewSwitchController::valueChanged (CControl* pControl)
 {
@@ -284,6 +524,7 @@ void UIDescriptionViewSwitchController::valueChanged (CControl* pControl)
 //-----------------------------------------------------------------------------
 void UIDescriptionViewSwitchController::setTemplateNames (UTF8StringPtr _templateNames)
 {
+	viewSwitch->clearCache ();
 	templateNames.clear ();
 	if (_templateNames)
 	{
@@ -7,7 +7,8 @@
 #include "../lib/cviewcontainer.h"
 #include "../lib/controls/icontrollistener.h"
 #include "../lib/vstguifwd.h"
-#include "uidescriptionfwd.h"
+#include "uidescription.h"
+#include "uidescriptionlistener.h"
 #include <vector>
 
 namespace VSTGUI {
@@ -18,6 +19,7 @@ class UIViewSwitchContainer : public CViewContainer
 {
 public:
 	explicit UIViewSwitchContainer (const CRect& size);
+	UIViewSwitchContainer (const UIViewSwitchContainer& other);
 	~UIViewSwitchContainer () noexcept override;
 
 	IViewSwitchController* getController () const { return controller; }
@@ -49,16 +51,60 @@ public:
 	void setTimingFunction (TimingFunction t);
 	TimingFunction getTimingFunction () const { return timingFunction; }
 
+	enum CachePolicy {
+		kRecreateViews,		// the views of a page are created every time the page is shown
+		kKeepViewsAlive,	// the views of the most recently shown pages are kept
+		kPreloadViews		// all pages are created in idle time when the container is attached
+	};
+
+	void setCachePolicy (CachePolicy policy);
+	CachePolicy getCachePolicy () const { return cachePolicy; }
+
+	/** number of pages kept by the kKeepViewsAlive policy besides the shown one */
+	void setCacheSize (uint32_t numPages);
+	uint32_t getCacheSize () const { return cacheSize; }
+
+	/** maximum number of views of all cached pages together, 0 means no limit */
+	void setCacheViewLimit (uint32_t numViews);
+	uint32_t getCacheViewLimit () const { return cacheViewLimit; }
+
+	uint32_t getNumCachedPages () const { return static_cast<uint32_t> (cachedViews.size ()); }
+	uint32_t getNumCachedViews () const;
+	void clearCache ();
+
 	bool attached (CView* parent) override;
 	bool removed (CView* parent) override;
 //-----------------------------------------------------------------------------
 	CLASS_METHODS (UIViewSwitchContainer, CViewContainer)
 protected:
+	struct CachedView
+	{
+		int32_t index;
+		SharedPointer<CView> view;
+		CRect viewSize;
+		float alphaValue;
+		uint32_t numViews;
+	};
+	using CachedViews = std::vector<CachedView>;
+
+	CachedViews::iterator findCachedView (int32_t index);
+	CView* takeCachedView (int32_t index);
+	void cacheView (int32_t index, CView* view, bool mostRecent = true);
+	void cacheCurrentView ();
+	void limitCache ();
+	void preloadNextView ();
+	void updatePreloadTimer ();
+
 	IViewSwitchController* controller {nullptr};
 	int32_t currentViewIndex {-1};
 	uint32_t animationTime {120};
 	AnimationStyle animationStyle {kFadeInOut};
 	TimingFunction timingFunction {kLinear};
+	CachePolicy cachePolicy {kRecreateViews};
+	uint32_t cacheSize {4};
+	uint32_t cacheViewLimit {0};
+	CachedViews cachedViews;
+	SharedPointer<CVSTGUITimer> preloadTimer;
 };
 
 //-----------------------------------------------------------------------------
@@ -73,6 +119,8 @@ public:
 	UIViewSwitchContainer* getViewSwitchContainer () const { return viewSwitch; }
 
 	virtual CView* createViewForIndex (int32_t index) = 0;
+	/** number of indices which can be created, only needed to preload the views */
+	virtual int32_t getNumViewIndices () const { return 0; }
 	virtual void switchContainerAttached () = 0;
 	virtual void switchContainerRemoved () = 0;
 protected:
@@ -80,12 +128,16 @@ protected:
 };
 
 //-----------------------------------------------------------------------------
-class UIDescriptionViewSwitchController : public CBaseObject, public IViewSwitchController, public IControlListener
+/** clears the cached pages of the view switch container when the UIDescription changes, e.g.
+ *	when it is reloaded, as the cached pages were created from the old description */
+class UIDescriptionViewSwitchController : public CBaseObject, public IViewSwitchController, public IControlListener, public UIDescriptionListenerAdapter
 {
 public:
 	UIDescriptionViewSwitchController (UIViewSwitchContainer* viewSwitch, const IUIDescription* uiDescription, IController* uiController);
+	~UIDescriptionViewSwitchController () noexcept override;
 
 	CView* createViewForIndex (int32_t index) override;
+	int32_t getNumViewIndices () const override;
 	void switchContainerAttached () override;
 	void switchContainerRemoved () override;
 
@@ -97,7 +149,15 @@ public:
 protected:
 	void valueChanged (CControl* pControl) override;
 
+	void onUIDescTagChanged (UIDescription* desc) override;
+	void onUIDescColorChanged (UIDescription* desc) override;
+	void onUIDescFontChanged (UIDescription* desc) override;
+	void onUIDescBitmapChanged (UIDescription* desc) override;
+	void onUIDescTemplateChanged (UIDescription* desc) override;
+	void onUIDescGradientChanged (UIDescription* desc) override;
+
 	const IUIDescription* uiDescription;
+	UIDescription* listenedDescription {nullptr};
 	IController* uiController;
 	int32_t switchControlTag;
 	int32_t currentIndex;
@@ -9,6 +9,7 @@
 #include "../uiviewcreator.h"
 #include "../uiviewfactory.h"
 #include "../uiviewswitchcontainer.h"
+#include <algorithm>
 #include <array>
 
 //------------------------------------------------------------------------
@@ -29,6 +30,13 @@ auto UIViewSwitchContainerCreator::animationStyleStrings () -> AnimationStyleStr
 	return strings;
 }
 
+//------------------------------------------------------------------------
+auto UIViewSwitchContainerCreator::cachePolicyStrings () -> CachePolicyStrings&
+{
+	static CachePolicyStrings strings = {"recreate", "keep-alive", "preload"};
+	return strings;
+}
+
 //------------------------------------------------------------------------
 UIViewSwitchContainerCreator::UIViewSwitchContainerCreator ()
 {
@@ -123,6 +131,25 @@ bool UIViewSwitchContainerCreator::apply (CView* view, const UIAttributes& attri
 	{
 		viewSwitch->setAnimationTime (static_cast<uint32_t> (animationTime));
 	}
+
+	int32_t cacheSize;
+	if (attributes.getIntegerAttribute (kAttrCacheSize, cacheSize))
+		viewSwitch->setCacheSize (static_cast<uint32_t> (std::max (cacheSize, 0)));
+	int32_t cacheViewLimit;
+	if (attributes.getIntegerAttribute (kAttrCacheViewLimit, cacheViewLimit))
+		viewSwitch->setCacheViewLimit (static_cast<uint32_t> (std::max (cacheViewLimit, 0)));
+	attr = attributes.getAttributeValue (kAttrCachePolicy);
+	if (attr)
+	{
+		for (auto index = 0u; index <= UIViewSwitchContainer::kPreloadViews; ++index)
+		{
+			if (*attr == cachePolicyStrings ()[index])
+			{
+				viewSwitch->setCachePolicy (static_cast<UIViewSwitchContainer::CachePolicy> (index));
+				break;
+			}
+		}
+	}
 	return true;
 }
 
@@ -134,6 +161,9 @@ bool UIViewSwitchContainerCreator::getAttributeNames (StringList& attributeNames
 	attributeNames.emplace_back (kAttrAnimationStyle);
 	attributeNames.emplace_back (kAttrAnimationTimingFunction);
 	attributeNames.emplace_back (kAttrAnimationTime);
+	attributeNames.emplace_back (kAttrCachePolicy);
+	attributeNames.emplace_back (kAttrCacheSize);
+	attributeNames.emplace_back (kAttrCacheViewLimit);
 	return true;
 }
 
@@ -150,6 +180,12 @@ auto UIViewSwitchContainerCreator::getAttributeType (const string& attributeName
 		return kListType;
 	if (attributeName == kAttrAnimationTime)
 		return kIntegerType;
+	if (attributeName == kAttrCachePolicy)
+		return kListType;
+	if (attributeName == kAttrCacheSize)
+		return kIntegerType;
+	if (attributeName == kAttrCacheViewLimit)
+		return kIntegerType;
 	return kUnknownType;
 }
 
@@ -203,6 +239,23 @@ bool UIViewSwitchContainerCreator::getAttributeValue (CView* view, const string&
 		stringValue = timingFunctionStrings ()[viewSwitch->getTimingFunction ()];
 		return true;
 	}
+	else if (attributeName == kAttrCachePolicy)
+	{
+		stringValue = cachePolicyStrings ()[viewSwitch->getCachePolicy ()];
+		return true;
+	}
+	else if (attributeName == kAttrCacheSize)
+	{
+		stringValue =
+		    UIAttributes::integerToString (static_cast<int32_t> (viewSwitch->getCacheSize ()));
+		return true;
+	}
+	else if (attributeName == kAttrCacheViewLimit)
+	{
+		stringValue =
+		    UIAttributes::integerToString (static_cast<int32_t> (viewSwitch->getCacheViewLimit ()));
+		return true;
+	}
 	return false;
 }
 
@@ -222,6 +275,12 @@ bool UIViewSwitchContainerCreator::getPossibleListValues (const string& attribut
 			values.emplace_back (&str);
 		return true;
 	}
+	if (attributeName == kAttrCachePolicy)
+	{
+		for (auto& str : cachePolicyStrings ())
+			values.emplace_back (&str);
+		return true;
+	}
 	return false;
 }
 
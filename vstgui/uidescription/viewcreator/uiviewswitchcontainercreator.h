@@ -32,8 +32,10 @@ struct UIViewSwitchContainerCreator : ViewCreatorAdapter
 private:
 	using TimingFunctionStrings = std::array<string, 5>;
 	using AnimationStyleStrings = std::array<string, 3>;
+	using CachePolicyStrings = std::array<string, 3>;
 	static TimingFunctionStrings& timingFunctionStrings ();
 	static AnimationStyleStrings& animationStyleStrings ();
+	static CachePolicyStrings& cachePolicyStrings ();
 };
 
 //------------------------------------------------------------------------
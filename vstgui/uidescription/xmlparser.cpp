@@ -34,6 +34,8 @@ namespace Xml {
 
 #include "xmlparser.h"
 #include <algorithm>
+#include <cstring>
+#include <limits>
 
 namespace VSTGUI {
 namespace Xml {
@@ -43,8 +45,67 @@ struct Parser::Impl
 {
 	XML_ParserStruct* parser {nullptr};
 	IHandler* handler {nullptr};
+	bool stopped {false};
 };
 
+//------------------------------------------------------------------------
+namespace BinaryFormat {
+
+static constexpr uint32_t kIdentifierSize = 8;
+static constexpr char kIdentifier[kIdentifierSize + 1] = "VGUIXB01";
+
+enum Event : uint8_t
+{
+	kStartElement = 1,
+	kEndElement,
+	kCharData,
+	kComment,
+};
+
+//------------------------------------------------------------------------
+struct Reader
+{
+	const uint8_t* pos;
+	const uint8_t* end;
+
+	bool read (uint32_t& value)
+	{
+		if (end - pos < 4)
+			return false;
+		value = static_cast<uint32_t> (pos[0]) | (static_cast<uint32_t> (pos[1]) << 8) |
+		        (static_cast<uint32_t> (pos[2]) << 16) | (static_cast<uint32_t> (pos[3]) << 24);
+		pos += 4;
+		return true;
+	}
+
+	// the values inside the event list are stored with 7 bits per byte, low bits first
+	bool readVar (uint32_t& value)
+	{
+		value = 0;
+		for (uint32_t shift = 0; shift < 35 && pos < end; shift += 7)
+		{
+			auto byte = *pos++;
+			// the fifth byte only holds the upper 4 bits and must be the last one
+			if (shift == 28 && (byte & 0xF0) != 0)
+				return false;
+			value |= static_cast<uint32_t> (byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	// a length of items which are at least itemSize bytes big and must fit into the rest of the data
+	bool readLength (uint32_t& length, uint32_t itemSize = 1)
+	{
+		return readVar (length) && length <= remaining () / itemSize;
+	}
+
+	uint32_t remaining () const { return static_cast<uint32_t> (end - pos); }
+};
+
+} // BinaryFormat
+
 //------------------------------------------------------------------------
 static void XMLCALL gStartElementHandler (void* userData, const char* name, const char** atts)
 {
@@ -118,6 +179,7 @@ bool Parser::parse (IContentProvider* provider, IHandler* handler)
 
 	provider->rewind ();
 
+	bool firstBuffer = true;
 	while (true) 
 	{
 		void* buffer = XML_GetBuffer (pImpl->parser, kBufferSize);
@@ -130,6 +192,30 @@ bool Parser::parse (IContentProvider* provider, IHandler* handler)
 		uint32_t bytesRead = provider->readRawXmlData ((int8_t*)buffer, kBufferSize);
 		if (bytesRead == kStreamIOError)
 			bytesRead = 0;
+		if (firstBuffer && BinaryWriter::isBinary (buffer, bytesRead))
+		{
+			bool result;
+			if (auto memoryProvider = dynamic_cast<MemoryContentProvider*> (provider))
+			{
+				result = parseBinary (memoryProvider->getData (), memoryProvider->getDataSize ());
+			}
+			else
+			{
+				std::vector<int8_t> content (static_cast<int8_t*> (buffer), static_cast<int8_t*> (buffer) + bytesRead);
+				while (bytesRead == kBufferSize)
+				{
+					content.resize (content.size () + kBufferSize);
+					bytesRead = provider->readRawXmlData (content.data () + content.size () - kBufferSize, kBufferSize);
+					if (bytesRead == kStreamIOError)
+						bytesRead = 0;
+					content.resize (content.size () - kBufferSize + bytesRead);
+				}
+				result = parseBinary (content.data (), static_cast<uint32_t> (content.size ()));
+			}
+			pImpl->handler = nullptr;
+			return result;
+		}
+		firstBuffer = false;
 		XML_Status status = XML_ParseBuffer (pImpl->parser, static_cast<int> (bytesRead), bytesRead == 0);
 		switch (status) 
 		{
@@ -195,13 +281,213 @@ bool Parser::parse (IContentProvider* provider, IHandler* handler)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+bool Parser::parseBinary (const void* data, uint32_t dataSize)
+{
+	using namespace BinaryFormat;
+	auto begin = static_cast<const uint8_t*> (data);
+	Reader reader {begin + kIdentifierSize, begin + dataSize};
+
+	uint32_t numStrings;
+	uint32_t stringBytes;
+	if (!reader.read (numStrings) || !reader.read (stringBytes))
+		return false;
+	if (reader.remaining () < stringBytes || numStrings > stringBytes)
+		return false;
+	if (stringBytes > 0 && reader.pos[stringBytes - 1] != 0)
+		return false;
+	std::vector<const char*> strings;
+	strings.reserve (numStrings);
+	auto stringsEnd = reader.pos + stringBytes;
+	for (auto ptr = reader.pos; ptr < stringsEnd; ptr += strlen (reinterpret_cast<const char*> (ptr)) + 1)
+		strings.emplace_back (reinterpret_cast<const char*> (ptr));
+	if (strings.size () != numStrings)
+		return false;
+	reader.pos = stringsEnd;
+
+	uint32_t eventBytes;
+	if (!reader.read (eventBytes) || reader.remaining () != eventBytes)
+		return false;
+
+	auto readString = [&] (UTF8StringPtr& string) {
+		uint32_t index;
+		if (!reader.readVar (index) || index >= numStrings)
+			return false;
+		string = strings[index];
+		return true;
+	};
+
+	std::vector<UTF8StringPtr> attributes;
+	pImpl->stopped = false;
+	while (reader.pos < reader.end && !pImpl->stopped)
+	{
+		switch (*reader.pos++)
+		{
+			case kStartElement:
+			{
+				UTF8StringPtr name;
+				uint32_t numAttributes;
+				// every attribute needs at least one byte for its name and its value index
+				if (!readString (name) || !reader.readLength (numAttributes, 2))
+					return false;
+				attributes.resize (numAttributes * 2 + 1);
+				for (auto i = 0u; i < numAttributes * 2; ++i)
+				{
+					if (!readString (attributes[i]))
+						return false;
+				}
+				attributes[numAttributes * 2] = nullptr;
+				pImpl->handler->startXmlElement (this, name, attributes.data ());
+				break;
+			}
+			case kEndElement:
+			{
+				UTF8StringPtr name;
+				if (!readString (name))
+					return false;
+				pImpl->handler->endXmlElement (this, name);
+				break;
+			}
+			case kCharData:
+			{
+				uint32_t length;
+				if (!reader.readLength (length) || length > static_cast<uint32_t> (std::numeric_limits<int32_t>::max ()))
+					return false;
+				pImpl->handler->xmlCharData (this, reinterpret_cast<const int8_t*> (reader.pos), static_cast<int32_t> (length));
+				reader.pos += length;
+				break;
+			}
+			case kComment:
+			{
+				UTF8StringPtr comment;
+				if (!readString (comment))
+					return false;
+				pImpl->handler->xmlComment (this, comment);
+				break;
+			}
+			default:
+				return false;
+		}
+	}
+	return !pImpl->stopped;
+}
+
 //-----------------------------------------------------------------------------
 bool Parser::stop ()
 {
+	pImpl->stopped = true;
 	XML_StopParser (pImpl->parser, false);
 	return true;
 }
 
+//------------------------------------------------------------------------
+//------------------------------------------------------------------------
+//------------------------------------------------------------------------
+bool BinaryWriter::isBinary (const void* data, uint32_t dataSize)
+{
+	return dataSize >= BinaryFormat::kIdentifierSize &&
+	       memcmp (data, BinaryFormat::kIdentifier, BinaryFormat::kIdentifierSize) == 0;
+}
+
+//------------------------------------------------------------------------
+bool BinaryWriter::write (IContentProvider* xmlProvider, OutputStream& stream)
+{
+	stringMap.clear ();
+	strings.clear ();
+	charData.clear ();
+	events.clear ();
+	Parser parser;
+	if (!parser.parse (xmlProvider, this))
+		return false;
+	flushCharData ();
+
+	auto writeValue = [&] (uint32_t value) {
+		uint8_t bytes[4] = {static_cast<uint8_t> (value), static_cast<uint8_t> (value >> 8),
+		                    static_cast<uint8_t> (value >> 16), static_cast<uint8_t> (value >> 24)};
+		return stream.writeRaw (bytes, 4) == 4;
+	};
+	auto writeData = [&] (const void* data, size_t size) {
+		return size == 0 || stream.writeRaw (data, static_cast<uint32_t> (size)) == size;
+	};
+	return writeData (BinaryFormat::kIdentifier, BinaryFormat::kIdentifierSize) &&
+	       writeValue (static_cast<uint32_t> (stringMap.size ())) &&
+	       writeValue (static_cast<uint32_t> (strings.size ())) &&
+	       writeData (strings.data (), strings.size ()) &&
+	       writeValue (static_cast<uint32_t> (events.size ())) &&
+	       writeData (events.data (), events.size ());
+}
+
+//------------------------------------------------------------------------
+uint32_t BinaryWriter::intern (const char* string)
+{
+	auto result = stringMap.emplace (string, static_cast<uint32_t> (stringMap.size ()));
+	if (result.second)
+	{
+		strings.append (string);
+		strings.push_back (0);
+	}
+	return result.first->second;
+}
+
+//------------------------------------------------------------------------
+void BinaryWriter::writeVarUInt32 (uint32_t value)
+{
+	while (value > 0x7F)
+	{
+		events.emplace_back (static_cast<uint8_t> (value | 0x80));
+		value >>= 7;
+	}
+	events.emplace_back (static_cast<uint8_t> (value));
+}
+
+//------------------------------------------------------------------------
+void BinaryWriter::flushCharData ()
+{
+	if (charData.find_first_not_of (" \t\r\n") != std::string::npos)
+	{
+		events.emplace_back (BinaryFormat::kCharData);
+		writeVarUInt32 (static_cast<uint32_t> (charData.size ()));
+		events.insert (events.end (), charData.begin (), charData.end ());
+	}
+	charData.clear ();
+}
+
+//------------------------------------------------------------------------
+void BinaryWriter::startXmlElement (Parser* parser, IdStringPtr elementName, UTF8StringPtr* elementAttributes)
+{
+	flushCharData ();
+	events.emplace_back (BinaryFormat::kStartElement);
+	writeVarUInt32 (intern (elementName));
+	uint32_t numAttributes = 0;
+	while (elementAttributes && elementAttributes[numAttributes * 2])
+		++numAttributes;
+	writeVarUInt32 (numAttributes);
+	for (auto i = 0u; i < numAttributes * 2; ++i)
+		writeVarUInt32 (intern (elementAttributes[i]));
+}
+
+//------------------------------------------------------------------------
+void BinaryWriter::endXmlElement (Parser* parser, IdStringPtr name)
+{
+	flushCharData ();
+	events.emplace_back (BinaryFormat::kEndElement);
+	writeVarUInt32 (intern (name));
+}
+
+//------------------------------------------------------------------------
+void BinaryWriter::xmlCharData (Parser* parser, const int8_t* data, int32_t length)
+{
+	charData.append (reinterpret_cast<const char*> (data), static_cast<size_t> (length));
+}
+
+//------------------------------------------------------------------------
+void BinaryWriter::xmlComment (Parser* parser, IdStringPtr comment)
+{
+	flushCharData ();
+	events.emplace_back (BinaryFormat::kComment);
+	writeVarUInt32 (intern (comment));
+}
+
 //------------------------------------------------------------------------
 //------------------------------------------------------------------------
 //------------------------------------------------------------------------
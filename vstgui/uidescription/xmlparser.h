@@ -7,6 +7,9 @@
 #include "../lib/vstguibase.h"
 #include "cstream.h"
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace VSTGUI {
 namespace Xml {
@@ -44,10 +47,49 @@ public:
 
 	IHandler* getHandler () const;
 protected:
+	bool parseBinary (const void* data, uint32_t dataSize);
+
 	struct Impl;
 	std::unique_ptr<Impl> pImpl;
 };
 
+//-----------------------------------------------------------------------------
+/** Writes the events of an xml document in a pre-tokenized binary form.
+ *
+ *	Parser::parse () detects the binary form and replays its events to the handler without
+ *	running the xml parser. The element names, attribute names and attribute values are stored
+ *	once in a string table and handed to the handler directly from the loaded buffer. Character
+ *	data which only contains whitespace is dropped.
+ *
+ *	The binary form only saves the tokenizing of the xml text: attribute values are still strings
+ *	which the handler converts, and embedded bitmaps are still base64 encoded character data. The
+ *	strings are only used in place if the content comes from a MemoryContentProvider, other
+ *	providers are read into one buffer first. All counts, lengths and string indices are checked
+ *	against the rest of the data, so parse () returns false for corrupt data.
+ */
+class BinaryWriter : public IHandler
+{
+public:
+	bool write (IContentProvider* xmlProvider, OutputStream& stream);
+
+	static bool isBinary (const void* data, uint32_t dataSize);
+
+	void startXmlElement (Parser* parser, IdStringPtr elementName, UTF8StringPtr* elementAttributes) override;
+	void endXmlElement (Parser* parser, IdStringPtr name) override;
+	void xmlCharData (Parser* parser, const int8_t* data, int32_t length) override;
+	void xmlComment (Parser* parser, IdStringPtr comment) override;
+
+private:
+	uint32_t intern (const char* string);
+	void writeVarUInt32 (uint32_t value);
+	void flushCharData ();
+
+	std::unordered_map<std::string, uint32_t> stringMap;
+	std::string strings;
+	std::string charData;
+	std::vector<uint8_t> events;
+};
+
 //-----------------------------------------------------------------------------
 class MemoryContentProvider : public CMemoryStream, public IContentProvider
 {
@@ -55,6 +97,9 @@ public:
 	MemoryContentProvider (const void* data, uint32_t dataSize);		// data must be valid the whole lifetime of this object
 	uint32_t readRawXmlData (int8_t* buffer, uint32_t size) override;
 	void rewind () override;
+
+	const int8_t* getData () const { return buffer; }
+	uint32_t getDataSize () const { return size; }
 };
 
 //-----------------------------------------------------------------------------
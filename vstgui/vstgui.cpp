@@ -4,6 +4,7 @@
 
 #include "lib/cbitmap.cpp"
 #include "lib/cbitmapfilter.cpp"
+#include "lib/cbitmapfilterkernels.cpp"
 #include "lib/ccolor.cpp"
 #include "lib/cdatabrowser.cpp"
 #include "lib/cdrawcontext.cpp"
@@ -14,11 +15,13 @@
 #include "lib/cframe.cpp"
 #include "lib/cgradientview.cpp"
 #include "lib/cgraphicspath.cpp"
+#include "lib/cinvalidrectlist.cpp"
 #include "lib/clayeredviewcontainer.cpp"
 #include "lib/clinestyle.cpp"
 #include "lib/coffscreencontext.cpp"
 #include "lib/copenglview.cpp"
 #include "lib/cpoint.cpp"
+#include "lib/cpufeatures.cpp"
 #include "lib/crect.cpp"
 #include "lib/crowcolumnview.cpp"
 #include "lib/cscrollview.cpp"
@@ -11,3 +11,5 @@
 #include "lib/platform/linux/cairofont.cpp"
 #include "lib/platform/linux/cairogradient.cpp"
 #include "lib/platform/linux/cairopath.cpp"
+#include "lib/platform/linux/cairotextlayout.cpp"
+#include "lib/platform/linux/cairoviewlayer.cpp"
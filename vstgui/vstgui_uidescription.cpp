@@ -4,6 +4,7 @@
 
 #include "vstgui_uidescription.h"
 
+#include "uidescription/base64codec.cpp"
 #include "uidescription/cstream.cpp"
 #include "uidescription/uiattributes.cpp"
 #include "uidescription/uidescription.cpp"